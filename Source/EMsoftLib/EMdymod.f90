@@ -42,6 +42,7 @@
 !> @date  01/14/16 MDG 2.3 added EMsoftCgetECPatterns routine
 !> @date  01/25/16 MDG 2.4 several routine name changes
 !> @date  04/28/16 MDG 2.5 unified the ipar and fpar arrays for all C-callable routines
+!> @date  10/16/26 2.6 added persistent EBSD detector (create/compute/destroy) for repeated pattern calls
 !--------------------------------------------------------------------------
 !
 ! general information: the ipar and fpar arrays for all the routines that are C-callable
@@ -112,6 +113,8 @@
 !
 module EMdymod
 
+use local
+
 !--------------------------------------------------------------------------
 ! Callback routine(s) to communicate progress with DREAM.3D package
 
@@ -152,6 +155,19 @@ ABSTRACT INTERFACE
    END SUBROUTINE ProgressCallBack3
 END INTERFACE
 
+!--------------------------------------------------------------------------
+! persistent EBSD detector; holds everything in EMsoftCgetEBSDPatterns that only
+! depends on the detector geometry and the master/Monte Carlo arrays, so that
+! repeated pattern calls with a fixed detector only pay for the interpolation.
+! C/C++ programs handle this as an opaque pointer via EMsoftCcreateEBSDDetector,
+! EMsoftCcomputeEBSDPatterns and EMsoftCdestroyEBSDDetector.
+type EBSDDetectorType
+  integer(kind=irg)             :: numsx, numsy, numEbins, npx
+  real(kind=sgl),allocatable    :: rgx(:,:), rgy(:,:), rgz(:,:)
+  real(kind=sgl),allocatable    :: accum_e_detector(:,:,:)
+  real(kind=sgl),allocatable    :: mLPNHsum(:,:,:), mLPSHsum(:,:,:)
+end type EBSDDetectorType
+
 !--------------------------------------------------------------------------
 
 contains
@@ -197,6 +213,7 @@ contains
 !> @date 06/12/16 MDG 2.2 correction for effective pixel area with respect to equal-area Lambert projection
 !> @date 07/01/16 MDG 2.3 correction of array subscripts in rgx/y/z arrays.
 !> @date 12/05/16 MDG 2.4 added option to pass in Euler angles instead of quaternions; quats array dimensions are unchanged
+!> @date 10/16/26 2.5 split into EBSDDetectorInit and EBSDDetectorPatterns; removed save attribute on prefactor
 !--------------------------------------------------------------------------
 recursive subroutine EMsoftCgetEBSDPatterns(ipar, fpar, EBSDpattern, quats, accum_e, mLPNH, mLPSH, cproc, objAddress, cancel) &
            bind(c, name='EMsoftCgetEBSDPatterns')    ! this routine is callable from a C/C++ program
@@ -231,10 +248,6 @@ recursive subroutine EMsoftCgetEBSDPatterns(ipar, fpar, EBSDpattern, quats, accu
 ! fpar(22) = gammavalue
 
 use local
-use constants
-use Lambert
-use quaternions
-use rotations
 use,INTRINSIC :: ISO_C_BINDING
 
 IMPLICIT NONE
@@ -253,46 +266,211 @@ TYPE(C_FUNPTR), INTENT(IN), VALUE       :: cproc
 integer(c_size_t),INTENT(IN), VALUE     :: objAddress
 character(len=1),INTENT(IN)             :: cancel
 
+type(EBSDDetectorType)                  :: det
+
+! set up the detector arrays, compute the patterns, and discard the detector
+call EBSDDetectorInit(det, ipar, fpar, accum_e, mLPNH, mLPSH)
+call EBSDDetectorPatterns(det, ipar, fpar, EBSDpattern, quats, cproc, objAddress, cancel)
+call EBSDDetectorClear(det)
+
+end subroutine EMsoftCgetEBSDPatterns
+
+!--------------------------------------------------------------------------
+!
+! FUNCTION:EMsoftCcreateEBSDDetector
+!
+!> @author Marc De Graef, Carnegie Mellon University / and others
+!
+!> @brief create a persistent EBSD detector for repeated calls to EMsoftCcomputeEBSDPatterns
+!
+!> @details The detector direction cosine arrays, the detector energy array and the
+!> numset-summed master patterns are computed once and kept until EMsoftCdestroyEBSDDetector
+!> is called; the master pattern and Monte Carlo arrays are not referenced afterwards, so the
+!> calling program is free to release them.  ipar and fpar follow the EMsoftCgetEBSDPatterns
+!> convention; only the geometry components (ipar 1, 9, 12, 17, 19, 20 and fpar 1, 2, 15-21)
+!> are used here.
+!
+!> @param ipar array with integer input parameters
+!> @param fpar array with float input parameters
+!> @param accum_e array with Monte Carlo histogram
+!> @param mLPNH Northern hemisphere master pattern
+!> @param mLPSH Southern hemisphere master pattern
+!
+!> @date 10/16/26 1.0 original
+!--------------------------------------------------------------------------
+recursive function EMsoftCcreateEBSDDetector(ipar, fpar, accum_e, mLPNH, mLPSH) result(detector) &
+           bind(c, name='EMsoftCcreateEBSDDetector')    ! this routine is callable from a C/C++ program
+!DEC$ ATTRIBUTES DLLEXPORT :: EMsoftCcreateEBSDDetector
+
+use local
+use,INTRINSIC :: ISO_C_BINDING
+
+IMPLICIT NONE
+
+integer(c_int32_t),PARAMETER            :: nipar=40
+integer(c_int32_t),PARAMETER            :: nfpar=40
+integer(c_int32_t),INTENT(IN)           :: ipar(nipar)
+real(kind=sgl),INTENT(IN)               :: fpar(nfpar)
+integer(c_int32_t),INTENT(IN)           :: accum_e(ipar(12),-ipar(1):ipar(1),-ipar(1):ipar(1))
+real(kind=sgl),INTENT(IN)               :: mLPNH(-ipar(17):ipar(17), -ipar(17):ipar(17), ipar(12), ipar(9))
+real(kind=sgl),INTENT(IN)               :: mLPSH(-ipar(17):ipar(17), -ipar(17):ipar(17), ipar(12), ipar(9))
+type(c_ptr)                             :: detector
+
+type(EBSDDetectorType),pointer          :: det
+
+allocate(det)
+call EBSDDetectorInit(det, ipar, fpar, accum_e, mLPNH, mLPSH)
+detector = c_loc(det)
+
+end function EMsoftCcreateEBSDDetector
+
+!--------------------------------------------------------------------------
+!
+! SUBROUTINE:EMsoftCcomputeEBSDPatterns
+!
+!> @author Marc De Graef, Carnegie Mellon University / and others
+!
+!> @brief compute a series of EBSD patterns for a detector created by EMsoftCcreateEBSDDetector
+!
+!> @details Only the per-call components of ipar and fpar are used (ipar 21-25 and fpar 22);
+!> all others are taken from the detector.  The detector is not modified, so several threads
+!> may use the same detector at the same time, each with its own output and quaternion arrays.
+!
+!> @param detector pointer returned by EMsoftCcreateEBSDDetector
+!> @param ipar array with integer input parameters
+!> @param fpar array with float input parameters
+!> @param EBSDpattern output array
+!> @param quats quaternion input array
+!> @param cproc pointer to a C-function for the callback process
+!> @param objAddress unique integer identifying the calling class in DREAM.3D
+!> @param cancel character defined by DREAM.3D; when not equal to NULL (i.e., char(0)), the computation should be halted
+!
+!> @date 10/16/26 1.0 original
+!--------------------------------------------------------------------------
+recursive subroutine EMsoftCcomputeEBSDPatterns(detector, ipar, fpar, EBSDpattern, quats, cproc, objAddress, cancel) &
+           bind(c, name='EMsoftCcomputeEBSDPatterns')    ! this routine is callable from a C/C++ program
+!DEC$ ATTRIBUTES DLLEXPORT :: EMsoftCcomputeEBSDPatterns
+
+use local
+use,INTRINSIC :: ISO_C_BINDING
+
+IMPLICIT NONE
+
+type(c_ptr),INTENT(IN), VALUE           :: detector
+integer(c_int32_t),PARAMETER            :: nipar=40
+integer(c_int32_t),PARAMETER            :: nfpar=40
+integer(c_int32_t),INTENT(IN)           :: ipar(nipar)
+real(kind=sgl),INTENT(IN)               :: fpar(nfpar)
+integer(c_int32_t),PARAMETER            :: nq=4
+real(kind=sgl),INTENT(IN)               :: quats(nq,ipar(21))
+real(kind=sgl),INTENT(OUT)              :: EBSDpattern(ipar(23),ipar(24),ipar(21))
+TYPE(C_FUNPTR), INTENT(IN), VALUE       :: cproc
+integer(c_size_t),INTENT(IN), VALUE     :: objAddress
+character(len=1),INTENT(IN)             :: cancel
+
+type(EBSDDetectorType),pointer          :: det
+
+if (.not.c_associated(detector)) return
+call c_f_pointer(detector, det)
+call EBSDDetectorPatterns(det, ipar, fpar, EBSDpattern, quats, cproc, objAddress, cancel)
+
+end subroutine EMsoftCcomputeEBSDPatterns
+
+!--------------------------------------------------------------------------
+!
+! SUBROUTINE:EMsoftCdestroyEBSDDetector
+!
+!> @author Marc De Graef, Carnegie Mellon University / and others
+!
+!> @brief release a detector created by EMsoftCcreateEBSDDetector
+!
+!> @param detector pointer returned by EMsoftCcreateEBSDDetector
+!
+!> @date 10/16/26 1.0 original
+!--------------------------------------------------------------------------
+recursive subroutine EMsoftCdestroyEBSDDetector(detector) &
+           bind(c, name='EMsoftCdestroyEBSDDetector')    ! this routine is callable from a C/C++ program
+!DEC$ ATTRIBUTES DLLEXPORT :: EMsoftCdestroyEBSDDetector
+
+use,INTRINSIC :: ISO_C_BINDING
+
+IMPLICIT NONE
+
+type(c_ptr),INTENT(IN), VALUE           :: detector
+
+type(EBSDDetectorType),pointer          :: det
+
+if (.not.c_associated(detector)) return
+call c_f_pointer(detector, det)
+call EBSDDetectorClear(det)
+deallocate(det)
+
+end subroutine EMsoftCdestroyEBSDDetector
+
+!--------------------------------------------------------------------------
+!
+! SUBROUTINE:EBSDDetectorInit
+!
+!> @author Marc De Graef, Carnegie Mellon University / and others
+!
+!> @brief compute the orientation independent detector arrays for EBSD pattern interpolation
+!
+!> @param det detector structure
+!> @param ipar array with integer input parameters
+!> @param fpar array with float input parameters
+!> @param accum_e array with Monte Carlo histogram
+!> @param mLPNH Northern hemisphere master pattern
+!> @param mLPSH Southern hemisphere master pattern
+!
+!> @date 10/16/26 1.0 split off from EMsoftCgetEBSDPatterns
+!--------------------------------------------------------------------------
+recursive subroutine EBSDDetectorInit(det, ipar, fpar, accum_e, mLPNH, mLPSH)
+
+use local
+use constants
+use Lambert
+use,INTRINSIC :: ISO_C_BINDING
+
+IMPLICIT NONE
+
+type(EBSDDetectorType),INTENT(INOUT)    :: det
+integer(c_int32_t),PARAMETER            :: nipar=40
+integer(c_int32_t),PARAMETER            :: nfpar=40
+integer(c_int32_t),INTENT(IN)           :: ipar(nipar)
+real(kind=sgl),INTENT(IN)               :: fpar(nfpar)
+integer(c_int32_t),INTENT(IN)           :: accum_e(ipar(12),-ipar(1):ipar(1),-ipar(1):ipar(1))
+real(kind=sgl),INTENT(IN)               :: mLPNH(-ipar(17):ipar(17), -ipar(17):ipar(17), ipar(12), ipar(9))
+real(kind=sgl),INTENT(IN)               :: mLPSH(-ipar(17):ipar(17), -ipar(17):ipar(17), ipar(12), ipar(9))
+
 ! various variables and arrays
-real(kind=sgl)                          :: fullsizepattern(ipar(19),ipar(20)), binned(ipar(23),ipar(24))
-real(kind=irg),allocatable              :: accum_e_detector(:,:,:)
-real(kind=sgl),allocatable              :: rgx(:,:), rgy(:,:), rgz(:,:)
-real(kind=sgl),allocatable              :: mLPNHsum(:,:,:), mLPSHsum(:,:,:)
-real(kind=sgl),save                     :: prefactor
+real(kind=sgl)                          :: prefactor
 real(kind=sgl),allocatable              :: scin_x(:), scin_y(:)                 ! scintillator coordinate arrays [microns]
 real(kind=sgl),parameter                :: dtor = 0.0174533  ! convert from degrees to radians
-real(kind=sgl)                          :: alp, ca, sa, cw, sw, quat(4)
+real(kind=sgl)                          :: alp, ca, sa, cw, sw
 real(kind=sgl)                          :: L2, Ls, Lc     ! distances
-integer(kind=irg)                       :: nix, niy, binx, biny,  nixp, niyp, i, j, Emin, Emax, istat, k, ip, dn, cn, & 
-                                           ii, jj, binfac, ipx, ipy      ! various parameters
+integer(kind=irg)                       :: nix, niy, i, j, Emin, Emax, istat, k, ipx, ipy      ! various parameters
 real(kind=sgl)                          :: dc(3), scl, alpha, theta, gam, pcvec(3), dp, calpha           ! direction cosine array
-real(kind=sgl)                          :: sx, dx, dxm, dy, dym, rhos, x, bindx         ! various parameters
+real(kind=sgl)                          :: sx, dx, dxm, dy, dym, x         ! various parameters
 real(kind=sgl)                          :: ixy(2)
-real(kind=dbl),parameter                :: nAmpere = 6.241D+18 
-PROCEDURE(ProgressCallBack), POINTER    :: proc
+real(kind=dbl),parameter                :: nAmpere = 6.241D+18
 
-! link the proc procedure to the cproc argument
-CALL C_F_PROCPOINTER (cproc, proc)
+call EBSDDetectorClear(det)
 
-! binned pattern dimensions
-  binx = ipar(23)
-  biny = ipar(24)
-  binfac = 2**ipar(22)
-  bindx = 1.0/float(binfac)**2
+det%numsx = ipar(19)
+det%numsy = ipar(20)
+det%numEbins = ipar(12)
+det%npx = ipar(17)
 
 !====================================
 ! ------ generate the detector rgx, rgy, rgz arrays (and a few others)
 !====================================
-  if (allocated(mLPNHsum)) deallocate(mLPNHsum)
-  if (allocated(mLPSHsum)) deallocate(mLPSHsum)
-
-  allocate(mLPNHsum(-ipar(17):ipar(17), -ipar(17):ipar(17), ipar(12)))
-  allocate(mLPSHsum(-ipar(17):ipar(17), -ipar(17):ipar(17), ipar(12)))
-  mLPNHsum = sum(mLPNH,4)
-  mLPSHsum = sum(mLPSH,4)
+  allocate(det%mLPNHsum(-ipar(17):ipar(17), -ipar(17):ipar(17), ipar(12)))
+  allocate(det%mLPSHsum(-ipar(17):ipar(17), -ipar(17):ipar(17), ipar(12)))
+  det%mLPNHsum = sum(mLPNH,4)
+  det%mLPSHsum = sum(mLPSH,4)
 
   allocate(scin_x(ipar(19)),scin_y(ipar(20)),stat=istat)
-  
+
   scin_x = - ( fpar(15) - ( 1.0 - float(ipar(19)) ) * 0.5 - (/ (i-1, i=1,ipar(19)) /) ) * fpar(17)
   scin_y = ( fpar(16) - ( 1.0 - float(ipar(20)) ) * 0.5 - (/ (i-1, i=1,ipar(20)) /) ) * fpar(17)
 
@@ -305,9 +483,7 @@ CALL C_F_PROCPOINTER (cproc, proc)
   sw = sin(fpar(2) * dtor)
 
 ! compute auxilliary interpolation arrays
-  if (allocated(rgx)) deallocate(rgx, rgy, rgz)
-
-  allocate(rgx(ipar(19),ipar(20)), rgy(ipar(19),ipar(20)), rgz(ipar(19),ipar(20)))
+  allocate(det%rgx(ipar(19),ipar(20)), det%rgy(ipar(19),ipar(20)), det%rgz(ipar(19),ipar(20)))
 
   L2 = fpar(19) * fpar(19)
   do j=1,ipar(19)
@@ -316,14 +492,14 @@ CALL C_F_PROCPOINTER (cproc, proc)
     Lc = cw * scin_x(j) + fpar(19) * sw
     do i=1,ipar(20)
 !   rhos = 1.0/sqrt(sx + scin_y(i)**2)
-     rgx(j,i) = (scin_y(i) * ca + sa * Ls) ! * rhos
-     rgy(j,i) = Lc ! * rhos
-     rgz(j,i) = (-sa * scin_y(i) + ca * Ls) ! * rhos
+     det%rgx(j,i) = (scin_y(i) * ca + sa * Ls) ! * rhos
+     det%rgy(j,i) = Lc ! * rhos
+     det%rgz(j,i) = (-sa * scin_y(i) + ca * Ls) ! * rhos
 ! make sure that these vectors are normalized !
-     x = sqrt(rgx(j,i)**2+rgy(j,i)**2+rgz(j,i)**2)
-     rgx(j,i) = rgx(j,i) / x
-     rgy(j,i) = rgy(j,i) / x
-     rgz(j,i) = rgz(j,i) / x
+     x = sqrt(det%rgx(j,i)**2+det%rgy(j,i)**2+det%rgz(j,i)**2)
+     det%rgx(j,i) = det%rgx(j,i) / x
+     det%rgy(j,i) = det%rgy(j,i) / x
+     det%rgz(j,i) = det%rgz(j,i) / x
     end do
   end do
 
@@ -334,19 +510,17 @@ CALL C_F_PROCPOINTER (cproc, proc)
 ! ------ create the equivalent detector energy array
 !====================================
 ! from the Monte Carlo energy data, we need to extract the relevant
-! entries for the detector geometry defined above.  
+! entries for the detector geometry defined above.
 
 ! determine the scale factor for the Lambert interpolation; the square has
 ! an edge length of 2 x sqrt(pi/2)
-  scl = float(ipar(1)) 
+  scl = float(ipar(1))
 
 ! energy summation will go over all energy bins
   Emin = 1
   Emax = ipar(12)
 
-  if (allocated(accum_e_detector)) deallocate(accum_e_detector)
-
-  allocate(accum_e_detector(ipar(12),ipar(19),ipar(20)))
+  allocate(det%accum_e_detector(ipar(12),ipar(19),ipar(20)))
 
 ! correction of change in effective pixel area compared to equal-area Lambert projection
   alpha = atan(fpar(17)/fpar(19)/sqrt(sngl(cPi)))
@@ -356,13 +530,13 @@ CALL C_F_PROCPOINTER (cproc, proc)
   if (ipx .lt. 1) ipx = 1
   if (ipy .gt. ipar(20)) ipy = ipar(20)
   if (ipy .lt. 1) ipy = 1
-  pcvec = (/ rgx(ipx,ipy), rgy(ipx,ipy), rgz(ipx,ipy) /)
+  pcvec = (/ det%rgx(ipx,ipy), det%rgy(ipx,ipy), det%rgz(ipx,ipy) /)
   calpha = cos(alpha)
   do i=1,ipar(19)
     do j=1,ipar(20)
 ! do the coordinate transformation for this detector pixel
-       dc = (/ rgx(i,j), rgy(i,j), rgz(i,j) /)
-! make sure the third one is positive; if not, switch all 
+       dc = (/ det%rgx(i,j), det%rgy(i,j), det%rgz(i,j) /)
+! make sure the third one is positive; if not, switch all
        if (dc(3).lt.0.0) dc = -dc
 ! convert these direction cosines to coordinates in the Rosca-Lambert projection
         ixy = scl * LambertSphereToSquare( dc, istat )
@@ -379,30 +553,100 @@ CALL C_F_PROCPOINTER (cproc, proc)
 ! do the area correction for this detector pixel
         dp = dot_product(pcvec,dc)
         if ((i.eq.ipx).and.(j.eq.ipy)) then
-          gam = 0.25 
+          gam = 0.25
         else
           theta = calpha*calpha + dp*dp - 1.0
           gam = theta**1.5/(calpha**3) * 0.25
-          
+
         end if
-! interpolate the intensity 
+! interpolate the intensity
         do k= Emin, Emax
-          accum_e_detector(k,i,j) = gam * (accum_e(k,nix,niy) * dxm * dym + &
+          det%accum_e_detector(k,i,j) = gam * (accum_e(k,nix,niy) * dxm * dym + &
                                     accum_e(k,nix+1,niy) * dx * dym + &
                                     accum_e(k,nix,niy+1) * dxm * dy + &
                                     accum_e(k,nix+1,niy+1) * dx * dy)
         end do
     end do
-  end do 
-  prefactor = 0.25D0 * nAmpere * fpar(20) * fpar(21)  * 1.0D-15 / sum(accum_e_detector)
-  accum_e_detector = accum_e_detector * prefactor
+  end do
+  prefactor = 0.25D0 * nAmpere * fpar(20) * fpar(21)  * 1.0D-15 / sum(det%accum_e_detector)
+  det%accum_e_detector = det%accum_e_detector * prefactor
 
-! from here on, we simply compute the EBSD patterns by interpolation, using the above arrays
-! no intensity scaling or anything else...other than multiplication by pre-factor
-! intensity scaling is left to the user of the calling program.
+end subroutine EBSDDetectorInit
+
+!--------------------------------------------------------------------------
+!
+! SUBROUTINE:EBSDDetectorPatterns
+!
+!> @author Marc De Graef, Carnegie Mellon University / and others
+!
+!> @brief compute EBSD patterns by interpolation, using the arrays of an initialized detector
+!
+!> @details no intensity scaling or anything else...other than multiplication by pre-factor;
+!> intensity scaling is left to the user of the calling program.  The detector is only read,
+!> and all work arrays are local, so this routine may be called concurrently for one detector.
+!
+!> @param det detector structure
+!> @param ipar array with integer input parameters
+!> @param fpar array with float input parameters
+!> @param EBSDpattern output array
+!> @param quats quaternion input array
+!> @param cproc pointer to a C-function for the callback process
+!> @param objAddress unique integer identifying the calling class in DREAM.3D
+!> @param cancel character defined by DREAM.3D; when not equal to NULL (i.e., char(0)), the computation should be halted
+!
+!> @date 10/16/26 1.0 split off from EMsoftCgetEBSDPatterns
+!--------------------------------------------------------------------------
+recursive subroutine EBSDDetectorPatterns(det, ipar, fpar, EBSDpattern, quats, cproc, objAddress, cancel)
+
+use local
+use Lambert
+use quaternions
+use rotations
+use,INTRINSIC :: ISO_C_BINDING
+
+IMPLICIT NONE
+
+type(EBSDDetectorType),INTENT(IN)       :: det
+integer(c_int32_t),PARAMETER            :: nipar=40
+integer(c_int32_t),PARAMETER            :: nfpar=40
+integer(c_int32_t),INTENT(IN)           :: ipar(nipar)
+real(kind=sgl),INTENT(IN)               :: fpar(nfpar)
+integer(c_int32_t),PARAMETER            :: nq=4
+real(kind=sgl),INTENT(IN)               :: quats(nq,ipar(21))
+real(kind=sgl),INTENT(OUT)              :: EBSDpattern(ipar(23),ipar(24),ipar(21))
+TYPE(C_FUNPTR), INTENT(IN), VALUE       :: cproc
+integer(c_size_t),INTENT(IN), VALUE     :: objAddress
+character(len=1),INTENT(IN)             :: cancel
+
+! various variables and arrays
+real(kind=sgl),allocatable              :: fullsizepattern(:,:), binned(:,:)
+real(kind=sgl)                          :: quat(4)
+integer(kind=irg)                       :: nix, niy, binx, biny,  nixp, niyp, i, j, istat, k, ip, dn, cn, &
+                                           ii, jj, binfac, numsx, numsy, npx      ! various parameters
+real(kind=sgl)                          :: dc(3), scl           ! direction cosine array
+real(kind=sgl)                          :: dx, dxm, dy, dym, bindx         ! various parameters
+real(kind=sgl)                          :: ixy(2)
+PROCEDURE(ProgressCallBack), POINTER    :: proc
+
+! link the proc procedure to the cproc argument
+CALL C_F_PROCPOINTER (cproc, proc)
+
+! detector dimensions
+  numsx = det%numsx
+  numsy = det%numsy
+  npx = det%npx
+
+! binned pattern dimensions
+  binx = ipar(23)
+  biny = ipar(24)
+  binfac = 2**ipar(22)
+  bindx = 1.0/float(binfac)**2
+
+! work arrays are allocated rather than automatic to keep them off the (thread) stack
+  allocate(fullsizepattern(numsx,numsy), binned(binx,biny))
 
 ! define some parameters and initialize EBSDpattern
-scl = dble(ipar(17)) 
+scl = dble(npx)
 EBSDpattern = 0.0
 fullsizepattern = 0.0
 dn = nint(float(ipar(21))*0.01)
@@ -412,45 +656,45 @@ cn = dn
 quatloop: do ip=1,ipar(21)
   binned = 0.0
   fullsizepattern = 0.0
-  if (ipar(25).eq.0) then 
+  if (ipar(25).eq.0) then
     quat = quats(1:4,ip)
   else
     quat = eu2qu(quats(1:3,ip)) ! this assumes that the input Euler angles are in radians
   end if
-  do i=1,ipar(19)
-    do j=1,ipar(20)
+  do i=1,numsx
+    do j=1,numsy
 ! do the active coordinate transformation for this euler angle
-      dc = quat_Lp(quat,  (/ rgx(i,j), rgy(i,j), rgz(i,j) /) )
+      dc = quat_Lp(quat,  (/ det%rgx(i,j), det%rgy(i,j), det%rgz(i,j) /) )
 ! normalize dc
       dc = dc/sqrt(sum(dc*dc))
 ! convert these direction cosines to coordinates in the Rosca-Lambert projection (always square projection !!!)
       ixy = scl * LambertSphereToSquare( dc, istat )
 
-      if (istat.eq.0) then 
+      if (istat.eq.0) then
 ! four-point interpolation (bi-quadratic)
-        nix = int(ipar(17)+ixy(1))-ipar(17)
-        niy = int(ipar(17)+ixy(2))-ipar(17)
+        nix = int(npx+ixy(1))-npx
+        niy = int(npx+ixy(2))-npx
         nixp = nix+1
         niyp = niy+1
-        if (nixp.gt.ipar(17)) nixp = nix
-        if (niyp.gt.ipar(17)) niyp = niy
-        if (nix.lt.-ipar(17)) nix = nixp
-        if (niy.lt.-ipar(17)) niy = niyp
+        if (nixp.gt.npx) nixp = nix
+        if (niyp.gt.npx) niyp = niy
+        if (nix.lt.-npx) nix = nixp
+        if (niy.lt.-npx) niy = niyp
         dx = ixy(1)-nix
         dy = ixy(2)-niy
         dxm = 1.0-dx
         dym = 1.0-dy
         if (dc(3).gt.0.0) then ! we're in the Northern hemisphere
-          do k=1,ipar(12) 
-            fullsizepattern(i,j) = fullsizepattern(i,j) + accum_e_detector(k,i,j) * ( mLPNHsum(nix,niy,k) * dxm * dym +&
-                                        mLPNHsum(nixp,niy,k) * dx * dym + mLPNHsum(nix,niyp,k) * dxm * dy + &
-                                        mLPNHsum(nixp,niyp,k) * dx * dy )
+          do k=1,det%numEbins
+            fullsizepattern(i,j) = fullsizepattern(i,j) + det%accum_e_detector(k,i,j) * ( det%mLPNHsum(nix,niy,k) * dxm * dym +&
+                                        det%mLPNHsum(nixp,niy,k) * dx * dym + det%mLPNHsum(nix,niyp,k) * dxm * dy + &
+                                        det%mLPNHsum(nixp,niyp,k) * dx * dy )
           end do
         else                   ! we're in the Southern hemisphere
-          do k=1,ipar(12) 
-            fullsizepattern(i,j) = fullsizepattern(i,j) + accum_e_detector(k,i,j) * ( mLPSHsum(nix,niy,k) * dxm * dym +&
-                                        mLPSHsum(nixp,niy,k) * dx * dym + mLPSHsum(nix,niyp,k) * dxm * dy + &
-                                        mLPSHsum(nixp,niyp,k) * dx * dy )
+          do k=1,det%numEbins
+            fullsizepattern(i,j) = fullsizepattern(i,j) + det%accum_e_detector(k,i,j) * ( det%mLPSHsum(nix,niy,k) * dxm * dym +&
+                                        det%mLPSHsum(nixp,niy,k) * dx * dym + det%mLPSHsum(nix,niyp,k) * dxm * dy + &
+                                        det%mLPSHsum(nixp,niyp,k) * dx * dy )
           end do
         end if
       end if
@@ -458,9 +702,9 @@ quatloop: do ip=1,ipar(21)
   end do
 
 ! bin the pattern if necessary and apply the gamma scaling factor
-  if (binx.ne.ipar(19)) then 
-    do ii=1,ipar(19),binfac
-        do jj=1,ipar(20),binfac
+  if (binx.ne.numsx) then
+    do ii=1,numsx,binfac
+        do jj=1,numsy,binfac
             binned(ii/binfac+1,jj/binfac+1) = &
             sum(fullsizepattern(ii:ii+binfac-1,jj:jj+binfac-1))
         end do
@@ -483,8 +727,34 @@ quatloop: do ip=1,ipar(21)
 
 end do quatloop
 
+deallocate(fullsizepattern, binned)
 
-end subroutine EMsoftCgetEBSDPatterns
+end subroutine EBSDDetectorPatterns
+
+!--------------------------------------------------------------------------
+!
+! SUBROUTINE:EBSDDetectorClear
+!
+!> @author Marc De Graef, Carnegie Mellon University / and others
+!
+!> @brief deallocate all arrays of a detector structure
+!
+!> @param det detector structure
+!
+!> @date 10/16/26 1.0 original
+!--------------------------------------------------------------------------
+recursive subroutine EBSDDetectorClear(det)
+
+IMPLICIT NONE
+
+type(EBSDDetectorType),INTENT(INOUT)    :: det
+
+if (allocated(det%rgx)) deallocate(det%rgx, det%rgy, det%rgz)
+if (allocated(det%accum_e_detector)) deallocate(det%accum_e_detector)
+if (allocated(det%mLPNHsum)) deallocate(det%mLPNHsum)
+if (allocated(det%mLPSHsum)) deallocate(det%mLPSHsum)
+
+end subroutine EBSDDetectorClear
 
 !--------------------------------------------------------------------------
 !
@@ -34,6 +34,48 @@ void EMsoftCgetEBSDPatterns
          ProgCallBackType callback, size_t object, bool* cancel);
 
 
+/**
+* Persistent EBSD detector; computes the detector geometry, the detector energy
+* array and the summed master patterns once, for repeated pattern calculations:
+* @param ipar array with integer input parameters
+* @param fpar array with float input parameters
+* @param accum_e array with Monte Carlo histogram
+* @param mLPNH Northern hemisphere master pattern
+* @param mLPSH Southern hemisphere master pattern
+* @return opaque detector handle; release with EMsoftCdestroyEBSDDetector
+*/
+
+void* EMsoftCcreateEBSDDetector
+	(int32_t* ipar, float* fpar, int32_t* accum_e, float* mLPNH, float* mLPSH);
+
+
+/**
+* EBSD pattern calculations for a detector created by EMsoftCcreateEBSDDetector;
+* only ipar[20..24] and fpar[21] are read, and the detector may be shared between threads:
+* @param detector detector handle
+* @param ipar array with integer input parameters
+* @param fpar array with float input parameters
+* @param EBSDpattern output array
+* @param quats quaternion input array
+* @param callback callback routine to update progress bar
+* @param object unique identifier for calling class instantiation
+* @param cancel boolean to trigger cancellation of computation
+*/
+
+void EMsoftCcomputeEBSDPatterns
+	(void* detector, int32_t* ipar, float* fpar, float* EBSDpattern, float* quats,
+         ProgCallBackType callback, size_t object, bool* cancel);
+
+
+/**
+* Release an EBSD detector:
+* @param detector detector handle
+*/
+
+void EMsoftCdestroyEBSDDetector
+	(void* detector);
+
+
 /**
 * ECP calculations:
 * @param ipar array with integer input parameters
@@ -266,6 +266,83 @@ deallocate(output)
 
 end subroutine Denoise_PED
 
+!--------------------------------------------------------------------------
+!
+! SUBROUTINE:Denoise_PED_Batch
+!
+!> @brief Denoise a stack of kinematical PED patterns; the patterns are
+!> distributed over all OpenMP threads, one pattern per thread at a time
+!
+!> @param pednl namelist file for PED
+!> @param nimg number of patterns in the stack
+!> @param img_in stack of noisy patterns
+!> @param img_out stack of denoised patterns
+!
+!> @date 10/16/26     1.0 original
+!--------------------------------------------------------------------------
+recursive subroutine Denoise_PED_Batch(pednl, nimg, img_in, img_out)
+!DEC$ ATTRIBUTES DLLEXPORT :: Denoise_PED_Batch
+
+use local
+use ISO_C_BINDING
+use NameListTypedefs
+
+interface
+    recursive subroutine denoiseBatch (lx, ly, nimg, pf, powp, sigma_w, prinf, noisinf, &
+    icd, mbike, img_out) bind(C, name = 'denoiseBatch')
+
+use ISO_C_BINDING
+
+IMPLICIT NONE
+ 
+        integer(C_INT)                      :: lx
+        integer(C_INT)                      :: ly
+        integer(C_INT)                      :: nimg
+        real(C_FLOAT)                       :: pf
+        real(C_FLOAT)                       :: powp
+        real(C_FLOAT)                       :: sigma_w
+        real(C_FLOAT)                       :: prinf
+        real(C_FLOAT)                       :: noisinf
+        integer(C_INT)                      :: icd
+        real(C_DOUBLE)                      :: mbike(*)
+        real(C_DOUBLE)                      :: img_out(*)
+    end subroutine denoiseBatch
+end interface
+
+type(PEDKINIndxListType),INTENT(IN)        :: pednl
+integer(kind=irg),INTENT(IN)               :: nimg
+real(kind=sgl), INTENT(IN)                 :: img_in(1:pednl%npix**2,1:nimg)
+real(kind=sgl), INTENT(OUT)                :: img_out(1:pednl%npix**2,1:nimg)
+
+real(C_FLOAT)                              :: pf, powp, sigma_w, prinf, noisinf
+integer(C_INT)                             :: lx, ly, icd, cnimg
+integer(kind=irg)                          :: istat
+real(C_DOUBLE), allocatable                :: aux_in(:,:), aux_out(:,:)
+
+lx = pednl%npix
+ly = pednl%npix
+cnimg = nimg
+
+! these values are the same as in Denoise_PED
+pf = 1.0
+powp = 1.2
+sigma_w = 15.0
+prinf = 1.0
+noisinf = 0.2
+icd = 15
+
+allocate(aux_in(1:lx*ly,1:nimg), aux_out(1:lx*ly,1:nimg), stat=istat)
+
+aux_in = img_in
+
+call denoiseBatch(lx, ly, cnimg, pf, powp, sigma_w, prinf, noisinf, icd, aux_in, aux_out)
+
+img_out = aux_out
+
+deallocate(aux_in, aux_out)
+
+end subroutine Denoise_PED_Batch
+
 !--------------------------------------------------------------------------
 !
 ! SUBROUTINE:ctfped_writeFile
@@ -24,6 +24,12 @@
 !> @date 07/10/15  PKC 1.0 original
 !> @date 11/23/15  SS  1.1 changed name of function, replaced argc, argv input, 
 !  replaced file operation by array input/output
+!> @date 10/16/26      2.0 moved all state into a denoiseContext so that denoise() is
+!  reentrant; the ICD sweep updates independent rows in parallel; added denoiseBatch
+!> @date 10/16/26      2.1 scratch buffers live in a reusable denoiseWorkspace; the ICD loop
+!  refreshes the periodic padding in place instead of unpadding and repadding every iteration
+!> @date 10/17/26      2.2 denoise() always uses the raster sweep again; the colour sweep is only
+!  used through denoiseParallel
 !--------------------------------------------------------------------------*/
 
 
@@ -34,103 +40,194 @@
 #include <string.h>
 #include "mbirHeader.h"
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 /*=============================================variables declaration==========================================*/
-int i, j, k, l, Nx, Ny, icdStep, Nicd, NNx, NNy, Nx2pad, Ny2pad;
-double maxval, minval,  p, sigma2w, sigma_w, sigma_px, alpha, sum, theta1, theta2, Presigma_px, xi, xj, v, gx, min, max;
-double q, T, cost_eachite, priorInfluence, noiseInfluence;
-double g[3][3]={{1.0/12.0, 1.0/6.0, 1.0/12.0}, {1.0/6.0, 0.0, 1.0/6.0}, {1.0/12.0, 1.0/6.0, 1.0/12.0}};
-double h[5][5]={{1.0/81.0, 2.0/81.0, 3.0/81.0, 2.0/81.0, 1.0/81.0}, {2.0/81.0, 4.0/81.0, 6.0/81.0, 4.0/81.0, 2.0/81.0}, {3.0/81.0, 6.0/81.0, 9.0/81.0, 6.0/81.0, 3.0/81.0}, {2.0/81.0, 4.0/81.0, 6.0/81.0, 4.0/81.0, 2.0/81.0}, {1.0/81.0, 2.0/81.0, 3.0/81.0, 2.0/81.0, 1.0/81.0}};
+/* prior (g) and blur (h) kernels; these are only ever read, so they can be shared by all threads */
+static double g[3][3]={{1.0/12.0, 1.0/6.0, 1.0/12.0}, {1.0/6.0, 0.0, 1.0/6.0}, {1.0/12.0, 1.0/6.0, 1.0/12.0}};
+static double h[5][5]={{1.0/81.0, 2.0/81.0, 3.0/81.0, 2.0/81.0, 1.0/81.0}, {2.0/81.0, 4.0/81.0, 6.0/81.0, 4.0/81.0, 2.0/81.0}, {3.0/81.0, 6.0/81.0, 9.0/81.0, 6.0/81.0, 3.0/81.0}, {2.0/81.0, 4.0/81.0, 6.0/81.0, 4.0/81.0, 2.0/81.0}, {1.0/81.0, 2.0/81.0, 3.0/81.0, 2.0/81.0, 1.0/81.0}};
+
+/* An ICD update of pixel (i,j) reads the 3x3 neighbourhood of the image and reads and writes the
+   5x5 neighbourhood of the error image, so two pixels whose rows are at least 5 apart never touch
+   the same data. denoiseParallel splits the rows into ICD_COLOURS colours (row modulo 5); the rows of
+   one colour are updated concurrently, and each row is swept from left to right. This visits the
+   pixels in another order than the raster sweep, so its result differs from that of denoise(), which
+   always uses the raster sweep. */
+#define ICD_COLOURS 5
 /*=========================================================================================================*/
 
 
 
 /*=============================================calling the internal  functions===============================*/
-void printarray(double inputArray[], int Nx, int Ny);
-void printarray1d(double inputArray[],int Nx, int Ny);
-double findlow (int i, int j, int Nx, double startingpoint, double inputArray[]);
-double findhigh(int i, int j, int Nx, double startingpoint,  double inputArray[]);
-double estimate_influence(double u, int i, int j, int Nx, double g[3][3], double alpha, double p, double inputArray[]);
-double equation(double theta1, double theta2, double u, double v, int i, int j, int Nx, double g[3][3], double alpha, double p, double inputArray[]);
-double hxval(double h[5][5], double inputArray[], int i, int j, int Nx, int Ny);
+void denoiseInit(denoiseContext *ctx, int Nx, int Ny, float pf, float powp, float sigma_w, float prinf, float noisinf, int icd);
+void icdUpdateRow(const denoiseContext *ctx, int i, double img_v1dpad[], double paded2dimg_e[]);
+int padBorderTable(void (*pad)(double[], double[], int, int), int Nx, int Ny, int npad, double scratch[], int **src, int **dst);
+void repad(double inputArray[], const int src[], const int dst[], int nborder);
 double surrogateXestimage(double v, double sigma2w, double h[5][5], double theta2, double inputArray[], double errorArray[], double bsr[], int i, int j, int NNx, int Nx2pad, double priorInfluence, double noiseInfluence);
-double cost1(double sigma2w, double h[5][5], double matrix_y[], double matrix_x[], int Nx, int Ny, int Nx2pad, int Ny2pad);
+double cost1(double sigma2w, double h[5][5], double matrix_y[], double matrix_x[], int Nx, int Ny, int Nx2pad, int Ny2pad, double counter2dpad[], double psuedohx[]);
 double cost2(double g[3][3], double inputArray[], double sigma_px, double p, int Nx, int Ny);
+double hxval(double h[5][5], double inputArray[], int i, int j, int Nx, int Ny);
 /*=====================================================================================================================*/
 
 
 double* denoise (int *lx, int *ly, float *pf, float *powp, float *sigma_w, float *prinf, float *noisinf, int *icd, double* mbike)
 {
-        Nx=*lx; Ny=*ly;
-        NNx=Nx+2, NNy=Ny+2, Nx2pad=Nx+4, Ny2pad=Ny+4, Nicd=*icd;
-        p=*powp; sigma2w=(*sigma_w)*(*sigma_w);
-        priorInfluence=*prinf, noiseInfluence=*noisinf;
-        q=2.0, T=0.0001;
-        theta2=0.0550221/sigma2w; Presigma_px=*pf;
-        /*==========================allocate all the arrays to be used here===============================*/
-        double *blurrpic=(double*)malloc(sizeof(double)*Ny*Nx);
-        double *blurrnoisypic=(double*)malloc(sizeof(double)*Ny*Nx);
-        double *img_y=(double*)malloc(sizeof(double)*Ny*Nx);
-        double *img_x=(double*)malloc(sizeof(double)*Ny*Nx);
-        double *img_e=(double*)malloc(sizeof(double)*Ny*Nx);
-        double *img_v=(double*)malloc(sizeof(double)*Ny*Nx);
-        
-        
-        double *pad1dblurrpic=(double*)malloc(sizeof(double)*NNy*NNx);
-        double *img_v1dpad=(double*)malloc(sizeof(double)*NNy*NNx);
-        
-        double *counter2dpad=(double*)malloc(sizeof(double)*Ny2pad*Nx2pad);
-        double *psuedoblurr=(double*)malloc(sizeof(double)*Ny2pad*Nx2pad);
-        double *paded2dimg_e=(double*)malloc(sizeof(double)*Ny2pad*Nx2pad);
+        int nthreads=1;
+
+        return denoiseParallel(lx, ly, pf, powp, sigma_w, prinf, noisinf, icd, mbike, &nthreads);
+}
+
+
+double* denoiseParallel (int *lx, int *ly, float *pf, float *powp, float *sigma_w, float *prinf, float *noisinf, int *icd, double* mbike, int *nthreads)
+{
+        denoiseContext ctx;
+        denoiseWorkspace *ws=denoiseCreateWorkspace(*lx, *ly, *icd);
+        double *img_v=(double*)malloc(sizeof(double)*(*ly)*(*lx));
+
+        denoiseInit(&ctx, *lx, *ly, *pf, *powp, *sigma_w, *prinf, *noisinf, *icd);
+        /* the colour sweep is only used when the caller asks for it; 0 or less means all OpenMP threads */
+        if (*nthreads>0)
+        {
+            ctx.nthreads=*nthreads;
+        }
+#ifdef _OPENMP
+        else
+        {
+            ctx.nthreads=omp_get_max_threads();
+        }
+#endif
+        denoiseImage(&ctx, ws, mbike, img_v);
+        denoiseDestroyWorkspace(ws);
+        return img_v;
+}
+
+
+void denoiseBatch (int *lx, int *ly, int *nimg, float *pf, float *powp, float *sigma_w, float *prinf, float *noisinf, int *icd, double* mbike, double* img_out)
+{
+        int n, Nimg=*nimg;
+        size_t npix=(size_t)(*lx)*(size_t)(*ly);
+        denoiseContext ctx;
+
+        /* each image is denoised by a single thread; the stack keeps all threads busy, and
+           every thread allocates one workspace that it reuses for all of its images */
+        denoiseInit(&ctx, *lx, *ly, *pf, *powp, *sigma_w, *prinf, *noisinf, *icd);
+
+#pragma omp parallel firstprivate(ctx) private(n)
+        {
+            denoiseWorkspace *ws=denoiseCreateWorkspace(*lx, *ly, *icd);
+#pragma omp for schedule(dynamic)
+            for (n=0; n<Nimg; n++)
+            {
+                denoiseImage(&ctx, ws, mbike+n*npix, img_out+n*npix);
+            }
+            denoiseDestroyWorkspace(ws);
+        }
+}
+
+
+denoiseWorkspace *denoiseCreateWorkspace(int Nx, int Ny, int Nicd)
+{
+        denoiseWorkspace *ws=(denoiseWorkspace*)malloc(sizeof(denoiseWorkspace));
+        int NNx=Nx+2, NNy=Ny+2, Nx2pad=Nx+4, Ny2pad=Ny+4;
+
+        ws->Nx=Nx; ws->Ny=Ny; ws->Nicd=Nicd;
+        ws->trackCost=0;
+        ws->img_v1dpad=(double*)malloc(sizeof(double)*NNy*NNx);
+        ws->paded2dimg_e=(double*)malloc(sizeof(double)*Ny2pad*Nx2pad);
+        ws->counter2dpad=(double*)malloc(sizeof(double)*Ny2pad*Nx2pad);
+        ws->psuedoblurr=(double*)malloc(sizeof(double)*Ny2pad*Nx2pad);
+        ws->totalcost=(double*)malloc(sizeof(double)*Nicd);
+
+        ws->nborder1d=padBorderTable(pad1d, Nx, Ny, 1, ws->counter2dpad, &ws->border1dsrc, &ws->border1ddst);
+        ws->nborder2d=padBorderTable(pad2d, Nx, Ny, 2, ws->counter2dpad, &ws->border2dsrc, &ws->border2ddst);
+        return ws;
+}
+
 
-        double newg[9];
-        double* totalcost = malloc(sizeof(double) * Nicd);
+void denoiseDestroyWorkspace(denoiseWorkspace *ws)
+{
+        if (ws==NULL) return;
+        free(ws->img_v1dpad), free(ws->paded2dimg_e);
+        free(ws->counter2dpad), free(ws->psuedoblurr);
+        free(ws->totalcost);
+        free(ws->border1dsrc), free(ws->border1ddst);
+        free(ws->border2dsrc), free(ws->border2ddst);
+        free(ws);
+}
+
+
+void denoiseInit(denoiseContext *ctx, int Nx, int Ny, float pf, float powp, float sigma_w, float prinf, float noisinf, int icd)
+{
+        ctx->Nx=Nx; ctx->Ny=Ny;
+        ctx->NNx=Nx+2, ctx->NNy=Ny+2, ctx->Nx2pad=Nx+4, ctx->Ny2pad=Ny+4, ctx->Nicd=icd;
+        ctx->p=powp; ctx->sigma2w=sigma_w*sigma_w;
+        ctx->priorInfluence=prinf, ctx->noiseInfluence=noisinf;
+        ctx->q=2.0, ctx->T=0.0001;
+        ctx->theta2=0.0550221/ctx->sigma2w; ctx->Presigma_px=pf;
+        ctx->sigma_px=0.0, ctx->maxval=0.0, ctx->minval=0.0;
+        ctx->nthreads=1;
+}
+
+
+void denoiseImage(denoiseContext *ctx, denoiseWorkspace *ws, double* mbike, double* img_v)
+{
+        int i, j, icdStep, colour, row, nrows;
+        int Nx=ctx->Nx, Ny=ctx->Ny, NNx=ctx->NNx, NNy=ctx->NNy, Nx2pad=ctx->Nx2pad, Ny2pad=ctx->Ny2pad;
+        double *img_v1dpad=ws->img_v1dpad, *paded2dimg_e=ws->paded2dimg_e;
+        double *counter2dpad=ws->counter2dpad, *psuedoblurr=ws->psuedoblurr;
         
         /*================================================================================================*/
- // replaced file read by array input       
+ // replaced file read by array input; mbike is used as img_y and is not modified
         
-        maxval=maximum(mbike, Nx, Ny); minval=minimum(mbike, Nx, Ny);
-        pad1d(mbike, pad1dblurrpic, Nx, Ny);
-        sigma_px=pow(Presigma_px, p)*estimate_sigmapx(g, pad1dblurrpic, p, NNx, NNy);
-        equalArray(mbike, img_y, Nx, Ny);
-        equalArray(img_y, img_x, Nx, Ny);
+        ctx->maxval=maximum(mbike, Nx, Ny); ctx->minval=minimum(mbike, Nx, Ny);
+        pad1d(mbike, img_v1dpad, Nx, Ny);
+        ctx->sigma_px=pow(ctx->Presigma_px, ctx->p)*estimate_sigmapx(g, img_v1dpad, ctx->p, NNx, NNy);
 
         /*================================================================================================*/
         
         
         /*===============================ICD implemenations here=========================================*/
-        pad2d(img_x, counter2dpad, Nx, Ny);
+        pad2d(mbike, counter2dpad, Nx, Ny);
         hxpic(h, counter2dpad, psuedoblurr, Nx2pad, Ny2pad);
-        decouple2dpad(psuedoblurr, blurrpic, Nx2pad, Ny2pad);/*output array is of Nx Ny*/
-        as2dArray(img_y, blurrpic, img_e, -1.0, Nx, Ny);
-        pad2d(img_e, paded2dimg_e, Nx, Ny);
-        alpha=1.0/sigma_px;
-
-        equalArray(img_x, img_v, Nx, Ny);
-        pad1d(img_v, img_v1dpad, Nx, Ny);
+        for (i=2; i<(Ny2pad-2); i++)
+        for (j=2; j<(Nx2pad-2); j++)
+        {
+            paded2dimg_e[i*Nx2pad+j]=mbike[(i-2)*Nx+(j-2)]-psuedoblurr[i*Nx2pad+j];
+        }
+        repad(paded2dimg_e, ws->border2dsrc, ws->border2ddst, ws->nborder2d);
 
-        for (icdStep=0; icdStep<Nicd;  icdStep++)
+        for (icdStep=0; icdStep<ctx->Nicd;  icdStep++)
         {
-            for (i=1; i<(NNy-1); i++)
-            for (j=1; j<(NNx-1); j++)
+            if (ctx->nthreads>1)
+            {
+                for (colour=0; colour<ICD_COLOURS; colour++)
+                {
+                    nrows=(NNy-2-colour+ICD_COLOURS-1)/ICD_COLOURS;
+#pragma omp parallel for schedule(static) num_threads(ctx->nthreads)
+                    for (row=0; row<nrows; row++)
+                    {
+                        icdUpdateRow(ctx, 1+colour+row*ICD_COLOURS, img_v1dpad, paded2dimg_e);
+                    }
+                }
+            }
+            else
             {
-                v=img_v1dpad[i*NNx+j];
-                barbsr(img_v1dpad, newg, g, p, q, T, sigma_px, i, j, NNx);
-                xi=surrogateXestimage(v, sigma2w, h, theta2, img_v1dpad, paded2dimg_e, newg, i, j, NNx, Nx2pad, priorInfluence, noiseInfluence);
-                if(xi>maxval) xi=maxval;
-                if (xi<minval) xi=minval;
-                img_v1dpad[i*NNx+j]=xi;
-
-                for (k=-2; k<3; k++)
-                for (l=-2; l<3; l++)
+                for (i=1; i<(NNy-1); i++)
                 {
-                    paded2dimg_e[((i+1)+k)*Nx2pad+((j+1)+l)]=paded2dimg_e[((i+1)+k)*Nx2pad+((j+1)+l)]-h[k+2][l+2]*(xi-v);
+                    icdUpdateRow(ctx, i, img_v1dpad, paded2dimg_e);
                 }
             }
-            decouple2dpad(paded2dimg_e, img_e, Nx2pad, Ny2pad);
-            pad2d(img_e, paded2dimg_e, Nx, Ny);
-            decouple1dpad(img_v1dpad, img_v, NNx, NNy);
-            pad1d(img_v, img_v1dpad, Nx, Ny);
-            totalcost[icdStep]=cost1(sigma2w, h, img_y, img_v, Nx, Ny, Nx2pad, Ny2pad)+cost2(g, img_v1dpad, sigma_px, p, NNx, NNy);
+            /* updates that landed in the padding are dropped and the padding is copied from the
+               interior again; only the border cells are touched */
+            repad(paded2dimg_e, ws->border2dsrc, ws->border2ddst, ws->nborder2d);
+            repad(img_v1dpad, ws->border1dsrc, ws->border1ddst, ws->nborder1d);
+            if (ws->trackCost)
+            {
+                decouple1dpad(img_v1dpad, img_v, NNx, NNy);
+                ws->totalcost[icdStep]=cost1(ctx->sigma2w, h, mbike, img_v, Nx, Ny, Nx2pad, Ny2pad, counter2dpad, psuedoblurr)+cost2(g, img_v1dpad, ctx->sigma_px, ctx->p, NNx, NNy);
+            }
         }
 
         /*===============================================================================================*/
@@ -140,22 +237,74 @@ double* denoise (int *lx, int *ly, float *pf, float *powp, float *sigma_w, float
     //if(strncmp(out, "blurr_pic", 1)==0) printarray1d(img_y, Nx, Ny);
     //if(strncmp(out, "deblurr_pic", 1)==0) printarray1d(img_v, Nx, Ny);
     //if(strncmp(out, "cost_convergence", 1)==0) printarray1d(totalcost, Nicd, 1);
-       
-// 04/27/16 SS
-// removed mbike and img_v from the list of pointers being freed.
-
-    free(pad1dblurrpic);
-    free(img_x), free(img_y), free(counter2dpad);
-    free(psuedoblurr), free(blurrpic);
-    free(img_e), free(paded2dimg_e);
-    free(img_v1dpad);
-    free(totalcost);
-    return img_v;
+
+    decouple1dpad(img_v1dpad, img_v, NNx, NNy);
+}
+
+/* lists the padding cells of an array padded by pad() together with the interior cell that each
+   of them copies, by padding an image that holds its own padded pixel indices */
+int padBorderTable(void (*pad)(double[], double[], int, int), int Nx, int Ny, int npad, double scratch[], int **src, int **dst)
+{
+    int i, j, n=0, NNx=Nx+2*npad, NNy=Ny+2*npad, nborder=NNx*NNy-Nx*Ny;
+    double *indices=(double*)malloc(sizeof(double)*Ny*Nx);
+
+    for (i=0; i<Ny; i++)
+    for (j=0; j<Nx; j++)
+    {
+        indices[i*Nx+j]=(double)((i+npad)*NNx+(j+npad));
+    }
+    pad(indices, scratch, Nx, Ny);
+
+    *src=(int*)malloc(sizeof(int)*nborder);
+    *dst=(int*)malloc(sizeof(int)*nborder);
+    for (i=0; i<NNy; i++)
+    for (j=0; j<NNx; j++)
+    {
+        if (i>=npad && i<(NNy-npad) && j>=npad && j<(NNx-npad)) continue;
+        (*src)[n]=(int)scratch[i*NNx+j];
+        (*dst)[n]=i*NNx+j;
+        n++;
+    }
+    free(indices);
+    return n;
+}
+
+void repad(double inputArray[], const int src[], const int dst[], int nborder)
+{
+    int n;
+    for (n=0; n<nborder; n++)
+    {
+        inputArray[dst[n]]=inputArray[src[n]];
+    }
+}
+
+void icdUpdateRow(const denoiseContext *ctx, int i, double img_v1dpad[], double paded2dimg_e[])
+{
+    int j, k, l, NNx=ctx->NNx, Nx2pad=ctx->Nx2pad;
+    double v, xi;
+    double newg[9];
+
+    for (j=1; j<(NNx-1); j++)
+    {
+        v=img_v1dpad[i*NNx+j];
+        barbsr(img_v1dpad, newg, g, ctx->p, ctx->q, ctx->T, ctx->sigma_px, i, j, NNx);
+        xi=surrogateXestimage(v, ctx->sigma2w, h, ctx->theta2, img_v1dpad, paded2dimg_e, newg, i, j, NNx, Nx2pad, ctx->priorInfluence, ctx->noiseInfluence);
+        if(xi>ctx->maxval) xi=ctx->maxval;
+        if (xi<ctx->minval) xi=ctx->minval;
+        img_v1dpad[i*NNx+j]=xi;
+
+        for (k=-2; k<3; k++)
+        for (l=-2; l<3; l++)
+        {
+            paded2dimg_e[((i+1)+k)*Nx2pad+((j+1)+l)]=paded2dimg_e[((i+1)+k)*Nx2pad+((j+1)+l)]-h[k+2][l+2]*(xi-v);
+        }
+    }
 }
 
 double surrogateXestimage(double v, double sigma2w, double h[5][5], double theta2, double inputArray[], double errorArray[], double bsr[], int i, int j, int NNx, int Nx2pad, double priorInfluence, double noiseInfluence)
 {
-    theta1=0.0;
+    int k, l;
+    double theta1=0.0;
     double sumBX=0.0, sumb=0.0;
     
     for (k=-2; k<3; k++)
@@ -175,28 +324,22 @@ double surrogateXestimage(double v, double sigma2w, double h[5][5], double theta
 }
 
 
-double cost1(double sigma2w, double h[5][5], double matrix_y[], double matrix_x[], int Nx, int Ny, int Nx2pad, int Ny2pad)
+double cost1(double sigma2w, double h[5][5], double matrix_y[], double matrix_x[], int Nx, int Ny, int Nx2pad, int Ny2pad, double counter2dpad[], double psuedohx[])
 {
-    double *counter2dpad=(double*)malloc(sizeof(double)*Ny2pad*Nx2pad);
-    double *psuedohx=(double*)malloc(sizeof(double)*Ny2pad*Nx2pad);
-    double *matrix_Hx=(double*)malloc(sizeof(double)*Ny*Nx);
-    double *diff_y_hx=(double*)malloc(sizeof(double)*Ny*Nx);
-    double *normMatrix=(double*)malloc(sizeof(double)*Ny*Nx);
+    int i, j;
+    double sum, diff;
 
     pad2d(matrix_x, counter2dpad, Nx, Ny);
     hxpic(h, counter2dpad, psuedohx, Nx2pad, Ny2pad);
-    decouple2dpad(psuedohx, matrix_Hx, Nx2pad, Ny2pad);
-    matrixdifference(matrix_y, matrix_Hx, diff_y_hx, Nx, Ny);
-    elementwise2dmult(diff_y_hx, diff_y_hx, normMatrix, Nx, Ny);
 
     
     sum=0.0;
     for (i=0; i<(Ny); i++)
     for (j=0; j<(Nx); j++)
     {
-        sum+=normMatrix[i*Nx+j];
+        diff=matrix_y[i*Nx+j]-psuedohx[(i+2)*Nx2pad+(j+2)];
+        sum+=diff*diff;
     }
-    free(counter2dpad), free(psuedohx), free(matrix_Hx), free(diff_y_hx), free(normMatrix);
     return (sum/(2.0*sigma2w));
 }
 
@@ -204,7 +347,8 @@ double cost1(double sigma2w, double h[5][5], double matrix_y[], double matrix_x[
 
 double cost2(double g[3][3], double inputArray[], double sigma_px, double p, int Nx, int Ny)
 {
-    sum=0.0;
+    int i, j, k, l;
+    double sum=0.0;
     for (i=1; i<(Ny-1); i++)
     for (j=1; j<(Nx-1); j++)
     {
@@ -223,7 +367,8 @@ double cost2(double g[3][3], double inputArray[], double sigma_px, double p, int
 
 double hxval(double h[5][5], double inputArray[], int i, int j, int Nx, int Ny)
 {
-    sum=0.0;
+    int k, l;
+    double sum=0.0;
     for (k=-2; k<3; k++)
     for (l=-2; l<3; l++)
     {
@@ -25,4 +25,35 @@ void pad1d (double inputArray[], double outputArray[], int Nx, int Ny);
 void pad2d (double inputArray[], double outputArray[], int Nx, int Ny);
 double *sumgx(double g[3][3], double inputArray[], int Nx, int Ny);
 
+/* all parameters of one denoising run; denoise() keeps no other state, so separate contexts
+   can be used from separate threads at the same time */
+typedef struct
+{
+    int Nx, Ny, NNx, NNy, Nx2pad, Ny2pad, Nicd;
+    double p, q, T, sigma2w, sigma_px, Presigma_px, theta2, priorInfluence, noiseInfluence;
+    double maxval, minval;
+    int nthreads; /* number of threads used for the ICD sweep of one image; 1 keeps the raster sweep */
+} denoiseContext;
+
+/* scratch buffers for denoising images of one size; a workspace can be reused for any number of
+   images but must not be used by two threads at once */
+typedef struct
+{
+    int Nx, Ny, Nicd;
+    double *img_v1dpad, *paded2dimg_e, *counter2dpad, *psuedoblurr;
+    int *border1dsrc, *border1ddst, nborder1d; /* padding cells of img_v1dpad and their sources */
+    int *border2dsrc, *border2ddst, nborder2d; /* padding cells of paded2dimg_e and their sources */
+    int trackCost; /* if set, the cost after every ICD iteration is stored in totalcost */
+    double *totalcost;
+} denoiseWorkspace;
+
+denoiseWorkspace *denoiseCreateWorkspace(int Nx, int Ny, int Nicd);
+void denoiseDestroyWorkspace(denoiseWorkspace *ws);
+double *denoise(int *lx, int *ly, float *pf, float *powp, float *sigma_w, float *prinf, float *noisinf, int *icd, double *mbike);
+/* denoise() with the colour-partitioned parallel ICD sweep on *nthreads threads (all OpenMP threads if
+   *nthreads <= 0); faster, but the pixels are visited in another order, so the result differs slightly */
+double *denoiseParallel(int *lx, int *ly, float *pf, float *powp, float *sigma_w, float *prinf, float *noisinf, int *icd, double *mbike, int *nthreads);
+void denoiseBatch(int *lx, int *ly, int *nimg, float *pf, float *powp, float *sigma_w, float *prinf, float *noisinf, int *icd, double *mbike, double *img_out);
+void denoiseImage(denoiseContext *ctx, denoiseWorkspace *ws, double *mbike, double *img_v);
+
 #endif
@@ -0,0 +1,476 @@
+/* ============================================================================
+* Copyright (c) 2009-2017 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+
+#include "AngleFileReader.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+#include <QtConcurrent/QtConcurrentRun>
+
+#include <QtCore/QByteArray>
+#include <QtCore/QFuture>
+#include <QtCore/QMutexLocker>
+#include <QtCore/QVector>
+
+#include "H5Support/QH5Lite.h"
+#include "H5Support/QH5Utilities.h"
+
+#include "EMsoftWorkbench/H5AccessMutex.h"
+#include "EMsoftWorkbench/AngleWidgets/AbstractAngleWidget.h"
+
+namespace
+{
+  // Number of lines that one parsing task handles; a multiple of the index spacing
+  const size_t k_LinesPerTask = 16 * AngleFileReader::k_LinesPerIndexEntry;
+
+  // Powers of ten that are exactly representable as doubles
+  const double k_PowersOfTen[23] = { 1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+                                     1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22 };
+
+  inline bool isSeparator(char c)
+  {
+    return (c == ' ' || c == '\t' || c == '\r' || c == '\v' || c == '\f');
+  }
+
+  inline bool isDigit(char c)
+  {
+    return (c >= '0' && c <= '9');
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+AngleFileReader::AngleFileReader() :
+  m_FileType(UnknownFile),
+  m_AngleCount(0),
+  m_FirstAngleLine(3),
+  m_Data(nullptr),
+  m_DataSize(0),
+  m_LineCount(0),
+  m_H5FileId(-1),
+  m_H5AnglesInDegrees(false)
+{
+
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+AngleFileReader::~AngleFileReader()
+{
+  closeFile();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool AngleFileReader::openFile(const QString& filePath)
+{
+  closeFile();
+
+  bool success = false;
+  bool isH5File = false;
+  {
+    QMutexLocker locker(&H5AccessMutex::Instance());
+    isH5File = (H5Fis_hdf5(filePath.toStdString().c_str()) > 0);
+  }
+
+  if (isH5File)
+  {
+    success = openH5File(filePath);
+  }
+  else
+  {
+    success = openTextFile(filePath);
+  }
+
+  if (success == false)
+  {
+    closeFile();
+    return false;
+  }
+
+  m_FilePath = filePath;
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void AngleFileReader::closeFile()
+{
+  if (nullptr != m_Data)
+  {
+    m_File.unmap(reinterpret_cast<uchar*>(const_cast<char*>(m_Data)));
+    m_Data = nullptr;
+  }
+  if (m_File.isOpen())
+  {
+    m_File.close();
+  }
+  if (m_H5FileId >= 0)
+  {
+    QMutexLocker locker(&H5AccessMutex::Instance());
+    QH5Utilities::closeFile(m_H5FileId);
+    m_H5FileId = -1;
+  }
+
+  m_FileType = UnknownFile;
+  m_FilePath.clear();
+  m_AngleTypeId.clear();
+  m_AngleCount = 0;
+  m_FirstAngleLine = 3;
+  m_DataSize = 0;
+  m_LineCount = 0;
+  m_LineIndex.clear();
+  m_H5DatasetPath.clear();
+  m_H5AnglesInDegrees = false;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool AngleFileReader::openTextFile(const QString& filePath)
+{
+  m_File.setFileName(filePath);
+  if (m_File.open(QIODevice::ReadOnly) == false || m_File.size() <= 0)
+  {
+    return false;
+  }
+
+  m_DataSize = static_cast<size_t>(m_File.size());
+  m_Data = reinterpret_cast<const char*>(m_File.map(0, m_File.size()));
+  if (nullptr == m_Data)
+  {
+    return false;
+  }
+
+  // Record where every k_LinesPerIndexEntry-th line starts
+  const char* end = m_Data + m_DataSize;
+  const char* p = m_Data;
+  m_LineIndex.push_back(0);
+  size_t lineCount = 0;
+  while (p < end)
+  {
+    const char* newLine = static_cast<const char*>(::memchr(p, '\n', end - p));
+    if (nullptr == newLine) { break; }
+    p = newLine + 1;
+    lineCount++;
+    if (lineCount % k_LinesPerIndexEntry == 0)
+    {
+      m_LineIndex.push_back(p - m_Data);
+    }
+  }
+  m_LineCount = (p < end) ? lineCount + 1 : lineCount;
+  if (m_LineCount < 2)
+  {
+    return false;
+  }
+
+  // The first line holds the angle type and the second one the number of angles
+  const char* line = m_Data;
+  const char* lineEnd = static_cast<const char*>(::memchr(line, '\n', end - line));
+  QByteArray angleTypeStr = QByteArray(line, static_cast<int>(lineEnd - line)).simplified();
+  m_AngleTypeId = (angleTypeStr.contains(' ')) ? QString() : QString::fromLatin1(angleTypeStr);
+
+  line = lineEnd + 1;
+  lineEnd = static_cast<const char*>(::memchr(line, '\n', end - line));
+  if (nullptr == lineEnd) { lineEnd = end; }
+  int angleCount = QByteArray(line, static_cast<int>(lineEnd - line)).trimmed().toInt();
+  m_AngleCount = (angleCount > 0) ? static_cast<size_t>(angleCount) : 0;
+
+  m_FileType = TextFile;
+  m_FirstAngleLine = 3;
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool AngleFileReader::openH5File(const QString& filePath)
+{
+  QMutexLocker locker(&H5AccessMutex::Instance());
+  m_H5FileId = QH5Utilities::openFile(filePath, true);
+  if (m_H5FileId < 0)
+  {
+    return false;
+  }
+
+  QStringList datasetPaths;
+  datasetPaths << "EulerAngles" << "EMData/EBSD/EulerAngles";
+  for (int i = 0; i < datasetPaths.size(); i++)
+  {
+    QString path = datasetPaths[i];
+    if (QH5Lite::datasetExists(m_H5FileId, path) == false)
+    {
+      continue;
+    }
+
+    QVector<hsize_t> dims;
+    H5T_class_t typeClass;
+    size_t typeSize = 0;
+    herr_t err = QH5Lite::getDatasetInfo(m_H5FileId, path, dims, typeClass, typeSize);
+    if (err < 0 || dims.size() != 2 || dims[1] != 3 || (typeClass != H5T_FLOAT && typeClass != H5T_INTEGER))
+    {
+      continue;
+    }
+
+    m_H5DatasetPath = path;
+    m_AngleCount = static_cast<size_t>(dims[0]);
+
+    // An optional "Units" string attribute marks angles stored in degrees; a missing
+    // attribute leaves the string empty and the angles are taken as radians.
+    QString units;
+    QH5Lite::readStringAttribute(m_H5FileId, path, "Units", units);
+    m_H5AnglesInDegrees = units.trimmed().startsWith("deg", Qt::CaseInsensitive);
+
+    m_AngleTypeId = AbstractAngleWidget::EulerId;
+    m_FileType = H5File;
+    m_FirstAngleLine = 1;
+    return true;
+  }
+
+  return false;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+FloatArrayType::Pointer AngleFileReader::readAngles(size_t firstAngle, size_t numAngles)
+{
+  if (m_FileType == UnknownFile)
+  {
+    return FloatArrayType::NullPointer();
+  }
+
+  FloatArrayType::Pointer angleArray = FloatArrayType::CreateArray(numAngles, QVector<size_t>(1, 3), "Angle Array");
+  angleArray->initializeWithZeros();
+  if (numAngles == 0)
+  {
+    return angleArray;
+  }
+  float* angles = angleArray->getPointer(0);
+
+  if (m_FileType == H5File)
+  {
+    if (firstAngle >= m_AngleCount)
+    {
+      return angleArray;
+    }
+    size_t numRows = std::min(numAngles, m_AngleCount - firstAngle);
+    QVector<hsize_t> offset;
+    offset << static_cast<hsize_t>(firstAngle) << 0;
+    QVector<hsize_t> count;
+    count << static_cast<hsize_t>(numRows) << 3;
+    {
+      QMutexLocker locker(&H5AccessMutex::Instance());
+      if (QH5Lite::readPointerDatasetHyperslab(m_H5FileId, m_H5DatasetPath, offset, count, angles) < 0)
+      {
+        return FloatArrayType::NullPointer();
+      }
+    }
+    if (m_H5AnglesInDegrees)
+    {
+      for (size_t i = 0; i < numRows * 3; i++)
+      {
+        angles[i] = AbstractAngleWidget::ConvertToRadians(angles[i]);
+      }
+    }
+    return angleArray;
+  }
+
+  // Parse the text lines in parallel chunks; each chunk starts its own search from the line index
+  size_t firstLine = static_cast<size_t>(m_FirstAngleLine - 1) + firstAngle;
+  if (numAngles <= k_LinesPerTask)
+  {
+    parseLines(firstLine, numAngles, angles);
+    return angleArray;
+  }
+
+  QVector<QFuture<void> > futures;
+  for (size_t start = 0; start < numAngles; start += k_LinesPerTask)
+  {
+    size_t count = std::min(k_LinesPerTask, numAngles - start);
+    futures.push_back(QtConcurrent::run(this, &AngleFileReader::parseLines, firstLine + start, count, angles + start * 3));
+  }
+  for (int i = 0; i < futures.size(); i++)
+  {
+    futures[i].waitForFinished();
+  }
+
+  return angleArray;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+const char* AngleFileReader::findLine(size_t line) const
+{
+  if (line >= m_LineCount)
+  {
+    return nullptr;
+  }
+
+  const char* end = m_Data + m_DataSize;
+  const char* p = m_Data + m_LineIndex[line / k_LinesPerIndexEntry];
+  for (size_t i = 0; i < line % k_LinesPerIndexEntry; i++)
+  {
+    p = static_cast<const char*>(::memchr(p, '\n', end - p)) + 1;
+  }
+  return p;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void AngleFileReader::parseLines(size_t firstLine, size_t numLines, float* output)
+{
+  const char* p = findLine(firstLine);
+  if (nullptr == p)
+  {
+    return;
+  }
+
+  const char* end = m_Data + m_DataSize;
+  for (size_t i = 0; i < numLines && p < end; i++)
+  {
+    const char* lineEnd = static_cast<const char*>(::memchr(p, '\n', end - p));
+    if (nullptr == lineEnd) { lineEnd = end; }
+
+    // Split the line at white space; only the first 3 values are kept
+    int component = 0;
+    while (p < lineEnd && component < 3)
+    {
+      while (p < lineEnd && isSeparator(*p)) { p++; }
+      const char* token = p;
+      while (p < lineEnd && !isSeparator(*p)) { p++; }
+      if (p > token)
+      {
+        output[i * 3 + component] = AbstractAngleWidget::ConvertToRadians(ParseFloat(token, p));
+        component++;
+      }
+    }
+
+    p = lineEnd + 1;
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+float AngleFileReader::ParseFloat(const char* begin, const char* end)
+{
+  // Fast path: a decimal number with at most 19 significant digits whose mantissa and
+  // power of ten are both exact in a double, so one multiplication or division rounds
+  // it correctly. Anything else goes through QByteArray::toDouble, which always uses
+  // the C locale just like QString::toFloat.
+  const char* p = begin;
+  bool negative = false;
+  if (p < end && (*p == '+' || *p == '-'))
+  {
+    negative = (*p == '-');
+    p++;
+  }
+
+  uint64_t mantissa = 0;
+  int significantDigits = 0;
+  int exponent = 0;
+  bool hasDigits = false;
+  while (p < end && isDigit(*p))
+  {
+    mantissa = mantissa * 10 + static_cast<uint64_t>(*p - '0');
+    if (mantissa != 0) { significantDigits++; }
+    hasDigits = true;
+    p++;
+  }
+  if (p < end && *p == '.')
+  {
+    p++;
+    while (p < end && isDigit(*p))
+    {
+      mantissa = mantissa * 10 + static_cast<uint64_t>(*p - '0');
+      if (mantissa != 0) { significantDigits++; }
+      exponent--;
+      hasDigits = true;
+      p++;
+    }
+  }
+  if (hasDigits && p < end && (*p == 'e' || *p == 'E'))
+  {
+    p++;
+    bool negativeExponent = false;
+    if (p < end && (*p == '+' || *p == '-'))
+    {
+      negativeExponent = (*p == '-');
+      p++;
+    }
+    int value = 0;
+    bool hasExponentDigits = false;
+    while (p < end && isDigit(*p) && value < 10000)
+    {
+      value = value * 10 + (*p - '0');
+      hasExponentDigits = true;
+      p++;
+    }
+    if (hasExponentDigits == false) { hasDigits = false; }
+    exponent += negativeExponent ? -value : value;
+  }
+
+  double value = 0.0;
+  if (hasDigits && p == end && significantDigits <= 19 && mantissa <= (static_cast<uint64_t>(1) << 53) && exponent >= -22 && exponent <= 22)
+  {
+    value = static_cast<double>(mantissa);
+    value = (exponent < 0) ? value / k_PowersOfTen[-exponent] : value * k_PowersOfTen[exponent];
+    if (negative) { value = -value; }
+  }
+  else
+  {
+    bool ok = false;
+    value = QByteArray(begin, static_cast<int>(end - begin)).toDouble(&ok);
+    if (ok == false) { return 0.0f; }
+  }
+
+  // QString::toFloat rejects finite values that do not fit into a float
+  if (std::isinf(value) == false && std::fabs(value) > std::numeric_limits<float>::max())
+  {
+    return 0.0f;
+  }
+  return static_cast<float>(value);
+}
@@ -0,0 +1,163 @@
+/* ============================================================================
+* Copyright (c) 2009-2017 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+
+#ifndef _anglefilereader_h_
+#define _anglefilereader_h_
+
+#include <vector>
+
+#include <hdf5.h>
+
+#include <QtCore/QFile>
+#include <QtCore/QString>
+
+#include "SIMPLib/Common/SIMPLibSetGetMacros.h"
+#include "SIMPLib/DataArrays/DataArray.hpp"
+
+/**
+ * @brief The AngleFileReader class reads Euler angle lists. Text files ("eu" on the first line, the
+ * number of angles on the second line and then one triplet in degrees per line) are memory mapped,
+ * and a sparse index with the offset of every k_LinesPerIndexEntry-th line is built once when the
+ * file is opened, so any range of angles can be read without scanning the lines in front of it.
+ * The lines are parsed in parallel chunks straight into the output array.
+ *
+ * HDF5 files are read from an N x 3 "EulerAngles" dataset in the root group or in EMData/EBSD.
+ * These angles are in radians unless the dataset has a "Units" attribute that says "degrees".
+ * Every HDF5 call is made while holding H5AccessMutex, which the master file loader also holds.
+ */
+class AngleFileReader
+{
+  public:
+    SIMPL_SHARED_POINTERS(AngleFileReader)
+    SIMPL_STATIC_NEW_MACRO(AngleFileReader)
+
+    virtual ~AngleFileReader();
+
+    enum FileType
+    {
+      UnknownFile = 0,
+      TextFile,
+      H5File
+    };
+
+    static const size_t k_LinesPerIndexEntry = 1024;
+
+    SIMPL_GET_PROPERTY(FileType, FileType)
+    SIMPL_GET_PROPERTY(QString, FilePath)
+
+    /**
+     * @brief The angle type identifier of the file, e.g. "eu"
+     */
+    SIMPL_GET_PROPERTY(QString, AngleTypeId)
+
+    /**
+     * @brief The number of angles that the file says it holds
+     */
+    SIMPL_GET_PROPERTY(size_t, AngleCount)
+
+    /**
+     * @brief The line number (starting at 1) of the first angle; this is 3 for text files and
+     * 1 for HDF5 files, whose rows are numbered like lines
+     */
+    SIMPL_GET_PROPERTY(int, FirstAngleLine)
+
+    /**
+     * @brief openFile Opens a text or HDF5 angle file, reads its header and, for text files, builds the line index
+     * @param filePath
+     * @return false if the file can not be opened or has no angles
+     */
+    bool openFile(const QString& filePath);
+
+    /**
+     * @brief closeFile Unmaps or closes the current file
+     */
+    void closeFile();
+
+    /**
+     * @brief readAngles Reads a range of angles into a new N x 3 array of Euler angles in radians.
+     * Lines with fewer than 3 values and angles past the end of the file are left at zero.
+     * @param firstAngle The index of the first angle to read (0 is the first angle in the file)
+     * @param numAngles The number of angles to read
+     * @return The angles or a NullPointer if no file is open or the range could not be read
+     */
+    FloatArrayType::Pointer readAngles(size_t firstAngle, size_t numAngles);
+
+    /**
+     * @brief ParseFloat Parses a number the same way QString::toFloat does, without its locale
+     * lookup or any allocation; invalid numbers give 0
+     * @param begin The first character of the number
+     * @param end One past the last character of the number
+     */
+    static float ParseFloat(const char* begin, const char* end);
+
+  protected:
+    AngleFileReader();
+
+    /**
+     * @brief parseLines Parses numLines text lines starting at line firstLine into output
+     */
+    void parseLines(size_t firstLine, size_t numLines, float* output);
+
+    /**
+     * @brief findLine Returns a pointer to the start of a line, or nullptr if the file is shorter
+     */
+    const char* findLine(size_t line) const;
+
+    bool openTextFile(const QString& filePath);
+    bool openH5File(const QString& filePath);
+
+  private:
+    FileType                      m_FileType;
+    QString                       m_FilePath;
+    QString                       m_AngleTypeId;
+    size_t                        m_AngleCount;
+    int                           m_FirstAngleLine;
+
+    QFile                         m_File;
+    const char*                   m_Data;
+    size_t                        m_DataSize;
+    size_t                        m_LineCount;
+    std::vector<size_t>           m_LineIndex;
+
+    hid_t                         m_H5FileId;
+    QString                       m_H5DatasetPath;
+    bool                          m_H5AnglesInDegrees;
+
+    AngleFileReader(const AngleFileReader&);    // Copy Constructor Not Implemented
+    void operator=(const AngleFileReader&);  // Operator '=' Not Implemented
+};
+
+#endif /* _anglefilereader_h_ */
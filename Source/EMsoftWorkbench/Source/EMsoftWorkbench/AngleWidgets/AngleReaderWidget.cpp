@@ -43,7 +43,8 @@
 //
 // -----------------------------------------------------------------------------
 AngleReaderWidget::AngleReaderWidget(QWidget *parent, Qt::WindowFlags windowFlags) :
-  AbstractAngleWidget(parent, windowFlags)
+  AbstractAngleWidget(parent, windowFlags),
+  m_AngleFileReader(AngleFileReader::New())
 {
   setupUi(this);
 
@@ -81,7 +82,7 @@ void AngleReaderWidget::on_loadAngleFileBtn_pressed()
 {
   QString proposedDir = m_OpenDialogLastDirectory;
   QString filePath = QFileDialog::getOpenFileName(nullptr, tr("Load Angle File"),
-    proposedDir, tr("Angle Files (*.txt);;All Files (*.*)"));
+    proposedDir, tr("Angle Files (*.txt);;HDF5 Angle Files (*.h5 *.hdf5);;All Files (*.*)"));
   if (filePath.isEmpty()) { return; }
 
   // Cache the last directory on old instance
@@ -137,16 +138,12 @@ void AngleReaderWidget::loadAngleFile(const QString &filePath)
 {
   numOfAngles->setText("0");
 
-  QFile file(filePath);
-  if (file.open(QIODevice::ReadOnly))
+  if (m_AngleFileReader->openFile(filePath))
   {
     angleFileLineEdit->setText(filePath);
     m_LoadedFilePath = filePath;
 
-    QTextStream in(&file);
-    QString angleTypeStr = in.readLine();
-    QStringList parts = angleTypeStr.split(QRegularExpression("[ \t]+"), QString::SkipEmptyParts);
-    if (parts.size() == 1 && parts[0] == EulerId)
+    if (m_AngleFileReader->getAngleTypeId() == EulerId)
     {
       angleType->setText(EulerStr);
     }
@@ -155,13 +152,18 @@ void AngleReaderWidget::loadAngleFile(const QString &filePath)
       angleType->setText(UnknownStr);
     }
 
-    m_FileAngleCount = in.readLine().toInt();
+    m_FileAngleCount = m_AngleFileReader->getAngleCount();
     numOfAngles->setText(QString::number(m_FileAngleCount));
 
-    minLineNum->setMaximum(m_FileAngleCount + 2);
-    minLineNum->setValue(3);
-    maxLineNum->setMaximum(m_FileAngleCount + 2);
-    maxLineNum->setValue(m_FileAngleCount + 2);
+    // The line numbers of the angles start at 3 in text files and at 1 in HDF5 files
+    int firstAngleLine = m_AngleFileReader->getFirstAngleLine();
+    int lastAngleLine = static_cast<int>(m_FileAngleCount) + firstAngleLine - 1;
+    minLineNum->setMinimum(firstAngleLine);
+    minLineNum->setMaximum(lastAngleLine);
+    minLineNum->setValue(firstAngleLine);
+    maxLineNum->setMinimum(firstAngleLine);
+    maxLineNum->setMaximum(lastAngleLine);
+    maxLineNum->setValue(lastAngleLine);
 
     angleTypeLabel->show();
     numOfAnglesLabel->show();
@@ -205,49 +207,17 @@ void AngleReaderWidget::on_maxLineNum_valueChanged(int value)
 // -----------------------------------------------------------------------------
 FloatArrayType::Pointer AngleReaderWidget::getEulerAngles()
 {
-  QFile file(m_LoadedFilePath);
-  if (file.open(QIODevice::ReadOnly))
+  if (m_AngleFileReader->getFilePath() != m_LoadedFilePath || m_LoadedFilePath.isEmpty())
   {
-    QTextStream in(&file);
-
-    size_t numberOfAngles;
-    if (partialFileCB->isChecked())
-    {
-      numberOfAngles = maxLineNum->value() - minLineNum->value() + 1;
-
-      // Skip to the part of the file that we want to read
-      for (int i = 0; i < minLineNum->value() - 1; i++)
-      {
-        in.readLine();
-      }
-    }
-    else
-    {
-      in.readLine();  // Angle Type
-      numberOfAngles = in.readLine().toInt();
-    }
-
-    FloatArrayType::Pointer angleArray = FloatArrayType::CreateArray(numberOfAngles, QVector<size_t>(1, 3), "Angle Array");
-
-    for (int i = 0; i < numberOfAngles; i++)
-    {
-      QString line = in.readLine();
-      QStringList parts = line.split(QRegularExpression("[ \t]+"), QString::SkipEmptyParts);
-      for (int j = 0; j < parts.size(); j++)
-      {
-        QString part = parts[j];
-        float value = part.toFloat();
-        value = AbstractAngleWidget::ConvertToRadians(value);
-        angleArray->setComponent(i, j, value);
-      }
-    }
+    return FloatArrayType::NullPointer();
+  }
 
-    return angleArray;
+  if (partialFileCB->isChecked())
+  {
+    size_t firstAngle = static_cast<size_t>(minLineNum->value() - m_AngleFileReader->getFirstAngleLine());
+    size_t numberOfAngles = static_cast<size_t>(maxLineNum->value() - minLineNum->value() + 1);
+    return m_AngleFileReader->readAngles(firstAngle, numberOfAngles);
   }
 
-  return FloatArrayType::NullPointer();
+  return m_AngleFileReader->readAngles(0, m_FileAngleCount);
 }
-
-
-
-
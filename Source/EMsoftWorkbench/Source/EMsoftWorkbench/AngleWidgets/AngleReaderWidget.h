@@ -39,6 +39,7 @@
 #include "SIMPLib/Common/SIMPLibSetGetMacros.h"
 
 #include "EMsoftWorkbench/AngleWidgets/AbstractAngleWidget.h"
+#include "EMsoftWorkbench/AngleWidgets/AngleFileReader.h"
 
 #include "ui_AngleReaderWidget.h"
 
@@ -106,6 +107,7 @@ public:
 private:
     QString                                   m_LoadedFilePath = "";
     size_t                                    m_FileAngleCount = 0;
+    AngleFileReader::Pointer                  m_AngleFileReader;
 
     AngleReaderWidget(const AngleReaderWidget&);    // Copy Constructor Not Implemented
     void operator=(const AngleReaderWidget&);  // Operator '=' Not Implemented
@@ -35,22 +35,19 @@
 
 #include "SampleCubochoricSpaceWidget.h"
 
-#include "EMsoftWorkbench/Constants.h"
-
-#include "OrientationLib/OrientationLibConstants.h"
-#include "OrientationLib/OrientationMath/OrientationTransforms.hpp"
-
-typedef std::list<DOrientArrayType> OrientationListArrayType;
-typedef OrientationTransforms<DOrientArrayType, double> OrientationTransformsType;
+#include <QtConcurrent/QtConcurrentRun>
 
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
 SampleCubochoricSpaceWidget::SampleCubochoricSpaceWidget(QWidget *parent, Qt::WindowFlags windowFlags) :
-  AbstractAngleWidget(parent, windowFlags)
+  AbstractAngleWidget(parent, windowFlags),
+  m_SamplingPercent(-1)
 {
   setupUi(this);
 
+  connect(&m_SamplingWatcher, SIGNAL(finished()), this, SLOT(samplingFinished()));
+
   setupGui();
 }
 
@@ -59,7 +56,7 @@ SampleCubochoricSpaceWidget::SampleCubochoricSpaceWidget(QWidget *parent, Qt::Wi
 // -----------------------------------------------------------------------------
 SampleCubochoricSpaceWidget::~SampleCubochoricSpaceWidget()
 {
-
+  stopSampling();
 }
 
 // -----------------------------------------------------------------------------
@@ -87,8 +84,8 @@ void SampleCubochoricSpaceWidget::setupGui()
   refOrientationZ_LE->setValidator(dblValidator);
   connect(refOrientationZ_LE, SIGNAL(textChanged(const QString &)), this, SLOT(lineEditChanged(const QString &)));
 
-  dblValidator = new QDoubleValidator(numOfSamplingPtsLE);
-  numOfSamplingPtsLE->setValidator(dblValidator);
+  intValidator = new QIntValidator(numOfSamplingPtsLE);
+  numOfSamplingPtsLE->setValidator(intValidator);
   connect(numOfSamplingPtsLE, SIGNAL(textChanged(const QString &)), this, SLOT(lineEditChanged(const QString &)));
 
   misorientationAngLabel->hide();
@@ -116,525 +113,180 @@ void SampleCubochoricSpaceWidget::lineEditChanged(const QString &text)
 // -----------------------------------------------------------------------------
 void SampleCubochoricSpaceWidget::valuesChanged()
 {
-  FloatArrayType::Pointer eulerAngles = getEulerAngles();
+  stopSampling();
 
-  if (eulerAngles == FloatArrayType::NullPointer())
+  CubochoricSampler::Pointer sampler = CubochoricSampler::New();
+  sampler->setNumberOfSamplingPoints(numOfSamplingPtsLE->text().toInt());
+  if(samplingModeCB->currentIndex() == 0)
   {
-    numOfAnglesLineEdit->setText("0");
+    sampler->setSamplingMode(CubochoricSampler::FundamentalZone);
+    sampler->setPointGroup(ptGrpNumLE->text().toInt());
+    sampler->setOffsetGrid(offsetSamplingGridChkBox->isChecked());
   }
   else
   {
-    numOfAnglesLineEdit->setText(QString::number(eulerAngles->getNumberOfTuples()));
+    double refOrientationX = refOrientationX_LE->text().toDouble();
+    double refOrientationY = refOrientationY_LE->text().toDouble();
+    double refOrientationZ = refOrientationZ_LE->text().toDouble();
+    double misorientationAngle = misorientationAngLE->text().toDouble();
+
+    // Index 1 is "Constant Misorientation", index 2 is "Less Than Given Misorientation"
+    if(samplingModeCB->currentIndex() == 1)
+    {
+      sampler->setSamplingMode(CubochoricSampler::MisorientationSurface);
+    }
+    else
+    {
+      sampler->setSamplingMode(CubochoricSampler::MisorientationVolume);
+    }
+    sampler->setMisorientationAngle(misorientationAngle * SIMPLib::Constants::k_Pi / 180.0f);
+    sampler->setReferenceOrientation(refOrientationX * SIMPLib::Constants::k_Pi / 180.0f,
+                                     refOrientationY * SIMPLib::Constants::k_Pi / 180.0f,
+                                     refOrientationZ * SIMPLib::Constants::k_Pi / 180.0f);
   }
+  sampler->setProgressCallback(&SampleCubochoricSpaceWidget::SamplingProgress, reinterpret_cast<size_t>(this));
 
-  emit dataChanged(hasValidAngles());
+  m_Sampler = sampler;
+  m_SamplingPercent.storeRelease(-1);
+  numOfAnglesLineEdit->setText("Sampling...");
+  emit dataChanged(false);
+
+  m_SamplingWatcher.setFuture(QtConcurrent::run(&SampleCubochoricSpaceWidget::SampleEulerAngles, sampler));
 }
 
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-bool SampleCubochoricSpaceWidget::hasValidAngles()
+void SampleCubochoricSpaceWidget::stopSampling()
 {
-  return (numOfAnglesLineEdit->text().toInt() > 0);
+  if (m_Sampler != CubochoricSampler::NullPointer())
+  {
+    m_Sampler->cancel();
+    m_SamplingWatcher.waitForFinished();
+    m_Sampler = CubochoricSampler::NullPointer();
+  }
 }
 
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-void SampleCubochoricSpaceWidget::void_on_offsetSamplingGridChkBox_stateChanged(int state)
+FloatArrayType::Pointer SampleCubochoricSpaceWidget::SampleEulerAngles(CubochoricSampler::Pointer sampler)
 {
-  Q_UNUSED(state)
-
-  valuesChanged();
+  return sampler->generate(3, "Euler Angles");
 }
 
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-void SampleCubochoricSpaceWidget::on_samplingModeCB_currentIndexChanged(int index)
+void SampleCubochoricSpaceWidget::SamplingProgress(size_t object, size_t completed, size_t total)
 {
-  if (index == 0)
+  // This is called from the sampling threads, so only post a percentage when it changes
+  SampleCubochoricSpaceWidget* widget = reinterpret_cast<SampleCubochoricSpaceWidget*>(object);
+  int percent = (total > 0) ? static_cast<int>((completed * 100) / total) : 0;
+  if (widget->m_SamplingPercent.fetchAndStoreOrdered(percent) != percent)
   {
-    ptGrpNumLabel->show();
-    ptGrpNumLE->show();
-    offsetSamplingGridChkBox->show();
-
-    misorientationAngLabel->hide();
-    misorientationAngLE->hide();
-    refOrientationLabel->hide();
-    refOrientationX_LE->hide();
-    refOrientationY_LE->hide();
-    refOrientationZ_LE->hide();
+    QMetaObject::invokeMethod(widget, "updateSamplingProgress", Qt::QueuedConnection, Q_ARG(int, percent));
   }
-  else
-  {
-    ptGrpNumLabel->hide();
-    ptGrpNumLE->hide();
-    offsetSamplingGridChkBox->hide();
-
-    misorientationAngLabel->show();
-    misorientationAngLE->show();
-    refOrientationLabel->show();
-    refOrientationX_LE->show();
-    refOrientationY_LE->show();
-    refOrientationZ_LE->show();
-  }
-
-  valuesChanged();
 }
 
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-void SampleCubochoricSpaceWidget::RodriguesComposition(DOrientArrayType sigma, DOrientArrayType &rod)
+void SampleCubochoricSpaceWidget::updateSamplingProgress(int percent)
 {
-    DOrientArrayType rho(3), rhomis(3);
-    rho[0] = -rod[0] * rod[3];
-    rho[1] = -rod[1] * rod[3];
-    rho[2] = -rod[2] * rod[3];
-
-    // perform the Rodrigues rotation composition with sigma to get rhomis
-    double denom = 1.0f + (sigma[0]*rho[0] + sigma[1]*rho[1] + sigma[2]*rho[2]);
-    if(denom == 0.0f)
-    {
-        double len;
-        len = sqrt(sigma[0]*sigma[0]+sigma[1]*sigma[1]+sigma[2]*sigma[2]);
-        rod[0] = sigma[0]/len;
-        rod[1] = sigma[1]/len;
-        rod[2] = sigma[2]/len;
-        rod[3] = std::numeric_limits<double>::infinity();  // set this to infinity
-    } else {
-        rhomis[0] = (rho[0] - sigma[0] + (rho[1]*sigma[2]-rho[2]*sigma[1]))/denom;
-        rhomis[1] = (rho[1] - sigma[1] + (rho[2]*sigma[0]-rho[0]*sigma[2]))/denom;
-        rhomis[2] = (rho[2] - sigma[2] + (rho[0]*sigma[1]-rho[1]*sigma[0]))/denom;
-        // revert rhomis to a four-component Rodrigues vector
-        double len;
-        len = sqrt(rhomis[0]*rhomis[0]+rhomis[1]*rhomis[1]+rhomis[2]*rhomis[2]);
-        if(len != 0.0f)
-        {
-            rod[0] = -rhomis[0]/len;
-            rod[1] = -rhomis[1]/len;
-            rod[2] = -rhomis[2]/len;
-            rod[3] = len;
-        } else {
-            rod[0] = 0.0;
-            rod[1] = 0.0;
-            rod[2] = 0.0;
-            rod[3] = 0.0;
-        }
-    }
-}
-
-// -----------------------------------------------------------------------------
-//
-// -----------------------------------------------------------------------------
-bool SampleCubochoricSpaceWidget::IsinsideFZ(double* rod, int FZtype, int FZorder)
-{
-  bool insideFZ = false;
-  // dealing with 180 rotations is needed only for
-  // FZtypes 0 and 1; the other FZs are always finite.
-  switch(FZtype)
+  if (m_SamplingWatcher.isRunning())
   {
-    case EMsoftWorkbenchConstants::Constants::AnorthicType:
-      insideFZ = true;   // all points are inside the FZ
-      break;
-    case EMsoftWorkbenchConstants::Constants::CyclicType:
-      insideFZ = insideCyclicFZ(rod,FZorder);      // infinity is checked inside this function
-      break;
-    case EMsoftWorkbenchConstants::Constants::DihedralType:
-      if (rod[3] != std::numeric_limits<double>::infinity()) insideFZ = insideDihedralFZ(rod,FZorder);
-      break;
-    case EMsoftWorkbenchConstants::Constants::TetrahedralType:
-      if (rod[3] != std::numeric_limits<double>::infinity()) insideFZ = insideCubicFZ(rod,EMsoftWorkbenchConstants::Constants::TetrahedralType);
-      break;
-    case EMsoftWorkbenchConstants::Constants::OctahedralType:
-      if (rod[3] != std::numeric_limits<double>::infinity()) insideFZ = insideCubicFZ(rod,EMsoftWorkbenchConstants::Constants::OctahedralType);
-      break;
-    default:
-      insideFZ = false;
-      break;
-
+    numOfAnglesLineEdit->setText(QString("Sampling... %1%").arg(percent));
   }
-  return insideFZ;
 }
 
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-bool SampleCubochoricSpaceWidget::insideCyclicFZ(double* rod, int order)
+void SampleCubochoricSpaceWidget::samplingFinished()
 {
+  // A canceled run may still report here after a new one has been started
+  if (m_SamplingWatcher.isRunning() || m_Sampler == CubochoricSampler::NullPointer())
+  {
+    return;
+  }
 
-  bool insideFZ = false;
-
-  if (rod[3] != std::numeric_limits<double>::infinity())
+  FloatArrayType::Pointer eulerAngles = m_SamplingWatcher.result();
+  if (eulerAngles == FloatArrayType::NullPointer())
   {
-    // check the z-component vs. tan(pi/2n)
-    insideFZ = fabs(rod[2]*rod[3]) <= LPs::BP[order - 1];
+    numOfAnglesLineEdit->setText("0");
   }
-  else if (rod[2] == 0.0)
+  else
   {
-    insideFZ = true;
+    numOfAnglesLineEdit->setText(QString::number(eulerAngles->getNumberOfTuples()));
   }
-  return insideFZ;
+
+  emit dataChanged(hasValidAngles());
 }
 
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-bool SampleCubochoricSpaceWidget::insideDihedralFZ(double* rod, int order)
+bool SampleCubochoricSpaceWidget::hasValidAngles()
 {
-
-  bool res = false, c1 = false, c2 = false;
-  double r[3] = { rod[0] * rod[3], rod[1] * rod[3], rod[2] * rod[3]};
-  const double r1 = 1.0;
-
-  // first, check the z-component vs. tan(pi/2n)  (same as insideCyclicFZ)
-  c1 = fabs(r[2]) <= LPs::BP[order -1];
-  res = false;
-
-  // check the square boundary planes if c1=true
-  if (c1) {
-    switch (order)
-    {
-      case EMsoftWorkbenchConstants::Constants::TwoFoldAxisOrder:
-        c2 = (fabs(r[0]) <= r1) && (fabs(r[1]) <= r1);
-        break;
-      case EMsoftWorkbenchConstants::Constants::ThreeFoldAxisOrder:
-        c2 = fabs( LPs::srt*r[0]+0.50*r[1]) <= r1;
-        c2 = c2 && ( fabs( LPs::srt*r[0]-0.50*r[1]) <= r1 );
-        c2 = c2 && ( fabs(r[1]) <= r1 );
-        break;
-      case EMsoftWorkbenchConstants::Constants::FourFoldAxisOrder:
-        c2 = (fabs(r[0]) <= r1) && (fabs(r[1]) <= r1);
-        c2 = c2 && ((LPs::r22*fabs(r[0]+r[1]) <= r1) && (LPs::r22*fabs(r[0]-r[1]) <= r1));
-        break;
-      case EMsoftWorkbenchConstants::Constants::SixFoldAxisOrder:
-        c2 =          fabs( 0.50*r[0]+LPs::srt*r[1]) <= r1;
-        c2 = c2 && ( fabs( LPs::srt*r[0]+0.50*r[1]) <= r1 );
-        c2 = c2 && ( fabs( LPs::srt*r[0]-0.50*r[1]) <= r1 );
-        c2 = c2 && ( fabs( 0.50*r[0]-LPs::srt*r[1]) <= r1 );
-        c2 = c2 && ( fabs(r[1]) <= r1 );
-        c2 = c2 && ( fabs(r[0]) <= r1 );
-        break;
-      default:
-        res = false;
-        break;
-
-    }
-    res = c2;
-  }
-  return res;
+  return (numOfAnglesLineEdit->text().toInt() > 0);
 }
 
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-bool SampleCubochoricSpaceWidget::insideCubicFZ(double* rod, int ot)
+void SampleCubochoricSpaceWidget::void_on_offsetSamplingGridChkBox_stateChanged(int state)
 {
-  bool res = false, c1 = false, c2 = false;
-  std::vector<double> r(3);
-  r[0] = rod[0] * rod[3];
-  r[1] = rod[1] * rod[3];
-  r[2] = rod[2] * rod[3];
-  const double r1 = 1.0;
-
-  // primary cube planes (only needed for octahedral case)
-  if (ot == EMsoftWorkbenchConstants::Constants::OctahedralType) {
-
-    typedef OrientationTransforms<std::vector<double>, double> OrientationTransformsType;
-
-    c1 = OrientationTransformsType::OMHelperType::maxval(OrientationTransformsType::OMHelperType::absValue(r)) <= LPs::BP[3];
-
-  } else {
-    c1 = true;
-  }
-
-  // octahedral truncation planes, both for tetrahedral and octahedral point groups
-  c2 = ((fabs(r[0])+fabs(r[1])+fabs(r[2])) <= r1);
-
-  // if both c1 and c2, then the point is inside
-  if (c1 && c2) { res = true;}
+  Q_UNUSED(state)
 
-  return res;
+  valuesChanged();
 }
 
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-FloatArrayType::Pointer SampleCubochoricSpaceWidget::getEulerAngles()
+void SampleCubochoricSpaceWidget::on_samplingModeCB_currentIndexChanged(int index)
 {
-  OrientationListArrayType FZlist;
-
-  double numOfSamplingPts = numOfSamplingPtsLE->text().toDouble();
-  if(samplingModeCB->currentIndex() == 0)
+  if (index == 0)
   {
-    int ptGrpNum = ptGrpNumLE->text().toInt();
-
-    // here we perform the actual calculation; once we have the FZlist,
-    // we can allocate the data array and copy all entries
-    double x, y, z, delta;
-    int32_t FZtype, FZorder;
-
-    // step size for sampling of grid; maximum total number of samples = pow(2*getNumsp()+1,3)
-    delta = ( 0.50 * LPs::ap )/static_cast<double>(numOfSamplingPts);
-
-    // do we need to shift this array away from the origin?
-    double gridShift = 0.0f;
-    if (offsetSamplingGridChkBox->isChecked())
-    {
-      gridShift = 0.5f;
-    }
-
-    // determine which function we should call for this point group symmetry
-    FZtype = EMsoftWorkbenchConstants::Constants::FZtarray[ptGrpNum-1];
-    FZorder = EMsoftWorkbenchConstants::Constants::FZoarray[ptGrpNum-1];
-
-
-    // loop over the cube of volume pi^2; note that we do not want to include
-    // the opposite edges/facets of the cube, to avoid double counting rotations
-    // with a rotation angle of 180 degrees.  This only affects the cyclic groups.
-    int Np = numOfSamplingPts;
-    int Totp = pow(2*Np+1,3);
-    int Dn = Totp/10;
-    int Dc = Dn;
-    int Di = 0;
-    int Dg = 0;
-
-    // eliminate points for which any of the coordinates lies outside the cube with semi-edge length "edge"
-    double edge = 0.5 * LPs::ap;
+    ptGrpNumLabel->show();
+    ptGrpNumLE->show();
+    offsetSamplingGridChkBox->show();
 
-    for(int i = -Np+1; i < Np+1; i++)
-    {
-      x = (static_cast<double>(i) + gridShift ) * delta;
-
-      if (fabs(x) <= edge)
-      {
-
-        for(int j = -Np+1; j < Np+1; j++)
-        {
-          y = (static_cast<double>(j) + gridShift ) * delta;
-
-          if (fabs(y) <= edge)
-          {
-
-            for (int k = -Np+1; k < Np+1; k++)
-            {
-              z = (static_cast<double>(k) + gridShift ) * delta;
-
-              if (fabs(z) <= edge)
-              {
-
-                // convert to Rodrigues representation
-                DOrientArrayType cu(x, y, z);
-                DOrientArrayType rod(4);
-                OrientationTransformsType::cu2ro(cu, rod);
-
-                // If insideFZ=true, then add this point to FZlist
-                bool b = IsinsideFZ(rod.data(), FZtype, FZorder);
-                if (b)
-                {
-                  FZlist.push_back(rod);
-                  Dg += 1;
-                }
-                Di += 1;
-              }
-            }
-          }
-        }
-      }
-
-      // report on status of computation
-      if (Di > Dc)
-      {
-        // Error: "Euler angle triplets tested: %1 of %2; triplets inside Rodrigues fundamental zone: %3 ").arg(QString::number(Di),QString::number(Totp),QString::number(Dg));
-
-        Dc += Dn;
-      }
-    }
+    misorientationAngLabel->hide();
+    misorientationAngLE->hide();
+    refOrientationLabel->hide();
+    refOrientationX_LE->hide();
+    refOrientationY_LE->hide();
+    refOrientationZ_LE->hide();
   }
-
-  // here are the misorientation sampling cases:
   else
   {
-    // here we perform the actual calculation; once we have the FZlist,
-    // we can allocate the data array and copy all entries
-    double x, y, z, delta, omega, semi;
-
-    double refOrientationX = refOrientationX_LE->text().toDouble();
-    double refOrientationY = refOrientationY_LE->text().toDouble();
-    double refOrientationZ = refOrientationZ_LE->text().toDouble();
-    double misorientationAngle = misorientationAngLE->text().toDouble();
+    ptGrpNumLabel->hide();
+    ptGrpNumLE->hide();
+    offsetSamplingGridChkBox->hide();
 
-    // step size for sampling of grid; the edge length of the cube is (pi ( w - sin(w) ))^1/3 with w the misorientation angle
-    omega = misorientationAngle * SIMPLib::Constants::k_Pi / 180.0f;
-    semi = pow(SIMPLib::Constants::k_Pi * (omega - sin(omega)),1.0/3.0) * 0.5;
-    delta = semi/static_cast<double>(numOfSamplingPts);
-
-    // convert the reference orientation to a 3-component Rodrigues vector sigma
-    DOrientArrayType sigm(4), sigma(3), referenceOrientation(3);
-    referenceOrientation[0] = static_cast<double>(refOrientationX * SIMPLib::Constants::k_Pi / 180.0f);
-    referenceOrientation[1] = static_cast<double>(refOrientationY * SIMPLib::Constants::k_Pi / 180.0f);
-    referenceOrientation[2] = static_cast<double>(refOrientationZ * SIMPLib::Constants::k_Pi / 180.0f);
-    OrientationTransformsType::eu2ro(referenceOrientation,sigm);
-    sigma[0] = sigm[0] * sigm[3];
-    sigma[1] = sigm[1] * sigm[3];
-    sigma[2] = sigm[2] * sigm[3];
-
-    if (samplingModeCB->currentIndex() == 1)
-    {
-      // set counter parameters for the loop over the sub-cube surface
-      int Np = numOfSamplingPts;
-      int Totp = 24*Np*Np+2;
-      int Dn = Totp/20;
-      int Dc = Dn;
-      int Dg = 0;
-
-      // x-y bottom and top planes
-      for(int i = -Np; i <= Np; i++)
-      {
-        x = static_cast<double>(i) * delta;
-        for(int j = -Np; j <= Np; j++)
-        {
-          y = static_cast<double>(j) * delta;
-          // convert to Rodrigues representation and apply Rodrigues composition formula
-          {
-            DOrientArrayType cu(-x, -y, -semi);
-            DOrientArrayType rod(4);
-            OrientationTransformsType::cu2ro(cu, rod);
-            RodriguesComposition(sigma,rod);
-            FZlist.push_back(rod);
-            Dg += 1;
-          }
-          {
-            DOrientArrayType cu(-x, -y, semi);
-            DOrientArrayType rod(4);
-            OrientationTransformsType::cu2ro(cu, rod);
-            RodriguesComposition(sigma,rod);
-            FZlist.push_back(rod);
-            Dg += 1;
-          }
-        }
-      }
-      // y-z  planes
-      for(int j = -Np; j <= Np; j++)
-      {
-        y = static_cast<double>(j) * delta;
-        for(int k = -Np+1; k <= Np-1; k++)
-        {
-          z = static_cast<double>(k) * delta;
-          // convert to Rodrigues representation and apply Rodrigues composition formula
-          {
-            DOrientArrayType cu(-semi, -y, -z);
-            DOrientArrayType rod(4);
-            OrientationTransformsType::cu2ro(cu, rod);
-            RodriguesComposition(sigma,rod);
-            FZlist.push_back(rod);
-            Dg += 1;
-          }
-          {
-            DOrientArrayType cu(semi, -y, -z);
-            DOrientArrayType rod(4);
-            OrientationTransformsType::cu2ro(cu, rod);
-            RodriguesComposition(sigma,rod);
-            FZlist.push_back(rod);
-            Dg += 1;
-          }
-        }
-      }
-      // finally the x-z  planes
-      for(int i = -Np+1; i <= Np-1; i++)
-      {
-        x = static_cast<double>(i) * delta;
-        for(int k = -Np+1; k <= Np-1; k++)
-        {
-          z = static_cast<double>(k) * delta;
-          // convert to Rodrigues representation and apply Rodrigues composition formula
-          {
-            DOrientArrayType cu(-x, -semi, -z);
-            DOrientArrayType rod(4);
-            OrientationTransformsType::cu2ro(cu, rod);
-            RodriguesComposition(sigma,rod);
-            FZlist.push_back(rod);
-            Dg += 1;
-          }
-          {
-            DOrientArrayType cu(-x, semi, -z);
-            DOrientArrayType rod(4);
-            OrientationTransformsType::cu2ro(cu, rod);
-            RodriguesComposition(sigma,rod);
-            FZlist.push_back(rod);
-            Dg += 1;
-          }
-        }
-      }
-
-      // report on status of computation
-      if (Dg > Dc)
-      {
-        // Error: "Euler angle triplets generated: %1 out of %2").arg(QString::number(Dg),QString::number(Totp));
-
-        Dc += Dn;
-      }
-    }
-    else
-    {
-      // set counter parameters for the loop over the sub-cube surface
-      int Np = numOfSamplingPts;
-      int Totp = pow((2*Np+1),3);  // see misorientation sampling paper for this expression
-      int Dn = Totp/20;
-      int Dc = Dn;
-      int Dg = 0;
-
-      for(int i = -Np; i <= Np; i++)
-      {
-        x = static_cast<double>(i) * delta;
-        for(int j = -Np; j <= Np; j++)
-        {
-          y = static_cast<double>(j) * delta;
-          for(int k = -Np; k <= Np; k++)
-          {
-            z = static_cast<double>(k) * delta;
-            // convert to Rodrigues representation and apply Rodrigues composition formula
-            {
-              DOrientArrayType cu(-x, -y, -z);
-              DOrientArrayType rod(4);
-              OrientationTransformsType::cu2ro(cu, rod);
-              RodriguesComposition(sigma,rod);
-              FZlist.push_back(rod);
-              Dg += 1;
-            }
-          }
-        }
-        // report on status of computation
-        if (Dg > Dc)
-        {
-          // Error: "Euler angle triplets generated: %1 out of %2").arg(QString::number(Dg),QString::number(Totp));
-
-          Dc += Dn;
-        }
-      }
-    }
+    misorientationAngLabel->show();
+    misorientationAngLE->show();
+    refOrientationLabel->show();
+    refOrientationX_LE->show();
+    refOrientationY_LE->show();
+    refOrientationZ_LE->show();
   }
 
-  // resize the EulerAngles array to the number of items in FZlist; don't forget to redefine the hard pointer
-  FloatArrayType::Pointer eulerAngles = FloatArrayType::CreateArray(FZlist.size(), QVector<size_t>(1, 3), "Euler Angles");
+  valuesChanged();
+}
 
-  // copy the Rodrigues vectors as Euler angles into the eulerAngles array; convert doubles to floats along the way
-  int j = -1;
-  for( DOrientArrayType rod : FZlist)
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+FloatArrayType::Pointer SampleCubochoricSpaceWidget::getEulerAngles()
+{
+  if (m_Sampler == CubochoricSampler::NullPointer())
   {
-    j += 1;
-    DOrientArrayType eu(3,0.0f);
-    OrientationTransformsType::ro2eu(rod,eu);
-
-    eulerAngles->setComponent(j, 0, static_cast<float>(eu[0]));
-    eulerAngles->setComponent(j, 1, static_cast<float>(eu[1]));
-    eulerAngles->setComponent(j, 2, static_cast<float>(eu[2]));
+    return FloatArrayType::NullPointer();
   }
 
-  return eulerAngles;
+  m_SamplingWatcher.waitForFinished();
+  return m_SamplingWatcher.result();
 }
-
-
-
-
@@ -36,11 +36,14 @@
 #ifndef samplecubochoricspacewidget_h
 #define samplecubochoricspacewidget_h
 
+#include <QtCore/QAtomicInt>
+#include <QtCore/QFutureWatcher>
+
 #include "SIMPLib/Common/SIMPLibSetGetMacros.h"
 
 #include "EMsoftWorkbench/AngleWidgets/AbstractAngleWidget.h"
 
-#include "OrientationLib/OrientationMath/OrientationArray.hpp"
+#include "OrientationLib/Utilities/CubochoricSampler.h"
 
 #include "ui_SampleCubochoricSpaceWidget.h"
 
@@ -61,7 +64,7 @@ public:
     void setupGui();
 
     /**
-     * @brief getEulerAngles
+     * @brief getEulerAngles Returns the sampled Euler angles; if the sampling is still running, this waits for it
      * @return
      */
     virtual FloatArrayType::Pointer getEulerAngles();
@@ -78,16 +81,26 @@ public:
 
     void lineEditChanged(const QString &text);
 
+    void samplingFinished();
+    void updateSamplingProgress(int percent);
+
 private:
+    CubochoricSampler::Pointer                      m_Sampler;
+    QFutureWatcher<FloatArrayType::Pointer>         m_SamplingWatcher;
+    QAtomicInt                                      m_SamplingPercent;
 
+    /**
+     * @brief valuesChanged Cancels the running sampling and starts a new one on the global thread pool
+     */
     void valuesChanged();
 
-    void RodriguesComposition(DOrientArrayType sigma, DOrientArrayType &rod);
+    /**
+     * @brief stopSampling Cancels the running sampling and waits for it to finish
+     */
+    void stopSampling();
 
-    bool IsinsideFZ(double* rod, int FZtype, int FZorder);
-    bool insideCyclicFZ(double* rod, int order);
-    bool insideDihedralFZ(double* rod, int order);
-    bool insideCubicFZ(double* rod, int ot);
+    static FloatArrayType::Pointer SampleEulerAngles(CubochoricSampler::Pointer sampler);
+    static void SamplingProgress(size_t object, size_t completed, size_t total);
 
     SampleCubochoricSpaceWidget(const SampleCubochoricSpaceWidget&);    // Copy Constructor Not Implemented
     void operator=(const SampleCubochoricSpaceWidget&);  // Operator '=' Not Implemented
@@ -16,6 +16,7 @@ set(Angle_Widgets_MOC_HDRS ${Angle_Widgets_MOC_HDRS}
 
 set(Angle_Widgets_SRCS ${Angle_Widgets_SRCS}
     ${EMsoftWorkbench_AngleWidgets_SOURCE_DIR}/AngleWidgets/AbstractAngleWidget.cpp
+    ${EMsoftWorkbench_AngleWidgets_SOURCE_DIR}/AngleWidgets/AngleFileReader.cpp
     ${EMsoftWorkbench_AngleWidgets_SOURCE_DIR}/AngleWidgets/AngleReaderWidget.cpp
     ${EMsoftWorkbench_AngleWidgets_SOURCE_DIR}/AngleWidgets/SampleCubochoricSpaceWidget.cpp
     ${EMsoftWorkbench_AngleWidgets_SOURCE_DIR}/AngleWidgets/SamplingRateWidget.cpp
@@ -32,7 +33,7 @@ set(Angle_Widgets_UIS ${Angle_Widgets_UIS}
 # Add in the remaining sources that are actually widgets but are completely Custom and do NOT use private
 # inheritance through a .ui file
 set(Angle_Widgets_HDRS ${Angle_Widgets_HDRS}
-
+    ${EMsoftWorkbench_AngleWidgets_SOURCE_DIR}/AngleWidgets/AngleFileReader.h
     )
 
 set(Angle_Widgets_HDRS ${Angle_Widgets_HDRS}
@@ -94,32 +94,6 @@ namespace EMsoftWorkbenchConstants
   static const double k_Cos_OneEigthPi = cos(k_PiOver8);
   static const double k_Cos_ThreeEightPi = cos(3.0 * k_PiOver8);
   static const double k_Sin_ThreeEightPi = sin(3.0 * k_PiOver8);
-
-  static const int AnorthicType = 0; // Triclinic
-  static const int CyclicType = 1;
-  static const int DihedralType = 2;
-  static const int TetrahedralType = 3;
-  static const int OctahedralType = 4;
-
-  static const int NoAxisOrder = 0;
-  static const int TwoFoldAxisOrder = 2;
-  static const int ThreeFoldAxisOrder = 3;
-  static const int FourFoldAxisOrder = 4;
-  static const int SixFoldAxisOrder = 6;
-
-  static const int FZtarray[32] = { AnorthicType, AnorthicType,CyclicType,CyclicType,CyclicType,
-                                    DihedralType,DihedralType,DihedralType,CyclicType,CyclicType,CyclicType,
-                                    DihedralType,DihedralType,DihedralType,DihedralType,CyclicType,CyclicType,
-                                    DihedralType,DihedralType,DihedralType,CyclicType,CyclicType,CyclicType,
-                                    DihedralType,DihedralType,DihedralType,DihedralType,TetrahedralType,
-                                    TetrahedralType,OctahedralType,TetrahedralType,OctahedralType };
-
-  static const int FZoarray[32] = { NoAxisOrder,NoAxisOrder,TwoFoldAxisOrder,TwoFoldAxisOrder,
-                                    TwoFoldAxisOrder,TwoFoldAxisOrder,TwoFoldAxisOrder,TwoFoldAxisOrder,FourFoldAxisOrder,
-                                    FourFoldAxisOrder,FourFoldAxisOrder,FourFoldAxisOrder,FourFoldAxisOrder,FourFoldAxisOrder,
-                                    FourFoldAxisOrder,ThreeFoldAxisOrder,ThreeFoldAxisOrder,ThreeFoldAxisOrder,ThreeFoldAxisOrder,
-                                    ThreeFoldAxisOrder,SixFoldAxisOrder,SixFoldAxisOrder,SixFoldAxisOrder,SixFoldAxisOrder,SixFoldAxisOrder,
-                                    SixFoldAxisOrder,SixFoldAxisOrder,NoAxisOrder,NoAxisOrder,NoAxisOrder,NoAxisOrder,NoAxisOrder};
   }
 
   namespace StringConstants
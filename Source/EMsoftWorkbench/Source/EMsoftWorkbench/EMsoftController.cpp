@@ -35,14 +35,18 @@
 
 #include "EMsoftController.h"
 
+#include <algorithm>
+#include <cstring>
 #include <initializer_list>
 
 
 
 #include "EMsoftLib/EMsoftLib.h"
 
+#include "OrientationLib/OrientationMath/OrientationArray.hpp"
 #include "OrientationLib/OrientationMath/OrientationTransforms.hpp"
 
+#include "EMsoftWorkbench/H5AccessMutex.h"
 #include "EMsoftWorkbench/ProjectionConversions.hpp"
 #include "EMsoftWorkbench/PatternListModel.h"
 
@@ -55,13 +59,16 @@
 // -----------------------------------------------------------------------------
 EMsoftController::EMsoftController(QObject* parent) :
   QObject(parent),
-  m_NumOfFinishedPatternsLock(1),
-  m_CurrentOrderLock(1),
+  m_PatternBlockSize(16),
+  m_PatternCacheSize(static_cast<size_t>(1024) * 1024 * 1024),
   m_EkeVs(FloatArrayType::NullPointer())
 {
   // Connection to allow the pattern list to redraw itself
   PatternListModel* model = PatternListModel::Instance();
   connect(this, SIGNAL(rowDataChanged(const QModelIndex &, const QModelIndex &)), model, SIGNAL(dataChanged(const QModelIndex &, const QModelIndex &)), Qt::QueuedConnection);
+
+  // A pattern generation request that arrives while the master file is loading is started from here
+  connect(&m_MasterFileWatcher, SIGNAL(finished()), this, SLOT(masterFileReadFinished()));
 }
 
 // -----------------------------------------------------------------------------
@@ -69,7 +76,22 @@ EMsoftController::EMsoftController(QObject* parent) :
 // -----------------------------------------------------------------------------
 EMsoftController::~EMsoftController()
 {
+  stopReadingMasterFile();
+  stopGeneration();
+  stopReprocessing();
+  destroyDetector();
+}
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void EMsoftController::destroyDetector()
+{
+  if (m_Detector != nullptr)
+  {
+    EMsoftCdestroyEBSDDetector(m_Detector);
+    m_Detector = nullptr;
+  }
 }
 
 // -----------------------------------------------------------------------------
@@ -85,7 +107,10 @@ void EMsoftController::setMasterFilePath(QString masterFilePath)
   emit statusMsgGenerated("Data File: " + fi.fileName());
   emit statusMsgGenerated("Suffix: " + fi.completeSuffix() + "\n");
 
-  readMasterFile();
+  // The file is read on its own thread so that the workbench is usable while the energy bins are loading
+  stopReadingMasterFile();
+  m_MasterFileFuture = QtConcurrent::run(this, &EMsoftController::readMasterFile);
+  m_MasterFileWatcher.setFuture(m_MasterFileFuture);
 }
 
 // -----------------------------------------------------------------------------
@@ -165,52 +190,14 @@ void EMsoftController::readHeaderData(hid_t fileId)
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-void EMsoftController::readMasterPatternData(hid_t fileId, size_t &currentCount, size_t &totalItems)
+bool EMsoftController::readMasterPatternData(hid_t ebsdMasterId, const std::vector<hsize_t> &mLPNH_dims, const std::vector<hsize_t> &masterSPNH_dims, QVector<QFuture<void> > &futures, QMutexLocker &h5Locker)
 {
-  QString ebsdMasterPath = "EMData/EBSDmaster";
-  hid_t ebsdMasterId = H5Utilities::openHDF5Object(fileId, ebsdMasterPath.toStdString());
-  if (ebsdMasterId < 0)
-  {
-    emit statusMsgGenerated(tr("Error: Unable to open object at path '%1'").arg(ebsdMasterPath));
-    return;
-  }
-  HDF5ScopedGroupSentinel sentinel(&ebsdMasterId, true);
-
-  // Read energy value data
-  {
-    m_EkeVs = readArrayDataset<float>(ebsdMasterId, "EkeVs");
-    if (m_EkeVs == FloatArrayType::NullPointer()) { return; }
-    emit updateEkeVs(m_EkeVs);
-  }
-
-  // Read numset data
-  QString numsetName = "numset";
-  int err = QH5Lite::readScalarDataset(ebsdMasterId, numsetName, m_HeaderData.numset);
-  if(err < 0)
-  {
-    emit statusMsgGenerated(tr("Error: Could not read object '%1'").arg(numsetName));
-    return;
-  }
-
   // Read Master Pattern lambert square projection data
   emit statusMsgGenerated(tr("Reading Master Pattern data sets..."));
-  emit splashScreenMsgGenerated(tr("Reading Master Pattern data sets (%1/%2)...").arg(currentCount).arg(totalItems));
   emit statusMsgGenerated(tr("File generated by program '%1'").arg(m_HeaderData.mpProgramName));
   emit statusMsgGenerated(tr("Version Identifier: %1").arg(m_HeaderData.mpVersionId));
   emit statusMsgGenerated(tr("Number Of Energy Bins: %1\n").arg(QString::number(m_HeaderData.numMPEnergyBins)));
 
-  m_MasterLPNHData = readArrayDataset<float>(ebsdMasterId, "mLPNH");
-  if (m_MasterLPNHData == FloatArrayType::NullPointer()) { return; }
-
-  std::vector<hsize_t> mLPNH_dims = readDatasetDimensions(ebsdMasterId, "mLPNH");
-  if (mLPNH_dims.size() <= 0) { return; }
-
-  m_MasterLPSHData = readArrayDataset<float>(ebsdMasterId, "mLPSH");
-  if (m_MasterLPSHData == FloatArrayType::NullPointer()) { return; }
-
-  std::vector<hsize_t> mLPSH_dims = readDatasetDimensions(ebsdMasterId, "mLPSH");
-  if (mLPSH_dims.size() <= 0) { return; }
-
   QString mpDimStr = "";
   for (int i = 0; i < mLPNH_dims.size(); i++)
   {
@@ -223,94 +210,101 @@ void EMsoftController::readMasterPatternData(hid_t fileId, size_t &currentCount,
 
   emit statusMsgGenerated(tr("Size of mLPNH data array: %1").arg(mpDimStr));
 
-  m_MasterLPNH = createImages<float>(m_MasterLPNHData, mLPNH_dims[3], mLPNH_dims[2], mLPNH_dims[1], m_MasterLPNHPairs);
-  m_MasterLPSH = createImages<float>(m_MasterLPSHData, mLPSH_dims[3], mLPSH_dims[2], mLPSH_dims[1], m_MasterLPSHPairs);
-
-  currentCount++;
-  emit splashScreenMsgGenerated(tr("Reading Master Pattern data sets (%1/%2)...").arg(currentCount).arg(totalItems));
-
-  // Generate Master Pattern Lambert Circle projection data
+  // The data sets are read one energy bin at a time; each bin is handed to the thread pool
+  // as soon as it has been read so that the images of the first bins are ready while the
+  // rest of the file is still being read.  The HDF5 lock is let go between the bins so that an
+  // angle file can be opened on the GUI thread without waiting for the whole master file.
   size_t zDim = mLPNH_dims[1];
-
-  for (int z = 0; z < zDim; z++)
+  for (size_t z = 0; z < zDim; z++)
   {
-    ProjectionConversions projConversion(this);
-    FloatArrayType::Pointer circularProj = projConversion.convertLambertSquareData<float>(m_MasterLPNHData, mLPNH_dims[3], ModifiedLambertProjection::ProjectionType::Circular, z, ModifiedLambertProjection::Square::NorthSquare);
-    FloatPair minMaxPair;
-    m_MasterCircle.push_back(createImage<float>(circularProj, mLPNH_dims[3], mLPNH_dims[2], 0, minMaxPair));
-    m_MasterCirclePairs.push_back(minMaxPair);
-  }
-
-  currentCount++;
-  emit splashScreenMsgGenerated(tr("Reading Master Pattern data sets (%1/%2)...").arg(currentCount).arg(totalItems));
+    if (z > 0)
+    {
+      h5Locker.unlock();
+      h5Locker.relock();
+    }
 
-  // Read Master Pattern stereographic projection data
-  m_MasterSPNHData = readArrayDataset<float>(ebsdMasterId, "masterSPNH");
-  if (m_MasterSPNHData == FloatArrayType::NullPointer()) { return; }
+    if (m_CancelMasterFileRead.load() != 0) { return false; }
 
-  std::vector<hsize_t> masterSPNH_dims = readDatasetDimensions(ebsdMasterId, "masterSPNH");
-  if (masterSPNH_dims.size() <= 0) { return; }
+    if (!readArrayDatasetSlice<float>(ebsdMasterId, "mLPNH", mLPNH_dims, 1, z, m_MasterLPNHData->getPointer(0))
+        || !readArrayDatasetSlice<float>(ebsdMasterId, "mLPSH", mLPNH_dims, 1, z, m_MasterLPSHData->getPointer(0))
+        || !readArrayDatasetSlice<float>(ebsdMasterId, "masterSPNH", masterSPNH_dims, 0, z, m_MasterSPNHData->getPointer(0)))
+    {
+      return false;
+    }
 
-  m_MasterSPNH = createImages<float>(m_MasterSPNHData, masterSPNH_dims[2], masterSPNH_dims[1], masterSPNH_dims[0], m_MasterSPNHPairs);
+    futures.push_back(QtConcurrent::run(this, &EMsoftController::createMasterPatternImages, z, mLPNH_dims, masterSPNH_dims));
+  }
 
-  currentCount++;
+  return true;
 }
 
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-void EMsoftController::readMonteCarloData(hid_t fileId, size_t &currentCount, size_t &totalItems)
+void EMsoftController::createMasterPatternImages(size_t z, std::vector<hsize_t> mLPNH_dims, std::vector<hsize_t> masterSPNH_dims)
 {
-  QString mcOpenCLPath = "EMData/MCOpenCL";
-  hid_t mcOpenCLId = H5Utilities::openHDF5Object(fileId, mcOpenCLPath.toStdString());
-  if (mcOpenCLId < 0)
+  if (m_CancelMasterFileRead.load() != 0) { return; }
+
+  FloatPair lpnhPair, lpshPair, circlePair, spnhPair;
+  QImage lpnhImage, lpshImage;
+  createHemisphereImages<float>(m_MasterLPNHData, m_MasterLPSHData, mLPNH_dims[3], mLPNH_dims[2], z, lpnhImage, lpnhPair, lpshImage, lpshPair);
+  QImage spnhImage = createImage<float>(m_MasterSPNHData, masterSPNH_dims[2], masterSPNH_dims[1], z, spnhPair);
+  if (m_CancelMasterFileRead.load() != 0) { return; }
+
+  // Generate Master Pattern Lambert Circle projection data
+  ProjectionConversions projConversion;
+  FloatArrayType::Pointer circularProj = projConversion.convertLambertSquareData<float>(m_MasterLPNHData, mLPNH_dims[3], ModifiedLambertProjection::ProjectionType::Circular, z, ModifiedLambertProjection::Square::NorthSquare);
+  QImage circleImage = createImage<float>(circularProj, mLPNH_dims[3], mLPNH_dims[2], 0, circlePair);
+
   {
-    emit statusMsgGenerated(tr("Error: Unable to open object at path '%1'").arg(mcOpenCLPath));
-    return;
+    QMutexLocker locker(&m_ImagesMutex);
+    m_MasterLPNH[z] = lpnhImage;
+    m_MasterLPNHPairs[z] = lpnhPair;
+    m_MasterLPSH[z] = lpshImage;
+    m_MasterLPSHPairs[z] = lpshPair;
+    m_MasterSPNH[z] = spnhImage;
+    m_MasterSPNHPairs[z] = spnhPair;
+    m_MasterCircle[z] = circleImage;
+    m_MasterCirclePairs[z] = circlePair;
   }
-  HDF5ScopedGroupSentinel sentinel(&mcOpenCLId, true);
 
+  QMetaObject::invokeMethod(this, "energyBinImagesCreated", Qt::QueuedConnection);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool EMsoftController::readMonteCarloData(hid_t mcOpenCLId, const std::vector<hsize_t> &monteCarlo_dims, QVector<QFuture<void> > &futures)
+{
   // Read Monte Carlo lambert square projection data
   emit statusMsgGenerated(tr("Reading Monte Carlo data sets..."));
-  emit splashScreenMsgGenerated(tr("Reading Monte Carlo data sets (%1/%2)...").arg(currentCount).arg(totalItems));
   emit statusMsgGenerated(tr("File generated by program '%1'").arg(m_HeaderData.mcProgramName));
   emit statusMsgGenerated(tr("Version Identifier: %1").arg(m_HeaderData.mcVersionId));
 
-  m_MonteCarloSquareData = readArrayDataset<int32_t>(mcOpenCLId, "accum_e");
-  if (m_MonteCarloSquareData == Int32ArrayType::NullPointer()) { return; }
-
-  std::vector<hsize_t> monteCarlo_dims = readDatasetDimensions(mcOpenCLId, "accum_e");
-  if (monteCarlo_dims.size() <= 0) { return; }
-
-  Int32ArrayType::Pointer monteCarloSquare_data = deHyperSlabData<int32_t>(m_MonteCarloSquareData, monteCarlo_dims[0], monteCarlo_dims[1], monteCarlo_dims[2]);
-
-  m_MonteCarloSquare = createImages<int32_t>(monteCarloSquare_data, monteCarlo_dims[0], monteCarlo_dims[1], monteCarlo_dims[2], m_MonteCarloSquarePairs);
+  // The energy bins are the fastest moving dimension of accum_e, so it is read into one buffer.  The
+  // buffer is filled one index of the slowest dimension at a time so that a cancel does not have to
+  // wait for the whole array.
+  size_t mcTuples = monteCarlo_dims[0] * monteCarlo_dims[1] * monteCarlo_dims[2];
+  Int32ArrayType::Pointer monteCarloSquareData = Int32ArrayType::CreateArray(mcTuples, QVector<size_t>(1, 1), "accum_e");
+  for (hsize_t x = 0; x < monteCarlo_dims[0]; x++)
+  {
+    if (m_CancelMasterFileRead.load() != 0) { return false; }
 
-  currentCount++;
-  emit splashScreenMsgGenerated(tr("Reading Monte Carlo data sets (%1/%2)...").arg(currentCount).arg(totalItems));
+    if (!readArrayDatasetSlice<int32_t>(mcOpenCLId, "accum_e", monteCarlo_dims, 0, x, monteCarloSquareData->getPointer(0)))
+    {
+      return false;
+    }
+  }
+  m_MonteCarloSquareData = monteCarloSquareData;
 
+  // Generate Monte Carlo square, stereographic and circular projection data.  m_MonteCarloSquareData keeps
+  // the file layout because the detector is created from it, so each task copies out only its own energy bin.
   size_t zDim = monteCarlo_dims[2];
-
-  // Generate Monte Carlo stereographic and circular projection data
-  for (int z = 0; z < zDim; z++)
+  for (size_t z = 0; z < zDim; z++)
   {
-    ProjectionConversions projConversion(this);
-    FloatArrayType::Pointer circularProj = projConversion.convertLambertSquareData<int32_t>(monteCarloSquare_data, monteCarlo_dims[0], ModifiedLambertProjection::ProjectionType::Circular, z, ModifiedLambertProjection::Square::NorthSquare);
-
-    FloatPair minMaxPair;
-    m_MonteCarloCircle.push_back(createImage<float>(circularProj, monteCarlo_dims[0], monteCarlo_dims[1], 0, minMaxPair).mirrored(false, true));
-    m_MonteCarloCirclePairs.push_back(minMaxPair);
-
-    FloatArrayType::Pointer stereoProj = projConversion.convertLambertSquareData<int32_t>(monteCarloSquare_data, monteCarlo_dims[0], ModifiedLambertProjection::ProjectionType::Stereographic, z, ModifiedLambertProjection::Square::NorthSquare);
-    m_MonteCarloStereo.push_back(createImage<float>(stereoProj, monteCarlo_dims[0], monteCarlo_dims[1], 0, minMaxPair));
-    m_MonteCarloStereoPairs.push_back(minMaxPair);
+    futures.push_back(QtConcurrent::run(this, &EMsoftController::createMonteCarloImages, z, monteCarlo_dims));
   }
 
-  currentCount++;
-  emit splashScreenMsgGenerated(tr("Reading Monte Carlo data sets (%1/%2)...").arg(currentCount).arg(totalItems));
-
-  currentCount++;
-
   QString mcDimStr = "";
   for (int i = 0; i < monteCarlo_dims.size(); i++)
   {
@@ -334,61 +328,243 @@ void EMsoftController::readMonteCarloData(hid_t fileId, size_t &currentCount, si
   emit statusMsgGenerated(tr("Number Of Depth Bins: %1").arg(QString::number(m_HeaderData.numDepthBins)));
   emit statusMsgGenerated(tr("Total Number Of Incident Electrons: %1").arg(QString::number(m_HeaderData.totalNumIncidentEl)));
   emit statusMsgGenerated(tr("Size of accum_e data array: %1").arg(mcDimStr));
+
+  return true;
 }
 
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-void EMsoftController::readMasterFile()
+void EMsoftController::createMonteCarloImages(size_t z, std::vector<hsize_t> monteCarlo_dims)
 {
-  QFileInfo fi(m_MasterFilePath);
+  if (m_CancelMasterFileRead.load() != 0) { return; }
+
+  // Each task reorders its own energy bin into a buffer that only holds that bin, so the memory peak
+  // stays at one accum_e plus one bin per running task
+  Int32ArrayType::Pointer monteCarloSquare_data = Int32ArrayType::CreateArray(monteCarlo_dims[0] * monteCarlo_dims[1], QVector<size_t>(1, 1), m_MonteCarloSquareData->getName());
+  deHyperSlabData<int32_t>(m_MonteCarloSquareData->getPointer(0), monteCarloSquare_data->getPointer(0), monteCarlo_dims[0], monteCarlo_dims[1], monteCarlo_dims[2], z);
+
+  IntPair squarePair;
+  QImage squareImage = createImage<int32_t>(monteCarloSquare_data, monteCarlo_dims[0], monteCarlo_dims[1], 0, squarePair);
+
+  ProjectionConversions projConversion;
+  FloatArrayType::Pointer circularProj = projConversion.convertLambertSquareData<int32_t>(monteCarloSquare_data, monteCarlo_dims[0], ModifiedLambertProjection::ProjectionType::Circular, 0, ModifiedLambertProjection::Square::NorthSquare);
+
+  FloatPair circlePair;
+  QImage circleImage = createImage<float>(circularProj, monteCarlo_dims[0], monteCarlo_dims[1], 0, circlePair).mirrored(false, true);
+  if (m_CancelMasterFileRead.load() != 0) { return; }
+
+  FloatArrayType::Pointer stereoProj = projConversion.convertLambertSquareData<int32_t>(monteCarloSquare_data, monteCarlo_dims[0], ModifiedLambertProjection::ProjectionType::Stereographic, 0, ModifiedLambertProjection::Square::NorthSquare);
+
+  FloatPair stereoPair;
+  QImage stereoImage = createImage<float>(stereoProj, monteCarlo_dims[0], monteCarlo_dims[1], 0, stereoPair);
 
-  hid_t fileId = H5Utilities::openFile(m_MasterFilePath.toStdString(), true);
-  if (fileId < 0)
   {
-    emit statusMsgGenerated(tr("Error: Unable to open data file '%1'").arg(fi.fileName()));
-    return;
+    QMutexLocker locker(&m_ImagesMutex);
+    m_MonteCarloSquare[z] = squareImage;
+    m_MonteCarloSquarePairs[z] = squarePair;
+    m_MonteCarloCircle[z] = circleImage;
+    m_MonteCarloCirclePairs[z] = circlePair;
+    m_MonteCarloStereo[z] = stereoImage;
+    m_MonteCarloStereoPairs[z] = stereoPair;
   }
-  else
+
+  QMetaObject::invokeMethod(this, "energyBinImagesCreated", Qt::QueuedConnection);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void EMsoftController::readMasterFile()
+{
+  QFileInfo fi(m_MasterFilePath);
+
+  QVector<QFuture<void> > futures;
+  bool success = false;
+
   {
-    emit statusMsgGenerated(tr("Reading data file '%1'...").arg(fi.fileName()));
+    // HDF5 calls are serialized by this lock. readMasterPatternData lets it go between the energy bins,
+    // while none of the identifiers below is in use. The sentinels are declared after the locker, so they
+    // close every identifier before the lock is released at the end of this block, and the image tasks
+    // are waited on without holding it.
+    QMutexLocker h5Locker(&H5AccessMutex::Instance());
+
+    hid_t fileId = H5Utilities::openFile(m_MasterFilePath.toStdString(), true);
+    if (fileId < 0)
+    {
+      emit statusMsgGenerated(tr("Error: Unable to open data file '%1'").arg(fi.fileName()));
+      return;
+    }
+    else
+    {
+      emit statusMsgGenerated(tr("Reading data file '%1'...").arg(fi.fileName()));
 
-    double fileSize = fi.size();      // This is in bytes
-    fileSize = fileSize / 1000000;    // Convert to MB
-    emit statusMsgGenerated(tr("File Size: %1 MB\n").arg(QString::number(fileSize, 'f', 2)));
-  }
-  HDF5ScopedFileSentinel sentinel(&fileId, true);
+      double fileSize = fi.size();      // This is in bytes
+      fileSize = fileSize / 1000000;    // Convert to MB
+      emit statusMsgGenerated(tr("File Size: %1 MB\n").arg(QString::number(fileSize, 'f', 2)));
+    }
+    HDF5ScopedFileSentinel sentinel(&fileId, true);
 
-  // Read the header data
-  readHeaderData(fileId);
+    // Read the header data
+    readHeaderData(fileId);
 
-  size_t currentCount = 1;
-  size_t totalItems = 6;
+    QString ebsdMasterPath = "EMData/EBSDmaster";
+    hid_t ebsdMasterId = H5Utilities::openHDF5Object(fileId, ebsdMasterPath.toStdString());
+    if (ebsdMasterId < 0)
+    {
+      emit statusMsgGenerated(tr("Error: Unable to open object at path '%1'").arg(ebsdMasterPath));
+      return;
+    }
+    HDF5ScopedGroupSentinel groupSentinel(&ebsdMasterId, true);
 
-  // Read the Master Pattern Data
-  readMasterPatternData(fileId, currentCount, totalItems);
+    QString mcOpenCLPath = "EMData/MCOpenCL";
+    hid_t mcOpenCLId = H5Utilities::openHDF5Object(fileId, mcOpenCLPath.toStdString());
+    if (mcOpenCLId < 0)
+    {
+      emit statusMsgGenerated(tr("Error: Unable to open object at path '%1'").arg(mcOpenCLPath));
+      return;
+    }
+    groupSentinel.addGroupId(&mcOpenCLId);
 
-  // Read the Monte Carlo Data
-  readMonteCarloData(fileId, currentCount, totalItems);
+    // Read energy value data
+    FloatArrayType::Pointer ekeVs = readArrayDataset<float>(ebsdMasterId, "EkeVs");
+    if (ekeVs == FloatArrayType::NullPointer()) { return; }
 
-  if ((m_MasterLPNH.size() == m_MasterSPNH.size()
-       && m_MasterLPNH.size() == m_MasterCircle.size()
-      && m_MasterLPNH.size() == m_MonteCarloSquare.size()
-       && m_MasterLPNH.size() == m_MonteCarloCircle.size()
-       && m_MasterLPNH.size() == m_MonteCarloStereo.size()))
-  {
-    if (m_MasterLPNH.size() > 0)
+    // Read numset data
+    QString numsetName = "numset";
+    int err = QH5Lite::readScalarDataset(ebsdMasterId, numsetName, m_HeaderData.numset);
+    if(err < 0)
     {
-      emit imageRangeChanged(1, m_MasterLPNH.size());
+      emit statusMsgGenerated(tr("Error: Could not read object '%1'").arg(numsetName));
+      return;
     }
-    else
+
+    // Read all of the dimensions first so that the sizes can be checked before any of the data is read
+    std::vector<hsize_t> mLPNH_dims = readDatasetDimensions(ebsdMasterId, "mLPNH");
+    std::vector<hsize_t> mLPSH_dims = readDatasetDimensions(ebsdMasterId, "mLPSH");
+    std::vector<hsize_t> masterSPNH_dims = readDatasetDimensions(ebsdMasterId, "masterSPNH");
+    std::vector<hsize_t> monteCarlo_dims = readDatasetDimensions(mcOpenCLId, "accum_e");
+    if (mLPNH_dims.size() != 4 || mLPSH_dims != mLPNH_dims || masterSPNH_dims.size() != 3 || monteCarlo_dims.size() != 3) { return; }
+
+    size_t zDim = mLPNH_dims[1];
+    if (masterSPNH_dims[0] != zDim || monteCarlo_dims[2] != zDim)
+    {
+      emit statusMsgGenerated(tr("Error: Data Images have different sizes."));
+      return;
+    }
+    if (zDim == 0)
     {
       emit statusMsgGenerated(tr("Error: No data images were generated."));
+      return;
+    }
+
+    size_t mpTuples = mLPNH_dims[0] * mLPNH_dims[1] * mLPNH_dims[2] * mLPNH_dims[3];
+    m_MasterLPNHData = FloatArrayType::CreateArray(mpTuples, QVector<size_t>(1, 1), "mLPNH");
+    m_MasterLPSHData = FloatArrayType::CreateArray(mpTuples, QVector<size_t>(1, 1), "mLPSH");
+    m_MasterSPNHData = FloatArrayType::CreateArray(masterSPNH_dims[0] * masterSPNH_dims[1] * masterSPNH_dims[2], QVector<size_t>(1, 1), "masterSPNH");
+
+    {
+      QMutexLocker locker(&m_ImagesMutex);
+      m_EkeVs = ekeVs;
+      resizeImages(zDim);
     }
+
+    // The energy bins can be selected as soon as their sizes are known; each bin is displayed once its images exist
+    QMetaObject::invokeMethod(this, "masterFileSizesRead", Qt::QueuedConnection, Q_ARG(int, static_cast<int>(zDim)));
+
+    // Read the Master Pattern Data
+    success = readMasterPatternData(ebsdMasterId, mLPNH_dims, masterSPNH_dims, futures, h5Locker);
+
+    // Read the Monte Carlo Data
+    success = success && m_CancelMasterFileRead.load() == 0 && readMonteCarloData(mcOpenCLId, monteCarlo_dims, futures);
   }
-  else
+
+  for (int i = 0; i < futures.size(); i++)
   {
-    emit statusMsgGenerated(tr("Error: Data Images have different sizes."));
+    futures[i].waitForFinished();
+  }
+
+  if (!success)
+  {
+    // Pattern generation must never see a partially read file
+    m_MasterLPNHData = FloatArrayType::NullPointer();
+    m_MasterLPSHData = FloatArrayType::NullPointer();
+    m_MasterSPNHData = FloatArrayType::NullPointer();
+    m_MonteCarloSquareData = Int32ArrayType::NullPointer();
+    return;
+  }
+
+  emit statusMsgGenerated(tr("Finished reading data file '%1'").arg(fi.fileName()));
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void EMsoftController::resizeImages(size_t zDim)
+{
+  m_MasterLPNH.assign(zDim, QImage());
+  m_MasterLPNHPairs.assign(zDim, FloatPair());
+  m_MasterLPSH.assign(zDim, QImage());
+  m_MasterLPSHPairs.assign(zDim, FloatPair());
+  m_MasterSPNH.assign(zDim, QImage());
+  m_MasterSPNHPairs.assign(zDim, FloatPair());
+  m_MasterCircle.assign(zDim, QImage());
+  m_MasterCirclePairs.assign(zDim, FloatPair());
+  m_MonteCarloSquare.assign(zDim, QImage());
+  m_MonteCarloSquarePairs.assign(zDim, IntPair());
+  m_MonteCarloCircle.assign(zDim, QImage());
+  m_MonteCarloCirclePairs.assign(zDim, IntPair());
+  m_MonteCarloStereo.assign(zDim, QImage());
+  m_MonteCarloStereoPairs.assign(zDim, IntPair());
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void EMsoftController::stopReadingMasterFile()
+{
+  m_CancelMasterFileRead.store(1);
+  m_MasterFileFuture.waitForFinished();
+  m_CancelMasterFileRead.store(0);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void EMsoftController::masterFileSizesRead(int numOfEnergyBins)
+{
+  FloatArrayType::Pointer ekeVs;
+  {
+    QMutexLocker locker(&m_ImagesMutex);
+    ekeVs = m_EkeVs;
+  }
+
+  emit updateEkeVs(ekeVs);
+  emit imageRangeChanged(1, numOfEnergyBins);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void EMsoftController::energyBinImagesCreated()
+{
+  int mpBin = 0, mcBin = 0;
+  MPMCDisplayWidget::ProjectionMode mpMode, mcMode;
+  {
+    QMutexLocker locker(&m_ImagesMutex);
+    mpBin = m_PendingMPBin;
+    mpMode = m_PendingMPMode;
+    mcBin = m_PendingMCBin;
+    mcMode = m_PendingMCMode;
+  }
+
+  if (mpBin > 0)
+  {
+    updateMPImage(mpBin, mpMode);
+  }
+  if (mcBin > 0)
+  {
+    updateMCImage(mcBin, mcMode);
   }
 }
 
@@ -413,12 +589,12 @@ std::vector<hsize_t> EMsoftController::readDatasetDimensions(hid_t parentId, QSt
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-void EMsoftController::generatePatternImagesUsingThread(PatternDisplayWidget::PatternDisplayData patternData, EMsoftController::DetectorData detectorData)
+void EMsoftController::initializeGenericParameters(PatternDisplayWidget::PatternDisplayData patternData, EMsoftController::DetectorData detectorData, Int32ArrayType::Pointer &genericIParPtr, FloatArrayType::Pointer &genericFParPtr)
 {
-  Int32ArrayType::Pointer genericIParPtr = Int32ArrayType::CreateArray(40, QVector<size_t>(1, 1), "IPar");
+  genericIParPtr = Int32ArrayType::CreateArray(40, QVector<size_t>(1, 1), "IPar");
   genericIParPtr->initializeWithZeros();
 
-  FloatArrayType::Pointer  genericFParPtr = FloatArrayType::CreateArray(40, QVector<size_t>(1, 1), "FPar");
+  genericFParPtr = FloatArrayType::CreateArray(40, QVector<size_t>(1, 1), "FPar");
   genericFParPtr->initializeWithZeros();
 
   int32_t* genericIPar = genericIParPtr->getPointer(0);
@@ -432,25 +608,11 @@ void EMsoftController::generatePatternImagesUsingThread(PatternDisplayWidget::Pa
   genericIPar[18] = static_cast<size_t>(detectorData.pixelNumX);
   genericIPar[19] = static_cast<size_t>(detectorData.pixelNumY);
 
-  int binningIndex = 0;
-  if (patternData.detectorBinningValue == 2)
-  {
-    binningIndex = 1;
-  }
-  else if (patternData.detectorBinningValue == 4)
-  {
-    binningIndex = 2;
-  }
-  else if (patternData.detectorBinningValue == 8)
-  {
-    binningIndex = 3;
-  }
-
-  //genericIPar[20] = static_cast<size_t>(genericQuaternionsPtr->getNumberOfTuples()); // number of orientations
-  genericIPar[20] = static_cast<size_t>(1); // number of orientations
-  genericIPar[21] = binningIndex;
-  genericIPar[22] = static_cast<size_t>(detectorData.pixelNumX / patternData.detectorBinningValue);
-  genericIPar[23] = static_cast<size_t>(detectorData.pixelNumY / patternData.detectorBinningValue);
+  // The raw patterns are cached unbinned, so that the binning can be changed without regenerating them
+  genericIPar[20] = static_cast<size_t>(1); // number of orientations; set per block by each thread
+  genericIPar[21] = 0;                      // binning index
+  genericIPar[22] = static_cast<size_t>(detectorData.pixelNumX);
+  genericIPar[23] = static_cast<size_t>(detectorData.pixelNumY);
 
   // and set all the float input parameters for the EMsoftCgetEBSDPatterns routine
   // some of these have been set in previous filters
@@ -464,107 +626,261 @@ void EMsoftController::generatePatternImagesUsingThread(PatternDisplayWidget::Pa
   genericFPar[18] = detectorData.scintillatorDist;           // sample-scintillator distance (microns)
   genericFPar[19] = detectorData.beamCurrent; // beam current [nA]
   genericFPar[20] = detectorData.dwellTime;   // beam dwell time per pattern [micro-seconds]
-  genericFPar[21] = patternData.gammaValue;  // intensity scaling gamma value
+  genericFPar[21] = 1.0f;   // intensity scaling gamma value; applied by PatternCache::ProcessPattern
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void EMsoftController::generatePatternImagesUsingThread(PatternDisplayWidget::PatternDisplayData patternData, Int32ArrayType::Pointer genericIParPtr, FloatArrayType::Pointer genericFParPtr, FloatArrayType::Pointer quaternions, PatternGenerationQueue::Pointer queue)
+{
+  // Each thread gets its own copy of the integer parameters, because the number of orientations changes from block to block
+  Int32ArrayType::Pointer threadIParPtr = std::dynamic_pointer_cast<Int32ArrayType>(genericIParPtr->deepCopy());
+  int32_t* genericIPar = threadIParPtr->getPointer(0);
+
+  size_t blockSize = (m_PatternBlockSize > 0) ? m_PatternBlockSize : 1;
 
   QVector<size_t> cDims(2);
   cDims[0] = genericIPar[22];
   cDims[1] = genericIPar[23];
 
-  FloatArrayType::Pointer genericEBSDPatternsPtr = FloatArrayType::CreateArray(1, cDims, "ebsdPatterns");
-  FloatArrayType::Pointer eulerAngles = patternData.angles;
+  FloatArrayType::Pointer genericEBSDPatternsPtr = FloatArrayType::CreateArray(blockSize, cDims, "ebsdPatterns");
+  FloatArrayType::Pointer genericQuaternionsPtr = FloatArrayType::CreateArray(blockSize, QVector<size_t>(1, 4), "Quats");
   PatternListModel* model = PatternListModel::Instance();
 
-  while (m_CurrentOrder.size() > 0)
+  QVector<size_t> indices;
+  indices.reserve(blockSize);
+
+  // takeIndices blocks while there is no work, and returns false once the queue is drained or cancelled
+  while (queue->takeIndices(blockSize, indices) == true)
   {
-    if (m_Cancel == true) { return; }
+    size_t minIndex = *std::min_element(indices.begin(), indices.end());
+    size_t maxIndex = *std::max_element(indices.begin(), indices.end());
+    QModelIndex topLeft = model->index(minIndex, PatternListItem::DefaultColumn);
+    QModelIndex bottomRight = model->index(maxIndex, PatternListItem::DefaultColumn);
 
-    // Load the next image
-    if (m_CurrentOrderLock.tryAcquire() == true)
+    for (int i = 0; i < indices.size(); i++)
     {
-      int index;
-      if (m_PriorityOrder.size() > 0)
-      {
-        // An index in this thread has been given priority
-        index = m_PriorityOrder.front();
-        m_PriorityOrder.pop_front();
-        m_CurrentOrder.removeAll(index);
-      }
-      else
-      {
-        index = m_CurrentOrder.front();
-        m_CurrentOrder.pop_front();
-      }
-      m_CurrentOrderLock.release();
-
-      QModelIndex modelIndex = model->index(index, PatternListItem::DefaultColumn);
-      model->setPatternStatus(index, PatternListItem::PatternStatus::Loading);
-      emit rowDataChanged(modelIndex, modelIndex);
+      model->setPatternStatus(indices[i], PatternListItem::PatternStatus::Loading);
+    }
+    emit rowDataChanged(topLeft, bottomRight);
 
-      bool success = generatePatternImage(index, eulerAngles, m_MasterLPNHData, m_MasterLPSHData, m_MonteCarloSquareData, genericEBSDPatternsPtr, genericIParPtr, genericFParPtr, patternData.patternOrigin);
+    bool success = generatePatternImageBlock(indices, quaternions, genericQuaternionsPtr, genericEBSDPatternsPtr, threadIParPtr, genericFParPtr, queue);
 
+    for (int i = 0; i < indices.size(); i++)
+    {
       if (success == true)
       {
-        model->setPatternStatus(index, PatternListItem::PatternStatus::Loaded);
+        model->setPatternStatus(indices[i], PatternListItem::PatternStatus::Loaded);
       }
       else
       {
-        model->setPatternStatus(index, PatternListItem::PatternStatus::Error);
+        model->setPatternStatus(indices[i], PatternListItem::PatternStatus::Error);
       }
+    }
 
-      m_NumOfFinishedPatternsLock.acquire();
-      m_NumOfFinishedPatterns++;
-      emit newProgressBarValue(m_NumOfFinishedPatterns);
-      m_NumOfFinishedPatternsLock.release();
+    size_t numOfFinishedPatterns = queue->finishIndices(indices.size());
+    emit newProgressBarValue(numOfFinishedPatterns);
 
-      emit rowDataChanged(modelIndex, modelIndex);
-    }
+    emit rowDataChanged(topLeft, bottomRight);
   }
 }
 
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-bool EMsoftController::generatePatternImage(size_t index, FloatArrayType::Pointer eulerAngles, FloatArrayType::Pointer genericLPNHPtr, FloatArrayType::Pointer genericLPSHPtr, Int32ArrayType::Pointer genericAccum_ePtr, FloatArrayType::Pointer genericEBSDPatternsPtr, Int32ArrayType::Pointer genericIParPtr, FloatArrayType::Pointer genericFParPtr, QString patternOrigin)
+bool EMsoftController::generatePatternImageBlock(const QVector<size_t> &indices, FloatArrayType::Pointer quaternions, FloatArrayType::Pointer genericQuaternionsPtr, FloatArrayType::Pointer genericEBSDPatternsPtr, Int32ArrayType::Pointer genericIParPtr, FloatArrayType::Pointer genericFParPtr, PatternGenerationQueue::Pointer queue)
 {
+  if (m_Detector == nullptr) { return false; }
+
   int32_t* genericIPar = genericIParPtr->getPointer(0);
   float* genericFPar = genericFParPtr->getPointer(0);
   float* genericEBSDPatterns = genericEBSDPatternsPtr->getPointer(0);
-  int32_t* genericAccum_e = genericAccum_ePtr->getPointer(0);
-  float* genericLPNH = genericLPNHPtr->getPointer(0);
-  float* genericLPSH = genericLPSHPtr->getPointer(0);
-
-  FloatArrayType::Pointer genericQuaternionsPtr = FloatArrayType::CreateArray(1, QVector<size_t>(1, 4), "Quats");
   float* genericQuaternions = genericQuaternionsPtr->getPointer(0);
 
-  QVector<float> eulerAngle;
-  eulerAngle.push_back(eulerAngles->getComponent(index, 0));
-  eulerAngle.push_back(eulerAngles->getComponent(index, 1));
-  eulerAngle.push_back(eulerAngles->getComponent(index, 2));
+  // Gather the quaternions of this block into one contiguous array
+  size_t numOfPatterns = indices.size();
+  for (size_t i = 0; i < numOfPatterns; i++)
+  {
+    ::memcpy(genericQuaternions + (4 * i), quaternions->getTuplePointer(indices[i]), 4 * sizeof(float));
+  }
 
-  QVector<float> quat(4);
-  OrientationTransforms<QVector<float>,float>::eu2qu(eulerAngle, quat, QuaternionMath<float>::QuaternionScalarVector);
-  genericQuaternionsPtr->setComponent(0, 0, quat[0]);
-  genericQuaternionsPtr->setComponent(0, 1, quat[1]);
-  genericQuaternionsPtr->setComponent(0, 2, quat[2]);
-  genericQuaternionsPtr->setComponent(0, 3, quat[3]);
+  genericIPar[20] = static_cast<int32_t>(numOfPatterns); // number of orientations
 
-  EMsoftCgetEBSDPatterns(genericIPar, genericFPar, genericEBSDPatterns, genericQuaternions, genericAccum_e, genericLPNH, genericLPSH, nullptr, 0, &m_Cancel);
+  EMsoftCcomputeEBSDPatterns(m_Detector, genericIPar, genericFPar, genericEBSDPatterns, genericQuaternions, nullptr, 0, queue->getCancelFlag());
 
-  QVector<size_t> cDims(2);
-  cDims[0] = genericIPar[22];
-  cDims[1] = genericIPar[23];
+  if (queue->isCancelled() == true) { return false; }
 
-  FloatPair minMaxPair;
-  QImage patternImage = createImage<float>(genericEBSDPatternsPtr, cDims[0], cDims[1], 0, minMaxPair);
+  size_t xDim = genericIPar[22];
+  size_t yDim = genericIPar[23];
+
+  // The patterns are stored one after the other, so pattern i is the i-th "slice" of the block.
+  // Each one is cached before it is displayed, so a display update that happens in between
+  // is either picked up here or finds the pattern in the cache.
+  FloatArrayType::Pointer processedPattern;
+  for (size_t i = 0; i < numOfPatterns; i++)
+  {
+    const float* rawPattern = genericEBSDPatterns + (xDim * yDim * i);
+    m_PatternCache->insert(indices[i], rawPattern);
+    displayPattern(indices[i], rawPattern, xDim, yDim, processedPattern);
+  }
+
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int EMsoftController::getPatternDisplayData(PatternDisplayWidget::PatternDisplayData &patternData)
+{
+  QMutexLocker locker(&m_PatternDisplayMutex);
+  patternData = m_PatternDisplayData;
+  return m_PatternDisplayVersion;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void EMsoftController::displayPattern(size_t index, const float* rawPattern, size_t xDim, size_t yDim, FloatArrayType::Pointer &processedPattern)
+{
+  PatternDisplayWidget::PatternDisplayData patternData;
+  int version = getPatternDisplayData(patternData);
 
   GLImageDisplayWidget::GLImageData imageData;
-  imageData.image = patternImage;
-  imageData.minValue = minMaxPair.first;
-  imageData.maxValue = minMaxPair.second;
+  while (true)
+  {
+    float gamma = static_cast<float>(patternData.gammaValue);
+    processedPattern = PatternCache::ProcessPattern(rawPattern, xDim, yDim, patternData.detectorBinningValue, gamma, processedPattern);
+    size_t binning = (patternData.detectorBinningValue > 0) ? patternData.detectorBinningValue : 1;
 
-  m_PatternDisplayWidget->loadImage(index, imageData);
+    FloatPair minMaxPair;
+    imageData.image = createImage<float>(processedPattern, xDim / binning, yDim / binning, 0, minMaxPair);
+    imageData.minValue = minMaxPair.first;
+    imageData.maxValue = minMaxPair.second;
+
+    // Start over if the display values changed while this image was being created
+    int currentVersion = getPatternDisplayData(patternData);
+    if (currentVersion == version) { break; }
+    version = currentVersion;
+  }
 
-  return true;
+  emit patternImageNeedsDisplayed(static_cast<int>(index), imageData);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void EMsoftController::updatePatternImages(PatternDisplayWidget::PatternDisplayData patternData)
+{
+  int version = 0;
+  {
+    QMutexLocker locker(&m_PatternDisplayMutex);
+    patternData.angles = m_PatternDisplayData.angles;
+    m_PatternDisplayData = patternData;
+    m_PatternDisplayVersion++;
+    version = m_PatternDisplayVersion;
+  }
+
+  // Tasks from an earlier update stop after their current pattern once they see the new version
+  for (int i = 0; i < m_ReprocessFutures.size(); i++)
+  {
+    m_ReprocessFutures[i].waitForFinished();
+  }
+  m_ReprocessFutures.clear();
+
+  PatternCache::Pointer cache = m_PatternCache;
+  if (cache == PatternCache::NullPointer()) { return; }
+
+  // Patterns that were evicted from the cache can not be redisplayed with the new values
+  QVector<size_t> evictedIndices = cache->takeEvictedIndices();
+  if (evictedIndices.isEmpty() == false)
+  {
+    PatternListModel* model = PatternListModel::Instance();
+    for (int i = 0; i < evictedIndices.size(); i++)
+    {
+      model->setPatternStatus(evictedIndices[i], PatternListItem::PatternStatus::WaitingToLoad);
+      // Sent through the same queue as the images, so that it lands after any image that is still pending
+      emit patternImageNeedsDisplayed(static_cast<int>(evictedIndices[i]), GLImageDisplayWidget::GLImageData());
+    }
+    emit rowDataChanged(model->index(0, PatternListItem::DefaultColumn), model->index(model->rowCount() - 1, PatternListItem::DefaultColumn));
+    emit statusMsgGenerated(tr("%1 patterns no longer fit in the pattern cache and must be generated again.").arg(evictedIndices.size()));
+  }
+
+  // The current pattern goes first so that it updates right away
+  QVector<size_t> indices = cache->indices();
+  int currentIndex = indices.indexOf(patternData.currentRow);
+  if (currentIndex > 0)
+  {
+    indices.move(currentIndex, 0);
+  }
+
+  int numOfTasks = QThreadPool::globalInstance()->maxThreadCount();
+  if (numOfTasks > indices.size()) { numOfTasks = indices.size(); }
+  for (int i = 0; i < numOfTasks; i++)
+  {
+    m_ReprocessFutures.push_back(QtConcurrent::run(this, &EMsoftController::reprocessPatterns, cache, indices, i, numOfTasks, version));
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void EMsoftController::reprocessPatterns(PatternCache::Pointer cache, QVector<size_t> indices, int firstIndex, int numOfTasks, int version)
+{
+  PatternDisplayWidget::PatternDisplayData patternData;
+  FloatArrayType::Pointer processedPattern;
+  for (int i = firstIndex; i < indices.size(); i += numOfTasks)
+  {
+    if (getPatternDisplayData(patternData) != version) { return; }
+
+    FloatArrayType::Pointer rawPattern = cache->value(indices[i]);
+    if (rawPattern != FloatArrayType::NullPointer())
+    {
+      displayPattern(indices[i], rawPattern->getPointer(0), cache->getXDim(), cache->getYDim(), processedPattern);
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void EMsoftController::stopReprocessing()
+{
+  {
+    QMutexLocker locker(&m_PatternDisplayMutex);
+    m_PatternDisplayVersion++;
+  }
+
+  for (int i = 0; i < m_ReprocessFutures.size(); i++)
+  {
+    m_ReprocessFutures[i].waitForFinished();
+  }
+  m_ReprocessFutures.clear();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+FloatArrayType::Pointer EMsoftController::convertEulersToQuaternions(FloatArrayType::Pointer eulerAngles)
+{
+  typedef OrientationArray<float> OrientationArrayType;
+
+  size_t numOfTuples = eulerAngles->getNumberOfTuples();
+  int eulerStride = eulerAngles->getNumberOfComponents();
+
+  FloatArrayType::Pointer quaternions = FloatArrayType::CreateArray(numOfTuples, QVector<size_t>(1, 4), "Quats");
+  float* eulerPtr = eulerAngles->getPointer(0);
+  float* quatPtr = quaternions->getPointer(0);
+
+  // EMsoftLib expects the scalar part of the quaternion first
+  for (size_t i = 0; i < numOfTuples; i++)
+  {
+    OrientationArrayType eu(eulerPtr + (eulerStride * i), 3);
+    OrientationArrayType qu(quatPtr + (4 * i), 4);
+    OrientationTransforms<OrientationArrayType, float>::eu2qu(eu, qu, QuaternionMath<float>::QuaternionScalarVector);
+  }
+
+  return quaternions;
 }
 
 // -----------------------------------------------------------------------------
@@ -572,10 +888,48 @@ bool EMsoftController::generatePatternImage(size_t index, FloatArrayType::Pointe
 // -----------------------------------------------------------------------------
 void EMsoftController::generatePatternImages(PatternDisplayWidget::PatternDisplayData patternData, EMsoftController::DetectorData detectorData)
 { 
-  m_NumOfFinishedPatterns = 0;
+  // A new run replaces any run that is still in progress
+  stopGeneration();
+  stopReprocessing();
+
+  // The master pattern and Monte Carlo arrays are only complete once the master file has been read, so
+  // the request is kept until masterFileReadFinished instead of blocking the GUI thread
+  if (m_MasterFileFuture.isRunning())
+  {
+    emit statusMsgGenerated(tr("Waiting for the master file to finish loading..."));
+    m_PatternGenerationPending = true;
+    m_PendingPatternData = patternData;
+    m_PendingDetectorData = detectorData;
+    return;
+  }
+
+  m_PatternGenerationPending = false;
+  startPatternGeneration(patternData, detectorData);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void EMsoftController::masterFileReadFinished()
+{
+  // A canceled read finishes right before the next one starts; the request waits for that one
+  if (!m_PatternGenerationPending || m_MasterFileFuture.isRunning()) { return; }
+
+  m_PatternGenerationPending = false;
+  startPatternGeneration(m_PendingPatternData, m_PendingDetectorData);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void EMsoftController::startPatternGeneration(PatternDisplayWidget::PatternDisplayData patternData, EMsoftController::DetectorData detectorData)
+{
   m_NumOfFinishedThreads = 0;
   m_Watchers.clear();
 
+  // Each run gets its own queue, so cancelling this run can never affect a later one
+  PatternGenerationQueue::Pointer queue = PatternGenerationQueue::New();
+
   FloatArrayType::Pointer eulerAngles = patternData.angles;
   size_t angleCount = eulerAngles->getNumberOfTuples();
   emit newProgressBarMaximumValue(angleCount);
@@ -584,24 +938,54 @@ void EMsoftController::generatePatternImages(PatternDisplayWidget::PatternDispla
   for (int i = 0; i < angleCount; i++)
   {
     model->setPatternStatus(i, PatternListItem::PatternStatus::WaitingToLoad);
+    queue->addIndex(i);
     if (i == patternData.currentRow)
     {
       // We want to render the current index first
-      m_CurrentOrder.push_front(i);
-    }
-    else
-    {
-      m_CurrentOrder.push_back(i);
+      queue->promoteIndex(i);
     }
   }
 
+  if (m_MasterLPNHData == FloatArrayType::NullPointer() || m_MasterLPSHData == FloatArrayType::NullPointer()
+      || m_MonteCarloSquareData == Int32ArrayType::NullPointer())
+  {
+    emit statusMsgGenerated(tr("Error: The master pattern and Monte Carlo data must be loaded before generating patterns."));
+    emit generationFinished();
+    return;
+  }
+
+  Int32ArrayType::Pointer genericIParPtr;
+  FloatArrayType::Pointer genericFParPtr;
+  initializeGenericParameters(patternData, detectorData, genericIParPtr, genericFParPtr);
+
+  // The raw patterns of this run, and the display values the threads apply to them
+  m_PatternCache = PatternCache::New(genericIParPtr->getValue(22), genericIParPtr->getValue(23), m_PatternCacheSize);
+  {
+    QMutexLocker locker(&m_PatternDisplayMutex);
+    m_PatternDisplayData = patternData;
+    m_PatternDisplayVersion++;
+  }
+
+  // The detector geometry and the summed master patterns are computed once here and
+  // shared (read-only) by all of the threads below
+  destroyDetector();
+  m_Detector = EMsoftCcreateEBSDDetector(genericIParPtr->getPointer(0), genericFParPtr->getPointer(0), m_MonteCarloSquareData->getPointer(0),
+                                         m_MasterLPNHData->getPointer(0), m_MasterLPSHData->getPointer(0));
+
+  // Convert all of the Euler angles in one pass; the threads then only gather quaternions for their blocks
+  FloatArrayType::Pointer quaternions = convertEulersToQuaternions(eulerAngles);
+
+  // All of the indices are in the queue, so the threads exit as soon as it is drained
+  queue->close();
+  m_GenerationQueue = queue;
+
   size_t threads = QThreadPool::globalInstance()->maxThreadCount();
   for (int i = 0; i < threads; i++)
   {
     QSharedPointer<QFutureWatcher<void>> watcher(new QFutureWatcher<void>());
     connect(watcher.data(), SIGNAL(finished()), this, SLOT(threadFinished()));
 
-    QFuture<void> future = QtConcurrent::run(this, &EMsoftController::generatePatternImagesUsingThread, patternData, detectorData);
+    QFuture<void> future = QtConcurrent::run(this, &EMsoftController::generatePatternImagesUsingThread, patternData, genericIParPtr, genericFParPtr, quaternions, queue);
     watcher->setFuture(future);
 
     m_Watchers.push_back(watcher);
@@ -613,7 +997,10 @@ void EMsoftController::generatePatternImages(PatternDisplayWidget::PatternDispla
 // -----------------------------------------------------------------------------
 void EMsoftController::addPriorityIndex(size_t index)
 {
-  m_PriorityOrder.push_back(index);
+  if (m_GenerationQueue != PatternGenerationQueue::NullPointer())
+  {
+    m_GenerationQueue->promoteIndex(index);
+  }
 }
 
 // -----------------------------------------------------------------------------
@@ -623,23 +1010,37 @@ void EMsoftController::updateMPImage(int value, MPMCDisplayWidget::ProjectionMod
 {
   QImage image;
   FloatPair minMaxPair;
-  if (mode == MPMCDisplayWidget::ProjectionMode::Lambert_Square)
+  float keV = 0.0f;
   {
-    image = m_MasterLPNH[value - 1];
-    minMaxPair = m_MasterLPNHPairs[value - 1];
-  }
-  else if (mode == MPMCDisplayWidget::ProjectionMode::Lambert_Circle)
-  {
-    image = m_MasterCircle[value - 1];
-    minMaxPair = m_MasterCirclePairs[value - 1];
-  }
-  else if (mode == MPMCDisplayWidget::ProjectionMode::Stereographic)
-  {
-    image = m_MasterSPNH[value - 1];
-    minMaxPair = m_MasterSPNHPairs[value - 1];
-  }
+    QMutexLocker locker(&m_ImagesMutex);
+    size_t index = static_cast<size_t>(value - 1);
+    if (mode == MPMCDisplayWidget::ProjectionMode::Lambert_Square && value > 0 && index < m_MasterLPNH.size())
+    {
+      image = m_MasterLPNH[index];
+      minMaxPair = m_MasterLPNHPairs[index];
+    }
+    else if (mode == MPMCDisplayWidget::ProjectionMode::Lambert_Circle && value > 0 && index < m_MasterCircle.size())
+    {
+      image = m_MasterCircle[index];
+      minMaxPair = m_MasterCirclePairs[index];
+    }
+    else if (mode == MPMCDisplayWidget::ProjectionMode::Stereographic && value > 0 && index < m_MasterSPNH.size())
+    {
+      image = m_MasterSPNH[index];
+      minMaxPair = m_MasterSPNHPairs[index];
+    }
 
-  float keV = m_EkeVs->getValue(value - 1);
+    if (image.isNull() || m_EkeVs == FloatArrayType::NullPointer() || index >= m_EkeVs->getNumberOfTuples())
+    {
+      // This energy bin is still being read; it is displayed by energyBinImagesCreated once it is ready
+      m_PendingMPBin = value;
+      m_PendingMPMode = mode;
+      return;
+    }
+    m_PendingMPBin = 0;
+
+    keV = m_EkeVs->getValue(index);
+  }
 
   GLImageDisplayWidget::GLImageData imageData;
   imageData.image = image;
@@ -657,23 +1058,37 @@ void EMsoftController::updateMCImage(int value, MPMCDisplayWidget::ProjectionMod
 {
   QImage image;
   IntPair minMaxPair;
-  if (mode == MPMCDisplayWidget::ProjectionMode::Lambert_Square)
+  float keV = 0.0f;
   {
-    image = m_MonteCarloSquare[value - 1];
-    minMaxPair = m_MonteCarloSquarePairs[value - 1];
-  }
-  else if (mode == MPMCDisplayWidget::ProjectionMode::Lambert_Circle)
-  {
-    image = m_MonteCarloCircle[value - 1];
-    minMaxPair = m_MonteCarloCirclePairs[value - 1];
-  }
-  else if (mode == MPMCDisplayWidget::ProjectionMode::Stereographic)
-  {
-    image = m_MonteCarloStereo[value - 1];
-    minMaxPair = m_MonteCarloStereoPairs[value - 1];
-  }
+    QMutexLocker locker(&m_ImagesMutex);
+    size_t index = static_cast<size_t>(value - 1);
+    if (mode == MPMCDisplayWidget::ProjectionMode::Lambert_Square && value > 0 && index < m_MonteCarloSquare.size())
+    {
+      image = m_MonteCarloSquare[index];
+      minMaxPair = m_MonteCarloSquarePairs[index];
+    }
+    else if (mode == MPMCDisplayWidget::ProjectionMode::Lambert_Circle && value > 0 && index < m_MonteCarloCircle.size())
+    {
+      image = m_MonteCarloCircle[index];
+      minMaxPair = m_MonteCarloCirclePairs[index];
+    }
+    else if (mode == MPMCDisplayWidget::ProjectionMode::Stereographic && value > 0 && index < m_MonteCarloStereo.size())
+    {
+      image = m_MonteCarloStereo[index];
+      minMaxPair = m_MonteCarloStereoPairs[index];
+    }
 
-  float keV = m_EkeVs->getValue(value - 1);
+    if (image.isNull() || m_EkeVs == FloatArrayType::NullPointer() || index >= m_EkeVs->getNumberOfTuples())
+    {
+      // This energy bin is still being read; it is displayed by energyBinImagesCreated once it is ready
+      m_PendingMCBin = value;
+      m_PendingMCMode = mode;
+      return;
+    }
+    m_PendingMCBin = 0;
+
+    keV = m_EkeVs->getValue(index);
+  }
 
   GLImageDisplayWidget::GLImageData imageData;
   imageData.image = image;
@@ -690,9 +1105,10 @@ void EMsoftController::updateMCImage(int value, MPMCDisplayWidget::ProjectionMod
 void EMsoftController::threadFinished()
 {
   m_NumOfFinishedThreads++;
-  if (m_NumOfFinishedThreads == QThreadPool::globalInstance()->maxThreadCount())
+  if (m_NumOfFinishedThreads == static_cast<size_t>(m_Watchers.size()))
   {
-    m_Cancel = false;
+    destroyDetector();
+    m_GenerationQueue = PatternGenerationQueue::NullPointer();
     emit generationFinished();
   }
 }
@@ -702,6 +1118,34 @@ void EMsoftController::threadFinished()
 // -----------------------------------------------------------------------------
 void EMsoftController::cancelGeneration()
 {
-  m_Cancel = true;
+  if (m_PatternGenerationPending)
+  {
+    // The run never started, so there are no threads that would report the end of it
+    m_PatternGenerationPending = false;
+    emit generationFinished();
+    return;
+  }
+
+  if (m_GenerationQueue != PatternGenerationQueue::NullPointer())
+  {
+    m_GenerationQueue->cancel();
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void EMsoftController::stopGeneration()
+{
+  if (m_GenerationQueue == PatternGenerationQueue::NullPointer()) { return; }
+
+  m_GenerationQueue->cancel();
+  for (int i = 0; i < m_Watchers.size(); i++)
+  {
+    m_Watchers[i]->disconnect(this);
+    m_Watchers[i]->waitForFinished();
+  }
+  m_Watchers.clear();
+  m_GenerationQueue = PatternGenerationQueue::NullPointer();
 }
 
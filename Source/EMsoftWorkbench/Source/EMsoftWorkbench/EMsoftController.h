@@ -38,10 +38,15 @@
 
 
 
+#include <cstring>
+
 #include <QtCore/QObject>
 #include <QtCore/QPair>
-#include <QtCore/QSemaphore>
+#include <QtCore/QAtomicInt>
+#include <QtCore/QFuture>
 #include <QtCore/QFutureWatcher>
+#include <QtCore/QMutex>
+#include <QtConcurrent/QtConcurrentRun>
 #include <QtGui/QImage>
 
 #include "H5Support/QH5Lite.h"
@@ -49,11 +54,14 @@
 #include "H5Support/HDF5ScopedFileSentinel.h"
 
 #include "SIMPLib/Math/SIMPLibMath.h"
+#include "SIMPLib/Math/ArrayPermute.hpp"
 #include "SIMPLib/Common/SIMPLibSetGetMacros.h"
 #include "SIMPLib/DataArrays/DataArray.hpp"
 
 
 #include "EMsoftWorkbench/MPMCDisplayWidget.h"
+#include "EMsoftWorkbench/PatternCache.h"
+#include "EMsoftWorkbench/PatternGenerationQueue.h"
 #include "EMsoftWorkbench/PatternDisplayWidget.h"
 
 class EMsoftController : public QObject
@@ -66,6 +74,17 @@ class EMsoftController : public QObject
 
     SIMPL_INSTANCE_PROPERTY(PatternDisplayWidget*, PatternDisplayWidget)
 
+    /**
+     * @brief The number of orientations that each thread hands to EMsoftLib in one call
+     */
+    SIMPL_INSTANCE_PROPERTY(size_t, PatternBlockSize)
+
+    /**
+     * @brief The maximum number of bytes of raw patterns that are kept so that the detector binning
+     * and the intensity scaling can be changed without generating the patterns again
+     */
+    SIMPL_INSTANCE_PROPERTY(size_t, PatternCacheSize)
+
     struct HeaderData
     {
       // EMheader/EBSDmaster
@@ -125,7 +144,8 @@ class EMsoftController : public QObject
 
     /**
      * @brief setMasterFilePath Sets a new master file.  Automatically reads the data from the master file
-     * into the EMsoftController
+     * into the EMsoftController.  The file is read on a separate thread and the images of each energy bin
+     * are created on the global thread pool as soon as that bin has been read.
      * @param masterFilePath
      */
     void setMasterFilePath(QString masterFilePath);
@@ -135,7 +155,8 @@ class EMsoftController : public QObject
 
   public slots:
     /**
-     * @brief generatePatternImage
+     * @brief generatePatternImages Starts generating the patterns of patternData.  While the master file is
+     * still loading the request is kept and started once the file has been read; a later request replaces it.
      * @param patternData
      * @param detectorData
      */
@@ -147,10 +168,19 @@ class EMsoftController : public QObject
      */
     void addPriorityIndex(size_t index);
 
+    /**
+     * @brief updatePatternImages Re-applies the detector binning and intensity scaling of patternData
+     * to the cached raw patterns, starting with the current row.  Patterns that are still being
+     * generated use the new values as well.
+     * @param patternData
+     */
+    void updatePatternImages(PatternDisplayWidget::PatternDisplayData patternData);
+
   signals:
     void updateEkeVs(FloatArrayType::Pointer ekeVs);
     void mpImageNeedsDisplayed(GLImageDisplayWidget::GLImageData);
     void mcImageNeedsDisplayed(GLImageDisplayWidget::GLImageData);
+    void patternImageNeedsDisplayed(int index, GLImageDisplayWidget::GLImageData);
     void mpKeVNeedsDisplayed(float keV);
     void mcKeVNeedsDisplayed(float keV);
     void imageRangeChanged(int min, int max);
@@ -169,17 +199,28 @@ class EMsoftController : public QObject
 
     void cancelGeneration();
 
+    /**
+     * @brief masterFileReadFinished Starts the pattern generation request that arrived while the master file was loading
+     */
+    void masterFileReadFinished();
+
+    /**
+     * @brief masterFileSizesRead Tells the viewers about the energy bins once the master file dimensions are known
+     * @param numOfEnergyBins
+     */
+    void masterFileSizesRead(int numOfEnergyBins);
+
+    /**
+     * @brief energyBinImagesCreated Displays a requested energy bin that was not ready when it was requested
+     */
+    void energyBinImagesCreated();
+
   private:
     QString                                   m_MasterFilePath;
     HeaderData                                m_HeaderData;
-    bool                                      m_Cancel = false;
-    QSemaphore                                m_NumOfFinishedPatternsLock;
-    size_t                                    m_NumOfFinishedPatterns = 0;
     size_t                                    m_NumOfFinishedThreads = 0;
 
-    QList<size_t>                             m_CurrentOrder;
-    QList<size_t>                             m_PriorityOrder;
-    QSemaphore                                m_CurrentOrderLock;
+    PatternGenerationQueue::Pointer           m_GenerationQueue;
 
     FloatArrayType::Pointer                   m_MasterLPNHData;
     std::vector<QImage>                       m_MasterLPNH;
@@ -211,8 +252,86 @@ class EMsoftController : public QObject
 
     FloatArrayType::Pointer                   m_EkeVs;
 
+    // Guards the image vectors, their min/max pairs, m_EkeVs and the pending bins while the master file is read
+    QMutex                                    m_ImagesMutex;
+    QFuture<void>                             m_MasterFileFuture;
+    QFutureWatcher<void>                      m_MasterFileWatcher;
+    QAtomicInt                                m_CancelMasterFileRead;
+    int                                       m_PendingMPBin = 0;
+    MPMCDisplayWidget::ProjectionMode         m_PendingMPMode = MPMCDisplayWidget::ProjectionMode::Lambert_Square;
+    int                                       m_PendingMCBin = 0;
+    MPMCDisplayWidget::ProjectionMode         m_PendingMCMode = MPMCDisplayWidget::ProjectionMode::Lambert_Square;
+
+    // A pattern generation request that waits for the master file to finish loading
+    bool                                      m_PatternGenerationPending = false;
+    PatternDisplayWidget::PatternDisplayData  m_PendingPatternData;
+    DetectorData                              m_PendingDetectorData;
+
     QVector< QSharedPointer<QFutureWatcher<void>> >           m_Watchers;
 
+    void*                                     m_Detector = nullptr;
+
+    // The raw patterns of the last generation run and the display values that are applied to them
+    PatternCache::Pointer                     m_PatternCache;
+    QMutex                                    m_PatternDisplayMutex;
+    PatternDisplayWidget::PatternDisplayData  m_PatternDisplayData;
+    int                                       m_PatternDisplayVersion = 0;
+    QVector<QFuture<void> >                   m_ReprocessFutures;
+
+    /**
+     * @brief getPatternDisplayData Returns a copy of the current display values
+     * @param patternData [output]
+     * @return The version of the display values, which changes every time they are updated
+     */
+    int getPatternDisplayData(PatternDisplayWidget::PatternDisplayData &patternData);
+
+    /**
+     * @brief displayPattern Applies the current display values to a raw pattern and sends the image
+     * to the pattern display widget.  It runs on the generation and reprocessing threads, so the image
+     * is delivered through the queued patternImageNeedsDisplayed signal.
+     * @param index
+     * @param rawPattern
+     * @param xDim
+     * @param yDim
+     * @param processedPattern Buffer for the processed pattern that the caller reuses between patterns
+     */
+    void displayPattern(size_t index, const float* rawPattern, size_t xDim, size_t yDim, FloatArrayType::Pointer &processedPattern);
+
+    /**
+     * @brief reprocessPatterns Displays every numOfTasks-th cached pattern of indices, starting at
+     * firstIndex, until the display values change again
+     * @param cache
+     * @param indices
+     * @param firstIndex
+     * @param numOfTasks
+     * @param version
+     */
+    void reprocessPatterns(PatternCache::Pointer cache, QVector<size_t> indices, int firstIndex, int numOfTasks, int version);
+
+    /**
+     * @brief stopReprocessing Stops re-applying the display values and waits for the tasks to finish
+     */
+    void stopReprocessing();
+
+    /**
+     * @brief destroyDetector Releases the EMsoftLib EBSD detector, if one exists
+     */
+    void destroyDetector();
+
+    /**
+     * @brief startPatternGeneration Starts a pattern generation run on the global thread pool.  The master
+     * file must have been read completely.
+     * @param patternData
+     * @param detectorData
+     */
+    void startPatternGeneration(PatternDisplayWidget::PatternDisplayData patternData, EMsoftController::DetectorData detectorData);
+
+    /**
+     * @brief stopGeneration Cancels the current pattern generation run, if there is one, and
+     * waits for its threads to finish
+     */
+    void stopGeneration();
+
     /**
      * @brief readDatasetDimensions
      * @param parentId
@@ -222,10 +341,21 @@ class EMsoftController : public QObject
     std::vector<hsize_t> readDatasetDimensions(hid_t parentId, QString objectName);
 
     /**
-     * @brief readMasterFile Reads data from the current master file
+     * @brief readMasterFile Reads data from the current master file.  This runs on its own thread.
      */
     void readMasterFile();
 
+    /**
+     * @brief stopReadingMasterFile Cancels the current master file read, if there is one, and waits for it to finish
+     */
+    void stopReadingMasterFile();
+
+    /**
+     * @brief resizeImages Resets all of the image vectors to zDim empty images.  The caller must hold m_ImagesMutex.
+     * @param zDim
+     */
+    void resizeImages(size_t zDim);
+
     /**
      * @brief readHeaderData Helper function that reads all the header data in the master file
      * @param fileId
@@ -233,42 +363,66 @@ class EMsoftController : public QObject
     void readHeaderData(hid_t fileId);
 
     /**
-     * @brief readMasterPatternData Helper function that reads all the master pattern data in the master file
-     * @param fileId
+     * @brief readMasterPatternData Helper function that reads the master pattern data in the master file one
+     * energy bin at a time and starts the image creation of each bin
+     * @param ebsdMasterId
+     * @param mLPNH_dims
+     * @param masterSPNH_dims
+     * @param futures [output] The image creation tasks
+     * @param h5Locker The caller's lock on H5AccessMutex; it is released briefly between energy bins
+     * @return
      */
-    void readMasterPatternData(hid_t fileId, size_t &currentCount, size_t &totalItems);
+    bool readMasterPatternData(hid_t ebsdMasterId, const std::vector<hsize_t> &mLPNH_dims, const std::vector<hsize_t> &masterSPNH_dims, QVector<QFuture<void> > &futures, QMutexLocker &h5Locker);
 
     /**
-     * @brief readMonteCarloData Helper function that reads all the monte carlo data in the master file
-     * @param fileId
+     * @brief createMasterPatternImages Creates the master pattern images of one energy bin
+     * @param z
+     * @param mLPNH_dims
+     * @param masterSPNH_dims
      */
-    void readMonteCarloData(hid_t fileId, size_t &currentCount, size_t &totalItems);
+    void createMasterPatternImages(size_t z, std::vector<hsize_t> mLPNH_dims, std::vector<hsize_t> masterSPNH_dims);
 
     /**
-     * @brief deHyperSlabData
+     * @brief readMonteCarloData Helper function that reads the monte carlo data in the master file and starts
+     * the image creation of each energy bin
+     * @param mcOpenCLId
+     * @param monteCarlo_dims
+     * @param futures [output] The image creation tasks
+     * @return
+     */
+    bool readMonteCarloData(hid_t mcOpenCLId, const std::vector<hsize_t> &monteCarlo_dims, QVector<QFuture<void> > &futures);
+
+    /**
+     * @brief createMonteCarloImages Creates the monte carlo images of one energy bin.  The bin is copied
+     * out of accum_e into a buffer of a single slice.
+     * @param z
+     * @param monteCarlo_dims
+     */
+    void createMonteCarloImages(size_t z, std::vector<hsize_t> monteCarlo_dims);
+
+    /**
+     * @brief deHyperSlabData Copies slice z of data, which is stored as (y, x, z) with z the fastest
+     * dimension, into a buffer of one slice.  Rows are stored top to bottom (y counts down) so that
+     * the image is not flipped.
      * @param data
+     * @param slice [output] Buffer of xDim*yDim values for slice z
+     * @param xDim
+     * @param yDim
+     * @param zDim
+     * @param z
      */
     template <typename T>
-    typename DataArray<T>::Pointer deHyperSlabData(typename DataArray<T>::Pointer data, hsize_t xDim, hsize_t yDim, hsize_t zDim)
+    void deHyperSlabData(const T* data, T* slice, hsize_t xDim, hsize_t yDim, hsize_t zDim, hsize_t z)
     {
-      typename DataArray<T>::Pointer newData = std::dynamic_pointer_cast<DataArray<T>>(data->deepCopy());
-      size_t currentIdx = 0;
-
-      for (int z = 0; z < zDim; z++)
-      {
-        for (int y = yDim - 1; y >= 0; y--)   // We count down in the y-direction so that the image isn't flipped
-        {
-          for (int x = 0; x < xDim; x++)
-          {
-            int index = (xDim*zDim*y) + (zDim*x) + z;
-            T value = data->getValue(index);
-            newData->setValue(currentIdx, value);
-            currentIdx++;
-          }
-        }
-      }
-
-      return newData;
+      if (xDim == 0 || yDim == 0) { return; }
+
+      // We count down in the y-direction so that the image isn't flipped.  The image tasks already run
+      // one slice per thread, so the copy stays on the calling thread.
+      ptrdiff_t rowStride = static_cast<ptrdiff_t>(xDim * zDim);
+      const T* first = data + (yDim - 1) * xDim * zDim + z;
+      std::vector<size_t> dims = { static_cast<size_t>(yDim), static_cast<size_t>(xDim) };
+      std::vector<ptrdiff_t> strides = { -rowStride, static_cast<ptrdiff_t>(zDim) };
+      ArrayPermute<T>::StridedCopy(first, dims, strides, slice, false);
     }
 
     /**
@@ -338,110 +492,284 @@ class EMsoftController : public QObject
     }
 
     /**
-     * @brief createImages
-     * @param data
-     * @param xDim
-     * @param yDim
-     * @param zDim
+     * @brief readArrayDatasetSlice Reads one index of one dimension of a dataset into its place in a
+     * buffer that holds the whole dataset.  Each plane below the sliced dimension is read as its own hyperslab.
+     * @param parentId
+     * @param objectName
+     * @param dims The dimensions of the dataset
+     * @param sliceDim The dimension that is sliced
+     * @param slice The index along sliceDim
+     * @param data The buffer for the whole dataset
      * @return
      */
     template <typename T>
-    std::vector<QImage> createImages(typename DataArray<T>::Pointer data, hsize_t xDim, hsize_t yDim, hsize_t zDim, std::vector<QPair<T,T> > &minMaxPairs)
+    bool readArrayDatasetSlice(hid_t parentId, QString objectName, const std::vector<hsize_t> &dims, size_t sliceDim, hsize_t slice, T* data)
     {
-      std::vector<QImage> images;
-
-      if (data->getNumberOfTuples() <= 0) { return images; }
+      size_t numOfPlanes = 1;
+      for (size_t i = 0; i < sliceDim; i++)
+      {
+        numOfPlanes = numOfPlanes * dims[i];
+      }
+      size_t planeSize = 1;
+      QVector<hsize_t> count(static_cast<int>(dims.size()), 1);
+      for (size_t i = sliceDim + 1; i < dims.size(); i++)
+      {
+        count[i] = dims[i];
+        planeSize = planeSize * dims[i];
+      }
 
-      for (int z = 0; z < zDim; z++)
+      QVector<hsize_t> offset(static_cast<int>(dims.size()), 0);
+      offset[sliceDim] = slice;
+      for (size_t plane = 0; plane < numOfPlanes; plane++)
       {
-        QPair<T,T> pair;
-        QImage image = createImage<T>(data, xDim, yDim, z, pair);
-        images.push_back(image);
-        minMaxPairs.push_back(pair);
+        // Unravel the plane number into the indices of the dimensions above the sliced one
+        size_t remainder = plane;
+        for (int i = static_cast<int>(sliceDim) - 1; i >= 0; i--)
+        {
+          offset[i] = remainder % dims[i];
+          remainder = remainder / dims[i];
+        }
+
+        T* planePtr = data + (plane * dims[sliceDim] + slice) * planeSize;
+        if (QH5Lite::readPointerDatasetHyperslab(parentId, objectName, offset, count, planePtr) < 0)
+        {
+          emit statusMsgGenerated(tr("Error: Could not read slice %1 of object '%2'").arg(slice).arg(objectName));
+          return false;
+        }
       }
 
-      return images;
+      return true;
     }
 
     /**
-     * @brief createImages
+     * @brief createImage Creates a grayscale image of slice zValue of data, scaled from its min/max value to 0-255
      * @param data
      * @param xDim
      * @param yDim
-     * @param zDim
+     * @param zValue
+     * @param minMaxPair [output] The min/max value of the slice
      * @return
      */
     template <typename T>
     QImage createImage(typename DataArray<T>::Pointer data, hsize_t xDim, hsize_t yDim, hsize_t zValue, QPair<T,T> &minMaxPair)
     {
-      T* dataPtr = data->getPointer(0);
-
       QImage image(xDim, yDim, QImage::Format_Grayscale8);
-      if (data->getNumberOfTuples() <= 0) { return image; }
+      if (data->getNumberOfTuples() <= 0 || xDim == 0 || yDim == 0) { return image; }
 
-      int firstIndex = yDim*xDim*zValue + xDim*0 + 0;
-      int lastIndex = yDim*xDim*zValue + xDim*(yDim - 1) + (xDim - 1);
-      T min = std::numeric_limits<T>::max(), max = std::numeric_limits<T>::min();
-      for (int i = firstIndex; i <= lastIndex; i++)
+      const T* slice = data->getPointer(0) + (xDim * yDim * zValue);
+      findMinMax<T>(slice, xDim * yDim, minMaxPair.first, minMaxPair.second);
+      quantizeToImage<T>(slice, xDim, yDim, minMaxPair.first, minMaxPair.second, image);
+
+      return image;
+    }
+
+    /**
+     * @brief createHemisphereImages Creates the images of slice zValue of the northern and southern
+     * hemisphere arrays, which have the same dimensions.  The min/max values of both slices are found
+     * in a single pass; each image is still scaled by its own min/max value.
+     * @param northData
+     * @param southData
+     * @param xDim
+     * @param yDim
+     * @param zValue
+     * @param northImage [output]
+     * @param northPair [output]
+     * @param southImage [output]
+     * @param southPair [output]
+     */
+    template <typename T>
+    void createHemisphereImages(typename DataArray<T>::Pointer northData, typename DataArray<T>::Pointer southData, hsize_t xDim, hsize_t yDim, hsize_t zValue,
+                                QImage &northImage, QPair<T,T> &northPair, QImage &southImage, QPair<T,T> &southPair)
+    {
+      northImage = QImage(xDim, yDim, QImage::Format_Grayscale8);
+      southImage = QImage(xDim, yDim, QImage::Format_Grayscale8);
+      if (northData->getNumberOfTuples() <= 0 || southData->getNumberOfTuples() <= 0 || xDim == 0 || yDim == 0) { return; }
+
+      const T* north = northData->getPointer(0) + (xDim * yDim * zValue);
+      const T* south = southData->getPointer(0) + (xDim * yDim * zValue);
+      findMinMax<T>(north, south, xDim * yDim, northPair.first, northPair.second, southPair.first, southPair.second);
+      quantizeToImage<T>(north, xDim, yDim, northPair.first, northPair.second, northImage);
+      quantizeToImage<T>(south, xDim, yDim, southPair.first, southPair.second, southImage);
+    }
+
+    /**
+     * @brief findMinMax Finds the min/max value of count values.  Eight independent running min/max
+     * values are kept so that the compiler can turn the loop into packed min/max instructions.
+     * @param data
+     * @param count Must be greater than 0
+     * @param min [output]
+     * @param max [output]
+     */
+    template <typename T>
+    static void findMinMax(const T* data, size_t count, T &min, T &max)
+    {
+      const size_t numOfLanes = 8;
+      T laneMin[numOfLanes], laneMax[numOfLanes];
+      for (size_t l = 0; l < numOfLanes; l++)
+      {
+        laneMin[l] = laneMax[l] = data[0];
+      }
+
+      size_t i = 0;
+      for (; i + numOfLanes <= count; i += numOfLanes)
       {
-        T value = dataPtr[i];
-        if (value < min)
+        for (size_t l = 0; l < numOfLanes; l++)
         {
-          min = dataPtr[i];
+          T value = data[i + l];
+          laneMin[l] = (value < laneMin[l]) ? value : laneMin[l];
+          laneMax[l] = (value > laneMax[l]) ? value : laneMax[l];
         }
-        if (value > max)
+      }
+      for (; i < count; i++)
+      {
+        laneMin[0] = (data[i] < laneMin[0]) ? data[i] : laneMin[0];
+        laneMax[0] = (data[i] > laneMax[0]) ? data[i] : laneMax[0];
+      }
+
+      for (size_t l = 1; l < numOfLanes; l++)
+      {
+        laneMin[0] = (laneMin[l] < laneMin[0]) ? laneMin[l] : laneMin[0];
+        laneMax[0] = (laneMax[l] > laneMax[0]) ? laneMax[l] : laneMax[0];
+      }
+
+      min = laneMin[0];
+      max = laneMax[0];
+    }
+
+    /**
+     * @brief findMinMax Finds the min/max values of two arrays of count values in the same pass
+     * @param a
+     * @param b
+     * @param count Must be greater than 0
+     * @param minA [output]
+     * @param maxA [output]
+     * @param minB [output]
+     * @param maxB [output]
+     */
+    template <typename T>
+    static void findMinMax(const T* a, const T* b, size_t count, T &minA, T &maxA, T &minB, T &maxB)
+    {
+      const size_t numOfLanes = 8;
+      T laneMinA[numOfLanes], laneMaxA[numOfLanes], laneMinB[numOfLanes], laneMaxB[numOfLanes];
+      for (size_t l = 0; l < numOfLanes; l++)
+      {
+        laneMinA[l] = laneMaxA[l] = a[0];
+        laneMinB[l] = laneMaxB[l] = b[0];
+      }
+
+      size_t i = 0;
+      for (; i + numOfLanes <= count; i += numOfLanes)
+      {
+        for (size_t l = 0; l < numOfLanes; l++)
         {
-          max = dataPtr[i];
+          T valueA = a[i + l];
+          T valueB = b[i + l];
+          laneMinA[l] = (valueA < laneMinA[l]) ? valueA : laneMinA[l];
+          laneMaxA[l] = (valueA > laneMaxA[l]) ? valueA : laneMaxA[l];
+          laneMinB[l] = (valueB < laneMinB[l]) ? valueB : laneMinB[l];
+          laneMaxB[l] = (valueB > laneMaxB[l]) ? valueB : laneMaxB[l];
         }
       }
+      for (; i < count; i++)
+      {
+        laneMinA[0] = (a[i] < laneMinA[0]) ? a[i] : laneMinA[0];
+        laneMaxA[0] = (a[i] > laneMaxA[0]) ? a[i] : laneMaxA[0];
+        laneMinB[0] = (b[i] < laneMinB[0]) ? b[i] : laneMinB[0];
+        laneMaxB[0] = (b[i] > laneMaxB[0]) ? b[i] : laneMaxB[0];
+      }
+
+      for (size_t l = 1; l < numOfLanes; l++)
+      {
+        laneMinA[0] = (laneMinA[l] < laneMinA[0]) ? laneMinA[l] : laneMinA[0];
+        laneMaxA[0] = (laneMaxA[l] > laneMaxA[0]) ? laneMaxA[l] : laneMaxA[0];
+        laneMinB[0] = (laneMinB[l] < laneMinB[0]) ? laneMinB[l] : laneMinB[0];
+        laneMaxB[0] = (laneMaxB[l] > laneMaxB[0]) ? laneMaxB[l] : laneMaxB[0];
+      }
 
-      minMaxPair.first = min;
-      minMaxPair.second = max;
+      minA = laneMinA[0];
+      maxA = laneMaxA[0];
+      minB = laneMinB[0];
+      maxB = laneMaxB[0];
+    }
 
-      for (int y = 0; y < yDim; y++)
+    /**
+     * @brief quantizeToImage Scales xDim * yDim values from min/max to 0-255 and writes them straight
+     * into the scan lines of a Format_Grayscale8 image
+     * @param data
+     * @param xDim
+     * @param yDim
+     * @param min
+     * @param max
+     * @param image
+     */
+    template <typename T>
+    static void quantizeToImage(const T* data, hsize_t xDim, hsize_t yDim, T min, T max, QImage &image)
+    {
+      if (max == min)
       {
-        for (int x = 0; x < xDim; x++)
+        // Matches the gray value that qRgb(value, value, value) used to produce
+        uchar value = static_cast<uchar>(static_cast<int>(min) & 0xff);
+        for (hsize_t y = 0; y < yDim; y++)
         {
-          int index = yDim*xDim*zValue + xDim*y + x;
-          T value = data->getValue(index);
-          if (max == min)
-          {
-            image.setPixel(x, y, qRgb(value, value, value));
-          }
-          else
-          {
-            float normalizedValue = (static_cast<float>(value - min)) / (static_cast<float>(max - min));
-            normalizedValue = normalizedValue * 255;
-            image.setPixel(x, y, qRgb(normalizedValue, normalizedValue, normalizedValue));
-          }
+          ::memset(image.scanLine(y), value, xDim);
         }
+        return;
       }
 
-      return image;
+      float range = static_cast<float>(max - min);
+      for (hsize_t y = 0; y < yDim; y++)
+      {
+        const T* row = data + (xDim * y);
+        uchar* line = image.scanLine(y);
+        for (hsize_t x = 0; x < xDim; x++)
+        {
+          float normalizedValue = (static_cast<float>(row[x] - min)) / range;
+          normalizedValue = normalizedValue * 255;
+          line[x] = static_cast<uchar>(normalizedValue);
+        }
+      }
     }
 
     /**
-     * @brief generatePatternImagesUsingThread
+     * @brief initializeGenericParameters Fills the ipar/fpar arrays used by the EMsoftLib EBSD pattern routines.
+     * The patterns are always computed unbinned and linear; the binning and gamma are applied afterwards.
      * @param patternData
      * @param detectorData
-     * @param indexOrder
+     * @param genericIParPtr
+     * @param genericFParPtr
      */
-    void generatePatternImagesUsingThread(PatternDisplayWidget::PatternDisplayData patternData, EMsoftController::DetectorData detectorData);
+    void initializeGenericParameters(PatternDisplayWidget::PatternDisplayData patternData, EMsoftController::DetectorData detectorData, Int32ArrayType::Pointer &genericIParPtr, FloatArrayType::Pointer &genericFParPtr);
 
     /**
-     * @brief generatePatternImage
-     * @param index
+     * @brief generatePatternImagesUsingThread
+     * @param patternData
+     * @param genericIParPtr
+     * @param genericFParPtr
+     * @param quaternions
+     * @param queue
+     */
+    void generatePatternImagesUsingThread(PatternDisplayWidget::PatternDisplayData patternData, Int32ArrayType::Pointer genericIParPtr, FloatArrayType::Pointer genericFParPtr, FloatArrayType::Pointer quaternions, PatternGenerationQueue::Pointer queue);
+
+    /**
+     * @brief convertEulersToQuaternions Converts all of the Euler angles to (scalar, vector) quaternions
      * @param eulerAngles
-     * @param genericLPNHPtr
-     * @param genericLPSHPtr
-     * @param genericAccum_ePtr
+     * @return
+     */
+    FloatArrayType::Pointer convertEulersToQuaternions(FloatArrayType::Pointer eulerAngles);
+
+    /**
+     * @brief generatePatternImageBlock Computes the patterns for a block of orientations in one EMsoftLib call,
+     * stores the raw patterns in the pattern cache and displays them
+     * @param indices
+     * @param quaternions
+     * @param genericQuaternionsPtr
      * @param genericEBSDPatternsPtr
      * @param genericIParPtr
      * @param genericFParPtr
-     * @param patternOrigin
+     * @param queue
      * @return
      */
-    bool generatePatternImage(size_t index, FloatArrayType::Pointer eulerAngles, FloatArrayType::Pointer genericLPNHPtr, FloatArrayType::Pointer genericLPSHPtr, Int32ArrayType::Pointer genericAccum_ePtr, FloatArrayType::Pointer genericEBSDPatternsPtr, Int32ArrayType::Pointer genericIParPtr, FloatArrayType::Pointer genericFParPtr, QString patternOrigin);
+    bool generatePatternImageBlock(const QVector<size_t> &indices, FloatArrayType::Pointer quaternions, FloatArrayType::Pointer genericQuaternionsPtr, FloatArrayType::Pointer genericEBSDPatternsPtr, Int32ArrayType::Pointer genericIParPtr, FloatArrayType::Pointer genericFParPtr, PatternGenerationQueue::Pointer queue);
 
     EMsoftController(const EMsoftController&);    // Copy Constructor Not Implemented
     void operator=(const EMsoftController&);  // Operator '=' Not Implemented
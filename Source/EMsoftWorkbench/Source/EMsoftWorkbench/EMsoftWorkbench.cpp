@@ -94,10 +94,14 @@ EMsoftWorkbench::EMsoftWorkbench(QString path, QWidget* parent) :
   m_Controller->setMasterFilePath(path);
   m_Controller->setPatternDisplayWidget(m_PatternDisplayWidget);
   connect(m_Controller, SIGNAL(newProgressBarMaximumValue(int)), m_PatternDisplayWidget, SLOT(setProgressBarMaximum(int)));
+  // The pattern images are created on the generation threads, so the queued connection has to copy the image data
+  qRegisterMetaType<GLImageDisplayWidget::GLImageData>("GLImageDisplayWidget::GLImageData");
+  connect(m_Controller, SIGNAL(patternImageNeedsDisplayed(int, GLImageDisplayWidget::GLImageData)), m_PatternDisplayWidget, SLOT(loadImage(int, GLImageDisplayWidget::GLImageData)), Qt::QueuedConnection);
   connect(m_Controller, SIGNAL(newProgressBarValue(int)), m_PatternDisplayWidget, SLOT(setProgressBarValue(int)), Qt::QueuedConnection);
   connect(m_Controller, SIGNAL(generationFinished()), m_PatternDisplayWidget, SLOT(generationFinished()));
   connect(m_PatternDisplayWidget, SIGNAL(cancelRequested()), m_Controller, SLOT(cancelGeneration()));
   connect(m_PatternDisplayWidget, SIGNAL(patternNeedsPriority(size_t)), m_Controller, SLOT(addPriorityIndex(size_t)));
+  connect(m_PatternDisplayWidget, SIGNAL(displayParametersChanged(PatternDisplayWidget::PatternDisplayData)), m_Controller, SLOT(updatePatternImages(PatternDisplayWidget::PatternDisplayData)));
 
   m_SingleAngleWidget = SingleAngleWidget::New();
   m_AngleReaderWidget = AngleReaderWidget::New();
@@ -40,14 +40,46 @@
 #include <QtCore/QMimeData>
 
 #include <QtGui/QDrag>
+#include <QtGui/QMatrix4x4>
 #include <QtGui/QMouseEvent>
-#include <QtGui/QPainter>
+#include <QtGui/QOpenGLContext>
+#include <QtGui/QOpenGLShaderProgram>
+#include <QtGui/QOpenGLTexture>
 
 #include <QtWidgets/QApplication>
 
 const float zoomOffset = 0.05f;
 const float bounceBackSpeed = 3.0f;
 
+namespace
+{
+  // A unit quad; the model-view-projection matrix scales and moves it to where the image is drawn
+  const GLfloat quadVertices[] = {
+    0.0f, 0.0f,
+    1.0f, 0.0f,
+    0.0f, 1.0f,
+    1.0f, 1.0f
+  };
+
+  const char* vertexShaderSource =
+      "attribute highp vec2 vertex;\n"
+      "uniform highp mat4 matrix;\n"
+      "varying highp vec2 texCoord;\n"
+      "void main()\n"
+      "{\n"
+      "  texCoord = vertex;\n"
+      "  gl_Position = matrix * vec4(vertex, 0.0, 1.0);\n"
+      "}\n";
+
+  const char* fragmentShaderSource =
+      "uniform sampler2D image;\n"
+      "varying highp vec2 texCoord;\n"
+      "void main()\n"
+      "{\n"
+      "  gl_FragColor = texture2D(image, texCoord);\n"
+      "}\n";
+}
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -62,7 +94,7 @@ GLImageViewer::GLImageViewer(QWidget *parent, Qt::WindowFlags windowFlags) :
 // -----------------------------------------------------------------------------
 GLImageViewer::~GLImageViewer()
 {
-
+  cleanupGL();
 }
 
 // -----------------------------------------------------------------------------
@@ -187,19 +219,101 @@ void GLImageViewer::fitToScreen()
 // -----------------------------------------------------------------------------
 void GLImageViewer::initializeGL()
 {
-  std::cout << "";
+  initializeOpenGLFunctions();
+
+  // The context can be destroyed and recreated when the widget is reparented
+  connect(context(), SIGNAL(aboutToBeDestroyed()), this, SLOT(cleanupGL()), Qt::UniqueConnection);
+
+  m_Program = new QOpenGLShaderProgram();
+  if (m_Program->addShaderFromSourceCode(QOpenGLShader::Vertex, vertexShaderSource) == false
+      || m_Program->addShaderFromSourceCode(QOpenGLShader::Fragment, fragmentShaderSource) == false)
+  {
+    std::cout << "GLImageViewer: Unable to compile the image shaders: " << m_Program->log().toStdString() << std::endl;
+  }
+  m_Program->bindAttributeLocation("vertex", 0);
+  if (m_Program->link() == false)
+  {
+    std::cout << "GLImageViewer: Unable to link the image shaders: " << m_Program->log().toStdString() << std::endl;
+  }
+
+  m_QuadBuffer.create();
+  m_QuadBuffer.bind();
+  m_QuadBuffer.allocate(quadVertices, sizeof(quadVertices));
+
+  // Vertex array objects are not available on every OpenGL 2 implementation; without one the
+  // attributes are set up again before every draw
+  if (m_QuadVAO.create() == true)
+  {
+    QOpenGLVertexArrayObject::Binder vaoBinder(&m_QuadVAO);
+    setupQuadAttributes();
+  }
+  m_QuadBuffer.release();
+
+  // The texture of the current image belonged to the previous context, if there was one
+  m_TextureNeedsUpload = true;
 }
 
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-void GLImageViewer::paintGL()
+void GLImageViewer::setupQuadAttributes()
+{
+  m_QuadBuffer.bind();
+  glEnableVertexAttribArray(0);
+  glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 2 * sizeof(GLfloat), nullptr);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void GLImageViewer::cleanupGL()
+{
+  if (m_Program == nullptr) { return; }
+
+  makeCurrent();
+  delete m_Texture;
+  m_Texture = nullptr;
+  m_QuadVAO.destroy();
+  m_QuadBuffer.destroy();
+  delete m_Program;
+  m_Program = nullptr;
+  doneCurrent();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void GLImageViewer::uploadTexture()
 {
+  delete m_Texture;
+  m_Texture = nullptr;
+  m_TextureNeedsUpload = false;
+
   if (m_CurrentImage.isNull()) { return; }
 
-  QPainter painter;
-  painter.begin(this);
-  painter.setRenderHints(QPainter::Antialiasing | QPainter::TextAntialiasing);
+  // Row 0 of the image becomes texture row 0, which the quad maps to the top of the viewer
+  m_Texture = new QOpenGLTexture(m_CurrentImage, QOpenGLTexture::GenerateMipMaps);
+  m_Texture->setMinificationFilter(QOpenGLTexture::LinearMipMapLinear);
+  m_Texture->setMagnificationFilter(QOpenGLTexture::Linear);
+  m_Texture->setWrapMode(QOpenGLTexture::ClampToEdge);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void GLImageViewer::paintGL()
+{
+  QColor background = palette().color(QPalette::Window);
+  glClearColor(background.redF(), background.greenF(), background.blueF(), 1.0f);
+  glClear(GL_COLOR_BUFFER_BIT);
+
+  if (m_TextureNeedsUpload == true)
+  {
+    uploadTexture();
+  }
+
+  if (m_CurrentImage.isNull() || m_Texture == nullptr || m_Program == nullptr) { return; }
+
   bool needsRepaint = false;
 
 //  QPoint mouseCoords = mapFromGlobal(QCursor::pos());
@@ -229,8 +343,6 @@ void GLImageViewer::paintGL()
   int sceneWidth = m_ViewportWidth;
   int sceneHeight = m_ViewportHeight;
 
-  QImage image = m_CurrentImage.scaled(newWidth, newHeight);
-
   int x, y, dx, dy, sx, sy;
   if (newWidth > sceneWidth && newHeight > sceneHeight)
   {
@@ -320,9 +432,34 @@ void GLImageViewer::paintGL()
     setCursor(Qt::ArrowCursor);
   }
 
-  painter.drawImage(x, y, image, sx, sy, newWidth, newHeight);
+  // Draw the whole zoomed image with its top left corner at (x - sx, y - sy); anything outside of
+  // the viewport is clipped.  The hardware does the scaling and filtering.
+  QMatrix4x4 matrix;
+  matrix.ortho(0.0f, static_cast<float>(width()), static_cast<float>(height()), 0.0f, -1.0f, 1.0f);
+  matrix.translate(static_cast<float>(x - sx), static_cast<float>(y - sy));
+  matrix.scale(static_cast<float>(newWidth), static_cast<float>(newHeight));
+
+  m_Program->bind();
+  m_Program->setUniformValue("matrix", matrix);
+  m_Program->setUniformValue("image", 0);
+
+  glActiveTexture(GL_TEXTURE0);
+  m_Texture->bind();
+
+  if (m_QuadVAO.isCreated() == true)
+  {
+    QOpenGLVertexArrayObject::Binder vaoBinder(&m_QuadVAO);
+    glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+  }
+  else
+  {
+    setupQuadAttributes();
+    glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+    m_QuadBuffer.release();
+  }
 
-  painter.end();
+  m_Texture->release();
+  m_Program->release();
 
   if (needsRepaint == true)
   {
@@ -336,6 +473,7 @@ void GLImageViewer::paintGL()
 void GLImageViewer::loadImage(const QImage &img)
 {
   m_CurrentImage = img;
+  m_TextureNeedsUpload = true;
   m_DefaultControls = true;
   update();
 }
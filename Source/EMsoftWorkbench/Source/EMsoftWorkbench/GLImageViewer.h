@@ -36,9 +36,22 @@
 #ifndef glimageviewer_h
 #define glimageviewer_h
 
+#include <QtGui/QOpenGLBuffer>
+#include <QtGui/QOpenGLFunctions>
+#include <QtGui/QOpenGLVertexArrayObject>
+
 #include <QtWidgets/QOpenGLWidget>
 
-class GLImageViewer : public QOpenGLWidget
+class QOpenGLShaderProgram;
+class QOpenGLTexture;
+
+/**
+ * @brief The GLImageViewer class displays an image as an OpenGL texture.  The image is uploaded
+ * once, when loadImage() is called, and zooming and panning only change the transform of the
+ * textured quad.  The shaders are GLSL 1.10/ES 2.0 so that the viewer also runs on software
+ * renderers such as Mesa's llvmpipe.
+ */
+class GLImageViewer : public QOpenGLWidget, protected QOpenGLFunctions
 {
     Q_OBJECT
 public:
@@ -60,6 +73,14 @@ protected:
     void paintGL() Q_DECL_OVERRIDE;
     void initializeGL() Q_DECL_OVERRIDE;
 
+protected slots:
+    /**
+     * @brief cleanupGL Releases the OpenGL resources before the context is destroyed
+     */
+    void cleanupGL();
+
+protected:
+
     void enterEvent(QEvent* event) Q_DECL_OVERRIDE;
     void leaveEvent(QEvent* event) Q_DECL_OVERRIDE;
     void mousePressEvent(QMouseEvent* event) Q_DECL_OVERRIDE;
@@ -83,6 +104,15 @@ private:
     int           m_ViewportHeight = 0;
     bool          m_DefaultControls = true;
 
+    QOpenGLShaderProgram*       m_Program = nullptr;
+    QOpenGLTexture*             m_Texture = nullptr;
+    QOpenGLBuffer               m_QuadBuffer;
+    QOpenGLVertexArrayObject    m_QuadVAO;
+    bool                        m_TextureNeedsUpload = false;
+
+    void uploadTexture();
+    void setupQuadAttributes();
+
     void zoomIn();
     void zoomOut();
     void fitToScreen();
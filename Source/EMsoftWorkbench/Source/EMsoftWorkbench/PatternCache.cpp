@@ -0,0 +1,275 @@
+/* ============================================================================
+* Copyright (c) 2009-2017 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+
+#include "PatternCache.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#include <QtCore/QMutexLocker>
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+PatternCache::PatternCache(size_t xDim, size_t yDim, size_t maxBytes) :
+  m_XDim(xDim),
+  m_YDim(yDim),
+  m_MaxBytes(maxBytes)
+{
+
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+PatternCache::~PatternCache()
+{
+
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+PatternCache::Pointer PatternCache::New(size_t xDim, size_t yDim, size_t maxBytes)
+{
+  Pointer sharedPtr(new PatternCache(xDim, yDim, maxBytes));
+  return sharedPtr;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void PatternCache::insert(size_t index, const float* pattern)
+{
+  size_t patternBytes = m_XDim * m_YDim * sizeof(float);
+  if (pattern == nullptr || patternBytes == 0 || patternBytes > m_MaxBytes) { return; }
+
+  // Copy outside of the lock; the generation threads insert whole blocks at a time
+  FloatArrayType::Pointer copy = FloatArrayType::CreateArray(m_XDim * m_YDim, QVector<size_t>(1, 1), "RawPattern");
+  ::memcpy(copy->getPointer(0), pattern, patternBytes);
+
+  QMutexLocker locker(&m_Mutex);
+
+  m_EvictedIndices.erase(index);
+
+  std::map<size_t, Entry>::iterator iter = m_Entries.find(index);
+  if (iter != m_Entries.end())
+  {
+    iter->second.pattern = copy;
+    m_Usage.splice(m_Usage.begin(), m_Usage, iter->second.usage);
+    return;
+  }
+
+  while (m_NumOfBytes + patternBytes > m_MaxBytes && m_Usage.empty() == false)
+  {
+    m_EvictedIndices.insert(m_Usage.back());
+    m_Entries.erase(m_Usage.back());
+    m_Usage.pop_back();
+    m_NumOfBytes -= patternBytes;
+  }
+
+  m_Usage.push_front(index);
+  Entry entry;
+  entry.pattern = copy;
+  entry.usage = m_Usage.begin();
+  m_Entries[index] = entry;
+  m_NumOfBytes += patternBytes;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+FloatArrayType::Pointer PatternCache::value(size_t index)
+{
+  QMutexLocker locker(&m_Mutex);
+
+  std::map<size_t, Entry>::iterator iter = m_Entries.find(index);
+  if (iter == m_Entries.end()) { return FloatArrayType::NullPointer(); }
+
+  m_Usage.splice(m_Usage.begin(), m_Usage, iter->second.usage);
+  return iter->second.pattern;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QVector<size_t> PatternCache::indices()
+{
+  QMutexLocker locker(&m_Mutex);
+
+  QVector<size_t> indices;
+  indices.reserve(static_cast<int>(m_Usage.size()));
+  for (std::list<size_t>::const_iterator iter = m_Usage.begin(); iter != m_Usage.end(); ++iter)
+  {
+    indices.push_back(*iter);
+  }
+  return indices;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QVector<size_t> PatternCache::takeEvictedIndices()
+{
+  QMutexLocker locker(&m_Mutex);
+
+  QVector<size_t> indices;
+  indices.reserve(static_cast<int>(m_EvictedIndices.size()));
+  for (std::set<size_t>::const_iterator iter = m_EvictedIndices.begin(); iter != m_EvictedIndices.end(); ++iter)
+  {
+    indices.push_back(*iter);
+  }
+  m_EvictedIndices.clear();
+  return indices;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void PatternCache::clear()
+{
+  QMutexLocker locker(&m_Mutex);
+  m_Entries.clear();
+  m_Usage.clear();
+  m_EvictedIndices.clear();
+  m_NumOfBytes = 0;
+}
+
+namespace
+{
+  /**
+   * @brief Sums the binning x binning blocks of one row of blocks into out.  Each block is added
+   * row by row, in the same order as the Fortran sum() over the block.  The binning is a template
+   * parameter for the common detector binning values, which unrolls the block loop and leaves a
+   * fixed stride loop over the output pixels that the compiler can vectorise.
+   */
+  template<size_t Binning>
+  void binBlockRow(const float* rows, size_t xDim, size_t binnedXDim, float* out)
+  {
+    for (size_t dy = 0; dy < Binning; dy++)
+    {
+      const float* row = rows + dy * xDim;
+      for (size_t xb = 0; xb < binnedXDim; xb++)
+      {
+        float sum = out[xb];
+        for (size_t dx = 0; dx < Binning; dx++)
+        {
+          sum += row[xb * Binning + dx];
+        }
+        out[xb] = sum;
+      }
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void binBlockRow(const float* rows, size_t xDim, size_t binnedXDim, size_t binning, float* out)
+  {
+    for (size_t dy = 0; dy < binning; dy++)
+    {
+      const float* row = rows + dy * xDim;
+      for (size_t xb = 0; xb < binnedXDim; xb++)
+      {
+        const float* block = row + xb * binning;
+        float sum = out[xb];
+        for (size_t dx = 0; dx < binning; dx++)
+        {
+          sum += block[dx];
+        }
+        out[xb] = sum;
+      }
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+FloatArrayType::Pointer PatternCache::ProcessPattern(const float* pattern, size_t xDim, size_t yDim, size_t binning, float gamma, FloatArrayType::Pointer buffer)
+{
+  if (binning == 0) { binning = 1; }
+  size_t binnedXDim = xDim / binning;
+  size_t binnedYDim = yDim / binning;
+  size_t count = binnedXDim * binnedYDim;
+
+  FloatArrayType::Pointer processedPtr = buffer;
+  if (processedPtr == FloatArrayType::NullPointer() || processedPtr->getNumberOfTuples() != count)
+  {
+    processedPtr = FloatArrayType::CreateArray(count, QVector<size_t>(1, 1), "ProcessedPattern");
+  }
+  if (count == 0) { return processedPtr; }
+  float* processed = processedPtr->getPointer(0);
+
+  if (binning == 1)
+  {
+    ::memcpy(processed, pattern, xDim * yDim * sizeof(float));
+  }
+  else
+  {
+    // Sum each block, then divide by the block size
+    float binScale = 1.0f / static_cast<float>(binning * binning);
+    for (size_t yb = 0; yb < binnedYDim; yb++)
+    {
+      const float* rows = pattern + yb * binning * xDim;
+      float* out = processed + yb * binnedXDim;
+      std::fill(out, out + binnedXDim, 0.0f);
+      switch (binning)
+      {
+        case 2: binBlockRow<2>(rows, xDim, binnedXDim, out); break;
+        case 4: binBlockRow<4>(rows, xDim, binnedXDim, out); break;
+        case 8: binBlockRow<8>(rows, xDim, binnedXDim, out); break;
+        default: binBlockRow(rows, xDim, binnedXDim, binning, out); break;
+      }
+      for (size_t xb = 0; xb < binnedXDim; xb++)
+      {
+        out[xb] = out[xb] * binScale;
+      }
+    }
+  }
+
+  // std::pow stays a scalar call so that the result matches the EMsoftLib routines exactly
+  if (gamma != 1.0f)
+  {
+    for (size_t i = 0; i < count; i++)
+    {
+      processed[i] = std::pow(processed[i], gamma);
+    }
+  }
+
+  return processedPtr;
+}
@@ -0,0 +1,149 @@
+/* ============================================================================
+* Copyright (c) 2009-2017 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+
+#ifndef _patterncache_h_
+#define _patterncache_h_
+
+#include <list>
+#include <map>
+#include <set>
+
+#include <QtCore/QMutex>
+#include <QtCore/QVector>
+
+#include "SIMPLib/Common/SIMPLibSetGetMacros.h"
+#include "SIMPLib/DataArrays/DataArray.hpp"
+
+/**
+ * @brief The PatternCache class keeps the raw, linear (unbinned and unscaled) EBSD patterns
+ * of a generation run so that the display parameters (detector binning and gamma scaling) can
+ * be re-applied without running the simulation again.  The cache is bounded by a byte budget;
+ * the least recently used patterns are evicted first.  All methods are thread safe.
+ */
+class PatternCache
+{
+  public:
+    SIMPL_SHARED_POINTERS(PatternCache)
+
+    /**
+     * @brief New
+     * @param xDim The width of the raw patterns
+     * @param yDim The height of the raw patterns
+     * @param maxBytes The maximum number of bytes of pattern data that is kept
+     * @return
+     */
+    static Pointer New(size_t xDim, size_t yDim, size_t maxBytes);
+
+    virtual ~PatternCache();
+
+    SIMPL_GET_PROPERTY(size_t, XDim)
+    SIMPL_GET_PROPERTY(size_t, YDim)
+    SIMPL_GET_PROPERTY(size_t, MaxBytes)
+
+    /**
+     * @brief insert Copies a raw pattern of xDim * yDim values into the cache
+     * @param index The index of the pattern
+     * @param pattern
+     */
+    void insert(size_t index, const float* pattern);
+
+    /**
+     * @brief value Returns the raw pattern at index, or a null pointer if the pattern is not
+     * in the cache.  The returned array must not be modified.
+     * @param index
+     * @return
+     */
+    FloatArrayType::Pointer value(size_t index);
+
+    /**
+     * @brief indices Returns the indices of all of the cached patterns, most recently used first
+     * @return
+     */
+    QVector<size_t> indices();
+
+    /**
+     * @brief takeEvictedIndices Returns the indices of the patterns that were evicted since the last
+     * call, and that have not been inserted again
+     * @return
+     */
+    QVector<size_t> takeEvictedIndices();
+
+    /**
+     * @brief clear Removes all of the patterns from the cache
+     */
+    void clear();
+
+    /**
+     * @brief ProcessPattern Applies the detector binning and the gamma scaling to a raw pattern,
+     * in the same way as the EMsoftLib pattern routines do: each binning x binning block is summed,
+     * divided by the number of pixels in the block and raised to the power gamma.
+     * @param pattern The raw pattern
+     * @param xDim
+     * @param yDim
+     * @param binning The detector binning factor
+     * @param gamma The gamma value; 1 is linear scaling
+     * @param buffer Optional array that is reused for the result when it has the right size, so that
+     * a thread processing many patterns allocates only once
+     * @return The processed pattern, of size (xDim / binning) * (yDim / binning)
+     */
+    static FloatArrayType::Pointer ProcessPattern(const float* pattern, size_t xDim, size_t yDim, size_t binning, float gamma,
+                                                  FloatArrayType::Pointer buffer = FloatArrayType::NullPointer());
+
+  protected:
+    PatternCache(size_t xDim, size_t yDim, size_t maxBytes);
+
+  private:
+    struct Entry
+    {
+      FloatArrayType::Pointer pattern;
+      std::list<size_t>::iterator usage;
+    };
+
+    size_t                                    m_XDim;
+    size_t                                    m_YDim;
+    size_t                                    m_MaxBytes;
+
+    QMutex                                    m_Mutex;
+    std::map<size_t, Entry>                   m_Entries;
+    std::list<size_t>                         m_Usage;  // Most recently used first
+    std::set<size_t>                          m_EvictedIndices;
+    size_t                                    m_NumOfBytes = 0;
+
+    PatternCache(const PatternCache&);    // Copy Constructor Not Implemented
+    void operator=(const PatternCache&);  // Operator '=' Not Implemented
+};
+
+#endif /* _patterncache_h_ */
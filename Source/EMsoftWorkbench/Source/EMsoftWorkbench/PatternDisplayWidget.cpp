@@ -36,6 +36,7 @@
 #include "PatternDisplayWidget.h"
 
 #include <QtCore/QSignalMapper>
+#include <QtCore/QThread>
 
 #include <QtWidgets/QMenu>
 #include <QtWidgets/QFileDialog>
@@ -199,7 +200,8 @@ void PatternDisplayWidget::detectorBinning_selectionChanged()
   size_t detectorBinValue = getDetectorBinningValue();
   detectorBinningBtn->setText(tr("%1: %2").arg(PatternDisplayWidget::DetBinLabel).arg(detectorBinValue));
 
-  displayImage(patternListView->currentIndex().row());
+  // The binning is applied to the cached raw patterns, so the patterns do not need to be generated again
+  emit displayParametersChanged(getPatternDisplayData());
 }
 
 // -----------------------------------------------------------------------------
@@ -225,6 +227,8 @@ void PatternDisplayWidget::patternScaling_selectionChanged()
   bool gammaIsOn = (patternScaling == PatternDisplayWidget::GammaScaling);
   gammaSpinBox->setEnabled(gammaIsOn);
   gammaLabel->setEnabled(gammaIsOn);
+
+  emit displayParametersChanged(getPatternDisplayData());
 }
 
 // -----------------------------------------------------------------------------
@@ -315,6 +319,8 @@ void PatternDisplayWidget::on_generateBtn_pressed()
 void PatternDisplayWidget::on_gammaSpinBox_valueChanged(double value)
 {
   m_NewPatternDisplayData.gammaValue = value;
+
+  emit displayParametersChanged(getPatternDisplayData());
 }
 
 // -----------------------------------------------------------------------------
@@ -390,6 +396,8 @@ void PatternDisplayWidget::setProgressBarMaximum(int value)
 // -----------------------------------------------------------------------------
 void PatternDisplayWidget::loadImage(int index, GLImageDisplayWidget::GLImageData data)
 {
+  Q_ASSERT(QThread::currentThread() == thread());
+
   if (index > m_LoadedImageData.size() - 1 || index < 0) { return; }
 
   m_LoadedImageData[index] = data;
@@ -437,8 +445,6 @@ void PatternDisplayWidget::displayImage(GLImageDisplayWidget::GLImageData imageD
     {
       imageData.image = imageData.image.mirrored(true, false);
     }
-
-    imageData.image = imageData.image.scaled(imageData.image.width() / displayData.detectorBinningValue, imageData.image.height() / displayData.detectorBinningValue);
   }
 
   minLabel->setText(QString::number(imageData.minValue));
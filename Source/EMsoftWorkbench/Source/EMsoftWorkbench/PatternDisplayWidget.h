@@ -113,7 +113,8 @@ class PatternDisplayWidget : public GLImageDisplayWidget, public Ui::PatternDisp
 
   public slots:
     /**
-     * @brief loadImage
+     * @brief loadImage Stores the image of a pattern and displays it if it is the current one.
+     * This must only be called on the GUI thread; worker threads reach it through a queued connection.
      * @param index
      * @param data
      */
@@ -210,6 +211,13 @@ class PatternDisplayWidget : public GLImageDisplayWidget, public Ui::PatternDisp
     void cancelRequested();
     void patternNeedsPriority(size_t index);
 
+    /**
+     * @brief displayParametersChanged Emitted when the detector binning or the intensity scaling
+     * changes; these are applied to the already generated patterns
+     * @param patternData
+     */
+    void displayParametersChanged(PatternDisplayWidget::PatternDisplayData patternData);
+
   private slots:
     void generationFinished();
 
@@ -0,0 +1,175 @@
+/* ============================================================================
+* Copyright (c) 2009-2017 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include "PatternGenerationQueue.h"
+
+#include <QtCore/QMutexLocker>
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+PatternGenerationQueue::PatternGenerationQueue()
+{
+
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+PatternGenerationQueue::~PatternGenerationQueue()
+{
+
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void PatternGenerationQueue::addIndex(size_t index)
+{
+  QMutexLocker locker(&m_Mutex);
+
+  if (index >= m_States.size())
+  {
+    m_States.resize(index + 1, IndexState::Unknown);
+  }
+  if (m_States[index] == IndexState::Waiting) { return; }
+
+  m_States[index] = IndexState::Waiting;
+  m_Order.push_back(index);
+  m_NumOfWaitingIndices++;
+
+  m_IndicesAvailable.wakeOne();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool PatternGenerationQueue::promoteIndex(size_t index)
+{
+  QMutexLocker locker(&m_Mutex);
+
+  if (index >= m_States.size() || m_States[index] != IndexState::Waiting) { return false; }
+
+  // The index stays in m_Order as well; takeIndices() skips entries that have already been handed out
+  m_PriorityOrder.push_front(index);
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void PatternGenerationQueue::close()
+{
+  QMutexLocker locker(&m_Mutex);
+  m_Closed = true;
+  m_IndicesAvailable.wakeAll();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void PatternGenerationQueue::cancel()
+{
+  QMutexLocker locker(&m_Mutex);
+  m_Cancel = true;
+  m_IndicesAvailable.wakeAll();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool PatternGenerationQueue::isCancelled()
+{
+  QMutexLocker locker(&m_Mutex);
+  return m_Cancel;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool* PatternGenerationQueue::getCancelFlag()
+{
+  return &m_Cancel;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool PatternGenerationQueue::takeIndices(size_t maxCount, QVector<size_t> &indices)
+{
+  indices.clear();
+
+  QMutexLocker locker(&m_Mutex);
+
+  while (m_NumOfWaitingIndices == 0 && m_Closed == false && m_Cancel == false)
+  {
+    m_IndicesAvailable.wait(&m_Mutex);
+  }
+
+  if (m_Cancel == true || m_NumOfWaitingIndices == 0) { return false; }
+
+  while (static_cast<size_t>(indices.size()) < maxCount && m_NumOfWaitingIndices > 0)
+  {
+    size_t index;
+    if (m_PriorityOrder.empty() == false)
+    {
+      index = m_PriorityOrder.front();
+      m_PriorityOrder.pop_front();
+    }
+    else
+    {
+      index = m_Order.front();
+      m_Order.pop_front();
+    }
+
+    if (m_States[index] != IndexState::Waiting) { continue; }
+
+    m_States[index] = IndexState::Taken;
+    m_NumOfWaitingIndices--;
+    indices.push_back(index);
+  }
+
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+size_t PatternGenerationQueue::finishIndices(size_t count)
+{
+  QMutexLocker locker(&m_Mutex);
+  m_NumOfFinishedIndices += count;
+  return m_NumOfFinishedIndices;
+}
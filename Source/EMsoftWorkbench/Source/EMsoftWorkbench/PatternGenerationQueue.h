@@ -0,0 +1,145 @@
+/* ============================================================================
+* Copyright (c) 2009-2017 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#ifndef _patterngenerationqueue_h_
+#define _patterngenerationqueue_h_
+
+#include <deque>
+#include <vector>
+
+#include <QtCore/QMutex>
+#include <QtCore/QVector>
+#include <QtCore/QWaitCondition>
+
+#include "SIMPLib/Common/SIMPLibSetGetMacros.h"
+
+/**
+ * @brief The PatternGenerationQueue class hands out pattern indices to the pattern
+ * generation threads.  Threads block in takeIndices() until work is available, so
+ * idle threads do not use any CPU time.  Indices can be promoted so that they are
+ * handed out next, and the whole queue can be cancelled.  One queue is created per
+ * generation run, so the queue also serves as the cancellation token for that run.
+ */
+class PatternGenerationQueue
+{
+  public:
+    SIMPL_SHARED_POINTERS(PatternGenerationQueue)
+    SIMPL_STATIC_NEW_MACRO(PatternGenerationQueue)
+
+    virtual ~PatternGenerationQueue();
+
+    /**
+     * @brief addIndex Appends an index to the end of the queue
+     * @param index
+     */
+    void addIndex(size_t index);
+
+    /**
+     * @brief promoteIndex Moves an index to the front of the queue, so that it is handed out next
+     * @param index
+     * @return True if the index was still waiting to be handed out
+     */
+    bool promoteIndex(size_t index);
+
+    /**
+     * @brief close Signals that no more indices will be added.  Threads waiting in
+     * takeIndices() return once the queue is empty.
+     */
+    void close();
+
+    /**
+     * @brief cancel Cancels the queue; takeIndices() returns false from now on
+     */
+    void cancel();
+
+    /**
+     * @brief isCancelled
+     * @return
+     */
+    bool isCancelled();
+
+    /**
+     * @brief getCancelFlag Returns the cancel flag in the form that the EMsoftLib routines expect.
+     * The flag is a plain bool because the Fortran pattern loop reads it as a character(1) through the
+     * C interface.  It is only written by cancel(), under the queue mutex, and only ever goes from false
+     * to true, so the one-byte race with the Fortran reader is benign: the loop checks the flag once for
+     * every orientation and stops at most one orientation after the write becomes visible.
+     * @return
+     */
+    bool* getCancelFlag();
+
+    /**
+     * @brief takeIndices Takes up to maxCount indices from the queue, blocking while the
+     * queue is empty but still open
+     * @param maxCount
+     * @param indices
+     * @return False if the queue has been cancelled, or has been closed and is empty
+     */
+    bool takeIndices(size_t maxCount, QVector<size_t> &indices);
+
+    /**
+     * @brief finishIndices Records that count indices have been completed
+     * @param count
+     * @return The total number of completed indices
+     */
+    size_t finishIndices(size_t count);
+
+  protected:
+    PatternGenerationQueue();
+
+  private:
+    enum class IndexState : unsigned char
+    {
+      Unknown,
+      Waiting,
+      Taken
+    };
+
+    QMutex                                    m_Mutex;
+    QWaitCondition                            m_IndicesAvailable;
+
+    std::deque<size_t>                        m_Order;
+    std::deque<size_t>                        m_PriorityOrder;
+    std::vector<IndexState>                   m_States;
+    size_t                                    m_NumOfWaitingIndices = 0;
+    size_t                                    m_NumOfFinishedIndices = 0;
+    bool                                      m_Closed = false;
+    bool                                      m_Cancel = false;
+
+    PatternGenerationQueue(const PatternGenerationQueue&);    // Copy Constructor Not Implemented
+    void operator=(const PatternGenerationQueue&);  // Operator '=' Not Implemented
+};
+
+#endif /* _patterngenerationqueue_h_ */
@@ -41,6 +41,7 @@
 #include "SIMPLib/DataArrays/DataArray.hpp"
 
 #include "OrientationLib/Utilities/ModifiedLambertProjection.h"
+#include "OrientationLib/Utilities/ModifiedLambertProjectionPlan.h"
 
 class ProjectionConversions : public QObject
 {
@@ -55,20 +56,26 @@ public:
                                                        ModifiedLambertProjection::ProjectionType projType, size_t zValue = 0,
                                                        ModifiedLambertProjection::Square square = ModifiedLambertProjection::Square::NorthSquare)
     {
-      ModifiedLambertProjection::Pointer lambertProjection = ModifiedLambertProjection::New();
-      lambertProjection->initializeSquares(dim, 1.0f);
+      ModifiedLambertProjectionPlan::Pointer plan = ModifiedLambertProjectionPlan::GetPlan(dim, 1.0f, dim, projType);
+      if (plan == ModifiedLambertProjectionPlan::NullPointer())
+      {
+        return FloatArrayType::NullPointer();
+      }
+
+      QString arrayName = (projType == ModifiedLambertProjection::ProjectionType::Stereographic) ? "ModifiedLambertProjection_StereographicProjection" : "ModifiedLambertProjection_CircularProjection";
+      FloatArrayType::Pointer stereoProj = FloatArrayType::CreateArray(QVector<size_t>(1, dim*dim), QVector<size_t>(1, 1), arrayName);
 
-      for (int y = 0; y < dim; y++)
+      // Gather straight from the requested slice; the other hemisphere is empty
+      const T* slice = lsData->getPointer(dim*dim*zValue);
+      if (square == ModifiedLambertProjection::Square::NorthSquare)
+      {
+        plan->apply<T>(slice, nullptr, stereoProj->getPointer(0));
+      }
+      else
       {
-        for (int x = 0; x < dim; x++)
-        {
-          size_t index = dim*dim*zValue + dim*y + x;
-          size_t projIdx = dim*y + x;
-          lambertProjection->setValue(square, projIdx, static_cast<double>(lsData->getValue(index)));
-        }
+        plan->apply<T>(nullptr, slice, stereoProj->getPointer(0));
       }
 
-      FloatArrayType::Pointer stereoProj = lambertProjection->createProjection(dim, projType);
       return stereoProj;
     }
 
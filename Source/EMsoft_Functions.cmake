@@ -124,3 +124,25 @@ function(AddEMsoftUnitTest)
 
 endfunction()
 
+
+#---------------------------------------------------------------------
+# This function will add a new EMsoft unit test that is written in C++
+# and supplies its own main() function, using the EMSOFT_ macros from
+# Source/Test/UnitTestSupport.hpp
+function(AddEMsoftCxxUnitTest)
+    set(options)
+    set(oneValueArgs TARGET SOLUTION_FOLDER)
+    set(multiValueArgs SOURCES LINK_LIBRARIES)
+    cmake_parse_arguments(Z "${options}" "${oneValueArgs}" "${multiValueArgs}" ${ARGN} )
+
+    add_executable( ${Z_TARGET} ${Z_SOURCES})
+    target_include_directories(${Z_TARGET} PRIVATE "${EMsoft_SOURCE_DIR}/Source/Test")
+    target_link_libraries( ${Z_TARGET} ${Z_LINK_LIBRARIES})
+    if("${Z_SOLUTION_FOLDER}" STREQUAL "")
+        set(Z_SOLUTION_FOLDER "Test")
+    endif()
+    set_target_properties( ${Z_TARGET} PROPERTIES FOLDER ${Z_SOLUTION_FOLDER})
+
+    add_test(${Z_TARGET} ${CMAKE_RUNTIME_OUTPUT_DIRECTORY}/${Z_TARGET})
+
+endfunction()
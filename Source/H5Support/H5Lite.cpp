@@ -134,6 +134,108 @@ void H5Lite::disableErrorHandlers()
   HDF_ERROR_HANDLER_OFF;
 }
 
+// -----------------------------------------------------------------------------
+//  Chunk shape used when filters are requested without explicit chunk dimensions
+// -----------------------------------------------------------------------------
+std::vector<hsize_t> H5Lite::defaultChunkDimensions(int32_t rank, const hsize_t* dims, size_t typeSize)
+{
+  // Aim for about 1 MiB per chunk but never let a single chunk exceed 64 MiB, well
+  // below the 4 GiB limit HDF5 places on a chunk.
+  const hsize_t targetBytes = 1024 * 1024;
+  const hsize_t maxBytes = 64 * 1024 * 1024;
+
+  std::vector<hsize_t> chunkDims(rank > 0 ? rank : 0, 1);
+  if(rank <= 0 || NULL == dims)
+  {
+    return chunkDims;
+  }
+
+  // The fastest dimension, or the two fastest for a stack of patterns/images, stays whole
+  int32_t wholeDims = (rank >= 3) ? 2 : 1;
+  hsize_t bytes = (typeSize > 0) ? typeSize : 1;
+  for(int32_t i = rank - 1; i >= 0; --i)
+  {
+    hsize_t dim = (dims[i] > 0) ? dims[i] : 1;
+    hsize_t limit = (i >= rank - wholeDims) ? maxBytes : targetBytes;
+    hsize_t fits = (bytes < limit) ? limit / bytes : 1;
+    chunkDims[i] = (dim < fits) ? dim : fits;
+    bytes = bytes * chunkDims[i];
+  }
+  return chunkDims;
+}
+
+// -----------------------------------------------------------------------------
+//  Builds a dataset creation property list from the options
+// -----------------------------------------------------------------------------
+hid_t H5Lite::createDatasetCreationPropertyList(const DatasetCreationOptions& options, int32_t rank, const hsize_t* dims, size_t typeSize)
+{
+  if(options.isDefault())
+  {
+    return H5P_DEFAULT;
+  }
+  if(rank <= 0 || NULL == dims)
+  {
+    return -1;
+  }
+
+  std::vector<hsize_t> chunkDims = options.chunkDims;
+  if(chunkDims.empty())
+  {
+    chunkDims = defaultChunkDimensions(rank, dims, typeSize);
+  }
+  else if(chunkDims.size() != static_cast<size_t>(rank))
+  {
+    std::cout << "Error: The chunk dimensions have rank " << chunkDims.size() << " but the dataset has rank " << rank << std::endl;
+    return -1;
+  }
+
+  // A dataset with an empty dimension can not be chunked, so it is written contiguous
+  bool canChunk = true;
+  for(int32_t i = 0; i < rank; ++i)
+  {
+    if(dims[i] == 0) { canChunk = false; }
+    if(chunkDims[i] == 0) { chunkDims[i] = 1; }
+    if(chunkDims[i] > dims[i]) { chunkDims[i] = dims[i]; }
+  }
+
+  hid_t dcpl = H5Pcreate(H5P_DATASET_CREATE);
+  if(dcpl < 0)
+  {
+    return dcpl;
+  }
+  herr_t err = 0;
+  if(canChunk)
+  {
+    err = H5Pset_chunk(dcpl, rank, &(chunkDims.front()));
+    if(err >= 0 && options.shuffle)
+    {
+      err = H5Pset_shuffle(dcpl);
+    }
+    if(err >= 0 && options.deflateLevel > 0)
+    {
+      if(H5Zfilter_avail(H5Z_FILTER_DEFLATE) > 0)
+      {
+        err = H5Pset_deflate(dcpl, options.deflateLevel > 9 ? 9 : options.deflateLevel);
+      }
+      else
+      {
+        std::cout << "Warning: The deflate filter is not available. The dataset will be written uncompressed." << std::endl;
+      }
+    }
+  }
+  if(err >= 0 && options.hasFillValue)
+  {
+    err = H5Pset_fill_value(dcpl, H5T_NATIVE_DOUBLE, &(options.fillValue));
+  }
+  if(err < 0)
+  {
+    std::cout << "Error creating the dataset creation property list" << std::endl;
+    H5Pclose(dcpl);
+    return err;
+  }
+  return dcpl;
+}
+
 // -----------------------------------------------------------------------------
 //  Opens an ID for HDF5 operations
 // -----------------------------------------------------------------------------
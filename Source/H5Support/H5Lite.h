@@ -64,6 +64,61 @@ namespace H5Support_NAMESPACE
        */
       static H5Support_EXPORT void disableErrorHandlers();
 
+      /**
+       * @brief Dataset creation settings used by the writePointerDataset(), replacePointerDataset()
+       * and writeVectorDataset() overloads that take them. A default constructed object produces
+       * the same contiguous, unfiltered dataset as the overloads that do not take any options.
+       *
+       * The chunk dimensions are given in HDF5 (slowest to fastest) order and must have the same
+       * rank as the dataset. Each chunk dimension is clamped to the size of the dataset. If a filter
+       * or a fill value is requested without chunk dimensions then defaultChunkDimensions() is used.
+       */
+      struct DatasetCreationOptions
+      {
+        DatasetCreationOptions() :
+          deflateLevel(0),
+          shuffle(false),
+          hasFillValue(false),
+          fillValue(0.0)
+        {}
+
+        std::vector<hsize_t> chunkDims;   // Empty means contiguous storage unless a filter is set
+        int32_t              deflateLevel; // 0 (no compression) through 9
+        bool                 shuffle;      // Apply the byte shuffle filter ahead of deflate
+        bool                 hasFillValue;
+        double               fillValue;    // Converted by HDF5 to the type of the dataset
+
+        bool isDefault() const
+        {
+          return chunkDims.empty() && deflateLevel <= 0 && !shuffle && !hasFillValue;
+        }
+      };
+
+      /**
+       * @brief Computes a chunk shape for a dataset. The fastest dimension (the two fastest
+       * dimensions for datasets of rank 3 or more, i.e. one pattern or image of a stack) is kept
+       * whole and the slower dimensions are grouped so that a chunk holds roughly 1 MiB.
+       * @param rank The number of dimensions
+       * @param dims The sizes of each dimension
+       * @param typeSize The size in bytes of a single element
+       * @return The chunk dimensions in HDF5 order
+       */
+      static H5Support_EXPORT std::vector<hsize_t> defaultChunkDimensions(int32_t rank, const hsize_t* dims, size_t typeSize);
+
+      /**
+       * @brief Creates the dataset creation property list described by the options. The caller
+       * is responsible for closing the returned id unless it is H5P_DEFAULT.
+       * @param options The dataset creation options
+       * @param rank The number of dimensions of the dataset
+       * @param dims The sizes of each dimension
+       * @param typeSize The size in bytes of a single element
+       * @return H5P_DEFAULT for default options, the property list id, or a negative value on error
+       */
+      static H5Support_EXPORT hid_t createDatasetCreationPropertyList(const DatasetCreationOptions& options,
+                                                                      int32_t rank,
+                                                                      const hsize_t* dims,
+                                                                      size_t typeSize);
+
       /**
        * @brief Opens an object for HDF5 operations
        * @param loc_id The parent object that holds the true object we want to open
@@ -288,6 +343,26 @@ namespace H5Support_NAMESPACE
                                         const std::string& dsetName,
                                         std::vector<hsize_t>& dims,
                                         std::vector<T>& data)
+      {
+        return writeVectorDataset(loc_id, dsetName, dims, data, DatasetCreationOptions());
+      }
+
+      /**
+       * @brief Creates a Dataset with the given name at the location defined by loc_id using
+       * the chunking, filters and fill value described by options.
+       * @param loc_id The Parent location to store the data
+       * @param dsetName The name of the dataset
+       * @param dims The dimensions of the dataset
+       * @param data The data to write to the file
+       * @param options The dataset creation options
+       * @return Standard HDF5 error conditions
+       */
+      template <typename T>
+      static herr_t writeVectorDataset (hid_t loc_id,
+                                        const std::string& dsetName,
+                                        std::vector<hsize_t>& dims,
+                                        std::vector<T>& data,
+                                        const DatasetCreationOptions& options)
       {
         herr_t err = -1;
         hid_t did = -1;
@@ -311,8 +386,15 @@ namespace H5Support_NAMESPACE
         {
           return -101;
         }
+        hid_t dcpl = createDatasetCreationPropertyList(options, static_cast<int32_t>(size), &(_dims.front()), sizeof(T));
+        if (dcpl < 0)
+        {
+          H5Sclose(sid);
+          return -106;
+        }
         // Create the Dataset
-        did = H5Dcreate (loc_id, dsetName.c_str(), dataType, sid, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+        did = H5Dcreate (loc_id, dsetName.c_str(), dataType, sid, H5P_DEFAULT, dcpl, H5P_DEFAULT);
+        if (dcpl != H5P_DEFAULT) { H5Pclose(dcpl); }
         if ( did >= 0 )
         {
           err = H5Dwrite( did, dataType, H5S_ALL, H5S_ALL, H5P_DEFAULT, &(data.front()) );
@@ -358,6 +440,28 @@ namespace H5Support_NAMESPACE
                                          hsize_t* dims,
                                          T* data)
       {
+        return writePointerDataset(loc_id, dsetName, rank, dims, data, DatasetCreationOptions());
+      }
+
+      /**
+       * @brief Writes the data of a pointer to an HDF5 file using the chunking, filters and
+       * fill value described by options.
+       * @param loc_id The hdf5 object id of the parent
+       * @param dsetName The name of the dataset to write to. This can be a name of Path
+       * @param rank The number of dimensions
+       * @param dims The sizes of each dimension
+       * @param data The data to be written.
+       * @param options The dataset creation options
+       * @return Standard hdf5 error condition.
+       */
+      template <typename T>
+      static herr_t writePointerDataset (hid_t loc_id,
+                                         const std::string& dsetName,
+                                         int32_t   rank,
+                                         hsize_t* dims,
+                                         T* data,
+                                         const DatasetCreationOptions& options)
+      {
 
         herr_t err    = -1;
         hid_t did     = -1;
@@ -384,9 +488,16 @@ namespace H5Support_NAMESPACE
         {
           return sid;
         }
+        hid_t dcpl = createDatasetCreationPropertyList(options, rank, dims, sizeof(T));
+        if (dcpl < 0)
+        {
+          H5Sclose(sid);
+          return dcpl;
+        }
         // Create the Dataset
         // This will fail if dsetName contains a "/"!
-        did = H5Dcreate (loc_id, dsetName.c_str(), dataType, sid, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+        did = H5Dcreate (loc_id, dsetName.c_str(), dataType, sid, H5P_DEFAULT, dcpl, H5P_DEFAULT);
+        if (dcpl != H5P_DEFAULT) { H5Pclose(dcpl); }
         if ( did >= 0 )
         {
           err = H5Dwrite( did, dataType, H5S_ALL, H5S_ALL, H5P_DEFAULT, data );
@@ -433,6 +544,28 @@ namespace H5Support_NAMESPACE
                                            hsize_t* dims,
                                            T* data)
       {
+        return replacePointerDataset(loc_id, dsetName, rank, dims, data, DatasetCreationOptions());
+      }
+
+      /**
+       * @brief Writes the data of a pointer into an existing dataset, creating the dataset with
+       * the given options if it does not exist yet. The options are ignored for an existing dataset.
+       * @param loc_id The hdf5 object id of the parent
+       * @param dsetName The name of the dataset to write to.
+       * @param rank The number of dimensions
+       * @param dims The sizes of each dimension
+       * @param data The data to be written.
+       * @param options The dataset creation options
+       * @return Standard hdf5 error condition.
+       */
+      template <typename T>
+      static herr_t replacePointerDataset (hid_t loc_id,
+                                           const std::string& dsetName,
+                                           int32_t   rank,
+                                           hsize_t* dims,
+                                           T* data,
+                                           const DatasetCreationOptions& options)
+      {
 
         herr_t err    = -1;
         hid_t did     = -1;
@@ -464,7 +597,14 @@ namespace H5Support_NAMESPACE
         HDF_ERROR_HANDLER_ON
         if ( did < 0 ) // dataset does not exist so create it
         {
-          did = H5Dcreate (loc_id, dsetName.c_str(), dataType, sid, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+          hid_t dcpl = createDatasetCreationPropertyList(options, rank, dims, sizeof(T));
+          if (dcpl < 0)
+          {
+            H5Sclose(sid);
+            return dcpl;
+          }
+          did = H5Dcreate (loc_id, dsetName.c_str(), dataType, sid, H5P_DEFAULT, dcpl, H5P_DEFAULT);
+          if (dcpl != H5P_DEFAULT) { H5Pclose(dcpl); }
         }
         if ( did >= 0 )
         {
@@ -1108,6 +1248,370 @@ namespace H5Support_NAMESPACE
       }
 
 
+      /**
+       * @brief Reads a hyperslab of an N-D dataset into a preallocated array. The hyperslab is
+       * stored contiguously in the array in the same (C) order as the dataset, so the array must
+       * hold at least the product of the count values.
+       * @param loc_id The parent location that contains the dataset to read
+       * @param dsetName The name of the dataset to read
+       * @param offset The starting index in each dimension
+       * @param count The number of elements to read in each dimension
+       * @param stride The step between elements in each dimension. An empty vector means 1 for every dimension.
+       * @param data A Pointer to the PreAllocated Array of Data
+       * @return Standard HDF error condition
+       */
+      template <typename T>
+      static herr_t readPointerDatasetHyperslab(hid_t loc_id,
+                                                const std::string& dsetName,
+                                                const std::vector<hsize_t>& offset,
+                                                const std::vector<hsize_t>& count,
+                                                const std::vector<hsize_t>& stride,
+                                                T* data)
+      {
+        herr_t err = 0;
+        herr_t retErr = 0;
+        T test = 0x00;
+        hid_t dataType = H5Lite::HDFTypeForPrimitive(test);
+        if (dataType == -1)
+        {
+          std::cout  << "dataType was not supported." << std::endl;
+          return -10;
+        }
+        if (NULL == data)
+        {
+          std::cout  << "The Pointer to hold the data is NULL. This is NOT allowed." << std::endl;
+          return -3;
+        }
+        hid_t did = H5Dopen( loc_id, dsetName.c_str(), H5P_DEFAULT );
+        if ( did < 0 )
+        {
+          std::cout  << " Error opening Dataset: " << did << std::endl;
+          return -1;
+        }
+        hid_t fileSpaceId = H5Dget_space(did);
+        hid_t memSpaceId = -1;
+        int32_t rank = H5Sget_simple_extent_ndims(fileSpaceId);
+        if (rank <= 0 || offset.size() != static_cast<size_t>(rank) || count.size() != static_cast<size_t>(rank)
+            || (!stride.empty() && stride.size() != static_cast<size_t>(rank)))
+        {
+          std::cout << "The hyperslab of '" << dsetName << "' does not match the rank of the dataset (" << rank << ")" << std::endl;
+          retErr = -4;
+        }
+        else
+        {
+          err = H5Sselect_hyperslab(fileSpaceId, H5S_SELECT_SET, &(offset.front()), stride.empty() ? NULL : &(stride.front()), &(count.front()), NULL);
+          if (err < 0)
+          {
+            std::cout << "Error Selecting Hyperslab of '" << dsetName << "'" << std::endl;
+            retErr = err;
+          }
+          else
+          {
+            memSpaceId = H5Screate_simple(rank, &(count.front()), NULL);
+            err = H5Dread(did, dataType, memSpaceId, fileSpaceId, H5P_DEFAULT, data );
+            if (err < 0)
+            {
+              std::cout << "Error Reading Data '" << dsetName << "'" << std::endl;
+              retErr = err;
+            }
+          }
+        }
+        if (memSpaceId >= 0) { H5Sclose(memSpaceId); }
+        H5Sclose(fileSpaceId);
+        err = H5Dclose( did );
+        if (err < 0 )
+        {
+          std::cout  << "Error Closing Dataset id" << std::endl;
+          retErr = err;
+        }
+        return retErr;
+      }
+
+      /**
+       * @brief Reads a hyperslab of an N-D dataset into a preallocated array using a stride of 1
+       * @param loc_id The parent location that contains the dataset to read
+       * @param dsetName The name of the dataset to read
+       * @param offset The starting index in each dimension
+       * @param count The number of elements to read in each dimension
+       * @param data A Pointer to the PreAllocated Array of Data
+       * @return Standard HDF error condition
+       */
+      template <typename T>
+      static herr_t readPointerDatasetHyperslab(hid_t loc_id,
+                                                const std::string& dsetName,
+                                                const std::vector<hsize_t>& offset,
+                                                const std::vector<hsize_t>& count,
+                                                T* data)
+      {
+        return H5Lite::readPointerDatasetHyperslab(loc_id, dsetName, offset, count, std::vector<hsize_t>(), data);
+      }
+
+      /**
+       * @brief Writes a contiguous array into a hyperslab of an existing N-D dataset.
+       * @param loc_id The parent location that contains the dataset to write
+       * @param dsetName The name of the dataset to write
+       * @param offset The starting index in each dimension
+       * @param count The number of elements to write in each dimension
+       * @param stride The step between elements in each dimension. An empty vector means 1 for every dimension.
+       * @param data The data to be written; it must hold the product of the count values
+       * @return Standard HDF error condition
+       */
+      template <typename T>
+      static herr_t writePointerDatasetHyperslab(hid_t loc_id,
+                                                 const std::string& dsetName,
+                                                 const std::vector<hsize_t>& offset,
+                                                 const std::vector<hsize_t>& count,
+                                                 const std::vector<hsize_t>& stride,
+                                                 const T* data)
+      {
+        herr_t err = 0;
+        herr_t retErr = 0;
+        T test = 0x00;
+        hid_t dataType = H5Lite::HDFTypeForPrimitive(test);
+        if (dataType == -1)
+        {
+          std::cout  << "dataType was not supported." << std::endl;
+          return -10;
+        }
+        if (NULL == data)
+        {
+          std::cout  << "The Pointer holding the data is NULL. This is NOT allowed." << std::endl;
+          return -3;
+        }
+        hid_t did = H5Dopen( loc_id, dsetName.c_str(), H5P_DEFAULT );
+        if ( did < 0 )
+        {
+          std::cout  << " Error opening Dataset: " << did << std::endl;
+          return -1;
+        }
+        hid_t fileSpaceId = H5Dget_space(did);
+        hid_t memSpaceId = -1;
+        int32_t rank = H5Sget_simple_extent_ndims(fileSpaceId);
+        if (rank <= 0 || offset.size() != static_cast<size_t>(rank) || count.size() != static_cast<size_t>(rank)
+            || (!stride.empty() && stride.size() != static_cast<size_t>(rank)))
+        {
+          std::cout << "The hyperslab of '" << dsetName << "' does not match the rank of the dataset (" << rank << ")" << std::endl;
+          retErr = -4;
+        }
+        else
+        {
+          err = H5Sselect_hyperslab(fileSpaceId, H5S_SELECT_SET, &(offset.front()), stride.empty() ? NULL : &(stride.front()), &(count.front()), NULL);
+          if (err < 0)
+          {
+            std::cout << "Error Selecting Hyperslab of '" << dsetName << "'" << std::endl;
+            retErr = err;
+          }
+          else
+          {
+            memSpaceId = H5Screate_simple(rank, &(count.front()), NULL);
+            err = H5Dwrite(did, dataType, memSpaceId, fileSpaceId, H5P_DEFAULT, data );
+            if (err < 0)
+            {
+              std::cout << "Error Writing Data '" << dsetName << "'" << std::endl;
+              retErr = err;
+            }
+          }
+        }
+        if (memSpaceId >= 0) { H5Sclose(memSpaceId); }
+        H5Sclose(fileSpaceId);
+        err = H5Dclose( did );
+        if (err < 0 )
+        {
+          std::cout  << "Error Closing Dataset id" << std::endl;
+          retErr = err;
+        }
+        return retErr;
+      }
+
+      /**
+       * @brief Creates an empty dataset that can grow along its first (slowest) dimension, e.g. a
+       * stack of patterns that is written one batch at a time with appendSlab. The first dimension
+       * starts at zero and has no upper limit; the remaining dimensions are fixed to rowDims.
+       * Extendible datasets must be chunked, so if options has no chunk dimensions the default
+       * chunk shape for a stack of about 1 MiB chunks is used.
+       * @param loc_id The hdf5 object id of the parent
+       * @param dsetName The name of the dataset to create
+       * @param rowDims The sizes of the fixed dimensions of a single row, e.g. {numsy, numsx} for a pattern
+       * @param options The dataset creation options. chunkDims, if given, includes the first dimension.
+       * @return Standard hdf5 error condition.
+       */
+      template <typename T>
+      static herr_t createExtendibleDataset(hid_t loc_id,
+                                            const std::string& dsetName,
+                                            const std::vector<hsize_t>& rowDims,
+                                            const DatasetCreationOptions& options = DatasetCreationOptions())
+      {
+        T test = 0x00;
+        hid_t dataType = H5Lite::HDFTypeForPrimitive(test);
+        if (dataType == -1)
+        {
+          std::cout  << "dataType was not supported." << std::endl;
+          return -10;
+        }
+        int32_t rank = static_cast<int32_t>(rowDims.size()) + 1;
+        std::vector<hsize_t> dims(rank, 0);
+        std::vector<hsize_t> maxDims(rank, H5S_UNLIMITED);
+        for (int32_t i = 1; i < rank; ++i)
+        {
+          if (rowDims[i - 1] == 0)
+          {
+            std::cout << "Error: Dimension " << i << " of the extendible dataset '" << dsetName << "' is zero" << std::endl;
+            return -4;
+          }
+          dims[i] = rowDims[i - 1];
+          maxDims[i] = rowDims[i - 1];
+        }
+
+        // The chunk shape is picked as if the dataset already held about a million rows; the
+        // property list is then built against a single chunk of rows because HDF5 clamps the
+        // chunk to the current extent, which is still empty.
+        DatasetCreationOptions chunkedOptions = options;
+        if (chunkedOptions.chunkDims.empty())
+        {
+          std::vector<hsize_t> nominalDims = dims;
+          nominalDims[0] = 1024 * 1024;
+          chunkedOptions.chunkDims = defaultChunkDimensions(rank, &(nominalDims.front()), sizeof(T));
+        }
+        else if (chunkedOptions.chunkDims.size() != static_cast<size_t>(rank))
+        {
+          std::cout << "Error: The chunk dimensions have rank " << chunkedOptions.chunkDims.size() << " but the dataset has rank " << rank << std::endl;
+          return -1;
+        }
+        std::vector<hsize_t> chunkExtent = dims;
+        chunkExtent[0] = (chunkedOptions.chunkDims[0] > 0) ? chunkedOptions.chunkDims[0] : 1;
+        hid_t dcpl = createDatasetCreationPropertyList(chunkedOptions, rank, &(chunkExtent.front()), sizeof(T));
+        if (dcpl < 0)
+        {
+          return dcpl;
+        }
+
+        herr_t retErr = 0;
+        hid_t sid = H5Screate_simple(rank, &(dims.front()), &(maxDims.front()));
+        if (sid < 0)
+        {
+          H5Pclose(dcpl);
+          return sid;
+        }
+        hid_t did = H5Dcreate(loc_id, dsetName.c_str(), dataType, sid, H5P_DEFAULT, dcpl, H5P_DEFAULT);
+        if (did < 0)
+        {
+          std::cout << "Error Creating Extendible Dataset '" << dsetName << "'" << std::endl;
+          retErr = did;
+        }
+        else if (H5Dclose(did) < 0)
+        {
+          std::cout << "Error Closing Dataset." << std::endl;
+          retErr = -1;
+        }
+        H5Pclose(dcpl);
+        H5Sclose(sid);
+        return retErr;
+      }
+
+      /**
+       * @brief Appends rows to a dataset created by createExtendibleDataset. The dataset is grown
+       * along its first dimension with H5Dset_extent and data is written into the new rows.
+       * @param loc_id The hdf5 object id of the parent
+       * @param dsetName The name of the dataset to append to
+       * @param data The rows to append, contiguous in the same (C) order as the dataset
+       * @param numRows The number of rows held by data
+       * @param totalRows If not NULL, receives the number of rows in the dataset after the append
+       * @return Standard hdf5 error condition.
+       */
+      template <typename T>
+      static herr_t appendSlab(hid_t loc_id,
+                               const std::string& dsetName,
+                               const T* data,
+                               hsize_t numRows,
+                               hsize_t* totalRows = NULL)
+      {
+        herr_t err = 0;
+        herr_t retErr = 0;
+        T test = 0x00;
+        hid_t dataType = H5Lite::HDFTypeForPrimitive(test);
+        if (dataType == -1)
+        {
+          std::cout  << "dataType was not supported." << std::endl;
+          return -10;
+        }
+        if (NULL == data && numRows > 0)
+        {
+          std::cout  << "The Pointer holding the data is NULL. This is NOT allowed." << std::endl;
+          return -3;
+        }
+        hid_t did = H5Dopen( loc_id, dsetName.c_str(), H5P_DEFAULT );
+        if ( did < 0 )
+        {
+          std::cout  << " Error opening Dataset: " << did << std::endl;
+          return -1;
+        }
+        hid_t fileSpaceId = H5Dget_space(did);
+        int32_t rank = H5Sget_simple_extent_ndims(fileSpaceId);
+        if (rank <= 0)
+        {
+          H5Sclose(fileSpaceId);
+          H5Dclose(did);
+          return -4;
+        }
+        std::vector<hsize_t> dims(rank, 0);
+        std::vector<hsize_t> maxDims(rank, 0);
+        H5Sget_simple_extent_dims(fileSpaceId, &(dims.front()), &(maxDims.front()));
+        H5Sclose(fileSpaceId);
+        fileSpaceId = -1;
+
+        hsize_t offset0 = dims[0];
+        if (maxDims[0] != H5S_UNLIMITED && offset0 + numRows > maxDims[0])
+        {
+          std::cout << "The dataset '" << dsetName << "' can not be extended to " << (offset0 + numRows) << " rows" << std::endl;
+          retErr = -5;
+        }
+        else if (numRows > 0)
+        {
+          dims[0] = offset0 + numRows;
+          err = H5Dset_extent(did, &(dims.front()));
+          if (err < 0)
+          {
+            std::cout << "Error Extending Dataset '" << dsetName << "'" << std::endl;
+            retErr = err;
+          }
+          else
+          {
+            std::vector<hsize_t> offset(rank, 0);
+            std::vector<hsize_t> count = dims;
+            offset[0] = offset0;
+            count[0] = numRows;
+            fileSpaceId = H5Dget_space(did);
+            err = H5Sselect_hyperslab(fileSpaceId, H5S_SELECT_SET, &(offset.front()), NULL, &(count.front()), NULL);
+            if (err < 0)
+            {
+              std::cout << "Error Selecting Hyperslab of '" << dsetName << "'" << std::endl;
+              retErr = err;
+            }
+            else
+            {
+              hid_t memSpaceId = H5Screate_simple(rank, &(count.front()), NULL);
+              err = H5Dwrite(did, dataType, memSpaceId, fileSpaceId, H5P_DEFAULT, data );
+              if (err < 0)
+              {
+                std::cout << "Error Writing Data '" << dsetName << "'" << std::endl;
+                retErr = err;
+              }
+              H5Sclose(memSpaceId);
+            }
+            H5Sclose(fileSpaceId);
+          }
+        }
+        if (NULL != totalRows) { *totalRows = dims[0]; }
+        err = H5Dclose( did );
+        if (err < 0 )
+        {
+          std::cout  << "Error Closing Dataset id" << std::endl;
+          retErr = err;
+        }
+        return retErr;
+      }
+
+
       /**
        * @brief Reads data from the HDF5 File into an std::vector<T> object. If the dataset
        * is very large this can be an expensive method to use. It is here for convenience
@@ -55,10 +55,44 @@ using namespace H5Support_NAMESPACE;
 // -----------------------------------------------------------------------------
 hid_t H5Utilities::createFile(const std::string& filename)
 {
+  return createFile(filename, FileAccessOptions());
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+hid_t H5Utilities::createFile(const std::string& filename, const FileAccessOptions& options)
+{
+  hid_t fapl = createFileAccessPropertyList(options);
+  if (fapl < 0)
+  {
+    return fapl;
+  }
+  hid_t fcpl = H5P_DEFAULT;
+  if (options.pageSize > 0)
+  {
+#if H5_VERSION_GE(1,10,1)
+    fcpl = H5Pcreate(H5P_FILE_CREATE);
+    if (fcpl < 0
+        || H5Pset_file_space_strategy(fcpl, H5F_FSPACE_STRATEGY_PAGE, 1, 1) < 0
+        || H5Pset_file_space_page_size(fcpl, options.pageSize) < 0)
+    {
+      std::cout << "Error: Could not set a file space page size of " << options.pageSize << std::endl;
+      if (fcpl >= 0) { H5Pclose(fcpl); }
+      if (fapl != H5P_DEFAULT) { H5Pclose(fapl); }
+      return -1;
+    }
+#else
+    std::cout << "Warning: Paged file space allocation needs HDF5 1.10.1 or newer. The page size is ignored." << std::endl;
+#endif
+  }
+
   // HDF_ERROR_HANDLER_OFF
   //Create the HDF File
-  hid_t fileId = H5Fcreate(filename.c_str(), H5F_ACC_TRUNC, H5P_DEFAULT, H5P_DEFAULT);
+  hid_t fileId = H5Fcreate(filename.c_str(), H5F_ACC_TRUNC, fcpl, fapl);
   // HDF_ERROR_HANDLER_ON
+  if (fcpl != H5P_DEFAULT) { H5Pclose(fcpl); }
+  if (fapl != H5P_DEFAULT) { H5Pclose(fapl); }
   return fileId;
 }
 
@@ -67,21 +101,125 @@ hid_t H5Utilities::createFile(const std::string& filename)
 // -----------------------------------------------------------------------------
 hid_t H5Utilities::openFile(const std::string& filename, bool readOnly)
 {
-  HDF_ERROR_HANDLER_OFF
-  hid_t fileId = -1;
-  if ( readOnly )
+  return openFile(filename, readOnly, FileAccessOptions());
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+hid_t H5Utilities::openFile(const std::string& filename, bool readOnly, const FileAccessOptions& options)
+{
+  hid_t fapl = createFileAccessPropertyList(options);
+  if (fapl < 0)
   {
-    fileId = H5Fopen(filename.c_str(), H5F_ACC_RDONLY, H5P_DEFAULT);
+    return fapl;
   }
-  else
+  unsigned int flags = readOnly ? H5F_ACC_RDONLY : H5F_ACC_RDWR;
+
+  HDF_ERROR_HANDLER_OFF
+  hid_t fileId = H5Fopen(filename.c_str(), flags, fapl);
+#if H5_VERSION_GE(1,10,1)
+  // A page buffer can only be used with files that were created with paged file space
+  // allocation; open everything else without one.
+  if (fileId < 0 && options.pageBufferBytes > 0 && H5Pset_page_buffer_size(fapl, 0, 0, 0) >= 0)
   {
-    fileId = H5Fopen(filename.c_str(), H5F_ACC_RDWR, H5P_DEFAULT);
+    fileId = H5Fopen(filename.c_str(), flags, fapl);
   }
-
+#endif
   HDF_ERROR_HANDLER_ON
+
+  if (fapl != H5P_DEFAULT) { H5Pclose(fapl); }
   return fileId;
 }
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+hid_t H5Utilities::createFileAccessPropertyList(const FileAccessOptions& options)
+{
+  if (options.isDefault())
+  {
+    return H5P_DEFAULT;
+  }
+
+  hid_t fapl = H5Pcreate(H5P_FILE_ACCESS);
+  if (fapl < 0)
+  {
+    return fapl;
+  }
+  herr_t err = 0;
+
+  switch(options.driver)
+  {
+    case FileAccessOptions::Sec2Driver:
+      err = H5Pset_fapl_sec2(fapl);
+      break;
+    case FileAccessOptions::CoreDriver:
+      err = H5Pset_fapl_core(fapl, options.coreIncrement, options.coreBackingStore ? 1 : 0);
+      break;
+    case FileAccessOptions::DirectDriver:
+#ifdef H5_HAVE_DIRECT
+      // Alignment and block size of 4 KiB with a 16 MiB copy buffer
+      err = H5Pset_fapl_direct(fapl, 4096, 4096, 16 * 1024 * 1024);
+#else
+      std::cout << "Error: This HDF5 library was built without the direct I/O driver" << std::endl;
+      err = -1;
+#endif
+      break;
+    case FileAccessOptions::DefaultDriver:
+    default:
+      break;
+  }
+
+  if (err >= 0 && (options.chunkCacheSlots > 0 || options.chunkCacheBytes > 0 || options.chunkCachePreemption >= 0.0))
+  {
+    int mdcElements = 0;
+    size_t slots = 0;
+    size_t bytes = 0;
+    double w0 = 0.0;
+    err = H5Pget_cache(fapl, &mdcElements, &slots, &bytes, &w0);
+    if (err >= 0)
+    {
+      if (options.chunkCacheSlots > 0) { slots = options.chunkCacheSlots; }
+      if (options.chunkCacheBytes > 0) { bytes = options.chunkCacheBytes; }
+      if (options.chunkCachePreemption >= 0.0) { w0 = options.chunkCachePreemption > 1.0 ? 1.0 : options.chunkCachePreemption; }
+      err = H5Pset_cache(fapl, mdcElements, slots, bytes, w0);
+    }
+  }
+
+  if (err >= 0 && options.metadataCacheBytes > 0)
+  {
+    H5AC_cache_config_t config;
+    config.version = H5AC__CURR_CACHE_CONFIG_VERSION;
+    err = H5Pget_mdc_config(fapl, &config);
+    if (err >= 0)
+    {
+      config.set_initial_size = true;
+      config.initial_size = options.metadataCacheBytes;
+      if (config.max_size < options.metadataCacheBytes) { config.max_size = options.metadataCacheBytes; }
+      if (config.min_size > options.metadataCacheBytes) { config.min_size = options.metadataCacheBytes; }
+      err = H5Pset_mdc_config(fapl, &config);
+    }
+  }
+
+  if (err >= 0 && options.pageBufferBytes > 0)
+  {
+#if H5_VERSION_GE(1,10,1)
+    err = H5Pset_page_buffer_size(fapl, options.pageBufferBytes, 0, 0);
+#else
+    std::cout << "Warning: A page buffer needs HDF5 1.10.1 or newer. The page buffer size is ignored." << std::endl;
+#endif
+  }
+
+  if (err < 0)
+  {
+    std::cout << "Error: Could not create the file access property list" << std::endl;
+    H5Pclose(fapl);
+    return -1;
+  }
+  return fapl;
+}
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -56,13 +56,90 @@ namespace H5Support_NAMESPACE
         H5Support_ANY = 15
       };
 
+      /**
+       * @brief Tunes how a file is opened or created. Every member left at its default value
+       * keeps the HDF5 library default, so a default constructed FileAccessOptions is the same
+       * as passing H5P_DEFAULT.
+       *
+       * The chunk cache settings become the default raw data chunk cache of every dataset opened
+       * through the file. The core driver reads the whole file into memory on open, which suits
+       * small master pattern files that are sliced repeatedly. The page buffer only has an effect
+       * on files that were created with a page size (see pageSize); for other files it is
+       * silently dropped when the file is opened.
+       */
+      struct FileAccessOptions
+      {
+        enum Driver
+        {
+          DefaultDriver = 0,
+          Sec2Driver,
+          CoreDriver,
+          DirectDriver
+        };
+
+        FileAccessOptions() :
+          driver(DefaultDriver),
+          coreIncrement(1024 * 1024),
+          coreBackingStore(true),
+          chunkCacheSlots(0),
+          chunkCacheBytes(0),
+          chunkCachePreemption(-1.0),
+          metadataCacheBytes(0),
+          pageBufferBytes(0),
+          pageSize(0)
+        {}
+
+        Driver  driver;
+        size_t  coreIncrement;        // Memory growth increment for the core driver
+        bool    coreBackingStore;     // Write the in-memory image back to disk on close (core driver)
+        size_t  chunkCacheSlots;      // Number of hash slots in the chunk cache; 0 keeps the default
+        size_t  chunkCacheBytes;      // Size of the chunk cache of each dataset; 0 keeps the default (1 MiB)
+        double  chunkCachePreemption; // 0.0 to 1.0; negative keeps the default (0.75)
+        size_t  metadataCacheBytes;   // Initial (and minimum maximum) size of the metadata cache; 0 keeps the default
+        size_t  pageBufferBytes;      // Size of the page buffer; 0 disables it
+        hsize_t pageSize;             // createFile only: use paged file space allocation with this page size
+
+        bool isDefault() const
+        {
+          return driver == DefaultDriver && chunkCacheSlots == 0 && chunkCacheBytes == 0 && chunkCachePreemption < 0.0
+                 && metadataCacheBytes == 0 && pageBufferBytes == 0;
+        }
+      };
+
       // -----------HDF5 File Operations
       static H5Support_EXPORT hid_t openFile(const std::string& filename, bool readOnly = false);
 
+      /**
+       * @brief Opens an existing file with the given file access options
+       * @param filename The path to the file
+       * @param readOnly Open the file read only
+       * @param options The file access options
+       * @return The file id or a negative value on error
+       */
+      static H5Support_EXPORT hid_t openFile(const std::string& filename, bool readOnly, const FileAccessOptions& options);
+
       static H5Support_EXPORT hid_t createFile(const std::string& filename);
 
+      /**
+       * @brief Creates (truncates) a file with the given file access options. A non zero
+       * FileAccessOptions::pageSize stores the file with paged, persistent free space so that it
+       * can later be opened with a page buffer.
+       * @param filename The path to the file
+       * @param options The file access options
+       * @return The file id or a negative value on error
+       */
+      static H5Support_EXPORT hid_t createFile(const std::string& filename, const FileAccessOptions& options);
+
       static H5Support_EXPORT herr_t closeFile(hid_t& fileId);
 
+      /**
+       * @brief Creates the file access property list described by the options. The caller is
+       * responsible for closing the returned id unless it is H5P_DEFAULT.
+       * @param options The file access options
+       * @return H5P_DEFAULT for default options, the property list id, or a negative value on error
+       */
+      static H5Support_EXPORT hid_t createFileAccessPropertyList(const FileAccessOptions& options);
+
       // -------------- HDF Indentifier Methods ----------------------------
       /**
       * @brief Retuirns the path to an object
@@ -244,6 +244,50 @@ namespace H5Support_NAMESPACE
         return H5Lite::replacePointerDataset(loc_id, dsetName.toStdString(), rank, dims, data);
       }
 
+      /**
+       * @brief Writes the data of a pointer to an HDF5 file using the chunking, filters and
+       * fill value described by options.
+       * @param loc_id The hdf5 object id of the parent
+       * @param dsetName The name of the dataset to write to.
+       * @param rank The number of dimensions
+       * @param dims The sizes of each dimension
+       * @param data The data to be written.
+       * @param options The dataset creation options
+       * @return Standard hdf5 error condition.
+       */
+      template <typename T>
+      static herr_t writePointerDataset (hid_t loc_id,
+                                         const QString& dsetName,
+                                         int32_t   rank,
+                                         hsize_t* dims,
+                                         T* data,
+                                         const H5Lite::DatasetCreationOptions& options)
+      {
+        return H5Lite::writePointerDataset(loc_id, dsetName.toStdString(), rank, dims, data, options);
+      }
+
+      /**
+       * @brief Writes the data of a pointer into an existing dataset, creating the dataset with
+       * the given options if it does not exist yet.
+       * @param loc_id The hdf5 object id of the parent
+       * @param dsetName The name of the dataset to write to.
+       * @param rank The number of dimensions
+       * @param dims The sizes of each dimension
+       * @param data The data to be written.
+       * @param options The dataset creation options
+       * @return Standard hdf5 error condition.
+       */
+      template <typename T>
+      static herr_t replacePointerDataset (hid_t loc_id,
+                                           const QString& dsetName,
+                                           int32_t   rank,
+                                           hsize_t* dims,
+                                           T* data,
+                                           const H5Lite::DatasetCreationOptions& options)
+      {
+        return H5Lite::replacePointerDataset(loc_id, dsetName.toStdString(), rank, dims, data, options);
+      }
+
 
       /**
        * @brief Creates a Dataset with the given name at the location defined by loc_id
@@ -450,6 +494,105 @@ namespace H5Support_NAMESPACE
 
 
 
+      /**
+       * @brief Reads a hyperslab of an N-D dataset into a preallocated array. The hyperslab is
+       * stored contiguously in the array in the same (C) order as the dataset.
+       * @param loc_id The parent location that contains the dataset to read
+       * @param dsetName The name of the dataset to read
+       * @param offset The starting index in each dimension
+       * @param count The number of elements to read in each dimension
+       * @param stride The step between elements in each dimension. An empty vector means 1 for every dimension.
+       * @param data A Pointer to the PreAllocated Array of Data
+       * @return Standard HDF error condition
+       */
+      template <typename T>
+      static herr_t readPointerDatasetHyperslab(hid_t loc_id,
+                                                const QString& dsetName,
+                                                const QVector<hsize_t>& offset,
+                                                const QVector<hsize_t>& count,
+                                                const QVector<hsize_t>& stride,
+                                                T* data)
+      {
+        return H5Lite::readPointerDatasetHyperslab(loc_id, dsetName.toStdString(), offset.toStdVector(), count.toStdVector(), stride.toStdVector(), data);
+      }
+
+      /**
+       * @brief Reads a hyperslab of an N-D dataset into a preallocated array using a stride of 1
+       * @param loc_id The parent location that contains the dataset to read
+       * @param dsetName The name of the dataset to read
+       * @param offset The starting index in each dimension
+       * @param count The number of elements to read in each dimension
+       * @param data A Pointer to the PreAllocated Array of Data
+       * @return Standard HDF error condition
+       */
+      template <typename T>
+      static herr_t readPointerDatasetHyperslab(hid_t loc_id,
+                                                const QString& dsetName,
+                                                const QVector<hsize_t>& offset,
+                                                const QVector<hsize_t>& count,
+                                                T* data)
+      {
+        return H5Lite::readPointerDatasetHyperslab(loc_id, dsetName.toStdString(), offset.toStdVector(), count.toStdVector(), data);
+      }
+
+      /**
+       * @brief Writes a contiguous array into a hyperslab of an existing N-D dataset.
+       * @param loc_id The parent location that contains the dataset to write
+       * @param dsetName The name of the dataset to write
+       * @param offset The starting index in each dimension
+       * @param count The number of elements to write in each dimension
+       * @param stride The step between elements in each dimension. An empty vector means 1 for every dimension.
+       * @param data The data to be written; it must hold the product of the count values
+       * @return Standard HDF error condition
+       */
+      template <typename T>
+      static herr_t writePointerDatasetHyperslab(hid_t loc_id,
+                                                 const QString& dsetName,
+                                                 const QVector<hsize_t>& offset,
+                                                 const QVector<hsize_t>& count,
+                                                 const QVector<hsize_t>& stride,
+                                                 const T* data)
+      {
+        return H5Lite::writePointerDatasetHyperslab(loc_id, dsetName.toStdString(), offset.toStdVector(), count.toStdVector(), stride.toStdVector(), data);
+      }
+
+      /**
+       * @brief Creates an empty dataset that can grow along its first (slowest) dimension. See
+       * H5Lite::createExtendibleDataset.
+       * @param loc_id The hdf5 object id of the parent
+       * @param dsetName The name of the dataset to create
+       * @param rowDims The sizes of the fixed dimensions of a single row
+       * @param options The dataset creation options
+       * @return Standard hdf5 error condition.
+       */
+      template <typename T>
+      static herr_t createExtendibleDataset(hid_t loc_id,
+                                            const QString& dsetName,
+                                            const QVector<hsize_t>& rowDims,
+                                            const H5Lite::DatasetCreationOptions& options = H5Lite::DatasetCreationOptions())
+      {
+        return H5Lite::createExtendibleDataset<T>(loc_id, dsetName.toStdString(), rowDims.toStdVector(), options);
+      }
+
+      /**
+       * @brief Appends rows to a dataset created by createExtendibleDataset.
+       * @param loc_id The hdf5 object id of the parent
+       * @param dsetName The name of the dataset to append to
+       * @param data The rows to append
+       * @param numRows The number of rows held by data
+       * @param totalRows If not NULL, receives the number of rows in the dataset after the append
+       * @return Standard hdf5 error condition.
+       */
+      template <typename T>
+      static herr_t appendSlab(hid_t loc_id,
+                               const QString& dsetName,
+                               const T* data,
+                               hsize_t numRows,
+                               hsize_t* totalRows = NULL)
+      {
+        return H5Lite::appendSlab(loc_id, dsetName.toStdString(), data, numRows, totalRows);
+      }
+
       /**
        * @brief Reads data from the HDF5 File into an QVector<T> object. If the dataset
        * is very large this can be an expensive method to use. It is here for convenience
@@ -54,6 +54,15 @@ hid_t QH5Utilities::createFile(const QString& filename)
 {
   return H5Utilities::createFile(filename.toStdString());
 }
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+hid_t QH5Utilities::createFile(const QString& filename, const H5Utilities::FileAccessOptions& options)
+{
+  return H5Utilities::createFile(filename.toStdString(), options);
+}
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -62,6 +71,14 @@ hid_t QH5Utilities::openFile(const QString& filename, bool readOnly)
   return H5Utilities::openFile(filename.toStdString(), readOnly);
 }
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+hid_t QH5Utilities::openFile(const QString& filename, bool readOnly, const H5Utilities::FileAccessOptions& options)
+{
+  return H5Utilities::openFile(filename.toStdString(), readOnly, options);
+}
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
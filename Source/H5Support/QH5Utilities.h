@@ -66,8 +66,12 @@ class QH5Utilities
 
     static H5Support_EXPORT hid_t openFile(const QString& filename, bool readOnly = false);
 
+    static H5Support_EXPORT hid_t openFile(const QString& filename, bool readOnly, const H5Utilities::FileAccessOptions& options);
+
     static H5Support_EXPORT hid_t createFile(const QString& filename);
 
+    static H5Support_EXPORT hid_t createFile(const QString& filename, const H5Utilities::FileAccessOptions& options);
+
 
     static H5Support_EXPORT herr_t closeFile(hid_t& fileId);
 
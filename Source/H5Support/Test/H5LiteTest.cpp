@@ -24,7 +24,7 @@
 #include "H5Support/QH5Lite.h"
 #include "H5Support/QH5Utilities.h"
 
-#include "DREAM3DLib/Utilities/UnitTestSupport.hpp"
+#include "UnitTestSupport.hpp"
 
 #include "H5SupportTestFileLocations.h"
 
@@ -74,6 +74,11 @@
  * writeScalarAttribute - DONE
  * readPointerDataset - DONE
  * readVectorDataset - DONE
+ * readPointerDatasetHyperslab - DONE
+ * writePointerDatasetHyperslab - DONE
+ * defaultChunkDimensions - DONE
+ * createExtendibleDataset - DONE
+ * appendSlab - DONE
  * readScalarDataset - DONE
  * readStringDataset - DONE
  * readStringDataset - DONE
@@ -120,7 +125,7 @@ herr_t testWritePointer1DArrayAttribute(hid_t file_id, const QString& dsetName)
   T value = 0x0;
   herr_t err = -1;
   QString attributeKey = QH5Lite::HDFTypeForPrimitiveAsStr(value);
-  DREAM3D_REQUIRE(attributeKey.isEmpty() == false);
+  EMSOFT_REQUIRE(attributeKey.isEmpty() == false);
   attributeKey = "1DArrayAttribute<" + attributeKey + ">";
   int32_t rank = 1;
   T data[DIM0];
@@ -132,7 +137,7 @@ herr_t testWritePointer1DArrayAttribute(hid_t file_id, const QString& dsetName)
   dims[0] = DIM0;
 
   err = QH5Lite::writePointerAttribute<T>(file_id, dsetName, attributeKey, rank, dims, (T*)data);
-  DREAM3D_REQUIRE(err >= 0);
+  EMSOFT_REQUIRE(err >= 0);
   return err;
 }
 
@@ -146,7 +151,7 @@ herr_t testReadPointer1DArrayAttribute(hid_t file_id, const QString& dsetName)
   herr_t err = -1;
   herr_t retErr = err;
   QString attributeKey = QH5Lite::HDFTypeForPrimitiveAsStr(value);
-  DREAM3D_REQUIRE(attributeKey.isEmpty() == false);
+  EMSOFT_REQUIRE(attributeKey.isEmpty() == false);
   attributeKey = "1DArrayAttribute<" + attributeKey + ">";
   QVector<T> referenceData(DIM0, 0);
   for(int i = 0; i < DIM0; ++i)
@@ -159,13 +164,13 @@ herr_t testReadPointer1DArrayAttribute(hid_t file_id, const QString& dsetName)
   hid_t typeId = -1;
   QVector<hsize_t> dims;  //Reusable for the loop
   err = QH5Lite::getAttributeInfo(file_id, dsetName, attributeKey, dims, attr_type, attr_size, typeId);
-  DREAM3D_REQUIRE(err >= 0);
-  DREAM3D_REQUIRE(dims.size() == 1);
-  DREAM3D_REQUIRE(attr_size == sizeof(T));
+  EMSOFT_REQUIRE(err >= 0);
+  EMSOFT_REQUIRE(dims.size() == 1);
+  EMSOFT_REQUIRE(attr_size == sizeof(T));
   hid_t rank = 0;
   err = QH5Lite::getAttributeNDims(file_id, dsetName, attributeKey, rank);
-  DREAM3D_REQUIRE(err >= 0);
-  DREAM3D_REQUIRE(rank == 1);
+  EMSOFT_REQUIRE(err >= 0);
+  EMSOFT_REQUIRE(rank == 1);
   CloseH5T(typeId, err, retErr); //Close the H5A type Id that was retrieved during the loop
   typename QVector<T>::size_type numElements = 1;
   for (QVector<uint64_t>::size_type i = 0; i < dims.size(); ++i)
@@ -174,8 +179,8 @@ herr_t testReadPointer1DArrayAttribute(hid_t file_id, const QString& dsetName)
   }
   QVector<T> data(numElements, 0);
   err = QH5Lite::readPointerAttribute<T>(file_id, dsetName, attributeKey, data.data() );
-  DREAM3D_REQUIRE(err >= 0);
-  DREAM3D_REQUIRE (data == referenceData);
+  EMSOFT_REQUIRE(err >= 0);
+  EMSOFT_REQUIRE (data == referenceData);
 
   return retErr;
 }
@@ -190,7 +195,7 @@ herr_t testWritePointer2DArrayAttribute(hid_t file_id, const QString& dsetName)
   T value = 0x0;
   herr_t err = -1;
   QString attributeKey = QH5Lite::HDFTypeForPrimitiveAsStr(value);
-  DREAM3D_REQUIRE(attributeKey.isEmpty() == false);
+  EMSOFT_REQUIRE(attributeKey.isEmpty() == false);
 
   attributeKey = "2DArrayAttribute<" + attributeKey + ">";
   int32_t rank = RANK_2D;
@@ -206,7 +211,7 @@ herr_t testWritePointer2DArrayAttribute(hid_t file_id, const QString& dsetName)
   dims[0] = DIM0;
   dims[1] = DIM1;
   err = QH5Lite::writePointerAttribute<T>(file_id, dsetName, attributeKey, rank, dims, (T*)data);
-  DREAM3D_REQUIRE(err >= 0);
+  EMSOFT_REQUIRE(err >= 0);
   return err;
 }
 
@@ -220,7 +225,7 @@ herr_t testReadPointer2DArrayAttribute(hid_t file_id, const QString& dsetName)
   herr_t err = -1;
   herr_t retErr = err;
   QString attributeKey = QH5Lite::HDFTypeForPrimitiveAsStr(value);
-  DREAM3D_REQUIRE(attributeKey.isEmpty() == false);
+  EMSOFT_REQUIRE(attributeKey.isEmpty() == false);
   attributeKey = "2DArrayAttribute<" + attributeKey + ">";
   T referenceData[DIM0][DIM1];
   for(int i = 0; i < DIM0; ++i)
@@ -235,13 +240,13 @@ herr_t testReadPointer2DArrayAttribute(hid_t file_id, const QString& dsetName)
   hid_t typeId = -1;
   QVector<hsize_t> dims;  //Reusable for the loop
   err = QH5Lite::getAttributeInfo(file_id, dsetName, attributeKey, dims, attr_type, attr_size, typeId);
-  DREAM3D_REQUIRE(err >= 0);
-  DREAM3D_REQUIRE(dims.size() == 2);
-  DREAM3D_REQUIRE(attr_size == sizeof(T));
+  EMSOFT_REQUIRE(err >= 0);
+  EMSOFT_REQUIRE(dims.size() == 2);
+  EMSOFT_REQUIRE(attr_size == sizeof(T));
   hid_t rank = 0;
   err = QH5Lite::getAttributeNDims(file_id, dsetName, attributeKey, rank);
-  DREAM3D_REQUIRE(err >= 0);
-  DREAM3D_REQUIRE(rank == 2);
+  EMSOFT_REQUIRE(err >= 0);
+  EMSOFT_REQUIRE(rank == 2);
 
   CloseH5T(typeId, err, retErr); //Close the H5A type Id that was retrieved during the loop
   typename QVector<T>::size_type numElements = 1;
@@ -251,9 +256,9 @@ herr_t testReadPointer2DArrayAttribute(hid_t file_id, const QString& dsetName)
   }
   QVector<T> data(numElements, 0);
   err = QH5Lite::readPointerAttribute<T>(file_id, dsetName, attributeKey, data.data() );
-  DREAM3D_REQUIRE(err >= 0);
+  EMSOFT_REQUIRE(err >= 0);
 
-  DREAM3D_REQUIRE (::memcmp( data.data(), referenceData, sizeof(T)*numElements) == 0);
+  EMSOFT_REQUIRE (::memcmp( data.data(), referenceData, sizeof(T)*numElements) == 0);
   return retErr;
 }
 
@@ -266,7 +271,7 @@ herr_t testWritePointer3DArrayAttribute(hid_t file_id, const QString& dsetName)
   T value = 0x0;
   herr_t err = -1;
   QString attributeKey = QH5Lite::HDFTypeForPrimitiveAsStr(value);
-  DREAM3D_REQUIRE(attributeKey.isEmpty() == false);
+  EMSOFT_REQUIRE(attributeKey.isEmpty() == false);
   attributeKey = "3DArrayAttribute<" + attributeKey + ">";
   int32_t rank = RANK_3D;
   T data[DIM0][DIM1][DIM2];
@@ -285,7 +290,7 @@ herr_t testWritePointer3DArrayAttribute(hid_t file_id, const QString& dsetName)
   dims[1] = DIM1;
   dims[2] = DIM2;
   err = QH5Lite::writePointerAttribute<T>(file_id, dsetName, attributeKey, rank, dims, (T*)data);
-  DREAM3D_REQUIRE(err >= 0);
+  EMSOFT_REQUIRE(err >= 0);
   return err;
 }
 
@@ -299,7 +304,7 @@ herr_t testReadPointer3DArrayAttribute(hid_t file_id, const QString& dsetName)
   herr_t err = -1;
   herr_t retErr = err;
   QString attributeKey = QH5Lite::HDFTypeForPrimitiveAsStr(value);
-  DREAM3D_REQUIRE(attributeKey.isEmpty() == false);
+  EMSOFT_REQUIRE(attributeKey.isEmpty() == false);
   attributeKey = "3DArrayAttribute<" + attributeKey + ">";
   T referenceData[DIM0][DIM1][DIM2];
   for(int i = 0; i < DIM0; ++i)
@@ -317,13 +322,13 @@ herr_t testReadPointer3DArrayAttribute(hid_t file_id, const QString& dsetName)
   hid_t typeId = -1;
   QVector<hsize_t> dims;  //Reusable for the loop
   err = QH5Lite::getAttributeInfo(file_id, dsetName, attributeKey, dims, attr_type, attr_size, typeId);
-  DREAM3D_REQUIRE(err >= 0);
-  DREAM3D_REQUIRE(dims.size() == 3);
-  DREAM3D_REQUIRE(attr_size == sizeof(T));
+  EMSOFT_REQUIRE(err >= 0);
+  EMSOFT_REQUIRE(dims.size() == 3);
+  EMSOFT_REQUIRE(attr_size == sizeof(T));
   hid_t rank = 0;
   err = QH5Lite::getAttributeNDims(file_id, dsetName, attributeKey, rank);
-  DREAM3D_REQUIRE(err >= 0);
-  DREAM3D_REQUIRE(rank == 3);
+  EMSOFT_REQUIRE(err >= 0);
+  EMSOFT_REQUIRE(rank == 3);
   CloseH5T(typeId, err, retErr); //Close the H5A type Id that was retrieved during the loop
   typename QVector<T>::size_type numElements = 1;
   for (QVector<uint64_t>::size_type i = 0; i < dims.size(); ++i)
@@ -332,9 +337,9 @@ herr_t testReadPointer3DArrayAttribute(hid_t file_id, const QString& dsetName)
   }
   QVector<T> data(numElements, 0);
   err = QH5Lite::readPointerAttribute<T>(file_id, dsetName, attributeKey, data.data() );
-  DREAM3D_REQUIRE(err >= 0);
+  EMSOFT_REQUIRE(err >= 0);
 
-  DREAM3D_REQUIRE (::memcmp( data.data(), referenceData, sizeof(T)*numElements) == 0);
+  EMSOFT_REQUIRE (::memcmp( data.data(), referenceData, sizeof(T)*numElements) == 0);
   return retErr;
 }
 
@@ -347,7 +352,7 @@ herr_t testWriteVectorAttribute(hid_t file_id, QString dsetName )
   T value = 0x0;
   herr_t err = -1;
   QString attributeKey = QH5Lite::HDFTypeForPrimitiveAsStr(value);
-  DREAM3D_REQUIRE(attributeKey.isEmpty() == false);
+  EMSOFT_REQUIRE(attributeKey.isEmpty() == false);
   attributeKey = "VectorAttribute<" + attributeKey + ">";
 
   int32_t numElements = DIM0;
@@ -361,7 +366,7 @@ herr_t testWriteVectorAttribute(hid_t file_id, QString dsetName )
   }
   //qDebug() << "Attribute->Write: " << objName;
   err = QH5Lite::writeVectorAttribute( file_id, dsetName, attributeKey, dims, data );
-  DREAM3D_REQUIRE(err >= 0);
+  EMSOFT_REQUIRE(err >= 0);
   return err;
 }
 
@@ -374,7 +379,7 @@ herr_t testReadVectorAttribute(hid_t file_id, QString dsetName )
   T value = 0x0;
   herr_t err = -1;
   QString attributeKey = QH5Lite::HDFTypeForPrimitiveAsStr(value);
-  DREAM3D_REQUIRE(attributeKey.isEmpty() == false);
+  EMSOFT_REQUIRE(attributeKey.isEmpty() == false);
   attributeKey = "VectorAttribute<" + attributeKey + ">";
 
   int32_t numElements = DIM0;
@@ -387,8 +392,8 @@ herr_t testReadVectorAttribute(hid_t file_id, QString dsetName )
   }
   QVector<T> rData(numElements, 0); //allocate and zero out the memory
   err = QH5Lite::readVectorAttribute(file_id, dsetName, attributeKey, rData);
-  DREAM3D_REQUIRE(err >= 0);
-  DREAM3D_REQUIRE( data == rData );
+  EMSOFT_REQUIRE(err >= 0);
+  EMSOFT_REQUIRE( data == rData );
   return err;
 }
 
@@ -401,10 +406,10 @@ herr_t testWriteScalarAttribute(hid_t file_id, const QString& dsetName)
   T value = 0x0F;
   herr_t err = -1;
   QString attributeKey = QH5Lite::HDFTypeForPrimitiveAsStr(value);
-  DREAM3D_REQUIRE(attributeKey.isEmpty() == false);
+  EMSOFT_REQUIRE(attributeKey.isEmpty() == false);
   attributeKey = "ScalarAttribute<" + attributeKey + ">";
   err = QH5Lite::writeScalarAttribute(file_id, dsetName, attributeKey, value);
-  DREAM3D_REQUIRE(err >= 0);
+  EMSOFT_REQUIRE(err >= 0);
   return err;
 }
 
@@ -418,12 +423,12 @@ herr_t testReadScalarAttribute(hid_t file_id, const QString& dsetName)
   T refValue = value;
   herr_t err = -1;
   QString attributeKey = QH5Lite::HDFTypeForPrimitiveAsStr(value);
-  DREAM3D_REQUIRE(attributeKey.isEmpty() == false);
+  EMSOFT_REQUIRE(attributeKey.isEmpty() == false);
   attributeKey = "ScalarAttribute<" + attributeKey + ">";
 
   err = QH5Lite::readScalarAttribute(file_id, dsetName, attributeKey, value);
-  DREAM3D_REQUIRE(err >= 0);
-  DREAM3D_REQUIRE(refValue == value);
+  EMSOFT_REQUIRE(err >= 0);
+  EMSOFT_REQUIRE(refValue == value);
   return err;
 }
 
@@ -456,7 +461,7 @@ herr_t testWritePointer2DArrayDataset(hid_t file_id)
   dsetName = "Pointer2DArrayDataset<" + dsetName + ">";
   qDebug() << "Running " << dsetName << " ... ";
   err = QH5Lite::writePointerDataset( file_id, dsetName, rank, dims, &(data.front()) );
-  DREAM3D_REQUIRE(err >= 0);
+  EMSOFT_REQUIRE(err >= 0);
   err = testWritePointer1DArrayAttribute<int8_t>(file_id, dsetName);
   err = testWritePointer1DArrayAttribute<uint8_t>(file_id, dsetName);
   err = testWritePointer1DArrayAttribute<int16_t>(file_id, dsetName);
@@ -537,7 +542,7 @@ herr_t testWriteVectorDataset(hid_t file_id)
   dsetName = "VectorDataset<" + dsetName + ">";
   qDebug() << "Running " << dsetName << " ... ";
   err = QH5Lite::writeVectorDataset<T>( file_id, dsetName, dims, data );
-  DREAM3D_REQUIRE(err >= 0);
+  EMSOFT_REQUIRE(err >= 0);
 
   qDebug() << " Passed" << "\n";
   return err;
@@ -565,8 +570,8 @@ herr_t testReadVectorDataset(hid_t file_id)
 
   std::vector<T> data;
   err = QH5Lite::readVectorDataset( file_id, dsetName, data );
-  DREAM3D_REQUIRE(err >= 0);
-  DREAM3D_REQUIRE(data == referenceData);
+  EMSOFT_REQUIRE(err >= 0);
+  EMSOFT_REQUIRE(data == referenceData);
 
   qDebug() << " Passed" << "\n";
   return err;
@@ -585,13 +590,13 @@ herr_t testWriteScalarDataset(hid_t file_id)
   dsetName = "ScalarDataset<" + dsetName + ">";
   qDebug() << "Running " << dsetName << " ... ";
   err = QH5Lite::writeScalarDataset(file_id, dsetName, value );
-  DREAM3D_REQUIRE(err >= 0);
+  EMSOFT_REQUIRE(err >= 0);
 
   bool exists = QH5Lite::datasetExists(file_id, dsetName);
-  DREAM3D_REQUIRE_EQUAL(exists, true);
+  EMSOFT_REQUIRE_EQUAL(exists, true);
 
   exists = QH5Lite::datasetExists(file_id, QString("DOES_NOT_EXIST") );
-  DREAM3D_REQUIRE_EQUAL(exists, false);
+  EMSOFT_REQUIRE_EQUAL(exists, false);
 
   qDebug() << " Passed" << "\n";
   return err;
@@ -613,8 +618,8 @@ herr_t testReadScalarDataset(hid_t file_id)
   dsetName = "ScalarDataset<" + dsetName + ">";
 
   err = QH5Lite::readScalarDataset(file_id, dsetName, value );
-  DREAM3D_REQUIRE(err >= 0);
-  DREAM3D_REQUIRE(refValue == value );
+  EMSOFT_REQUIRE(err >= 0);
+  EMSOFT_REQUIRE(refValue == value );
 
   qDebug() << " Passed" << "\n";
   return err;
@@ -630,7 +635,7 @@ herr_t testMXAAttribute(hid_t file_id, const QString& dsetName)
   T value = 0x0F;
   herr_t err = -1;
   QString attributeKey = QH5Lite::HDFTypeForPrimitiveAsStr(value);
-  DREAM3D_REQUIRE(attributeKey.isEmpty() == false);
+  EMSOFT_REQUIRE(attributeKey.isEmpty() == false);
   attributeKey = "MXAAttribute<" + attributeKey + ">";
   IMXAArray* array = MXAArrayTemplate<T>::New(10);
   IMXAArray::Pointer arrayPtr (array);
@@ -640,25 +645,25 @@ herr_t testMXAAttribute(hid_t file_id, const QString& dsetName)
     p[var] = static_cast<T>(var + 65);
   }
   err = QH5Lite::writeMXAAttribute(file_id, dsetName, attributeKey, array);
-  DREAM3D_REQUIRE(err >= 0);
+  EMSOFT_REQUIRE(err >= 0);
 
   // Now Read the Attribute back into an MXAArray object and test against the previous for equality
   IMXAArray* rArray = QH5Lite::readMXAAttribute(file_id, dsetName, attributeKey);
-  DREAM3D_REQUIRE (rArray != NULL);
+  EMSOFT_REQUIRE (rArray != NULL);
   //hid_t t = rArray->getDataType();
   IMXAArray::Pointer rArrayPtr(rArray); // Let boost clean up the pointer
   T* r = static_cast<T*>(rArrayPtr->getVoidPointer(0));
 //  for (int var = 0; var < 10; ++var) {
 //    qDebug() << "p=" << p[var] << "  r=" << (r[var]) << "\n";
 //  }
-  DREAM3D_REQUIRE( ::memcmp(r, p, sizeof(T) * 10) == 0);
+  EMSOFT_REQUIRE( ::memcmp(r, p, sizeof(T) * 10) == 0);
 
 
 
   AbstractH5Attribute::Pointer ptr = H5Attribute::ReadH5Attribute(file_id, dsetName, attributeKey);
-  DREAM3D_REQUIRE(ptr.get() != NULL);
+  EMSOFT_REQUIRE(ptr.get() != NULL);
   r = static_cast<T*>(ptr->getAttributeValue()->getVoidPointer(0));
-  DREAM3D_REQUIRE( ::memcmp(r, p, sizeof(T) * 10) == 0);
+  EMSOFT_REQUIRE( ::memcmp(r, p, sizeof(T) * 10) == 0);
 
   return err;
 }
@@ -685,28 +690,28 @@ herr_t testWriteMXAArray(hid_t file_id)
     p[var] = static_cast<T>(var);
   }
   err = QH5Lite::writeMXAArray(file_id, dsetName, array);
-  DREAM3D_REQUIRE(err >= 0);
-
-  DREAM3D_REQUIRE ( testMXAAttribute<int8_t>(file_id, dsetName) >= 0 );
-  DREAM3D_REQUIRE ( testMXAAttribute<uint8_t>(file_id, dsetName) >= 0 );
-  DREAM3D_REQUIRE ( testMXAAttribute<int16_t>(file_id, dsetName) >= 0 );
-  DREAM3D_REQUIRE ( testMXAAttribute<uint16_t>(file_id, dsetName) >= 0 );
-  DREAM3D_REQUIRE ( testMXAAttribute<int32_t>(file_id, dsetName) >= 0 );
-  DREAM3D_REQUIRE ( testMXAAttribute<uint32_t>(file_id, dsetName) >= 0 );
-  DREAM3D_REQUIRE ( testMXAAttribute<int64_t>(file_id, dsetName) >= 0 );
-  DREAM3D_REQUIRE ( testMXAAttribute<uint64_t>(file_id, dsetName) >= 0 );
-  DREAM3D_REQUIRE ( testMXAAttribute<float32>(file_id, dsetName) >= 0 );
-  DREAM3D_REQUIRE ( testMXAAttribute<float64>(file_id, dsetName) >= 0 );
+  EMSOFT_REQUIRE(err >= 0);
+
+  EMSOFT_REQUIRE ( testMXAAttribute<int8_t>(file_id, dsetName) >= 0 );
+  EMSOFT_REQUIRE ( testMXAAttribute<uint8_t>(file_id, dsetName) >= 0 );
+  EMSOFT_REQUIRE ( testMXAAttribute<int16_t>(file_id, dsetName) >= 0 );
+  EMSOFT_REQUIRE ( testMXAAttribute<uint16_t>(file_id, dsetName) >= 0 );
+  EMSOFT_REQUIRE ( testMXAAttribute<int32_t>(file_id, dsetName) >= 0 );
+  EMSOFT_REQUIRE ( testMXAAttribute<uint32_t>(file_id, dsetName) >= 0 );
+  EMSOFT_REQUIRE ( testMXAAttribute<int64_t>(file_id, dsetName) >= 0 );
+  EMSOFT_REQUIRE ( testMXAAttribute<uint64_t>(file_id, dsetName) >= 0 );
+  EMSOFT_REQUIRE ( testMXAAttribute<float32>(file_id, dsetName) >= 0 );
+  EMSOFT_REQUIRE ( testMXAAttribute<float64>(file_id, dsetName) >= 0 );
 
   // Now Read the Attribute back into an MXAArray object and test against the previous for equality
   IMXAArray* rArray = QH5Lite::readMXAArray(file_id, dsetName);
-  DREAM3D_REQUIRE (rArray != NULL);
+  EMSOFT_REQUIRE (rArray != NULL);
   IMXAArray::Pointer rArrayPtr(rArray); // Let boost clean up the pointer
   T* r = static_cast<T*>(rArrayPtr->getVoidPointer(0));
 //  for (int var = 0; var < 10; ++var) {
 //    qDebug() << "p=" << p[var] << "  r=" << (r[var]) << "\n";
 //  }
-  DREAM3D_REQUIRE( ::memcmp(r, p, sizeof(T) * 10) == 0);
+  EMSOFT_REQUIRE( ::memcmp(r, p, sizeof(T) * 10) == 0);
 
   qDebug() << " Passed" << "\n";
   return err;
@@ -732,36 +737,36 @@ herr_t testWriteStringDatasetAndAttributes(hid_t file_id)
 
   // Write a String Data set using a QString as the data source
   err = QH5Lite::writeStringDataset(file_id, dsetName, strData);
-  DREAM3D_REQUIRE(err >= 0);
+  EMSOFT_REQUIRE(err >= 0);
 
   // Over Write the data from Above but with different values
   strData = "THIS IS XXX DATA";
   err = QH5Lite::writeStringDataset(file_id, dsetName, strData);
-  DREAM3D_REQUIRE(err >= 0);
+  EMSOFT_REQUIRE(err >= 0);
 
   // Over Write the data from Above but with longer string
   strData = "THIS IS LONGER DATA";
   err = QH5Lite::writeStringDataset(file_id, dsetName, strData);
-  DREAM3D_REQUIRE(err >= 0);
+  EMSOFT_REQUIRE(err >= 0);
 
   // Over Write the data from Above but with shorter string
   strData = "THIS IS LESS DATA";
   err = QH5Lite::writeStringDataset(file_id, dsetName, strData);
-  DREAM3D_REQUIRE(err >= 0);
+  EMSOFT_REQUIRE(err >= 0);
 
   // Over Write the data from Above but with even shorter string
   strData = "Even LESS DATA";
   err = QH5Lite::writeStringDataset(file_id, dsetName, strData);
-  DREAM3D_REQUIRE(err >= 0);
+  EMSOFT_REQUIRE(err >= 0);
 
   // Over Write the data from Above but with even shorter string
   strData = "THIS IS THE DATA";
   err = QH5Lite::writeStringDataset(file_id, dsetName, strData);
-  DREAM3D_REQUIRE(err >= 0);
+  EMSOFT_REQUIRE(err >= 0);
 
   // Write a String attribute using a QString as the data source
   err = QH5Lite::writeStringAttribute(file_id, dsetName, attributeKey, attrData);
-  DREAM3D_REQUIRE(err >= 0);
+  EMSOFT_REQUIRE(err >= 0);
 
   attributeKey = "c_string";
   err = QH5Lite::writeStringAttribute(file_id, dsetName, attributeKey, attrDataBytes.size() + 1, attrDataBytes.data());
@@ -769,7 +774,7 @@ herr_t testWriteStringDatasetAndAttributes(hid_t file_id)
 
 // Write a String data set using char* as data source
   err = QH5Lite::writeStringDataset(file_id, dsetNameBytes, strDataBytes.size() + 1, strDataBytes.data());
-  DREAM3D_REQUIRE(err >= 0);
+  EMSOFT_REQUIRE(err >= 0);
 
   // Write a bunch of Attributes using a Map structure.
   QMap<QString, QString> attrMap;
@@ -778,7 +783,7 @@ herr_t testWriteStringDatasetAndAttributes(hid_t file_id)
   attrMap[attributeKey] = attrData;
 
   err = QH5Lite::writeStringAttributes(file_id, dsetNameBytes, attrMap);
-  DREAM3D_REQUIRE(err >= 0);
+  EMSOFT_REQUIRE(err >= 0);
 
   qDebug() << " Passed";
   return err;
@@ -876,16 +881,16 @@ herr_t testReadPointer2DArrayDataset(hid_t file_id)
   size_t attr_size;
 
   err = QH5Lite::getDatasetInfo(file_id, "FOOBAR", dims, attr_type, attr_size);
-  DREAM3D_REQUIRE(err < 0);
+  EMSOFT_REQUIRE(err < 0);
 
   err = QH5Lite::getDatasetInfo(file_id, dsetName, dims, attr_type, attr_size);
-  DREAM3D_REQUIRE(err >= 0);
-  DREAM3D_REQUIRE(dims.size() == 2);
-  DREAM3D_REQUIRE(attr_size == sizeof(T));
+  EMSOFT_REQUIRE(err >= 0);
+  EMSOFT_REQUIRE(dims.size() == 2);
+  EMSOFT_REQUIRE(attr_size == sizeof(T));
   hid_t rank = 0;
   err = QH5Lite::getDatasetNDims(file_id, dsetName, rank);
-  DREAM3D_REQUIRE(err >= 0);
-  DREAM3D_REQUIRE(rank == 2);
+  EMSOFT_REQUIRE(err >= 0);
+  EMSOFT_REQUIRE(rank == 2);
   typename QVector<T>::size_type numElements = 1;
   for (QVector<hsize_t>::size_type i = 0; i < dims.size(); ++i)
   {
@@ -914,24 +919,24 @@ herr_t testReadPointer2DArrayDataset(hid_t file_id)
     return retErr;
   }
 
-  DREAM3D_REQUIRE (tid > 0);
+  EMSOFT_REQUIRE (tid > 0);
 //  qDebug() << QH5Lite::StringForHDFType(tid) << "\n";
   err = H5Tclose(tid);
-  DREAM3D_REQUIRE(err >= 0);
+  EMSOFT_REQUIRE(err >= 0);
 
   hid_t dsType = QH5Lite::getDatasetType(file_id, dsetName);
-  DREAM3D_REQUIRE (dsType > 0);
+  EMSOFT_REQUIRE (dsType > 0);
 //  qDebug() << QH5Lite::StringForHDFType(dsType) << "\n";
 
 
   err = H5Tclose(dsType);
-  DREAM3D_REQUIRE(err >= 0);
+  EMSOFT_REQUIRE(err >= 0);
 
   QVector<T> data(numElements, 0);
   err = QH5Lite::readPointerDataset(file_id, dsetName, data.data() );
-  DREAM3D_REQUIRE(err >= 0);
+  EMSOFT_REQUIRE(err >= 0);
   // Compare the data...
-  DREAM3D_REQUIRE(data == referenceData);
+  EMSOFT_REQUIRE(data == referenceData);
 
   //Read all the attributes
   err = testReadPointer1DArrayAttribute<int8_t>(file_id, dsetName);
@@ -993,6 +998,267 @@ herr_t testReadPointer2DArrayDataset(hid_t file_id)
   return err;
 }
 
+// -----------------------------------------------------------------------------
+//  Writes and reads hyperslabs of a 3D dataset
+// -----------------------------------------------------------------------------
+template <typename T>
+herr_t testHyperslabDataset(hid_t file_id)
+{
+  T value = 0x0;
+  herr_t err = 1;
+  int32_t rank = 3;
+  hsize_t dims[3] = { DIM0, DIM1, DIM };
+
+  int32_t tSize = dims[0] * dims[1] * dims[2];
+  QVector<T> data(tSize, 0);
+
+  QString dsetName = QH5Lite::HDFTypeForPrimitiveAsStr(value);
+  qDebug() << "Running testHyperslabDataset<" << dsetName << "> ... ";
+  dsetName = "HyperslabDataset<" + dsetName + ">";
+  err = QH5Lite::writePointerDataset( file_id, dsetName, rank, dims, data.data() );
+  EMSOFT_REQUIRE(err >= 0);
+
+  // Every other element of the last dimension in a 2 x 2 block of the first two
+  QVector<hsize_t> offset(3, 0);
+  offset[0] = 1;
+  offset[1] = 1;
+  offset[2] = 1;
+  QVector<hsize_t> count(3, 2);
+  count[2] = DIM / 2 - 1;
+  QVector<hsize_t> stride(3, 1);
+  stride[2] = 2;
+
+  int32_t slabSize = count[0] * count[1] * count[2];
+  QVector<T> slab(slabSize);
+  for (int32_t i = 0; i < slabSize; ++i)
+  {
+    slab[i] = static_cast<T>(i + 1);
+  }
+  err = QH5Lite::writePointerDatasetHyperslab(file_id, dsetName, offset, count, stride, slab.data());
+  EMSOFT_REQUIRE(err >= 0);
+
+  // Build what the whole dataset should now hold
+  QVector<T> referenceData(tSize, 0);
+  int32_t slabIndex = 0;
+  for (hsize_t z = 0; z < count[0]; ++z)
+  {
+    for (hsize_t y = 0; y < count[1]; ++y)
+    {
+      for (hsize_t x = 0; x < count[2]; ++x)
+      {
+        hsize_t index = ((offset[0] + z) * dims[1] + (offset[1] + y)) * dims[2] + (offset[2] + x * stride[2]);
+        referenceData[index] = slab[slabIndex++];
+      }
+    }
+  }
+
+  err = QH5Lite::readPointerDataset(file_id, dsetName, data.data());
+  EMSOFT_REQUIRE(err >= 0);
+  EMSOFT_REQUIRE(data == referenceData);
+
+  QVector<T> rSlab(slabSize, 0);
+  err = QH5Lite::readPointerDatasetHyperslab(file_id, dsetName, offset, count, stride, rSlab.data());
+  EMSOFT_REQUIRE(err >= 0);
+  EMSOFT_REQUIRE(rSlab == slab);
+
+  // A single plane with the default stride
+  offset = QVector<hsize_t>(3, 0);
+  offset[0] = DIM0 - 1;
+  count = QVector<hsize_t>(3, 1);
+  count[1] = DIM1;
+  count[2] = DIM;
+  QVector<T> plane(DIM1 * DIM, 0);
+  err = QH5Lite::readPointerDatasetHyperslab(file_id, dsetName, offset, count, plane.data());
+  EMSOFT_REQUIRE(err >= 0);
+  EMSOFT_REQUIRE(plane == referenceData.mid((DIM0 - 1) * DIM1 * DIM, DIM1 * DIM));
+
+  // The hyperslab must have the rank of the dataset
+  count.resize(2);
+  err = QH5Lite::readPointerDatasetHyperslab(file_id, dsetName, offset, count, plane.data());
+  EMSOFT_REQUIRE(err < 0);
+
+  qDebug() << " Passed" << "\n";
+  return 1;
+}
+
+// -----------------------------------------------------------------------------
+//  Writes chunked and compressed 3D datasets and reads them back
+// -----------------------------------------------------------------------------
+template <typename T>
+herr_t testChunkedDataset(hid_t file_id)
+{
+  T value = 0x0;
+  herr_t err = 1;
+  int32_t rank = 3;
+  hsize_t dims[3] = { DIM0, DIM1, DIM };
+
+  int32_t tSize = dims[0] * dims[1] * dims[2];
+  QVector<T> data(tSize, 0);
+  for (int32_t i = 0; i < tSize; ++i)
+  {
+    data[i] = static_cast<T>(i % 100);
+  }
+
+  QString dsetName = QH5Lite::HDFTypeForPrimitiveAsStr(value);
+  qDebug() << "Running testChunkedDataset<" << dsetName << "> ... ";
+  dsetName = "ChunkedDataset<" + dsetName + ">";
+
+  // One plane per chunk, shuffled and deflated
+  H5Lite::DatasetCreationOptions options;
+  options.chunkDims.push_back(1);
+  options.chunkDims.push_back(DIM1);
+  options.chunkDims.push_back(DIM);
+  options.deflateLevel = 6;
+  options.shuffle = true;
+  options.hasFillValue = true;
+  options.fillValue = 1.0;
+  err = QH5Lite::writePointerDataset( file_id, dsetName, rank, dims, data.data(), options );
+  EMSOFT_REQUIRE(err >= 0);
+
+  QVector<T> rData(tSize, 0);
+  err = QH5Lite::readPointerDataset(file_id, dsetName, rData.data());
+  EMSOFT_REQUIRE(err >= 0);
+  EMSOFT_REQUIRE(rData == data);
+
+  hid_t did = H5Dopen(file_id, dsetName.toLatin1().data(), H5P_DEFAULT);
+  EMSOFT_REQUIRE(did >= 0);
+  hid_t dcpl = H5Dget_create_plist(did);
+  EMSOFT_REQUIRE(dcpl >= 0);
+  EMSOFT_REQUIRE(H5Pget_layout(dcpl) == H5D_CHUNKED);
+  hsize_t chunkDims[3] = { 0, 0, 0 };
+  EMSOFT_REQUIRE(H5Pget_chunk(dcpl, 3, chunkDims) == 3);
+  EMSOFT_REQUIRE(chunkDims[0] == 1 && chunkDims[1] == DIM1 && chunkDims[2] == DIM);
+  if (H5Zfilter_avail(H5Z_FILTER_DEFLATE) > 0)
+  {
+    EMSOFT_REQUIRE(H5Pget_nfilters(dcpl) == 2);
+  }
+  H5Pclose(dcpl);
+  H5Dclose(did);
+
+  // Compression without chunk dimensions picks the default chunk shape
+  QString defaultName = dsetName + "_Default";
+  H5Lite::DatasetCreationOptions defaultOptions;
+  defaultOptions.deflateLevel = 1;
+  err = QH5Lite::replacePointerDataset( file_id, defaultName, rank, dims, data.data(), defaultOptions );
+  EMSOFT_REQUIRE(err >= 0);
+  err = QH5Lite::readPointerDataset(file_id, defaultName, rData.data());
+  EMSOFT_REQUIRE(err >= 0);
+  EMSOFT_REQUIRE(rData == data);
+
+  std::vector<hsize_t> expected = H5Lite::defaultChunkDimensions(rank, dims, sizeof(T));
+  EMSOFT_REQUIRE(expected.size() == 3);
+  EMSOFT_REQUIRE(expected[1] == DIM1 && expected[2] == DIM);
+  did = H5Dopen(file_id, defaultName.toLatin1().data(), H5P_DEFAULT);
+  EMSOFT_REQUIRE(did >= 0);
+  dcpl = H5Dget_create_plist(did);
+  EMSOFT_REQUIRE(H5Pget_chunk(dcpl, 3, chunkDims) == 3);
+  EMSOFT_REQUIRE(chunkDims[0] == expected[0] && chunkDims[1] == expected[1] && chunkDims[2] == expected[2]);
+  H5Pclose(dcpl);
+  H5Dclose(did);
+
+  // The chunk dimensions must have the rank of the dataset
+  options.chunkDims.resize(2);
+  err = QH5Lite::writePointerDataset( file_id, dsetName + "_BadChunk", rank, dims, data.data(), options );
+  EMSOFT_REQUIRE(err < 0);
+
+  qDebug() << " Passed" << "\n";
+  return 1;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+template<typename T>
+herr_t testExtendibleDataset(hid_t file_id)
+{
+  T value = 0x0;
+  herr_t err = 1;
+  QVector<hsize_t> rowDims;
+  rowDims.push_back(DIM1);
+  rowDims.push_back(DIM);
+  int32_t rowSize = DIM1 * DIM;
+
+  QString dsetName = QH5Lite::HDFTypeForPrimitiveAsStr(value);
+  qDebug() << "Running testExtendibleDataset<" << dsetName << "> ... ";
+  dsetName = "ExtendibleDataset<" + dsetName + ">";
+
+  err = QH5Lite::createExtendibleDataset<T>(file_id, dsetName, rowDims);
+  EMSOFT_REQUIRE(err >= 0);
+  QVector<hsize_t> dims;
+  H5T_class_t type_class;
+  size_t type_size = 0;
+  err = QH5Lite::getDatasetInfo(file_id, dsetName, dims, type_class, type_size);
+  EMSOFT_REQUIRE(err >= 0);
+  EMSOFT_REQUIRE(dims.size() == 3 && dims[0] == 0 && dims[1] == DIM1 && dims[2] == DIM);
+
+  // Append the rows in batches of different sizes, including an empty one
+  int32_t batches[4] = { 1, 0, DIM0, 2 };
+  int32_t totalRows = 1 + DIM0 + 2;
+  QVector<T> data(totalRows * rowSize, 0);
+  for (int32_t i = 0; i < data.size(); ++i)
+  {
+    data[i] = static_cast<T>(i % 100);
+  }
+  int32_t row = 0;
+  for (int32_t b = 0; b < 4; ++b)
+  {
+    hsize_t numRows = 0;
+    err = QH5Lite::appendSlab(file_id, dsetName, data.data() + row * rowSize, batches[b], &numRows);
+    EMSOFT_REQUIRE(err >= 0);
+    row += batches[b];
+    EMSOFT_REQUIRE(numRows == static_cast<hsize_t>(row));
+  }
+
+  err = QH5Lite::getDatasetInfo(file_id, dsetName, dims, type_class, type_size);
+  EMSOFT_REQUIRE(err >= 0);
+  EMSOFT_REQUIRE(dims.size() == 3 && dims[0] == static_cast<hsize_t>(totalRows));
+  EMSOFT_REQUIRE(type_size == sizeof(T));
+
+  QVector<T> rData(totalRows * rowSize, 0);
+  err = QH5Lite::readPointerDataset(file_id, dsetName, rData.data());
+  EMSOFT_REQUIRE(err >= 0);
+  EMSOFT_REQUIRE(rData == data);
+
+  hid_t did = H5Dopen(file_id, dsetName.toLatin1().data(), H5P_DEFAULT);
+  EMSOFT_REQUIRE(did >= 0);
+  hid_t dcpl = H5Dget_create_plist(did);
+  EMSOFT_REQUIRE(H5Pget_layout(dcpl) == H5D_CHUNKED);
+  hsize_t chunkDims[3] = { 0, 0, 0 };
+  EMSOFT_REQUIRE(H5Pget_chunk(dcpl, 3, chunkDims) == 3);
+  EMSOFT_REQUIRE(chunkDims[0] > 0 && chunkDims[1] == DIM1 && chunkDims[2] == DIM);
+  H5Pclose(dcpl);
+  H5Dclose(did);
+
+  // A fixed size dataset can not be appended to
+  hsize_t fixedDims[3] = { 1, DIM1, DIM };
+  err = QH5Lite::writePointerDataset(file_id, dsetName + "_Fixed", 3, fixedDims, data.data());
+  EMSOFT_REQUIRE(err >= 0);
+  err = QH5Lite::appendSlab(file_id, dsetName + "_Fixed", data.data(), 1);
+  EMSOFT_REQUIRE(err < 0);
+
+  // Explicit chunk dimensions and compression
+  H5Lite::DatasetCreationOptions options;
+  options.chunkDims.push_back(2);
+  options.chunkDims.push_back(DIM1);
+  options.chunkDims.push_back(DIM);
+  options.deflateLevel = 1;
+  err = QH5Lite::createExtendibleDataset<T>(file_id, dsetName + "_Deflate", rowDims, options);
+  EMSOFT_REQUIRE(err >= 0);
+  err = QH5Lite::appendSlab(file_id, dsetName + "_Deflate", data.data(), totalRows);
+  EMSOFT_REQUIRE(err >= 0);
+  err = QH5Lite::readPointerDataset(file_id, dsetName + "_Deflate", rData.data());
+  EMSOFT_REQUIRE(err >= 0);
+  EMSOFT_REQUIRE(rData == data);
+
+  // The chunk dimensions must have the rank of the dataset
+  options.chunkDims.resize(2);
+  err = QH5Lite::createExtendibleDataset<T>(file_id, dsetName + "_BadChunk", rowDims, options);
+  EMSOFT_REQUIRE(err < 0);
+
+  qDebug() << " Passed" << "\n";
+  return 1;
+}
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -1036,43 +1302,43 @@ herr_t testReadStringDatasetAndAttributes(hid_t file_id)
   QString strData ("");
   // Read the string as a QString from the file
   err = QH5Lite::readStringDataset(file_id, dsetName, strData);
-  DREAM3D_REQUIRE(err >= 0);
-  DREAM3D_REQUIRE( refData.compare(strData) == 0);
+  EMSOFT_REQUIRE(err >= 0);
+  EMSOFT_REQUIRE( refData.compare(strData) == 0);
 
   // Read the string again this time passing in a QString that has data in it which should get cleared
   strData = "FooBarJunk";
   err = QH5Lite::readStringDataset(file_id, dsetName, strData);
-  DREAM3D_REQUIRE(err >= 0);
-  DREAM3D_REQUIRE( refData.compare(strData) == 0);
+  EMSOFT_REQUIRE(err >= 0);
+  EMSOFT_REQUIRE( refData.compare(strData) == 0);
 
   // Read the Attributes
   QString attrData ("");
   // Read the Attribute as a QString and compare to the reference
   err = QH5Lite::readStringAttribute(file_id, dsetName, attributeKey, attrData);
-  DREAM3D_REQUIRE(err >= 0);
-  DREAM3D_REQUIRE( refAttrData.compare(attrData) == 0);
+  EMSOFT_REQUIRE(err >= 0);
+  EMSOFT_REQUIRE( refAttrData.compare(attrData) == 0);
 
   // Read the attribute as a byte array (US ASCII NULL TERM)
   QByteArray attrDataPtr(refAttrDataBytes.size(), 0); // Create a null terminated string initialized to all zeros
   attributeKey = "c_string";
   err = QH5Lite::readStringAttribute(file_id, dsetName, attributeKey, attrDataPtr.data() );
-  DREAM3D_REQUIRE(err >= 0);
-  DREAM3D_REQUIRE( ::memcmp(attrDataPtr.data(), refAttrDataBytes.data(), refAttrDataBytes.size()) == 0 );
+  EMSOFT_REQUIRE(err >= 0);
+  EMSOFT_REQUIRE( ::memcmp(attrDataPtr.data(), refAttrDataBytes.data(), refAttrDataBytes.size()) == 0 );
 
   // Read a string data set which was written as a QByteArray into a QByteArray
   QByteArray strDataBytes(refDataBytes.size(), 0);
   err = QH5Lite::readStringDataset(file_id, dsetNameBytes, strDataBytes.data());
-  DREAM3D_REQUIRE(err >= 0);
-  DREAM3D_REQUIRE( strDataBytes == refDataBytes);
+  EMSOFT_REQUIRE(err >= 0);
+  EMSOFT_REQUIRE( strDataBytes == refDataBytes);
 
   QString mapString;
   err = QH5Lite::readStringAttribute(file_id, dsetNameBytes, dsetNameBytes, mapString);
-  DREAM3D_REQUIRE(err >= 0);
-  DREAM3D_REQUIRE( refAttrData.compare(mapString) == 0);
+  EMSOFT_REQUIRE(err >= 0);
+  EMSOFT_REQUIRE( refAttrData.compare(mapString) == 0);
 
   err = QH5Lite::readStringAttribute(file_id, dsetNameBytes, attributeKey, mapString);
-  DREAM3D_REQUIRE(err >= 0);
-  DREAM3D_REQUIRE( refAttrData.compare(mapString) == 0);
+  EMSOFT_REQUIRE(err >= 0);
+  EMSOFT_REQUIRE( refAttrData.compare(mapString) == 0);
 
   qDebug() << " Passed" << "\n";
   return err;
@@ -1087,7 +1353,7 @@ void QH5LiteTest()
   hid_t   file_id = 0;
   /* Create a new file using default properties. */
   file_id = H5Fcreate( UnitTest::H5LiteTest::FileName.toLatin1().data(), H5F_ACC_TRUNC, H5P_DEFAULT, H5P_DEFAULT );
-  DREAM3D_REQUIRE(file_id > 0);
+  EMSOFT_REQUIRE(file_id > 0);
   //Create the Extra Groups
   hid_t sintGid = H5Gcreate(file_id, "Signed Int", H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
   hid_t uintGid = H5Gcreate(file_id, "Unsigned Int", H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
@@ -1112,89 +1378,122 @@ void QH5LiteTest()
   }
 
   // qDebug() << logTime() << "----------- Testing Writing/Reading of Datasets using Raw Pointers -----------" << "\n";
-  DREAM3D_REQUIRE ( testWritePointer2DArrayDataset<int8_t>(file_id) >= 0);
-  DREAM3D_REQUIRE ( testWritePointer2DArrayDataset<uint8_t>(file_id) >= 0);
-  DREAM3D_REQUIRE ( testWritePointer2DArrayDataset<int16_t>(file_id) >= 0);
-  DREAM3D_REQUIRE ( testWritePointer2DArrayDataset<uint16_t>(file_id) >= 0);
-  DREAM3D_REQUIRE ( testWritePointer2DArrayDataset<int32_t>(file_id) >= 0);
-  DREAM3D_REQUIRE ( testWritePointer2DArrayDataset<uint32_t>(file_id) >= 0);
-  DREAM3D_REQUIRE ( testWritePointer2DArrayDataset<int64_t>(file_id) >= 0);
-  DREAM3D_REQUIRE ( testWritePointer2DArrayDataset<uint64_t>(file_id) >= 0);
-  DREAM3D_REQUIRE ( testWritePointer2DArrayDataset<float32>(file_id) >= 0);
-  DREAM3D_REQUIRE ( testWritePointer2DArrayDataset<float64>(file_id) >= 0);
-
-  DREAM3D_REQUIRE ( testWriteVectorDataset<int8_t>(file_id) >= 0);
-  DREAM3D_REQUIRE ( testWriteVectorDataset<uint8_t>(file_id) >= 0);
-  DREAM3D_REQUIRE ( testWriteVectorDataset<int16_t>(file_id) >= 0);
-  DREAM3D_REQUIRE ( testWriteVectorDataset<uint16_t>(file_id) >= 0);
-  DREAM3D_REQUIRE ( testWriteVectorDataset<int32_t>(file_id) >= 0);
-  DREAM3D_REQUIRE ( testWriteVectorDataset<uint32_t>(file_id) >= 0);
-  DREAM3D_REQUIRE ( testWriteVectorDataset<int64_t>(file_id) >= 0);
-  DREAM3D_REQUIRE ( testWriteVectorDataset<uint64_t>(file_id) >= 0);
-  DREAM3D_REQUIRE ( testWriteVectorDataset<float32>(file_id) >= 0);
-  DREAM3D_REQUIRE ( testWriteVectorDataset<float64>(file_id) >= 0);
-
-  DREAM3D_REQUIRE ( testWriteScalarDataset<int8_t>(file_id) >= 0);
-  DREAM3D_REQUIRE ( testWriteScalarDataset<uint8_t>(file_id) >= 0);
-  DREAM3D_REQUIRE ( testWriteScalarDataset<int16_t>(file_id) >= 0);
-  DREAM3D_REQUIRE ( testWriteScalarDataset<uint16_t>(file_id) >= 0);
-  DREAM3D_REQUIRE ( testWriteScalarDataset<int32_t>(file_id) >= 0);
-  DREAM3D_REQUIRE ( testWriteScalarDataset<uint32_t>(file_id) >= 0);
-  DREAM3D_REQUIRE ( testWriteScalarDataset<int64_t>(file_id) >= 0);
-  DREAM3D_REQUIRE ( testWriteScalarDataset<uint64_t>(file_id) >= 0);
-  DREAM3D_REQUIRE ( testWriteScalarDataset<float32>(file_id) >= 0);
-  DREAM3D_REQUIRE ( testWriteScalarDataset<float64>(file_id) >= 0);
-
-  DREAM3D_REQUIRE ( testWriteStringDatasetAndAttributes(file_id) >= 0);
-
-//   DREAM3D_REQUIRE ( testWriteMXAArray<int8_t>(file_id) >= 0);
-//   DREAM3D_REQUIRE ( testWriteMXAArray<uint8_t>(file_id) >= 0);
-//   DREAM3D_REQUIRE ( testWriteMXAArray<int16_t>(file_id) >= 0);
-//   DREAM3D_REQUIRE ( testWriteMXAArray<uint16_t>(file_id) >= 0);
-//   DREAM3D_REQUIRE ( testWriteMXAArray<int32_t>(file_id) >= 0);
-//   DREAM3D_REQUIRE ( testWriteMXAArray<uint32_t>(file_id) >= 0);
-//   DREAM3D_REQUIRE ( testWriteMXAArray<int64_t>(file_id) >= 0);
-//   DREAM3D_REQUIRE ( testWriteMXAArray<uint64_t>(file_id) >= 0);
-//   DREAM3D_REQUIRE ( testWriteMXAArray<float32>(file_id) >= 0);
-//   DREAM3D_REQUIRE ( testWriteMXAArray<float64>(file_id) >= 0);
+  EMSOFT_REQUIRE ( testWritePointer2DArrayDataset<int8_t>(file_id) >= 0);
+  EMSOFT_REQUIRE ( testWritePointer2DArrayDataset<uint8_t>(file_id) >= 0);
+  EMSOFT_REQUIRE ( testWritePointer2DArrayDataset<int16_t>(file_id) >= 0);
+  EMSOFT_REQUIRE ( testWritePointer2DArrayDataset<uint16_t>(file_id) >= 0);
+  EMSOFT_REQUIRE ( testWritePointer2DArrayDataset<int32_t>(file_id) >= 0);
+  EMSOFT_REQUIRE ( testWritePointer2DArrayDataset<uint32_t>(file_id) >= 0);
+  EMSOFT_REQUIRE ( testWritePointer2DArrayDataset<int64_t>(file_id) >= 0);
+  EMSOFT_REQUIRE ( testWritePointer2DArrayDataset<uint64_t>(file_id) >= 0);
+  EMSOFT_REQUIRE ( testWritePointer2DArrayDataset<float32>(file_id) >= 0);
+  EMSOFT_REQUIRE ( testWritePointer2DArrayDataset<float64>(file_id) >= 0);
+
+  EMSOFT_REQUIRE ( testWriteVectorDataset<int8_t>(file_id) >= 0);
+  EMSOFT_REQUIRE ( testWriteVectorDataset<uint8_t>(file_id) >= 0);
+  EMSOFT_REQUIRE ( testWriteVectorDataset<int16_t>(file_id) >= 0);
+  EMSOFT_REQUIRE ( testWriteVectorDataset<uint16_t>(file_id) >= 0);
+  EMSOFT_REQUIRE ( testWriteVectorDataset<int32_t>(file_id) >= 0);
+  EMSOFT_REQUIRE ( testWriteVectorDataset<uint32_t>(file_id) >= 0);
+  EMSOFT_REQUIRE ( testWriteVectorDataset<int64_t>(file_id) >= 0);
+  EMSOFT_REQUIRE ( testWriteVectorDataset<uint64_t>(file_id) >= 0);
+  EMSOFT_REQUIRE ( testWriteVectorDataset<float32>(file_id) >= 0);
+  EMSOFT_REQUIRE ( testWriteVectorDataset<float64>(file_id) >= 0);
+
+  EMSOFT_REQUIRE ( testWriteScalarDataset<int8_t>(file_id) >= 0);
+  EMSOFT_REQUIRE ( testWriteScalarDataset<uint8_t>(file_id) >= 0);
+  EMSOFT_REQUIRE ( testWriteScalarDataset<int16_t>(file_id) >= 0);
+  EMSOFT_REQUIRE ( testWriteScalarDataset<uint16_t>(file_id) >= 0);
+  EMSOFT_REQUIRE ( testWriteScalarDataset<int32_t>(file_id) >= 0);
+  EMSOFT_REQUIRE ( testWriteScalarDataset<uint32_t>(file_id) >= 0);
+  EMSOFT_REQUIRE ( testWriteScalarDataset<int64_t>(file_id) >= 0);
+  EMSOFT_REQUIRE ( testWriteScalarDataset<uint64_t>(file_id) >= 0);
+  EMSOFT_REQUIRE ( testWriteScalarDataset<float32>(file_id) >= 0);
+  EMSOFT_REQUIRE ( testWriteScalarDataset<float64>(file_id) >= 0);
+
+  EMSOFT_REQUIRE ( testWriteStringDatasetAndAttributes(file_id) >= 0);
+
+//   EMSOFT_REQUIRE ( testWriteMXAArray<int8_t>(file_id) >= 0);
+//   EMSOFT_REQUIRE ( testWriteMXAArray<uint8_t>(file_id) >= 0);
+//   EMSOFT_REQUIRE ( testWriteMXAArray<int16_t>(file_id) >= 0);
+//   EMSOFT_REQUIRE ( testWriteMXAArray<uint16_t>(file_id) >= 0);
+//   EMSOFT_REQUIRE ( testWriteMXAArray<int32_t>(file_id) >= 0);
+//   EMSOFT_REQUIRE ( testWriteMXAArray<uint32_t>(file_id) >= 0);
+//   EMSOFT_REQUIRE ( testWriteMXAArray<int64_t>(file_id) >= 0);
+//   EMSOFT_REQUIRE ( testWriteMXAArray<uint64_t>(file_id) >= 0);
+//   EMSOFT_REQUIRE ( testWriteMXAArray<float32>(file_id) >= 0);
+//   EMSOFT_REQUIRE ( testWriteMXAArray<float64>(file_id) >= 0);
 
 
 //  // ******************* Test Reading Data *************************************
-  DREAM3D_REQUIRE ( testReadPointer2DArrayDataset<int8_t>(file_id) >= 0);
-  DREAM3D_REQUIRE ( testReadPointer2DArrayDataset<uint8_t>(file_id) >= 0);
-  DREAM3D_REQUIRE ( testReadPointer2DArrayDataset<int16_t>(file_id) >= 0);
-  DREAM3D_REQUIRE ( testReadPointer2DArrayDataset<uint16_t>(file_id) >= 0);
-  DREAM3D_REQUIRE ( testReadPointer2DArrayDataset<int32_t>(file_id) >= 0);
-  DREAM3D_REQUIRE ( testReadPointer2DArrayDataset<uint32_t>(file_id) >= 0);
-  DREAM3D_REQUIRE ( testReadPointer2DArrayDataset<int64_t>(file_id) >= 0);
-  DREAM3D_REQUIRE ( testReadPointer2DArrayDataset<uint64_t>(file_id) >= 0);
-  DREAM3D_REQUIRE ( testReadPointer2DArrayDataset<float32>(file_id) >= 0);
-  DREAM3D_REQUIRE ( testReadPointer2DArrayDataset<float64>(file_id) >= 0);
-
-
-  DREAM3D_REQUIRE ( testReadVectorDataset<int8_t>(file_id) >= 0);
-  DREAM3D_REQUIRE ( testReadVectorDataset<uint8_t>(file_id) >= 0);
-  DREAM3D_REQUIRE ( testReadVectorDataset<int16_t>(file_id) >= 0);
-  DREAM3D_REQUIRE ( testReadVectorDataset<uint16_t>(file_id) >= 0);
-  DREAM3D_REQUIRE ( testReadVectorDataset<int32_t>(file_id) >= 0);
-  DREAM3D_REQUIRE ( testReadVectorDataset<uint32_t>(file_id) >= 0);
-  DREAM3D_REQUIRE ( testReadVectorDataset<int64_t>(file_id) >= 0);
-  DREAM3D_REQUIRE ( testReadVectorDataset<uint64_t>(file_id) >= 0);
-  DREAM3D_REQUIRE ( testReadVectorDataset<float32>(file_id) >= 0);
-  DREAM3D_REQUIRE ( testReadVectorDataset<float64>(file_id) >= 0);
+  EMSOFT_REQUIRE ( testReadPointer2DArrayDataset<int8_t>(file_id) >= 0);
+  EMSOFT_REQUIRE ( testReadPointer2DArrayDataset<uint8_t>(file_id) >= 0);
+  EMSOFT_REQUIRE ( testReadPointer2DArrayDataset<int16_t>(file_id) >= 0);
+  EMSOFT_REQUIRE ( testReadPointer2DArrayDataset<uint16_t>(file_id) >= 0);
+  EMSOFT_REQUIRE ( testReadPointer2DArrayDataset<int32_t>(file_id) >= 0);
+  EMSOFT_REQUIRE ( testReadPointer2DArrayDataset<uint32_t>(file_id) >= 0);
+  EMSOFT_REQUIRE ( testReadPointer2DArrayDataset<int64_t>(file_id) >= 0);
+  EMSOFT_REQUIRE ( testReadPointer2DArrayDataset<uint64_t>(file_id) >= 0);
+  EMSOFT_REQUIRE ( testReadPointer2DArrayDataset<float32>(file_id) >= 0);
+  EMSOFT_REQUIRE ( testReadPointer2DArrayDataset<float64>(file_id) >= 0);
+
+
+  EMSOFT_REQUIRE ( testReadVectorDataset<int8_t>(file_id) >= 0);
+  EMSOFT_REQUIRE ( testReadVectorDataset<uint8_t>(file_id) >= 0);
+  EMSOFT_REQUIRE ( testReadVectorDataset<int16_t>(file_id) >= 0);
+  EMSOFT_REQUIRE ( testReadVectorDataset<uint16_t>(file_id) >= 0);
+  EMSOFT_REQUIRE ( testReadVectorDataset<int32_t>(file_id) >= 0);
+  EMSOFT_REQUIRE ( testReadVectorDataset<uint32_t>(file_id) >= 0);
+  EMSOFT_REQUIRE ( testReadVectorDataset<int64_t>(file_id) >= 0);
+  EMSOFT_REQUIRE ( testReadVectorDataset<uint64_t>(file_id) >= 0);
+  EMSOFT_REQUIRE ( testReadVectorDataset<float32>(file_id) >= 0);
+  EMSOFT_REQUIRE ( testReadVectorDataset<float64>(file_id) >= 0);
 //
-  DREAM3D_REQUIRE ( testReadScalarDataset<int8_t>(file_id) >= 0);
-  DREAM3D_REQUIRE ( testReadScalarDataset<uint8_t>(file_id) >= 0);
-  DREAM3D_REQUIRE ( testReadScalarDataset<int16_t>(file_id) >= 0);
-  DREAM3D_REQUIRE ( testReadScalarDataset<uint16_t>(file_id) >= 0);
-  DREAM3D_REQUIRE ( testReadScalarDataset<int32_t>(file_id) >= 0);
-  DREAM3D_REQUIRE ( testReadScalarDataset<uint32_t>(file_id) >= 0);
-  DREAM3D_REQUIRE ( testReadScalarDataset<int64_t>(file_id) >= 0);
-  DREAM3D_REQUIRE ( testReadScalarDataset<uint64_t>(file_id) >= 0);
-  DREAM3D_REQUIRE ( testReadScalarDataset<float32>(file_id) >= 0);
-  DREAM3D_REQUIRE ( testReadScalarDataset<float64>(file_id) >= 0);
-
-  DREAM3D_REQUIRE ( testReadStringDatasetAndAttributes(file_id) >= 0);
+  EMSOFT_REQUIRE ( testReadScalarDataset<int8_t>(file_id) >= 0);
+  EMSOFT_REQUIRE ( testReadScalarDataset<uint8_t>(file_id) >= 0);
+  EMSOFT_REQUIRE ( testReadScalarDataset<int16_t>(file_id) >= 0);
+  EMSOFT_REQUIRE ( testReadScalarDataset<uint16_t>(file_id) >= 0);
+  EMSOFT_REQUIRE ( testReadScalarDataset<int32_t>(file_id) >= 0);
+  EMSOFT_REQUIRE ( testReadScalarDataset<uint32_t>(file_id) >= 0);
+  EMSOFT_REQUIRE ( testReadScalarDataset<int64_t>(file_id) >= 0);
+  EMSOFT_REQUIRE ( testReadScalarDataset<uint64_t>(file_id) >= 0);
+  EMSOFT_REQUIRE ( testReadScalarDataset<float32>(file_id) >= 0);
+  EMSOFT_REQUIRE ( testReadScalarDataset<float64>(file_id) >= 0);
+
+  EMSOFT_REQUIRE ( testReadStringDatasetAndAttributes(file_id) >= 0);
+
+  EMSOFT_REQUIRE ( testHyperslabDataset<int8_t>(file_id) >= 0);
+  EMSOFT_REQUIRE ( testHyperslabDataset<uint8_t>(file_id) >= 0);
+  EMSOFT_REQUIRE ( testHyperslabDataset<int16_t>(file_id) >= 0);
+  EMSOFT_REQUIRE ( testHyperslabDataset<uint16_t>(file_id) >= 0);
+  EMSOFT_REQUIRE ( testHyperslabDataset<int32_t>(file_id) >= 0);
+  EMSOFT_REQUIRE ( testHyperslabDataset<uint32_t>(file_id) >= 0);
+  EMSOFT_REQUIRE ( testHyperslabDataset<int64_t>(file_id) >= 0);
+  EMSOFT_REQUIRE ( testHyperslabDataset<uint64_t>(file_id) >= 0);
+  EMSOFT_REQUIRE ( testHyperslabDataset<float32>(file_id) >= 0);
+  EMSOFT_REQUIRE ( testHyperslabDataset<float64>(file_id) >= 0);
+
+  EMSOFT_REQUIRE ( testChunkedDataset<int8_t>(file_id) >= 0);
+  EMSOFT_REQUIRE ( testChunkedDataset<uint8_t>(file_id) >= 0);
+  EMSOFT_REQUIRE ( testChunkedDataset<int16_t>(file_id) >= 0);
+  EMSOFT_REQUIRE ( testChunkedDataset<uint16_t>(file_id) >= 0);
+  EMSOFT_REQUIRE ( testChunkedDataset<int32_t>(file_id) >= 0);
+  EMSOFT_REQUIRE ( testChunkedDataset<uint32_t>(file_id) >= 0);
+  EMSOFT_REQUIRE ( testChunkedDataset<int64_t>(file_id) >= 0);
+  EMSOFT_REQUIRE ( testChunkedDataset<uint64_t>(file_id) >= 0);
+  EMSOFT_REQUIRE ( testChunkedDataset<float32>(file_id) >= 0);
+  EMSOFT_REQUIRE ( testChunkedDataset<float64>(file_id) >= 0);
+
+  EMSOFT_REQUIRE ( testExtendibleDataset<int8_t>(file_id) >= 0);
+  EMSOFT_REQUIRE ( testExtendibleDataset<uint8_t>(file_id) >= 0);
+  EMSOFT_REQUIRE ( testExtendibleDataset<int16_t>(file_id) >= 0);
+  EMSOFT_REQUIRE ( testExtendibleDataset<uint16_t>(file_id) >= 0);
+  EMSOFT_REQUIRE ( testExtendibleDataset<int32_t>(file_id) >= 0);
+  EMSOFT_REQUIRE ( testExtendibleDataset<uint32_t>(file_id) >= 0);
+  EMSOFT_REQUIRE ( testExtendibleDataset<int64_t>(file_id) >= 0);
+  EMSOFT_REQUIRE ( testExtendibleDataset<uint64_t>(file_id) >= 0);
+  EMSOFT_REQUIRE ( testExtendibleDataset<float32>(file_id) >= 0);
+  EMSOFT_REQUIRE ( testExtendibleDataset<float64>(file_id) >= 0);
 
   /* Close the file. */
   H5Fclose( file_id );
@@ -1210,7 +1509,7 @@ void TestLargeFileSupport()
   hid_t file_id;
   /* Create a new file using default properties. */
   file_id = H5Fcreate(UnitTest::H5LiteTest::LargeFile.toLatin1().data(), H5F_ACC_TRUNC, H5P_DEFAULT, H5P_DEFAULT);
-  DREAM3D_REQUIRE(file_id > 0);
+  EMSOFT_REQUIRE(file_id > 0);
   QVector<int > buffer(1000000); // Create a 4 MegaByte Buffer
   int32_t rank = 1;
   QVector<hsize_t > dims(1, 1000000);
@@ -1224,7 +1523,7 @@ void TestLargeFileSupport()
   }
 
   herr_t err = H5Fclose(file_id);
-  DREAM3D_REQUIRE(err >= 0);
+  EMSOFT_REQUIRE(err >= 0);
 
 }
 
@@ -1232,7 +1531,7 @@ void TestLargeFileSupport()
   {\
     m_msgType v = 0x00;\
     hid_t t = QH5Lite::HDFTypeForPrimitive<m_msgType>(v);\
-    DREAM3D_REQUIRE_EQUAL(t, check);\
+    EMSOFT_REQUIRE_EQUAL(t, check);\
   }
 
 
@@ -1249,15 +1548,15 @@ hid_t _testTypeName()
 void TestTypeDetection()
 {
 
-  DREAM3D_REQUIRE_EQUAL(_testTypeName<int8_t>(), H5T_NATIVE_INT8)
+  EMSOFT_REQUIRE_EQUAL(_testTypeName<int8_t>(), H5T_NATIVE_INT8)
 #if CMP_TYPE_CHAR_IS_SIGNED
-  DREAM3D_REQUIRE_EQUAL(_testTypeName<char>(), H5T_NATIVE_INT8)
+  EMSOFT_REQUIRE_EQUAL(_testTypeName<char>(), H5T_NATIVE_INT8)
 #else
-  DREAM3D_REQUIRE_EQUAL(_testTypeName<char>(), H5T_NATIVE_UINT8)
+  EMSOFT_REQUIRE_EQUAL(_testTypeName<char>(), H5T_NATIVE_UINT8)
 #endif
-  DREAM3D_REQUIRE_EQUAL(_testTypeName<signed char>(), H5T_NATIVE_INT8)
-  DREAM3D_REQUIRE_EQUAL(_testTypeName<unsigned char>(), H5T_NATIVE_UINT8)
-  DREAM3D_REQUIRE_EQUAL(_testTypeName<uint8_t>(), H5T_NATIVE_UINT8)
+  EMSOFT_REQUIRE_EQUAL(_testTypeName<signed char>(), H5T_NATIVE_INT8)
+  EMSOFT_REQUIRE_EQUAL(_testTypeName<unsigned char>(), H5T_NATIVE_UINT8)
+  EMSOFT_REQUIRE_EQUAL(_testTypeName<uint8_t>(), H5T_NATIVE_UINT8)
 
 //  TYPE_DETECTION(uint8_t, H5T_NATIVE_UINT8);
 //
@@ -1403,7 +1702,7 @@ void TestVLengStringReadWrite()
     strings.push_back("Nickel");
 
     herr_t err = H5Lite::writeVectorOfStringsDataset(file_id, "VlenStrings", strings);
-    DREAM3D_REQUIRE(err >= 0)
+    EMSOFT_REQUIRE(err >= 0)
 
     H5Utilities::closeFile(file_id);
   }
@@ -1414,7 +1713,7 @@ void TestVLengStringReadWrite()
 
     std::vector<std::string> data;
     H5Lite::readVectorOfStringDataset(file_id, "VlenStrings", data);
-    DREAM3D_REQUIRE(data.size() == 5)
+    EMSOFT_REQUIRE(data.size() == 5)
   }
 
   {
@@ -1428,7 +1727,7 @@ void TestVLengStringReadWrite()
     strings.push_back("Nickel");
 
     herr_t err = QH5Lite::writeVectorOfStringsDataset(file_id, "VlenStrings", strings);
-    DREAM3D_REQUIRE(err >= 0)
+    EMSOFT_REQUIRE(err >= 0)
 
     QH5Utilities::closeFile(file_id);
   }
@@ -1439,7 +1738,7 @@ void TestVLengStringReadWrite()
 
     QVector<QString> data;
     QH5Lite::readVectorOfStringDataset(file_id, "VlenStrings", data);
-    DREAM3D_REQUIRE(data.size() == 5)
+    EMSOFT_REQUIRE(data.size() == 5)
 #if 0
     /*
     * Open file and dataset.
@@ -1514,11 +1813,11 @@ int main(int argc, char** argv)
 {
   int err = EXIT_SUCCESS;
 
-  DREAM3D_REGISTER_TEST (TestVLengStringReadWrite() )
+  EMSOFT_REGISTER_TEST (TestVLengStringReadWrite() )
 
-  DREAM3D_REGISTER_TEST( TestTypeDetection() )
-  DREAM3D_REGISTER_TEST( QH5LiteTest() )
-  DREAM3D_REGISTER_TEST( RemoveTestFiles() )
+  EMSOFT_REGISTER_TEST( TestTypeDetection() )
+  EMSOFT_REGISTER_TEST( QH5LiteTest() )
+  EMSOFT_REGISTER_TEST( RemoveTestFiles() )
 
   PRINT_TEST_SUMMARY();
   return err;
@@ -41,8 +41,6 @@ standard C++ library."
 #include <list>
 #include <string>
 
-#include <boost/assert.hpp>
-
 #include <QtCore/QFile>
 #include <QtCore/QDateTime>
 #include <QtCore/QtDebug>
@@ -52,8 +50,7 @@ standard C++ library."
 #include "H5SupportTestFileLocations.h"
 
 
-// THIS IS REALLY DANGEROUS AS IT COULD SETUP A CIRCULAR REFERENCE WITH LIBRARY DEPENDECIES.
-#include "DREAM3DLib/Utilities/UnitTestSupport.hpp"
+#include "UnitTestSupport.hpp"
 
 #define DIM 6
 #define DIM0 4
@@ -89,7 +86,7 @@ herr_t testWritePointer1DArrayAttribute(hid_t file_id, const QString& dsetName)
   T value = 0x0;
   herr_t err = -1;
   QString attributeKey = QH5Lite::HDFTypeForPrimitiveAsStr(value);
-  DREAM3D_REQUIRE(attributeKey.isEmpty() == false);
+  EMSOFT_REQUIRE(attributeKey.isEmpty() == false);
   attributeKey = "1DArrayAttribute<" + attributeKey + ">";
   int32_t rank = 1;
   T data[DIM0];
@@ -101,7 +98,7 @@ herr_t testWritePointer1DArrayAttribute(hid_t file_id, const QString& dsetName)
   dims[0] = DIM0;
 
   err = QH5Lite::writePointerAttribute<T>(file_id, dsetName, attributeKey, rank, dims, (T*)data);
-  DREAM3D_REQUIRE(err >= 0);
+  EMSOFT_REQUIRE(err >= 0);
   return err;
 }
 
@@ -118,7 +115,7 @@ herr_t testWritePointer2DArrayAttribute(hid_t file_id, const QString& dsetName)
   T value = 0x0;
   herr_t err = -1;
   QString attributeKey = QH5Lite::HDFTypeForPrimitiveAsStr(value);
-  DREAM3D_REQUIRE(attributeKey.isEmpty() == false);
+  EMSOFT_REQUIRE(attributeKey.isEmpty() == false);
 
   attributeKey = "2DArrayAttribute<" + attributeKey + ">";
   int32_t rank = RANK_2D;
@@ -134,7 +131,7 @@ herr_t testWritePointer2DArrayAttribute(hid_t file_id, const QString& dsetName)
   dims[0] = DIM0;
   dims[1] = DIM1;
   err = QH5Lite::writePointerAttribute<T>(file_id, dsetName, attributeKey, rank, dims, (T*)data);
-  DREAM3D_REQUIRE(err >= 0);
+  EMSOFT_REQUIRE(err >= 0);
   return err;
 }
 
@@ -149,7 +146,7 @@ herr_t testWritePointer3DArrayAttribute(hid_t file_id, const QString& dsetName)
   T value = 0x0;
   herr_t err = -1;
   QString attributeKey = QH5Lite::HDFTypeForPrimitiveAsStr(value);
-  DREAM3D_REQUIRE(attributeKey.isEmpty() == false);
+  EMSOFT_REQUIRE(attributeKey.isEmpty() == false);
   attributeKey = "3DArrayAttribute<" + attributeKey + ">";
   int32_t rank = RANK_3D;
   T data[DIM0][DIM1][DIM2];
@@ -168,7 +165,7 @@ herr_t testWritePointer3DArrayAttribute(hid_t file_id, const QString& dsetName)
   dims[1] = DIM1;
   dims[2] = DIM2;
   err = QH5Lite::writePointerAttribute<T>(file_id, dsetName, attributeKey, rank, dims, (T*)data);
-  DREAM3D_REQUIRE(err >= 0);
+  EMSOFT_REQUIRE(err >= 0);
   return err;
 }
 
@@ -182,7 +179,7 @@ herr_t testWriteVectorAttribute(hid_t file_id, QString dsetName )
   T value = 0x0;
   herr_t err = -1;
   QString attributeKey = QH5Lite::HDFTypeForPrimitiveAsStr(value);
-  DREAM3D_REQUIRE(attributeKey.isEmpty() == false);
+  EMSOFT_REQUIRE(attributeKey.isEmpty() == false);
   attributeKey = "VectorAttribute<" + attributeKey + ">";
 
   int32_t numElements = DIM0;
@@ -196,7 +193,7 @@ herr_t testWriteVectorAttribute(hid_t file_id, QString dsetName )
   }
   //std::cout << "Attribute->Write: " << objName;
   err = QH5Lite::writeVectorAttribute( file_id, dsetName, attributeKey, dims, data );
-  DREAM3D_REQUIRE(err >= 0);
+  EMSOFT_REQUIRE(err >= 0);
   return err;
 }
 
@@ -211,10 +208,10 @@ herr_t testWriteScalarAttribute(hid_t file_id, const QString& dsetName)
   T value = 0x0F;
   herr_t err = -1;
   QString attributeKey = QH5Lite::HDFTypeForPrimitiveAsStr(value);
-  DREAM3D_REQUIRE(attributeKey.isEmpty() == false);
+  EMSOFT_REQUIRE(attributeKey.isEmpty() == false);
   attributeKey = "ScalarAttribute<" + attributeKey + ">";
   err = QH5Lite::writeScalarAttribute(file_id, dsetName, attributeKey, value);
-  DREAM3D_REQUIRE(err >= 0);
+  EMSOFT_REQUIRE(err >= 0);
   return err;
 }
 
@@ -247,7 +244,7 @@ herr_t testWritePointer2DArrayDataset(hid_t file_id)
   dsetName = "Pointer2DArrayDataset<" + dsetName + ">";
   qDebug() << "Running " << dsetName << " ... ";
   err = QH5Lite::writePointerDataset( file_id, dsetName, rank, dims, &(data.front()) );
-  DREAM3D_REQUIRE(err >= 0);
+  EMSOFT_REQUIRE(err >= 0);
 
   err = testWritePointer3DArrayAttribute<uint8_t>(file_id, dsetName);
   err = testWritePointer3DArrayAttribute<uint16_t>(file_id, dsetName);
@@ -317,96 +314,96 @@ void QH5UtilitiesTest()
   hid_t   file_id;
   /* Create a new file using default properties. */
   file_id = H5Fcreate( UnitTest::H5UtilTest::FileName.toStdString().c_str(), H5F_ACC_TRUNC, H5P_DEFAULT, H5P_DEFAULT );
-  DREAM3D_REQUIRE(file_id > 0);
+  EMSOFT_REQUIRE(file_id > 0);
 
   // std::cout << logTime() << "----------- Testing Writing/Reading of Datasets using Raw Pointers -----------";
-  DREAM3D_REQUIRE ( testWritePointer2DArrayDataset<int32_t>(file_id) >= 0);
+  EMSOFT_REQUIRE ( testWritePointer2DArrayDataset<int32_t>(file_id) >= 0);
 
   hid_t dsetId = QH5Utilities::openHDF5Object(file_id, "Pointer2DArrayDataset<H5T_NATIVE_INT32>");
-  DREAM3D_REQUIRE(dsetId > 0);
+  EMSOFT_REQUIRE(dsetId > 0);
 
-  DREAM3D_REQUIRE( QH5Utilities::isGroup(file_id, "/") == true);
-  DREAM3D_REQUIRE( QH5Utilities::isGroup(file_id, "Pointer2DArrayDataset<H5T_NATIVE_INT32>") == false);
+  EMSOFT_REQUIRE( QH5Utilities::isGroup(file_id, "/") == true);
+  EMSOFT_REQUIRE( QH5Utilities::isGroup(file_id, "Pointer2DArrayDataset<H5T_NATIVE_INT32>") == false);
 
   QString objName;
   int32_t err = QH5Utilities::objectNameAtIndex(file_id, 0, objName);
-  DREAM3D_REQUIRE(objName.compare("Pointer2DArrayDataset<H5T_NATIVE_INT32>") == 0);
+  EMSOFT_REQUIRE(objName.compare("Pointer2DArrayDataset<H5T_NATIVE_INT32>") == 0);
 
   hid_t objType = -1;
   err = QH5Utilities::getObjectType(file_id, "Pointer2DArrayDataset<H5T_NATIVE_INT32>", &objType);
-  DREAM3D_REQUIRE(objType == H5O_TYPE_DATASET);
-  DREAM3D_REQUIRE(err >= 0);
+  EMSOFT_REQUIRE(objType == H5O_TYPE_DATASET);
+  EMSOFT_REQUIRE(err >= 0);
 
   err = QH5Utilities::getObjectType(file_id, "/", &objType);
-  DREAM3D_REQUIRE(objType == H5O_TYPE_GROUP);
-  DREAM3D_REQUIRE(err >= 0);
+  EMSOFT_REQUIRE(objType == H5O_TYPE_GROUP);
+  EMSOFT_REQUIRE(err >= 0);
 
   QString objPath = QH5Utilities::getObjectPath(dsetId, false);
-  DREAM3D_REQUIRE(objPath.compare("Pointer2DArrayDataset<H5T_NATIVE_INT32>") == 0);
+  EMSOFT_REQUIRE(objPath.compare("Pointer2DArrayDataset<H5T_NATIVE_INT32>") == 0);
 
   err = QH5Utilities::closeHDF5Object(dsetId);
-  DREAM3D_REQUIRE(err >= 0);
+  EMSOFT_REQUIRE(err >= 0);
 
-  DREAM3D_REQUIRE ( QH5Utilities::createGroupsFromPath("/Test Path 1", file_id) >= 0);
-  DREAM3D_REQUIRE ( QH5Utilities::createGroupsFromPath("/Test Path 2/", file_id) >= 0);
-  DREAM3D_REQUIRE ( QH5Utilities::createGroupsFromPath("Test Path 3/", file_id) >= 0);
-  DREAM3D_REQUIRE ( QH5Utilities::createGroupsFromPath("/", file_id) < 0);
-  DREAM3D_REQUIRE ( QH5Utilities::createGroupsFromPath("/Test Path 4/Test Path 7", file_id) >= 0);
-  DREAM3D_REQUIRE ( QH5Utilities::createGroupsFromPath("/Test Path 5/Test Path 8/", file_id) >= 0);
-  DREAM3D_REQUIRE ( QH5Utilities::createGroupsFromPath("Test Path 6/Test Path 9/", file_id) >= 0);
+  EMSOFT_REQUIRE ( QH5Utilities::createGroupsFromPath("/Test Path 1", file_id) >= 0);
+  EMSOFT_REQUIRE ( QH5Utilities::createGroupsFromPath("/Test Path 2/", file_id) >= 0);
+  EMSOFT_REQUIRE ( QH5Utilities::createGroupsFromPath("Test Path 3/", file_id) >= 0);
+  EMSOFT_REQUIRE ( QH5Utilities::createGroupsFromPath("/", file_id) < 0);
+  EMSOFT_REQUIRE ( QH5Utilities::createGroupsFromPath("/Test Path 4/Test Path 7", file_id) >= 0);
+  EMSOFT_REQUIRE ( QH5Utilities::createGroupsFromPath("/Test Path 5/Test Path 8/", file_id) >= 0);
+  EMSOFT_REQUIRE ( QH5Utilities::createGroupsFromPath("Test Path 6/Test Path 9/", file_id) >= 0);
 
   hid_t grpId = QH5Utilities::openHDF5Object(file_id, "Test Path 1");
-  DREAM3D_REQUIRE(grpId > 0);
-  DREAM3D_REQUIRE ( QH5Utilities::createGroupsFromPath("/Test Path 1", grpId) >= 0);
-  DREAM3D_REQUIRE ( QH5Utilities::createGroupsFromPath("/Test Path 2/", grpId) >= 0);
-  DREAM3D_REQUIRE ( QH5Utilities::createGroupsFromPath("Test Path 3/", grpId) >= 0);
-  DREAM3D_REQUIRE ( QH5Utilities::createGroupsFromPath("/", grpId) < 0);
-  DREAM3D_REQUIRE ( QH5Utilities::createGroupsFromPath("/Test Path 4/Test Path 7", grpId) >= 0);
-  DREAM3D_REQUIRE ( QH5Utilities::createGroupsFromPath("/Test Path 5/Test Path 8/", grpId) >= 0);
-  DREAM3D_REQUIRE ( QH5Utilities::createGroupsFromPath("Test Path 6/Test Path 9/", grpId) >= 0);
+  EMSOFT_REQUIRE(grpId > 0);
+  EMSOFT_REQUIRE ( QH5Utilities::createGroupsFromPath("/Test Path 1", grpId) >= 0);
+  EMSOFT_REQUIRE ( QH5Utilities::createGroupsFromPath("/Test Path 2/", grpId) >= 0);
+  EMSOFT_REQUIRE ( QH5Utilities::createGroupsFromPath("Test Path 3/", grpId) >= 0);
+  EMSOFT_REQUIRE ( QH5Utilities::createGroupsFromPath("/", grpId) < 0);
+  EMSOFT_REQUIRE ( QH5Utilities::createGroupsFromPath("/Test Path 4/Test Path 7", grpId) >= 0);
+  EMSOFT_REQUIRE ( QH5Utilities::createGroupsFromPath("/Test Path 5/Test Path 8/", grpId) >= 0);
+  EMSOFT_REQUIRE ( QH5Utilities::createGroupsFromPath("Test Path 6/Test Path 9/", grpId) >= 0);
   err = H5Gclose(grpId);
-  DREAM3D_REQUIRE(err >= 0);
+  EMSOFT_REQUIRE(err >= 0);
 
   hid_t gid = QH5Utilities::createGroup(file_id, "test group");
-  DREAM3D_REQUIRE(gid >= 0);
+  EMSOFT_REQUIRE(gid >= 0);
   err = QH5Utilities::closeHDF5Object(gid);
 
   QList<QString> groups;
   err = QH5Utilities::getGroupObjects(file_id, H5Utilities::H5Support_ANY, groups);
-  DREAM3D_REQUIRE(err >= 0);
-  DREAM3D_REQUIRE( groups.size() == 8);
+  EMSOFT_REQUIRE(err >= 0);
+  EMSOFT_REQUIRE( groups.size() == 8);
 
 
   err = QH5Utilities::createGroupsForDataset("/group1/group2/group3/data", file_id);
-  DREAM3D_REQUIRE(err >= 0);
+  EMSOFT_REQUIRE(err >= 0);
   gid = QH5Utilities::openHDF5Object(file_id, "/group1/group2");
-  DREAM3D_REQUIRE(gid >= 0);
+  EMSOFT_REQUIRE(gid >= 0);
   err = QH5Utilities::closeHDF5Object(gid);
 
 #if 0
   bool success = QH5Utilities::probeForAttribute(file_id, "Pointer2DArrayDataset<H5T_NATIVE_INT32>", "ScalarAttribute<H5T_NATIVE_INT32>" );
-  DREAM3D_REQUIRE(success == true);
+  EMSOFT_REQUIRE(success == true);
 
   success = QH5Utilities::probeForAttribute(file_id, "Pointer2DArrayDataset<H5T_NATIVE_INT32>", "ScalarAttribute<>" );
-  DREAM3D_REQUIRE(success == false);
+  EMSOFT_REQUIRE(success == false);
 #endif
 
   QList<QString> attributes;
   err = QH5Utilities::getAllAttributeNames(file_id, "Pointer2DArrayDataset<H5T_NATIVE_INT32>", attributes);
-  DREAM3D_REQUIRE(err >= 0);
-  DREAM3D_REQUIRE(attributes.size() == AttrSize);
+  EMSOFT_REQUIRE(err >= 0);
+  EMSOFT_REQUIRE(attributes.size() == AttrSize);
 
   dsetId = QH5Utilities::openHDF5Object(file_id, "Pointer2DArrayDataset<H5T_NATIVE_INT32>");
-  DREAM3D_REQUIRE(dsetId > 0);
+  EMSOFT_REQUIRE(dsetId > 0);
   attributes.clear();
   err = QH5Utilities::getAllAttributeNames(dsetId, attributes);
-  DREAM3D_REQUIRE(err >= 0);
-  DREAM3D_REQUIRE(attributes.size() == AttrSize);
+  EMSOFT_REQUIRE(err >= 0);
+  EMSOFT_REQUIRE(attributes.size() == AttrSize);
   err = QH5Utilities::closeHDF5Object(dsetId);
-  DREAM3D_REQUIRE(err >= 0);
+  EMSOFT_REQUIRE(err >= 0);
 
   err = QH5Utilities::closeFile(file_id);
-  DREAM3D_REQUIRE(err >= 0);
+  EMSOFT_REQUIRE(err >= 0);
 }
 
 // -----------------------------------------------------------------------------
@@ -423,21 +420,21 @@ void StressTestCreateGroups()
 
   /* Create a new file using default properties. */
   file_id = H5Fcreate(UnitTest::H5UtilTest::GroupTest.toStdString().c_str(), H5F_ACC_TRUNC, H5P_DEFAULT, H5P_DEFAULT );
-  DREAM3D_REQUIRE(file_id > 0);
+  EMSOFT_REQUIRE(file_id > 0);
 
 
   for (int i = 0; i < 100; ++i)
   {
     qDebug() << QDateTime::currentDateTime() << "Outer Loop: " << i;
 //    err = H5Fclose(file_id);
-//    DREAM3D_REQUIRE(err >= 0);
+//    EMSOFT_REQUIRE(err >= 0);
 //    file_id = H5Fopen(MXAUnitTest::H5UtilTest::GroupTest.toStdString().c_str(), H5F_ACC_RDWR, H5P_DEFAULT);
     ::memset(path, 0, 64);
     snprintf(path, 64, "/%03d", i);
     grpId = QH5Utilities::createGroup(file_id, path);
-    DREAM3D_REQUIRE(grpId > 0);
+    EMSOFT_REQUIRE(grpId > 0);
     err = H5Gclose(grpId);
-    DREAM3D_REQUIRE(err >= 0);
+    EMSOFT_REQUIRE(err >= 0);
 
 
     for (int j = 0; j < 100; ++j)
@@ -445,25 +442,25 @@ void StressTestCreateGroups()
 
       snprintf(path, 64, "/%03d/%03d", i, j);
       grpId = QH5Utilities::createGroup(file_id, path);
-      DREAM3D_REQUIRE(grpId > 0);
-      DREAM3D_REQUIRE(grpId > 0);
+      EMSOFT_REQUIRE(grpId > 0);
+      EMSOFT_REQUIRE(grpId > 0);
       err = H5Gclose(grpId);
-      DREAM3D_REQUIRE(err >= 0);
+      EMSOFT_REQUIRE(err >= 0);
 
       for (int k = 0; k < 100; ++k)
       {
 
         snprintf(path, 64, "/%03d/%03d/%03d", i, j, k);
         grpId = QH5Utilities::createGroup(file_id, path);
-        DREAM3D_REQUIRE(grpId >= 0);
-        DREAM3D_REQUIRE(grpId > 0);
+        EMSOFT_REQUIRE(grpId >= 0);
+        EMSOFT_REQUIRE(grpId > 0);
         err = H5Gclose(grpId);
-        DREAM3D_REQUIRE(err >= 0);
+        EMSOFT_REQUIRE(err >= 0);
       }
     }
   }
   err = H5Fclose(file_id);
-  DREAM3D_REQUIRE(err >= 0);
+  EMSOFT_REQUIRE(err >= 0);
 }
 
 // -----------------------------------------------------------------------------
@@ -483,12 +480,12 @@ void HDF5Darwin2GBWriteTest()
   hid_t   file_id;
   /* Create a new file using default properties. */
   file_id = H5Fcreate( "/tmp/HDF5_LARGE_WRITE_BUG.h5", H5F_ACC_TRUNC, H5P_DEFAULT, H5P_DEFAULT );
-  DREAM3D_REQUIRE(file_id > 0);
+  EMSOFT_REQUIRE(file_id > 0);
   int32_t rank = 2;
   hsize_t dims[2] = {dim0, dim1};
 
   herr_t err = QH5Lite::writePointerDataset(file_id, "data", rank, dims, data);
-  DREAM3D_REQUIRE(err > -1);
+  EMSOFT_REQUIRE(err > -1);
 }
 #endif
 
@@ -502,13 +499,13 @@ void TestOpenSameFile2x()
   hid_t   file_id;
   /* Create a new file using default properties. */
   file_id = H5Fcreate(UnitTest::H5UtilTest::FileName.toStdString().c_str(), H5F_ACC_TRUNC, H5P_DEFAULT, H5P_DEFAULT);
-  DREAM3D_REQUIRE(file_id > 0);
+  EMSOFT_REQUIRE(file_id > 0);
 
   hid_t gid = H5Utilities::createGroup(file_id, "TestGroup");
   hid_t gid2 = H5Utilities::createGroup(file_id, "TestGroup2");
 
   // std::cout << logTime() << "----------- Testing Writing/Reading of Datasets using Raw Pointers -----------";
-  DREAM3D_REQUIRE(testWritePointer2DArrayDataset<int32_t>(gid) >= 0);
+  EMSOFT_REQUIRE(testWritePointer2DArrayDataset<int32_t>(gid) >= 0);
   err = H5Gclose(gid);
   err = H5Gclose(gid2);
   gid = 0;
@@ -527,17 +524,99 @@ void TestOpenSameFile2x()
     err = H5Gclose(dcaGid2);
     dcaGid2 = 0;
     err = H5Utilities::closeFile(fileId2);
-    DREAM3D_REQUIRE(err == 0);
+    EMSOFT_REQUIRE(err == 0);
   }
 
 
   err = H5Gclose(dcaGid);
-  DREAM3D_REQUIRE(err == 0);
+  EMSOFT_REQUIRE(err == 0);
 
   err = H5Utilities::closeFile(fileId);
-  DREAM3D_REQUIRE(err == 0);
+  EMSOFT_REQUIRE(err == 0);
 }
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void TestFileAccessOptions()
+{
+  herr_t err = -1;
+  hsize_t dims[3] = { 8, 16, 16 };
+  std::vector<uint16_t> data(8 * 16 * 16);
+  for (size_t i = 0; i < data.size(); ++i) { data[i] = static_cast<uint16_t>(i); }
+
+  H5Utilities::FileAccessOptions defaults;
+  EMSOFT_REQUIRE(defaults.isDefault() == true);
+  EMSOFT_REQUIRE(H5Utilities::createFileAccessPropertyList(defaults) == H5P_DEFAULT);
+
+  // Create a paged file so it can be opened with a page buffer later on
+  H5Utilities::FileAccessOptions createOptions;
+  createOptions.metadataCacheBytes = 4 * 1024 * 1024;
+  createOptions.pageSize = 4096;
+  hid_t fileId = QH5Utilities::createFile(UnitTest::H5UtilTest::FileName, createOptions);
+  EMSOFT_REQUIRE(fileId > 0);
+  H5Lite::DatasetCreationOptions dsetOptions;
+  dsetOptions.chunkDims.resize(3);
+  dsetOptions.chunkDims[0] = 1;
+  dsetOptions.chunkDims[1] = 16;
+  dsetOptions.chunkDims[2] = 16;
+  err = H5Lite::writePointerDataset(fileId, "Patterns", 3, dims, &(data.front()), dsetOptions);
+  EMSOFT_REQUIRE(err >= 0);
+  err = H5Utilities::closeFile(fileId);
+  EMSOFT_REQUIRE(err >= 0);
+
+  // Read only with a large chunk cache and a page buffer
+  H5Utilities::FileAccessOptions readOptions;
+  readOptions.chunkCacheSlots = 521;
+  readOptions.chunkCacheBytes = 8 * 1024 * 1024;
+  readOptions.chunkCachePreemption = 1.0;
+  readOptions.pageBufferBytes = 64 * 1024;
+  EMSOFT_REQUIRE(readOptions.isDefault() == false);
+  fileId = QH5Utilities::openFile(UnitTest::H5UtilTest::FileName, true, readOptions);
+  EMSOFT_REQUIRE(fileId > 0);
+  hid_t fapl = H5Fget_access_plist(fileId);
+  EMSOFT_REQUIRE(fapl > 0);
+  int mdcElements = 0;
+  size_t slots = 0;
+  size_t bytes = 0;
+  double w0 = 0.0;
+  err = H5Pget_cache(fapl, &mdcElements, &slots, &bytes, &w0);
+  EMSOFT_REQUIRE(err >= 0);
+  EMSOFT_REQUIRE_EQUAL(slots, readOptions.chunkCacheSlots);
+  EMSOFT_REQUIRE_EQUAL(bytes, readOptions.chunkCacheBytes);
+  H5Pclose(fapl);
+  std::vector<uint16_t> readBack(data.size(), 0);
+  err = H5Lite::readPointerDataset(fileId, "Patterns", &(readBack.front()));
+  EMSOFT_REQUIRE(err >= 0);
+  EMSOFT_REQUIRE(readBack == data);
+  err = H5Utilities::closeFile(fileId);
+  EMSOFT_REQUIRE(err >= 0);
+
+  // Read the whole file into memory with the core driver
+  H5Utilities::FileAccessOptions coreOptions;
+  coreOptions.driver = H5Utilities::FileAccessOptions::CoreDriver;
+  coreOptions.coreBackingStore = false;
+  fileId = QH5Utilities::openFile(UnitTest::H5UtilTest::FileName, true, coreOptions);
+  EMSOFT_REQUIRE(fileId > 0);
+  readBack.assign(data.size(), 0);
+  err = H5Lite::readPointerDataset(fileId, "Patterns", &(readBack.front()));
+  EMSOFT_REQUIRE(err >= 0);
+  EMSOFT_REQUIRE(readBack == data);
+  err = H5Utilities::closeFile(fileId);
+  EMSOFT_REQUIRE(err >= 0);
+
+  // A page buffer is dropped for files that were not created with a page size
+  fileId = QH5Utilities::createFile(UnitTest::H5UtilTest::FileName);
+  EMSOFT_REQUIRE(fileId > 0);
+  err = H5Lite::writePointerDataset(fileId, "Patterns", 3, dims, &(data.front()));
+  EMSOFT_REQUIRE(err >= 0);
+  err = H5Utilities::closeFile(fileId);
+  EMSOFT_REQUIRE(err >= 0);
+  fileId = QH5Utilities::openFile(UnitTest::H5UtilTest::FileName, true, readOptions);
+  EMSOFT_REQUIRE(fileId > 0);
+  err = H5Utilities::closeFile(fileId);
+  EMSOFT_REQUIRE(err >= 0);
+}
 
 // -----------------------------------------------------------------------------
 //  Use unit test framework
@@ -546,9 +625,10 @@ int main(int argc, char** argv)
 {
   int err = EXIT_SUCCESS;
 
-  DREAM3D_REGISTER_TEST( QH5UtilitiesTest() )
-  DREAM3D_REGISTER_TEST( TestOpenSameFile2x() )
-  DREAM3D_REGISTER_TEST( RemoveTestFiles() )
+  EMSOFT_REGISTER_TEST( QH5UtilitiesTest() )
+  EMSOFT_REGISTER_TEST( TestOpenSameFile2x() )
+  EMSOFT_REGISTER_TEST( TestFileAccessOptions() )
+  EMSOFT_REGISTER_TEST( RemoveTestFiles() )
   PRINT_TEST_SUMMARY();
 
   return err;
@@ -74,6 +74,36 @@ namespace LambertParametersType
                               };     //used for Fundamental Zone determination in so3 module
 }
 
+namespace FundamentalZoneConstants
+{
+  static const int AnorthicType = 0; // Triclinic
+  static const int CyclicType = 1;
+  static const int DihedralType = 2;
+  static const int TetrahedralType = 3;
+  static const int OctahedralType = 4;
+
+  static const int NoAxisOrder = 0;
+  static const int TwoFoldAxisOrder = 2;
+  static const int ThreeFoldAxisOrder = 3;
+  static const int FourFoldAxisOrder = 4;
+  static const int SixFoldAxisOrder = 6;
+
+  // fundamental zone type and axis order for each of the 32 point groups
+  static const int FZtarray[32] = { AnorthicType, AnorthicType,CyclicType,CyclicType,CyclicType,
+                                    DihedralType,DihedralType,DihedralType,CyclicType,CyclicType,CyclicType,
+                                    DihedralType,DihedralType,DihedralType,DihedralType,CyclicType,CyclicType,
+                                    DihedralType,DihedralType,DihedralType,CyclicType,CyclicType,CyclicType,
+                                    DihedralType,DihedralType,DihedralType,DihedralType,TetrahedralType,
+                                    TetrahedralType,OctahedralType,TetrahedralType,OctahedralType };
+
+  static const int FZoarray[32] = { NoAxisOrder,NoAxisOrder,TwoFoldAxisOrder,TwoFoldAxisOrder,
+                                    TwoFoldAxisOrder,TwoFoldAxisOrder,TwoFoldAxisOrder,TwoFoldAxisOrder,FourFoldAxisOrder,
+                                    FourFoldAxisOrder,FourFoldAxisOrder,FourFoldAxisOrder,FourFoldAxisOrder,FourFoldAxisOrder,
+                                    FourFoldAxisOrder,ThreeFoldAxisOrder,ThreeFoldAxisOrder,ThreeFoldAxisOrder,ThreeFoldAxisOrder,
+                                    ThreeFoldAxisOrder,SixFoldAxisOrder,SixFoldAxisOrder,SixFoldAxisOrder,SixFoldAxisOrder,SixFoldAxisOrder,
+                                    SixFoldAxisOrder,SixFoldAxisOrder,NoAxisOrder,NoAxisOrder,NoAxisOrder,NoAxisOrder,NoAxisOrder};
+}
+
 // Add some shortened namespace alias
 // Condense some of the namespaces to same some typing later on.
 namespace LPs = LambertParametersType;
@@ -0,0 +1,153 @@
+/* ============================================================================
+* Copyright (c) 2009-2017 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#ifndef _OrientationBatchTransforms_H_
+#define _OrientationBatchTransforms_H_
+
+#include "OrientationLib/OrientationLib.h"
+#include "OrientationLib/OrientationMath/OrientationFixedArray.hpp"
+#include "OrientationLib/OrientationMath/OrientationTransforms.hpp"
+
+
+/**
+ * @brief The OrientationBatchTransforms class converts whole arrays of orientations
+ * between representations. Every conversion of OrientationTransforms has a batch
+ * version named xx2yy_batch(const K* in, K* out, size_t n) that reads n packed input
+ * tuples (3 values for eu/ho/cu, 4 for ax/ro/qu and 9 for om) and writes n packed
+ * output tuples, which is the layout of the DataArrays used by OrientationConverter.
+ *
+ * Each tuple is converted by the scalar OrientationTransforms code on
+ * OrientationFixedArray tuples, so the results are identical to the per-tuple
+ * conversions (including the epsijk convention) and no memory is allocated.
+ * The kernels are plain loops rather than SIMD code; the conversions are dominated
+ * by sin, cos, atan2 and sqrt, and OrientationConverter spreads the tuples over threads.
+ */
+template<typename K>
+class OrientationBatchTransforms
+{
+  public:
+    typedef OrientationFixedArray<K> FixedArrayType;
+    typedef OrientationTransforms<FixedArrayType, K> TransformsType;
+    typedef typename QuaternionMath<K>::Order QuatOrder;
+
+    virtual ~OrientationBatchTransforms() {}
+
+/* Batch version of a conversion that runs the scalar OrientationTransforms code on each tuple */
+#define OBT_TUPLE_KERNEL(CONVERSION_METHOD, IN_SIZE, OUT_SIZE)\
+    static void CONVERSION_METHOD##_batch(const K* in, K* out, size_t n)\
+    {\
+      for(size_t i = 0; i < n; i++)\
+      {\
+        FixedArrayType a(in + IN_SIZE * i, IN_SIZE);\
+        FixedArrayType res(OUT_SIZE);\
+        TransformsType::CONVERSION_METHOD(a, res);\
+        res.copyTo(out + OUT_SIZE * i);\
+      }\
+    }
+
+/* Same as OBT_TUPLE_KERNEL for the conversions that take a quaternion layout argument */
+#define OBT_TUPLE_KERNEL_QUAT(CONVERSION_METHOD, IN_SIZE, OUT_SIZE)\
+    static void CONVERSION_METHOD##_batch(const K* in, K* out, size_t n, QuatOrder layout = QuaternionMath<K>::QuaternionVectorScalar)\
+    {\
+      for(size_t i = 0; i < n; i++)\
+      {\
+        FixedArrayType a(in + IN_SIZE * i, IN_SIZE);\
+        FixedArrayType res(OUT_SIZE);\
+        TransformsType::CONVERSION_METHOD(a, res, layout);\
+        res.copyTo(out + OUT_SIZE * i);\
+      }\
+    }
+
+    OBT_TUPLE_KERNEL(eu2om, 3, 9)
+    OBT_TUPLE_KERNEL_QUAT(eu2qu, 3, 4)
+    OBT_TUPLE_KERNEL(eu2ax, 3, 4)
+    OBT_TUPLE_KERNEL(eu2ro, 3, 4)
+    OBT_TUPLE_KERNEL(eu2ho, 3, 3)
+    OBT_TUPLE_KERNEL(eu2cu, 3, 3)
+
+    OBT_TUPLE_KERNEL(om2eu, 9, 3)
+    OBT_TUPLE_KERNEL(om2ax, 9, 4)
+    OBT_TUPLE_KERNEL(om2ro, 9, 4)
+    OBT_TUPLE_KERNEL_QUAT(om2qu, 9, 4)
+    OBT_TUPLE_KERNEL(om2ho, 9, 3)
+    OBT_TUPLE_KERNEL(om2cu, 9, 3)
+
+    OBT_TUPLE_KERNEL(ax2eu, 4, 3)
+    OBT_TUPLE_KERNEL(ax2om, 4, 9)
+    OBT_TUPLE_KERNEL(ax2ro, 4, 4)
+    OBT_TUPLE_KERNEL_QUAT(ax2qu, 4, 4)
+    OBT_TUPLE_KERNEL(ax2ho, 4, 3)
+    OBT_TUPLE_KERNEL(ax2cu, 4, 3)
+
+    OBT_TUPLE_KERNEL(ro2eu, 4, 3)
+    OBT_TUPLE_KERNEL(ro2om, 4, 9)
+    OBT_TUPLE_KERNEL(ro2ax, 4, 4)
+    OBT_TUPLE_KERNEL_QUAT(ro2qu, 4, 4)
+    OBT_TUPLE_KERNEL(ro2ho, 4, 3)
+    OBT_TUPLE_KERNEL(ro2cu, 4, 3)
+
+    OBT_TUPLE_KERNEL_QUAT(qu2eu, 4, 3)
+    OBT_TUPLE_KERNEL_QUAT(qu2om, 4, 9)
+    OBT_TUPLE_KERNEL_QUAT(qu2ax, 4, 4)
+    OBT_TUPLE_KERNEL_QUAT(qu2ro, 4, 4)
+    OBT_TUPLE_KERNEL_QUAT(qu2ho, 4, 3)
+    OBT_TUPLE_KERNEL_QUAT(qu2cu, 4, 3)
+
+    OBT_TUPLE_KERNEL(ho2eu, 3, 3)
+    OBT_TUPLE_KERNEL(ho2om, 3, 9)
+    OBT_TUPLE_KERNEL(ho2ax, 3, 4)
+    OBT_TUPLE_KERNEL(ho2ro, 3, 4)
+    OBT_TUPLE_KERNEL_QUAT(ho2qu, 3, 4)
+    OBT_TUPLE_KERNEL(ho2cu, 3, 3)
+
+    OBT_TUPLE_KERNEL(cu2eu, 3, 3)
+    OBT_TUPLE_KERNEL(cu2om, 3, 9)
+    OBT_TUPLE_KERNEL(cu2ax, 3, 4)
+    OBT_TUPLE_KERNEL(cu2ro, 3, 4)
+    OBT_TUPLE_KERNEL_QUAT(cu2qu, 3, 4)
+    OBT_TUPLE_KERNEL(cu2ho, 3, 3)
+
+#undef OBT_TUPLE_KERNEL
+#undef OBT_TUPLE_KERNEL_QUAT
+
+  protected:
+    OrientationBatchTransforms() {}
+
+  private:
+    OrientationBatchTransforms(const OrientationBatchTransforms&); // Copy Constructor Not Implemented
+    void operator=(const OrientationBatchTransforms&); // Operator '=' Not Implemented
+};
+
+#endif /* _OrientationBatchTransforms_H_ */
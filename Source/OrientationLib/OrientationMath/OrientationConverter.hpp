@@ -36,20 +36,127 @@
 #ifndef _OrientationConverter_H_
 #define _OrientationConverter_H_
 
+#include <algorithm>
 #include <iostream>     // std::cout, std::fixed, std::scientific
 
 
 #include <QtCore/QVector>
 #include <QtCore/QString>
+#include <QtCore/QAtomicInt>
+#include <QtCore/QRunnable>
+#include <QtCore/QSemaphore>
+#include <QtCore/QThreadPool>
 
 #include "SIMPLib/Math/SIMPLibMath.h"
 #include "SIMPLib/DataArrays/DataArray.hpp"
 #include "SIMPLib/Common/SIMPLibSetGetMacros.h"
 
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+#include <tbb/parallel_for.h>
+#include <tbb/blocked_range.h>
+#include <tbb/partitioner.h>
+#endif
+
 #include "OrientationLib/OrientationLib.h"
 #include "OrientationLib/OrientationMath/OrientationArray.hpp"
+#include "OrientationLib/OrientationMath/OrientationBatchTransforms.hpp"
 #include "OrientationLib/OrientationMath/OrientationTransforms.hpp"
 
+
+/**
+ * @brief The OrientationConversionRange class converts a range of tuples with one of the
+ * batch kernels of OrientationBatchTransforms. It is the body that is handed to
+ * tbb::parallel_for, and it is also used for the serial and thread pool conversions.
+ */
+template<typename T, typename KernelType>
+class OrientationConversionRange
+{
+  public:
+    OrientationConversionRange(const T* input, int inStride, T* output, int outStride, KernelType kernel) :
+      m_Input(input),
+      m_InStride(inStride),
+      m_Output(output),
+      m_OutStride(outStride),
+      m_Kernel(kernel)
+    {}
+
+    virtual ~OrientationConversionRange() {}
+
+    void convert(size_t start, size_t end) const
+    {
+      m_Kernel(m_Input + start * m_InStride, m_Output + start * m_OutStride, end - start);
+    }
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+    void operator()(const tbb::blocked_range<size_t>& r) const
+    {
+      convert(r.begin(), r.end());
+    }
+#endif
+
+  private:
+    const T*    m_Input;
+    int         m_InStride;
+    T*          m_Output;
+    int         m_OutStride;
+    KernelType  m_Kernel;
+};
+
+/**
+ * @brief The OrientationConversionTask class is a QRunnable that converts chunks of an
+ * OrientationConversionRange until there are none left. The calling thread works on the
+ * same chunks, so the conversion finishes even if no pool thread is free.
+ */
+template<typename RangeType>
+class OrientationConversionTask : public QRunnable
+{
+  public:
+    typedef struct
+    {
+      const RangeType* range;
+      size_t numTuples;
+      size_t chunkSize;
+      int numChunks;
+      QAtomicInt nextChunk;
+      QSemaphore finished;
+    } SharedState;
+
+    explicit OrientationConversionTask(SharedState* state) :
+      m_State(state)
+    {}
+
+    virtual ~OrientationConversionTask() {}
+
+    void run()
+    {
+      Convert(m_State);
+      m_State->finished.release();
+    }
+
+    /**
+     * @brief Convert Converts chunks until all of them have been taken
+     * @param state
+     */
+    static void Convert(SharedState* state)
+    {
+      int chunk = state->nextChunk.fetchAndAddOrdered(1);
+      while(chunk < state->numChunks)
+      {
+        size_t start = static_cast<size_t>(chunk) * state->chunkSize;
+        size_t end = start + state->chunkSize;
+        if(end > state->numTuples) { end = state->numTuples; }
+        state->range->convert(start, end);
+        chunk = state->nextChunk.fetchAndAddOrdered(1);
+      }
+    }
+
+  private:
+    SharedState* m_State;
+
+    OrientationConversionTask(const OrientationConversionTask&); // Copy Constructor Not Implemented
+    void operator=(const OrientationConversionTask&); // Operator '=' Not Implemented
+};
+
 template<typename T>
 class OrientationConverter
 {
@@ -81,56 +188,87 @@ class OrientationConverter
     */
     virtual OrientationType getOrientationRepresentation() { return UnknownOrientationType; }
 
+    /**
+     * @brief The ExecutionPolicy enum selects how the tuples are distributed over threads
+     */
+    enum ExecutionPolicy
+    {
+      Serial,       //!< Convert all tuples on the calling thread
+      ThreadPool,   //!< Convert chunks of tuples on QThreadPool::globalInstance() and the calling thread
+      ParallelFor   //!< Convert chunks of tuples with tbb::parallel_for; uses ThreadPool if TBB is not available
+    };
+
     /**
     * @brief convert
     * @param src
-    * @return
+    * @return 0 on success or a negative error code, see convertRepresentationTo(OrientationType)
+    */
+    int convertRepresentationTo(OrientationType repType, ExecutionPolicy policy)
+    {
+      setExecutionPolicy(policy);
+      return convertRepresentationTo(repType);
+    }
+
+    /**
+    * @brief convert Converts using the current ExecutionPolicy
+    * @param src
+    * @return 0 on success, -1 if the input array has fewer components than its representation
+    * and -2 for an unknown representation. The output data is a NullPointer on error.
     */
-    void convertRepresentationTo(OrientationType repType)
+    int convertRepresentationTo(OrientationType repType)
     {
-      if(repType == Euler) { toEulers(); }
-      else if(repType == OrientationMatrix) { toOrientationMatrix(); }
-      else if(repType == Quaternion) { toQuaternion(); }
-      else if(repType == AxisAngle) { toAxisAngle(); }
-      else if(repType == Rodrigues) { toRodrigues(); }
-      else if(repType == Homochoric) { toHomochoric(); }
-      else if(repType == Cubochoric) { toCubochoric(); }
+      if(repType == Euler) { return toEulers(); }
+      else if(repType == OrientationMatrix) { return toOrientationMatrix(); }
+      else if(repType == Quaternion) { return toQuaternion(); }
+      else if(repType == AxisAngle) { return toAxisAngle(); }
+      else if(repType == Rodrigues) { return toRodrigues(); }
+      else if(repType == Homochoric) { return toHomochoric(); }
+      else if(repType == Cubochoric) { return toCubochoric(); }
+      setOutputData(DataArray<T>::NullPointer());
+      return -2;
     }
 
     /**
      * @brief toEulers Converts the input orientations to Euler Angles
+     * @return 0 on success or -1 if the input array has fewer components than its representation
      */
-    virtual void toEulers() = 0;
+    virtual int toEulers() = 0;
 
     /**
      * @brief toOrientationMatrix  Converts the input orientations to an Orientation Matrix (3x3)
+     * @return 0 on success or -1 if the input array has fewer components than its representation
      */
-    virtual void toOrientationMatrix() = 0;
+    virtual int toOrientationMatrix() = 0;
 
     /**
      * @brief toQuaternion  Converts the input orientations to Quaternions
+     * @return 0 on success or -1 if the input array has fewer components than its representation
      */
-    virtual void toQuaternion() = 0;
+    virtual int toQuaternion() = 0;
 
     /**
      * @brief toAxisAngle  Converts the input orientations to Axis Angles
+     * @return 0 on success or -1 if the input array has fewer components than its representation
      */
-    virtual void toAxisAngle() = 0;
+    virtual int toAxisAngle() = 0;
 
     /**
      * @brief toRodrigues  Converts the input orientations to Rodrigues
+     * @return 0 on success or -1 if the input array has fewer components than its representation
      */
-    virtual void toRodrigues() = 0;
+    virtual int toRodrigues() = 0;
 
     /**
      * @brief toHomochoric  Converts the input orientations to Homochoric
+     * @return 0 on success or -1 if the input array has fewer components than its representation
      */
-    virtual void toHomochoric() = 0;
+    virtual int toHomochoric() = 0;
 
     /**
      * @brief toCubochoric  Converts the input orientations to Cubochoric
+     * @return 0 on success or -1 if the input array has fewer components than its representation
      */
-    virtual void toCubochoric() = 0;
+    virtual int toCubochoric() = 0;
 
     /**
      * @brief compareRepresentations Compares 2 representations of the same type
@@ -167,6 +305,17 @@ class OrientationConverter
     */
     SIMPL_INSTANCE_PROPERTY(typename DataArray<T>::Pointer, OutputData)
 
+    /**
+    * @brief The ExecutionPolicy that the toXxx() conversions use; the default is Serial
+    */
+    SIMPL_INSTANCE_PROPERTY(ExecutionPolicy, ExecutionPolicy)
+
+    /**
+    * @brief The number of tuples per chunk for the parallel policies. When it is 0 the chunk
+    * size is chosen so that the input and output of a chunk fit in 256 KiB.
+    */
+    SIMPL_INSTANCE_PROPERTY(size_t, ChunkSize)
+
     /**
      * @brief GetOrientationTypeStrings
      * @return
@@ -231,7 +380,109 @@ class OrientationConverter
     static int GetMaxIndex() { return 6; }
 
   protected:
-    OrientationConverter() {}
+    OrientationConverter() :
+      m_ExecutionPolicy(Serial),
+      m_ChunkSize(0)
+    {}
+
+    /**
+     * @brief convertWithKernel Converts the input array into a new output array with a
+     * batch kernel of OrientationBatchTransforms, using the current ExecutionPolicy. The
+     * output is not zero filled first because the kernel writes every value. The kernels
+     * read packed tuples, so an input with more components than its representation is
+     * packed first, and an input with fewer components is rejected with a NULL output.
+     * @param outStride Number of components of the output representation
+     * @param name Name of the output array
+     * @param kernel Callable with the signature (const T* in, T* out, size_t n)
+     * @return 0 on success or -1 if the input has too few components
+     */
+    template<typename KernelType>
+    int convertWithKernel(int outStride, const QString& name, KernelType kernel)
+    {
+      typedef OrientationConversionRange<T, KernelType> RangeType;
+      typedef OrientationConversionTask<RangeType> TaskType;
+
+      typename DataArray<T>::Pointer input = getInputData();
+      size_t nTuples = input->getNumberOfTuples();
+      int inStride = input->getNumberOfComponents();
+      int inSize = GetComponentCounts()[getOrientationRepresentation()];
+      if(inStride < inSize)
+      {
+        setOutputData(DataArray<T>::NullPointer());
+        return -1;
+      }
+
+      const T* inPtr = input->getPointer(0);
+      typename DataArray<T>::Pointer packed;
+      if(inStride > inSize)
+      {
+        packed = DataArray<T>::CreateArray(nTuples, QVector<size_t>(1, inSize), input->getName());
+        T* packedPtr = packed->getPointer(0);
+        for(size_t i = 0; i < nTuples; ++i)
+        {
+          std::copy(inPtr + i * inStride, inPtr + i * inStride + inSize, packedPtr + i * inSize);
+        }
+        inPtr = packedPtr;
+        inStride = inSize;
+      }
+
+      QVector<size_t> cDims(1, outStride); /* Create the n component (nx1) based array.*/
+      typename DataArray<T>::Pointer output = DataArray<T>::CreateArray(nTuples, cDims, name);
+
+      RangeType range(inPtr, inStride, output->getPointer(0), outStride, kernel);
+
+      size_t chunkSize = m_ChunkSize;
+      if(chunkSize == 0)
+      {
+        chunkSize = (256 * 1024) / (sizeof(T) * (inStride + outStride));
+      }
+
+      ExecutionPolicy policy = m_ExecutionPolicy;
+#ifndef SIMPLib_USE_PARALLEL_ALGORITHMS
+      if(policy == ParallelFor) { policy = ThreadPool; }
+#endif
+
+      if(policy == Serial || nTuples <= chunkSize)
+      {
+        range.convert(0, nTuples);
+      }
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+      else if(policy == ParallelFor)
+      {
+        tbb::parallel_for(tbb::blocked_range<size_t>(0, nTuples, chunkSize), range, tbb::simple_partitioner());
+      }
+#endif
+      else
+      {
+        typename TaskType::SharedState state;
+        state.range = &range;
+        state.numTuples = nTuples;
+        state.chunkSize = chunkSize;
+        state.numChunks = static_cast<int>((nTuples + chunkSize - 1) / chunkSize);
+
+        // Only count the tasks that actually started, so that a busy pool can not deadlock us
+        QThreadPool* pool = QThreadPool::globalInstance();
+        int numHelpers = std::min(pool->maxThreadCount(), state.numChunks) - 1;
+        int started = 0;
+        for(int i = 0; i < numHelpers; i++)
+        {
+          TaskType* task = new TaskType(&state);
+          task->setAutoDelete(true);
+          if(pool->tryStart(task) == false)
+          {
+            delete task;
+            break;
+          }
+          started++;
+        }
+
+        TaskType::Convert(&state);
+        state.finished.acquire(started);
+      }
+
+      setOutputData(output);
+      return 0;
+    }
 
   private:
     OrientationConverter(const OrientationConverter&); // Copy Constructor Not Implemented
@@ -239,25 +490,14 @@ class OrientationConverter
 
 };
 
+/* The conversion is done by the batch kernel of OrientationBatchTransforms, which
+ * reads packed tuples; convertWithKernel packs or rejects inputs whose component
+ * count differs from the representation. */
 #define OC_CONVERT_BODY(OUTSTRIDE, OUT_ARRAY_NAME, CONVERSION_METHOD)\
-  typedef OrientationArray<T> OrientationArray_t;\
-  typename DataArray<T>::Pointer input = this->getInputData();\
-  T* inPtr = input->getPointer(0);\
-  size_t nTuples = input->getNumberOfTuples();\
-  int inStride = input->getNumberOfComponents();\
-  int outStride = OUTSTRIDE;\
-  QVector<size_t> cDims(1, outStride); /* Create the n component (nx1) based array.*/ \
-  typename DataArray<T>::Pointer output = DataArray<T>::CreateArray(nTuples, cDims, #OUT_ARRAY_NAME);\
-  output->initializeWithZeros(); /* Intialize the array with Zeros */ \
-  T* OUT_ARRAY_NAME##Ptr = output->getPointer(0);\
-  for (size_t i = 0; i < nTuples; ++i) { \
-    OrientationArray_t rot(inPtr, inStride); \
-    OrientationArray_t res(OUT_ARRAY_NAME##Ptr, outStride); \
-    OrientationTransforms<OrientationArray_t, T>::CONVERSION_METHOD(rot, res); \
-    inPtr = inPtr + inStride; /* Increment input pointer */ \
-    OUT_ARRAY_NAME##Ptr = OUT_ARRAY_NAME##Ptr + outStride; /* Increment output pointer*/ \
-  }\
-  this->setOutputData(output);
+  return this->convertWithKernel(OUTSTRIDE, #OUT_ARRAY_NAME, [](const T* in, T* out, size_t n)\
+  {\
+    OrientationBatchTransforms<T>::CONVERSION_METHOD##_batch(in, out, n);\
+  });
 
 
 
@@ -279,45 +519,46 @@ class EulerConverter : public OrientationConverter<T>
     virtual typename OrientationConverter<T>::OrientationType getOrientationRepresentation()
     { return OrientationConverter<T>::Euler; }
 
-    virtual void toEulers()
+    virtual int toEulers()
     {
       typedef typename DataArray<T>::Pointer PointerType;
       PointerType input = this->getInputData();
       PointerType output = std::dynamic_pointer_cast<DataArray<T> >(input->deepCopy());
       this->setOutputData(output);
+      return 0;
     }
 
-    virtual void toOrientationMatrix()
+    virtual int toOrientationMatrix()
     {
       sanityCheckInputData();
       OC_CONVERT_BODY(9, OrientationMatrix, eu2om)
     }
 
-    virtual void toQuaternion()
+    virtual int toQuaternion()
     {
       sanityCheckInputData();
       OC_CONVERT_BODY(4, Quaternions, eu2qu)
     }
 
-    virtual void toAxisAngle()
+    virtual int toAxisAngle()
     {
       sanityCheckInputData();
       OC_CONVERT_BODY(4, AxisAngle, eu2ax)
     }
 
-    virtual void toRodrigues()
+    virtual int toRodrigues()
     {
       sanityCheckInputData();
       OC_CONVERT_BODY(4, Rodrigues, eu2ro)
     }
 
-    virtual void toHomochoric()
+    virtual int toHomochoric()
     {
       sanityCheckInputData();
       OC_CONVERT_BODY(3, Homochoric, eu2ho)
     }
 
-    virtual void toCubochoric()
+    virtual int toCubochoric()
     {
       sanityCheckInputData();
       OC_CONVERT_BODY(3, Cubochoric, eu2cu)
@@ -330,6 +571,7 @@ class EulerConverter : public OrientationConverter<T>
       T* inPtr = input->getPointer(0);
       size_t nTuples = input->getNumberOfTuples();
       int inStride = input->getNumberOfComponents();
+      if(inStride < 3) { return; } // The conversion reports the bad component count
       for (size_t i = 0; i < nTuples; ++i)
       {
 
@@ -395,45 +637,46 @@ class OrientationMatrixConverter : public OrientationConverter<T>
     virtual typename OrientationConverter<T>::OrientationType getOrientationRepresentation()
     { return OrientationConverter<T>::OrientationMatrix; }
 
-    virtual void toEulers()
+    virtual int toEulers()
     {
       sanityCheckInputData();
       OC_CONVERT_BODY(3, Eulers, om2eu)
     }
 
-    virtual void toOrientationMatrix()
+    virtual int toOrientationMatrix()
     {
       typedef typename DataArray<T>::Pointer PointerType;
       PointerType input = this->getInputData();
       PointerType output = std::dynamic_pointer_cast<DataArray<T> >(input->deepCopy());
       this->setOutputData(output);
+      return 0;
     }
 
-    virtual void toQuaternion()
+    virtual int toQuaternion()
     {
       sanityCheckInputData();
       OC_CONVERT_BODY(4, Quaternion, om2qu)
     }
 
-    virtual void toAxisAngle()
+    virtual int toAxisAngle()
     {
       sanityCheckInputData();
       OC_CONVERT_BODY(4, AxisAngle, om2ax)
     }
 
-    virtual void toRodrigues()
+    virtual int toRodrigues()
     {
       sanityCheckInputData();
       OC_CONVERT_BODY(4, Rodrigues, om2ro)
     }
 
-    virtual void toHomochoric()
+    virtual int toHomochoric()
     {
       sanityCheckInputData();
       OC_CONVERT_BODY(3, Homochoric, om2ho)
     }
 
-    virtual void toCubochoric()
+    virtual int toCubochoric()
     {
       sanityCheckInputData();
       OC_CONVERT_BODY(3, Cubochoric, om2cu)
@@ -445,6 +688,7 @@ class OrientationMatrixConverter : public OrientationConverter<T>
       T* inPtr = input->getPointer(0);
       size_t nTuples = input->getNumberOfTuples();
       int inStride = input->getNumberOfComponents();
+      if(inStride < 9) { return; } // The conversion reports the bad component count
       for (size_t i = 0; i < nTuples; ++i)
       {
 
@@ -518,40 +762,41 @@ class QuaternionConverter : public OrientationConverter<T>
     virtual typename OrientationConverter<T>::OrientationType getOrientationRepresentation()
     { return OrientationConverter<T>::Quaternion; }
 
-    virtual void toEulers()
+    virtual int toEulers()
     {
       OC_CONVERT_BODY(3, Eulers, qu2eu)
     }
 
-    virtual void toOrientationMatrix()
+    virtual int toOrientationMatrix()
     {
       OC_CONVERT_BODY(9, OrientationMatrix, qu2om)
     }
 
-    virtual void toQuaternion()
+    virtual int toQuaternion()
     {
       typedef typename DataArray<T>::Pointer PointerType;
       PointerType input = this->getInputData();
       PointerType output = std::dynamic_pointer_cast<DataArray<T> >(input->deepCopy());
       this->setOutputData(output);
+      return 0;
     }
 
-    virtual void toAxisAngle()
+    virtual int toAxisAngle()
     {
       OC_CONVERT_BODY(4, AxisAngle, qu2ax)
     }
 
-    virtual void toRodrigues()
+    virtual int toRodrigues()
     {
       OC_CONVERT_BODY(4, Rodrigues, qu2ro)
     }
 
-    virtual void toHomochoric()
+    virtual int toHomochoric()
     {
       OC_CONVERT_BODY(3, Homochoric, qu2ho)
     }
 
-    virtual void toCubochoric()
+    virtual int toCubochoric()
     {
       OC_CONVERT_BODY(3, Cubochoric, qu2cu)
     }
@@ -618,40 +863,41 @@ class AxisAngleConverter : public OrientationConverter<T>
     virtual typename OrientationConverter<T>::OrientationType getOrientationRepresentation()
     { return OrientationConverter<T>::AxisAngle; }
 
-    virtual void toEulers()
+    virtual int toEulers()
     {
       OC_CONVERT_BODY(3, Eulers, ax2eu)
     }
 
-    virtual void toOrientationMatrix()
+    virtual int toOrientationMatrix()
     {
       OC_CONVERT_BODY(9, OrientationMatrix, ax2om)
     }
 
-    virtual void toQuaternion()
+    virtual int toQuaternion()
     {
       OC_CONVERT_BODY(4, Quaternions, ax2qu)
     }
 
-    virtual void toAxisAngle()
+    virtual int toAxisAngle()
     {
       typedef typename DataArray<T>::Pointer PointerType;
       PointerType input = this->getInputData();
       PointerType output = std::dynamic_pointer_cast<DataArray<T> >(input->deepCopy());
       this->setOutputData(output);
+      return 0;
     }
 
-    virtual void toRodrigues()
+    virtual int toRodrigues()
     {
       OC_CONVERT_BODY(4, Rodrigues, ax2ro)
     }
 
-    virtual void toHomochoric()
+    virtual int toHomochoric()
     {
       OC_CONVERT_BODY(3, Homochoric, ax2ho)
     }
 
-    virtual void toCubochoric()
+    virtual int toCubochoric()
     {
       OC_CONVERT_BODY(3, Cubochoric, ax2cu)
     }
@@ -713,40 +959,41 @@ class RodriguesConverter : public OrientationConverter<T>
     virtual typename OrientationConverter<T>::OrientationType getOrientationRepresentation()
     { return OrientationConverter<T>::Rodrigues; }
 
-    virtual void toEulers()
+    virtual int toEulers()
     {
       OC_CONVERT_BODY(3, Eulers, ro2eu)
     }
 
-    virtual void toOrientationMatrix()
+    virtual int toOrientationMatrix()
     {
       OC_CONVERT_BODY(9, OrientationMatrix, ro2om)
     }
 
-    virtual void toQuaternion()
+    virtual int toQuaternion()
     {
       OC_CONVERT_BODY(4, Quaternions, ro2qu)
     }
 
-    virtual void toAxisAngle()
+    virtual int toAxisAngle()
     {
       OC_CONVERT_BODY(4, AxisAngle, ro2ax)
     }
 
-    virtual void toRodrigues()
+    virtual int toRodrigues()
     {
       typedef typename DataArray<T>::Pointer PointerType;
       PointerType input = this->getInputData();
       PointerType output = std::dynamic_pointer_cast<DataArray<T> >(input->deepCopy());
       this->setOutputData(output);
+      return 0;
     }
 
-    virtual void toHomochoric()
+    virtual int toHomochoric()
     {
       OC_CONVERT_BODY(3, Homochoric, ro2ho)
     }
 
-    virtual void toCubochoric()
+    virtual int toCubochoric()
     {
       OC_CONVERT_BODY(3, Cubochoric, ro2cu)
     }
@@ -808,40 +1055,41 @@ class HomochoricConverter : public OrientationConverter<T>
     virtual typename OrientationConverter<T>::OrientationType getOrientationRepresentation()
     { return OrientationConverter<T>::Homochoric; }
 
-    virtual void toEulers()
+    virtual int toEulers()
     {
       OC_CONVERT_BODY(3, Eulers, ho2eu)
     }
 
-    virtual void toOrientationMatrix()
+    virtual int toOrientationMatrix()
     {
       OC_CONVERT_BODY(9, OrientationMatrix, ho2om)
     }
 
-    virtual void toQuaternion()
+    virtual int toQuaternion()
     {
       OC_CONVERT_BODY(4, Quaternions, ho2qu)
     }
 
-    virtual void toAxisAngle()
+    virtual int toAxisAngle()
     {
       OC_CONVERT_BODY(4, AxisAngle, ho2ax)
     }
 
-    virtual void toRodrigues()
+    virtual int toRodrigues()
     {
       OC_CONVERT_BODY(4, Rodrigues, ho2ro)
     }
 
-    virtual void toHomochoric()
+    virtual int toHomochoric()
     {
       typedef typename DataArray<T>::Pointer PointerType;
       PointerType input = this->getInputData();
       PointerType output = std::dynamic_pointer_cast<DataArray<T> >(input->deepCopy());
       this->setOutputData(output);
+      return 0;
     }
 
-    virtual void toCubochoric()
+    virtual int toCubochoric()
     {
       OC_CONVERT_BODY(3, Cubochoric, ho2cu)
     }
@@ -904,42 +1152,43 @@ class CubochoricConverter : public OrientationConverter<T>
     virtual typename OrientationConverter<T>::OrientationType getOrientationRepresentation()
     { return OrientationConverter<T>::Cubochoric; }
 
-    virtual void toEulers()
+    virtual int toEulers()
     {
       OC_CONVERT_BODY(3, Eulers, cu2eu)
     }
 
-    virtual void toOrientationMatrix()
+    virtual int toOrientationMatrix()
     {
       OC_CONVERT_BODY(9, OrientationMatrix, cu2om)
     }
 
-    virtual void toQuaternion()
+    virtual int toQuaternion()
     {
       OC_CONVERT_BODY(4, Quaternions, cu2qu)
     }
 
-    virtual void toAxisAngle()
+    virtual int toAxisAngle()
     {
       OC_CONVERT_BODY(4, AxisAngle, cu2ax)
     }
 
-    virtual void toRodrigues()
+    virtual int toRodrigues()
     {
       OC_CONVERT_BODY(4, Rodrigues, cu2ro)
     }
 
-    virtual void toHomochoric()
+    virtual int toHomochoric()
     {
       OC_CONVERT_BODY(3, Homochoric, cu2ho)
     }
 
-    virtual void toCubochoric()
+    virtual int toCubochoric()
     {
       typedef typename DataArray<T>::Pointer PointerType;
       PointerType input = this->getInputData();
       PointerType output = std::dynamic_pointer_cast<DataArray<T> >(input->deepCopy());
       this->setOutputData(output);
+      return 0;
     }
 
     virtual void sanityCheckInputData()
@@ -55,6 +55,7 @@
 
 #include "OrientationLib/OrientationLib.h"
 #include "OrientationLib/OrientationMath/OrientationArray.hpp"
+#include "OrientationLib/OrientationMath/OrientationFixedArray.hpp"
 #include "OrientationLib/Utilities/ModifiedLambertProjection3D.hpp"
 
 
@@ -133,9 +134,11 @@ namespace DConst = SIMPLib::Constants;
 
 /**
  * @brief The OrientationTransforms class
- * template parameter T can be one of std::vector<T>, QVector<T> or OrientationArray<T>
- * and template parameter K is the type specified in T. For example if T is std::vector<float>
- * then K is float.
+ * template parameter T can be one of std::vector<T>, QVector<T>, OrientationArray<T> or
+ * OrientationFixedArray<T> and template parameter K is the type specified in T. For example
+ * if T is std::vector<float> then K is float. The composite conversions (cu2eu, qu2cu, ...)
+ * create their intermediate representations as T, so only OrientationFixedArray<T> converts
+ * without any heap allocations.
  */
 template<typename T, typename K>
 class OrientationTransforms
@@ -970,7 +973,7 @@ class OrientationTransforms
         z = 2;
       }
 
-      T qq(4);
+      const T& qq = q;
       K q12 = 0.0f;
       K q03 = 0.0f;
       K chi = 0.0f;
@@ -978,8 +981,6 @@ class OrientationTransforms
       K phi1 = 0.0f;
       K phi2 = 0.0f;
 
-      qq = q;
-
       q03 = qq[w] * qq[w] + qq[z] * qq[z];
       q12 = qq[x] * qq[x] + qq[y] * qq[y];
       chi = sqrt(q03 * q12);
@@ -1096,9 +1097,7 @@ class OrientationTransforms
       else
       {
         K hm = hmag;
-        T hn = h;
         K sqrRtHMag = 1.0 / sqrt(hmag);
-        OMHelperType::scalarMultiply(hn, sqrRtHMag); // In place scalar multiply
         K s = LPs::tfit[0] + LPs::tfit[1] * hmag;
         for(int i = 2; i < 16; i++)
         {
@@ -1106,9 +1105,9 @@ class OrientationTransforms
           s = s + LPs::tfit[i] * hm;
         }
         s = 2.0 * acos(s);
-        res[0] = hn[0];
-        res[1] = hn[1];
-        res[2] = hn[2];
+        res[0] = h[0] * sqrRtHMag;
+        res[1] = h[1] * sqrRtHMag;
+        res[2] = h[2] * sqrRtHMag;
         K delta = std::fabs(s - SIMPLib::Constants::k_Pi);
         if ( delta < thr)
         {
@@ -1347,7 +1346,7 @@ class OrientationTransforms
       {
 
         RotationMatrixMapType resWrap(const_cast<K*>(&(res[0])));
-        resWrap.transpose();
+        resWrap.transposeInPlace();
 
 //        res = OMHelperType::transpose(res);
       }
@@ -1462,13 +1461,11 @@ class OrientationTransforms
       }
 
       K epsijk = RConst::epsijkd;
-      T qo(q);
       // make sure q[0] is >= 0.0
       K sign = 1.0;
       if(q[w] < 0.0) { sign = -1.0; }
-      for (int i = 0; i < 4; i++) {qo[i] = sign * q[i];}
       K eps = static_cast<K>(1.0e-12L);
-      K omega = 2.0 * acos(qo[w]);
+      K omega = 2.0 * acos(sign * q[w]);
       if (omega < eps)
       {
         res[0] = 0.0;
@@ -2150,5 +2147,8 @@ class OrientationTransforms
 typedef OrientationTransforms<FOrientArrayType, float>     FOrientTransformsType;
 typedef OrientationTransforms<DOrientArrayType, double>     DOrientTransformsType;
 
+typedef OrientationTransforms<FOrientFixedArrayType, float>     FFixedOrientTransformsType;
+typedef OrientationTransforms<DOrientFixedArrayType, double>     DFixedOrientTransformsType;
+
 
 #endif /* _OrientationTransforms_H_ */
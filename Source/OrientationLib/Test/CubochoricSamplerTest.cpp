@@ -0,0 +1,279 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (c) 2017 BlueQuartz Software
+//  All rights reserved.
+//  BSD License: http://www.opensource.org/licenses/bsd-license.html
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include <stdio.h>
+
+//-- C++ includes
+#include <cmath>
+#include <iostream>
+
+#include <QtCore/QMutex>
+#include <QtCore/QMutexLocker>
+
+#include "OrientationLib/OrientationLibConstants.h"
+#include "OrientationLib/OrientationMath/OrientationArray.hpp"
+#include "OrientationLib/OrientationMath/OrientationTransforms.hpp"
+#include "OrientationLib/Utilities/CubochoricSampler.h"
+
+#include "UnitTestSupport.hpp"
+
+namespace
+{
+  typedef OrientationTransforms<DOrientArrayType, double> OrientationTransformsType;
+
+  const int k_NumberOfSamplingPoints[3] = { 1, 4, 9 };
+
+  // -----------------------------------------------------------------------------
+  //  The serial grid walk of the fundamental zone sampling as it was done in the
+  //  SampleCubochoricSpaceWidget before the sampler existed
+  // -----------------------------------------------------------------------------
+  size_t countFundamentalZone(int Np, int ptGrpNum, bool offsetGrid)
+  {
+    double delta = (0.50 * LPs::ap) / static_cast<double>(Np);
+    double gridShift = offsetGrid ? 0.5 : 0.0;
+    int FZtype = FundamentalZoneConstants::FZtarray[ptGrpNum - 1];
+    int FZorder = FundamentalZoneConstants::FZoarray[ptGrpNum - 1];
+    double edge = 0.5 * LPs::ap;
+
+    size_t count = 0;
+    for(int i = -Np + 1; i < Np + 1; i++)
+    {
+      double x = (static_cast<double>(i) + gridShift) * delta;
+      if(fabs(x) > edge) { continue; }
+      for(int j = -Np + 1; j < Np + 1; j++)
+      {
+        double y = (static_cast<double>(j) + gridShift) * delta;
+        if(fabs(y) > edge) { continue; }
+        for(int k = -Np + 1; k < Np + 1; k++)
+        {
+          double z = (static_cast<double>(k) + gridShift) * delta;
+          if(fabs(z) > edge) { continue; }
+          DOrientArrayType cu(x, y, z);
+          DOrientArrayType rod(4);
+          OrientationTransformsType::cu2ro(cu, rod);
+          if(CubochoricSampler::IsInsideFZ(rod.data(), FZtype, FZorder))
+          {
+            count++;
+          }
+        }
+      }
+    }
+    return count;
+  }
+
+  // -----------------------------------------------------------------------------
+  //  The loops of the old constant misorientation surface sampling; every grid
+  //  point of a pair of opposite faces adds two samples
+  // -----------------------------------------------------------------------------
+  size_t countMisorientationSurface(int Np)
+  {
+    size_t count = 0;
+    // x-y bottom and top planes
+    for(int i = -Np; i <= Np; i++)
+    {
+      for(int j = -Np; j <= Np; j++) { count += 2; }
+    }
+    // y-z planes
+    for(int j = -Np; j <= Np; j++)
+    {
+      for(int k = -Np + 1; k <= Np - 1; k++) { count += 2; }
+    }
+    // x-z planes
+    for(int i = -Np + 1; i <= Np - 1; i++)
+    {
+      for(int k = -Np + 1; k <= Np - 1; k++) { count += 2; }
+    }
+    return count;
+  }
+
+  // -----------------------------------------------------------------------------
+  //  The loops of the old "less than given misorientation" volume sampling
+  // -----------------------------------------------------------------------------
+  size_t countMisorientationVolume(int Np)
+  {
+    size_t count = 0;
+    for(int i = -Np; i <= Np; i++)
+    {
+      for(int j = -Np; j <= Np; j++)
+      {
+        for(int k = -Np; k <= Np; k++) { count++; }
+      }
+    }
+    return count;
+  }
+
+  /**
+   * @brief Records the progress callbacks, which arrive from the worker threads
+   */
+  typedef struct
+  {
+    QMutex mutex;
+    size_t calls;
+    size_t completed;
+    size_t firstTotal;
+    bool   sameTotal;
+  } ProgressRecord;
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void recordProgress(size_t object, size_t completed, size_t total)
+  {
+    ProgressRecord* record = reinterpret_cast<ProgressRecord*>(object);
+    QMutexLocker locker(&record->mutex);
+    if(record->calls == 0)
+    {
+      record->firstTotal = total;
+    }
+    record->sameTotal = record->sameTotal && (total == record->firstTotal);
+    record->completed = std::max(record->completed, completed);
+    record->calls++;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void clearProgress(ProgressRecord& record)
+  {
+    record.calls = 0;
+    record.completed = 0;
+    record.firstTotal = 0;
+    record.sameTotal = true;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  bool ignoreBlock(size_t object, const float* data, size_t firstSample, size_t numSamples)
+  {
+    (void)object; (void)data; (void)firstSample; (void)numSamples;
+    return true;
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void TestFundamentalZoneCounts()
+{
+  CubochoricSampler::Pointer sampler = CubochoricSampler::New();
+  sampler->setSamplingMode(CubochoricSampler::FundamentalZone);
+  for(int n = 0; n < 3; n++)
+  {
+    for(int ptGrpNum = 1; ptGrpNum <= 32; ptGrpNum++)
+    {
+      for(int offset = 0; offset < 2; offset++)
+      {
+        int Np = k_NumberOfSamplingPoints[n];
+        sampler->setNumberOfSamplingPoints(Np);
+        sampler->setPointGroup(ptGrpNum);
+        sampler->setOffsetGrid(offset != 0);
+
+        size_t expected = countFundamentalZone(Np, ptGrpNum, offset != 0);
+        EMSOFT_REQUIRE_EQUAL(sampler->countSamples(), expected);
+        FloatArrayType::Pointer eulers = sampler->generate(3, "Euler Angles");
+        EMSOFT_REQUIRE(eulers.get() != nullptr);
+        EMSOFT_REQUIRE_EQUAL(eulers->getNumberOfTuples(), expected);
+      }
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void TestMisorientationCounts()
+{
+  CubochoricSampler::Pointer sampler = CubochoricSampler::New();
+  sampler->setMisorientationAngle(7.5 * SIMPLib::Constants::k_Pi / 180.0);
+  sampler->setReferenceOrientation(0.3, 0.7, 1.1);
+  for(int n = 0; n < 3; n++)
+  {
+    int Np = k_NumberOfSamplingPoints[n];
+    sampler->setNumberOfSamplingPoints(Np);
+
+    sampler->setSamplingMode(CubochoricSampler::MisorientationSurface);
+    EMSOFT_REQUIRE_EQUAL(sampler->countSamples(), countMisorientationSurface(Np));
+    FloatArrayType::Pointer quats = sampler->generate(4, "Quaternions");
+    EMSOFT_REQUIRE(quats.get() != nullptr);
+    EMSOFT_REQUIRE_EQUAL(quats->getNumberOfTuples(), countMisorientationSurface(Np));
+
+    sampler->setSamplingMode(CubochoricSampler::MisorientationVolume);
+    EMSOFT_REQUIRE_EQUAL(sampler->countSamples(), countMisorientationVolume(Np));
+    quats = sampler->generate(4, "Quaternions");
+    EMSOFT_REQUIRE(quats.get() != nullptr);
+    EMSOFT_REQUIRE_EQUAL(quats->getNumberOfTuples(), countMisorientationVolume(Np));
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void TestCancelIsKeptUntilReset()
+{
+  CubochoricSampler::Pointer sampler = CubochoricSampler::New();
+  sampler->setNumberOfSamplingPoints(4);
+  sampler->setPointGroup(32);
+
+  // A cancel that arrives before or between the phases must not be cleared by the next phase
+  sampler->cancel();
+  EMSOFT_REQUIRE_EQUAL(sampler->countSamples(), 0);
+  EMSOFT_REQUIRE(sampler->generate(3, "Euler Angles").get() == nullptr);
+  EMSOFT_REQUIRE_EQUAL(sampler->generateBlocks(3, 100, &ignoreBlock, 0), false);
+  EMSOFT_REQUIRE_EQUAL(sampler->wasCanceled(), true);
+
+  sampler->reset();
+  EMSOFT_REQUIRE_EQUAL(sampler->wasCanceled(), false);
+  FloatArrayType::Pointer eulers = sampler->generate(3, "Euler Angles");
+  EMSOFT_REQUIRE(eulers.get() != nullptr);
+  EMSOFT_REQUIRE_EQUAL(eulers->getNumberOfTuples(), countFundamentalZone(4, 32, false));
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void TestProgressUsesOneTotal()
+{
+  ProgressRecord record;
+  CubochoricSampler::Pointer sampler = CubochoricSampler::New();
+  sampler->setNumberOfSamplingPoints(9);
+  sampler->setPointGroup(1);
+  sampler->setProgressCallback(&recordProgress, reinterpret_cast<size_t>(&record));
+
+  // The count and the write pass of the fundamental zone report against one total
+  clearProgress(record);
+  FloatArrayType::Pointer eulers = sampler->generate(3, "Euler Angles");
+  EMSOFT_REQUIRE(eulers.get() != nullptr);
+  EMSOFT_REQUIRE_EQUAL(record.sameTotal, true);
+  EMSOFT_REQUIRE_EQUAL(record.firstTotal, 2 * 18 * 18);
+  EMSOFT_REQUIRE_EQUAL(record.completed, record.firstTotal);
+
+  // The blocks split rows, but every row is reported once
+  clearProgress(record);
+  sampler->setPointGroup(32);
+  EMSOFT_REQUIRE_EQUAL(sampler->generateBlocks(3, 7, &ignoreBlock, 0), true);
+  EMSOFT_REQUIRE_EQUAL(record.sameTotal, true);
+  EMSOFT_REQUIRE_EQUAL(record.firstTotal, 2 * 18 * 18);
+  EMSOFT_REQUIRE_EQUAL(record.completed, record.firstTotal);
+}
+
+// -----------------------------------------------------------------------------
+//  Use unit test framework
+// -----------------------------------------------------------------------------
+int main(int argc, char** argv)
+{
+  int err = EXIT_SUCCESS;
+
+  EMSOFT_REGISTER_TEST( TestFundamentalZoneCounts() )
+  EMSOFT_REGISTER_TEST( TestMisorientationCounts() )
+  EMSOFT_REGISTER_TEST( TestCancelIsKeptUntilReset() )
+  EMSOFT_REGISTER_TEST( TestProgressUsesOneTotal() )
+  PRINT_TEST_SUMMARY();
+
+  return err;
+}
@@ -0,0 +1,185 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (c) 2017 BlueQuartz Software
+//  All rights reserved.
+//  BSD License: http://www.opensource.org/licenses/bsd-license.html
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include <stdio.h>
+
+//-- C++ includes
+#include <iostream>
+
+#include "OrientationLib/OrientationMath/OrientationArray.hpp"
+#include "OrientationLib/OrientationMath/OrientationFixedArray.hpp"
+#include "OrientationLib/OrientationMath/OrientationTransforms.hpp"
+
+#include "UnitTestSupport.hpp"
+
+namespace
+{
+  /**
+   * @brief One orientation and the results of the conversions whose implementation
+   * changed when the fixed size types were added. The expected values were printed
+   * (with 9 significant digits, which is exact for a float) by the OrientationArray
+   * code before that change.
+   */
+  typedef struct
+  {
+    float qu[4];
+    float ho[3];
+    float qu2eu[3];
+    float qu2ax[4];
+    float ho2ax[4];
+  } ConversionFixture;
+
+  const size_t k_NumFixtures = 5;
+
+  // The quaternions and homochoric vectors are eu2qu and eu2ho of the Euler angles
+  // (0, 0, 0), (0.3, 0.7, 1.1), (2.5, 1.9, 4.2), (5.9, 3.0, 0.4) and (1.2, 0, 2.0)
+  const ConversionFixture k_Fixtures[k_NumFixtures] =
+  {
+    { { -0.0f, -0.0f, -0.0f, 1.0f }, { 0.0f, 0.0f, 0.0f },
+      { 0.0f, 0.0f, 0.0f },
+      { 0.0f, 0.0f, 1.0f, 0.0f },
+      { 0.0f, 0.0f, 1.0f, 0.0f } },
+    { { -0.315829784f, 0.133530691f, -0.605160534f, 0.718471825f }, { -0.335722715f, 0.141941294f, -0.643277347f },
+      { 0.300000012f, 0.700000048f, 1.10000002f },
+      { -0.454068065f, 0.191976905f, -0.870038509f, 1.53838718f },
+      { -0.454068094f, 0.19197692f, -0.870038569f, 1.5383873f } },
+    { { 0.536840618f, -0.611103117f, -0.120351322f, 0.569096506f }, { 0.592162132f, -0.674077451f, -0.132753581f },
+      { 2.5f, 1.89999998f, 4.19999981f },
+      { 0.652875602f, -0.743189514f, -0.14636457f, 1.93077934f },
+      { 0.652875602f, -0.743189573f, -0.146364599f, 1.93077946f } },
+    { { -0.921986997f, 0.380704939f, -0.000594711921f, 0.0707346946f }, { -1.19188285f, 0.49214974f, -0.000768803584f },
+      { 5.9000001f, 3.0f, 0.400000095f },
+      { -0.92430222f, 0.381660938f, -0.000596205355f, 3.00000501f },
+      { -0.92430222f, 0.381660908f, -0.000596205296f, 3.00000501f } },
+    { { 0.0f, -0.0f, 0.999573588f, 0.0291995462f }, { 0.0f, -0.0f, 1.31397319f },
+      { 3.20000005f, 0.0f, 0.0f },
+      { 0.0f, -0.0f, 1.0f, 3.0831852f },
+      { 0.0f, -0.0f, 1.0f, 3.0831852f } }
+  };
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  template<typename A, typename B>
+  void requireIdentical(const A& lhs, const B& rhs)
+  {
+    EMSOFT_REQUIRE_EQUAL(lhs.size(), rhs.size());
+    for (size_t i = 0; i < lhs.size(); i++)
+    {
+      EMSOFT_REQUIRE_EQUAL(lhs[i], rhs[i]);
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void requireIdentical(const FOrientFixedArrayType& lhs, const float* expected, size_t size)
+  {
+    EMSOFT_REQUIRE_EQUAL(lhs.size(), size);
+    for (size_t i = 0; i < size; i++)
+    {
+      EMSOFT_REQUIRE_EQUAL(lhs[i], expected[i]);
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+// qu2eu, qu2ax and ho2ax give the same bits as before the copies were removed
+// -----------------------------------------------------------------------------
+void TestChangedConversionsMatchFixture()
+{
+  for (size_t n = 0; n < k_NumFixtures; n++)
+  {
+    const ConversionFixture& fixture = k_Fixtures[n];
+    Quat4<float> qu(fixture.qu[0], fixture.qu[1], fixture.qu[2], fixture.qu[3]);
+    Ho3<float> ho(fixture.ho[0], fixture.ho[1], fixture.ho[2]);
+
+    Euler3<float> eu;
+    FFixedOrientTransformsType::qu2eu(qu, eu);
+    requireIdentical(eu, fixture.qu2eu, 3);
+
+    AxAng4<float> ax;
+    FFixedOrientTransformsType::qu2ax(qu, ax);
+    requireIdentical(ax, fixture.qu2ax, 4);
+
+    FFixedOrientTransformsType::ho2ax(ho, ax);
+    requireIdentical(ax, fixture.ho2ax, 4);
+  }
+}
+
+#define COMPARE_CONVERSION(IN, OUT, FUNC)\
+  {\
+    FOrientArrayType arrayResult(OUT);\
+    FOrientTransformsType::FUNC(arrays[IN], arrayResult);\
+    FOrientFixedArrayType fixedResult(OUT);\
+    FFixedOrientTransformsType::FUNC(fixed[IN], fixedResult);\
+    requireIdentical(fixedResult, arrayResult);\
+  }
+
+// -----------------------------------------------------------------------------
+// Every conversion gives the same bits with the fixed size and the heap backed type
+// -----------------------------------------------------------------------------
+void TestFixedArrayMatchesOrientationArray()
+{
+  enum { Eu = 0, Om, Ax, Ro, Qu, Ho, Cu, NumReps };
+  const size_t sizes[NumReps] = { 3, 9, 4, 4, 4, 3, 3 };
+
+  for (size_t n = 0; n < k_NumFixtures; n++)
+  {
+    // Every representation is made from the quaternion with OrientationArray
+    std::vector<FOrientArrayType> arrays;
+    arrays.push_back(FOrientArrayType(sizes[Eu]));
+    arrays.push_back(FOrientArrayType(sizes[Om]));
+    arrays.push_back(FOrientArrayType(sizes[Ax]));
+    arrays.push_back(FOrientArrayType(sizes[Ro]));
+    arrays.push_back(FOrientArrayType(k_Fixtures[n].qu[0], k_Fixtures[n].qu[1], k_Fixtures[n].qu[2], k_Fixtures[n].qu[3]));
+    arrays.push_back(FOrientArrayType(sizes[Ho]));
+    arrays.push_back(FOrientArrayType(sizes[Cu]));
+    FOrientTransformsType::qu2eu(arrays[Qu], arrays[Eu]);
+    FOrientTransformsType::qu2om(arrays[Qu], arrays[Om]);
+    FOrientTransformsType::qu2ax(arrays[Qu], arrays[Ax]);
+    FOrientTransformsType::qu2ro(arrays[Qu], arrays[Ro]);
+    FOrientTransformsType::qu2ho(arrays[Qu], arrays[Ho]);
+    FOrientTransformsType::qu2cu(arrays[Qu], arrays[Cu]);
+
+    std::vector<FOrientFixedArrayType> fixed;
+    for (size_t i = 0; i < NumReps; i++)
+    {
+      fixed.push_back(FOrientFixedArrayType(&(arrays[i][0]), sizes[i]));
+    }
+
+    COMPARE_CONVERSION(Eu, sizes[Om], eu2om) COMPARE_CONVERSION(Eu, sizes[Ax], eu2ax) COMPARE_CONVERSION(Eu, sizes[Ro], eu2ro)
+    COMPARE_CONVERSION(Eu, sizes[Qu], eu2qu) COMPARE_CONVERSION(Eu, sizes[Ho], eu2ho) COMPARE_CONVERSION(Eu, sizes[Cu], eu2cu)
+    COMPARE_CONVERSION(Om, sizes[Eu], om2eu) COMPARE_CONVERSION(Om, sizes[Ax], om2ax) COMPARE_CONVERSION(Om, sizes[Ro], om2ro)
+    COMPARE_CONVERSION(Om, sizes[Qu], om2qu) COMPARE_CONVERSION(Om, sizes[Ho], om2ho) COMPARE_CONVERSION(Om, sizes[Cu], om2cu)
+    COMPARE_CONVERSION(Ax, sizes[Eu], ax2eu) COMPARE_CONVERSION(Ax, sizes[Om], ax2om) COMPARE_CONVERSION(Ax, sizes[Ro], ax2ro)
+    COMPARE_CONVERSION(Ax, sizes[Qu], ax2qu) COMPARE_CONVERSION(Ax, sizes[Ho], ax2ho) COMPARE_CONVERSION(Ax, sizes[Cu], ax2cu)
+    COMPARE_CONVERSION(Ro, sizes[Eu], ro2eu) COMPARE_CONVERSION(Ro, sizes[Om], ro2om) COMPARE_CONVERSION(Ro, sizes[Ax], ro2ax)
+    COMPARE_CONVERSION(Ro, sizes[Qu], ro2qu) COMPARE_CONVERSION(Ro, sizes[Ho], ro2ho) COMPARE_CONVERSION(Ro, sizes[Cu], ro2cu)
+    COMPARE_CONVERSION(Qu, sizes[Eu], qu2eu) COMPARE_CONVERSION(Qu, sizes[Om], qu2om) COMPARE_CONVERSION(Qu, sizes[Ax], qu2ax)
+    COMPARE_CONVERSION(Qu, sizes[Ro], qu2ro) COMPARE_CONVERSION(Qu, sizes[Ho], qu2ho) COMPARE_CONVERSION(Qu, sizes[Cu], qu2cu)
+    COMPARE_CONVERSION(Ho, sizes[Eu], ho2eu) COMPARE_CONVERSION(Ho, sizes[Om], ho2om) COMPARE_CONVERSION(Ho, sizes[Ax], ho2ax)
+    COMPARE_CONVERSION(Ho, sizes[Ro], ho2ro) COMPARE_CONVERSION(Ho, sizes[Qu], ho2qu) COMPARE_CONVERSION(Ho, sizes[Cu], ho2cu)
+    COMPARE_CONVERSION(Cu, sizes[Eu], cu2eu) COMPARE_CONVERSION(Cu, sizes[Om], cu2om) COMPARE_CONVERSION(Cu, sizes[Ax], cu2ax)
+    COMPARE_CONVERSION(Cu, sizes[Ro], cu2ro) COMPARE_CONVERSION(Cu, sizes[Qu], cu2qu) COMPARE_CONVERSION(Cu, sizes[Ho], cu2ho)
+  }
+}
+
+// -----------------------------------------------------------------------------
+//  Use unit test framework
+// -----------------------------------------------------------------------------
+int main(int argc, char** argv)
+{
+  int err = EXIT_SUCCESS;
+
+  EMSOFT_REGISTER_TEST( TestChangedConversionsMatchFixture() )
+  EMSOFT_REGISTER_TEST( TestFixedArrayMatchesOrientationArray() )
+  PRINT_TEST_SUMMARY();
+
+  return err;
+}
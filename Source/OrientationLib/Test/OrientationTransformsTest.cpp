@@ -0,0 +1,123 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (c) 2017 BlueQuartz Software
+//  All rights reserved.
+//  BSD License: http://www.opensource.org/licenses/bsd-license.html
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include <stdio.h>
+
+//-- C++ includes
+#include <cmath>
+#include <iostream>
+
+#include "OrientationLib/OrientationMath/OrientationArray.hpp"
+#include "OrientationLib/OrientationMath/OrientationConverter.hpp"
+#include "OrientationLib/OrientationMath/OrientationTransforms.hpp"
+
+#include "UnitTestSupport.hpp"
+
+namespace
+{
+  typedef OrientationTransforms<DOrientArrayType, double> OrientationTransformsType;
+
+  const size_t k_NumEulers = 5;
+  const double k_Eulers[k_NumEulers][3] =
+  {
+    { 0.0, 0.0, 0.0 },
+    { 0.3, 0.7, 1.1 },
+    { 2.5, 1.9, 4.2 },
+    { 5.9, 3.0, 0.4 },
+    { 1.2, 0.0, 2.0 }
+  };
+
+  const double k_Tolerance = 1.0e-12;
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  double maxDifference(const DOrientArrayType& lhs, const DOrientArrayType& rhs)
+  {
+    double diff = 0.0;
+    for (size_t i = 0; i < lhs.size(); i++)
+    {
+      diff = std::max(diff, std::fabs(lhs[i] - rhs[i]));
+    }
+    return diff;
+  }
+}
+
+// -----------------------------------------------------------------------------
+//  qu2om has to produce the same matrix as the other paths to a rotation matrix
+//  and om2qu has to invert it. With epsijk = -1 (DREAM3D_ACTIVE_ROTATION) this
+//  only holds if qu2om transposes its result, as the EMsoft Fortran code does.
+// -----------------------------------------------------------------------------
+void TestQuaternionToMatrixConvention()
+{
+  for (size_t n = 0; n < k_NumEulers; n++)
+  {
+    DOrientArrayType eu(k_Eulers[n][0], k_Eulers[n][1], k_Eulers[n][2]);
+    DOrientArrayType qu(4), ax(4), ro(4);
+    OrientationTransformsType::eu2qu(eu, qu);
+    OrientationTransformsType::qu2ax(qu, ax);
+    OrientationTransformsType::qu2ro(qu, ro);
+
+    DOrientArrayType om(9), euOm(9), axOm(9), roOm(9);
+    OrientationTransformsType::qu2om(qu, om);
+    OrientationTransformsType::eu2om(eu, euOm);
+    OrientationTransformsType::ax2om(ax, axOm);
+    OrientationTransformsType::ro2om(ro, roOm);
+    EMSOFT_REQUIRE(maxDifference(om, euOm) < k_Tolerance);
+    EMSOFT_REQUIRE(maxDifference(om, axOm) < k_Tolerance);
+    EMSOFT_REQUIRE(maxDifference(om, roOm) < k_Tolerance);
+
+    DOrientArrayType omQu(4);
+    OrientationTransformsType::om2qu(om, omQu);
+    EMSOFT_REQUIRE(maxDifference(omQu, qu) < k_Tolerance);
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void TestConverterErrorCodes()
+{
+  EulerConverter<double>::Pointer converter = EulerConverter<double>::New();
+
+  // An input with fewer components than the representation is rejected
+  DoubleArrayType::Pointer shortInput = DoubleArrayType::CreateArray(k_NumEulers, QVector<size_t>(1, 2), "Eulers");
+  shortInput->initializeWithZeros();
+  converter->setInputData(shortInput);
+  EMSOFT_REQUIRE_EQUAL(converter->convertRepresentationTo(OrientationConverter<double>::Quaternion), -1);
+  EMSOFT_REQUIRE(converter->getOutputData().get() == nullptr);
+
+  DoubleArrayType::Pointer input = DoubleArrayType::CreateArray(k_NumEulers, QVector<size_t>(1, 3), "Eulers");
+  for (size_t n = 0; n < k_NumEulers; n++)
+  {
+    input->setComponent(n, 0, k_Eulers[n][0]);
+    input->setComponent(n, 1, k_Eulers[n][1]);
+    input->setComponent(n, 2, k_Eulers[n][2]);
+  }
+  converter->setInputData(input);
+  EMSOFT_REQUIRE_EQUAL(converter->convertRepresentationTo(OrientationConverter<double>::Quaternion), 0);
+  EMSOFT_REQUIRE(converter->getOutputData().get() != nullptr);
+  EMSOFT_REQUIRE_EQUAL(converter->getOutputData()->getNumberOfComponents(), 4);
+
+  EMSOFT_REQUIRE_EQUAL(converter->convertRepresentationTo(OrientationConverter<double>::UnknownOrientationType), -2);
+  EMSOFT_REQUIRE(converter->getOutputData().get() == nullptr);
+}
+
+// -----------------------------------------------------------------------------
+//  Use unit test framework
+// -----------------------------------------------------------------------------
+int main(int argc, char** argv)
+{
+  int err = EXIT_SUCCESS;
+
+  EMSOFT_REGISTER_TEST( TestQuaternionToMatrixConvention() )
+  EMSOFT_REGISTER_TEST( TestConverterErrorCodes() )
+  PRINT_TEST_SUMMARY();
+
+  return err;
+}
@@ -0,0 +1,944 @@
+/* ============================================================================
+* Copyright (c) 2009-2017 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+
+#include "CubochoricSampler.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include <QtCore/QThreadPool>
+
+#include "SIMPLib/Math/SIMPLibMath.h"
+
+#include "H5Support/H5Lite.h"
+
+#include "OrientationLib/OrientationLibConstants.h"
+#include "OrientationLib/OrientationMath/OrientationConverter.hpp"
+#include "OrientationLib/OrientationMath/OrientationTransforms.hpp"
+
+typedef OrientationTransforms<DOrientFixedArrayType, double> FixedOrientationTransformsType;
+
+namespace
+{
+  // Number of grid points that one chunk of rows should contain
+  const size_t k_PointsPerChunk = 4096;
+
+  struct H5DatasetBlockWriter
+  {
+    hid_t datasetId;
+    int numComponents;
+  };
+}
+
+/**
+ * @brief The CubochoricSamplerRange class hands rows of a CubochoricSampler to the
+ * OrientationConversionTask workers.
+ */
+class CubochoricSamplerRange
+{
+  public:
+    CubochoricSamplerRange(CubochoricSampler* sampler, size_t firstRow) :
+      m_Sampler(sampler),
+      m_FirstRow(firstRow)
+    {}
+
+    void convert(size_t start, size_t end) const
+    {
+      m_Sampler->processRows(m_FirstRow + start, m_FirstRow + end);
+    }
+
+  private:
+    CubochoricSampler* m_Sampler;
+    size_t             m_FirstRow;
+};
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+CubochoricSampler::CubochoricSampler() :
+  m_SamplingMode(FundamentalZone),
+  m_NumberOfSamplingPoints(0),
+  m_PointGroup(1),
+  m_OffsetGrid(false),
+  m_MisorientationAngle(0.0),
+  m_ProgressCallback(nullptr),
+  m_ProgressObject(0),
+  m_Canceled(0),
+  m_Prepared(false),
+  m_PreparedMode(FundamentalZone),
+  m_PreparedNumberOfSamplingPoints(0),
+  m_PreparedPointGroup(0),
+  m_PreparedOffsetGrid(false),
+  m_FZtype(FundamentalZoneConstants::AnorthicType),
+  m_FZorder(FundamentalZoneConstants::NoAxisOrder),
+  m_Delta(0.0),
+  m_Edge(0.0),
+  m_GridShift(0.0),
+  m_NumberOfRows(0),
+  m_NumberOfSamples(0),
+  m_Pass(CountPass),
+  m_Semi(0.0),
+  m_Output(nullptr),
+  m_NumberOfComponents(0),
+  m_FirstSample(0),
+  m_EndSample(0),
+  m_FirstNewRow(0),
+  m_Completed(0),
+  m_TotalWork(0)
+{
+  m_ReferenceOrientation[0] = 0.0;
+  m_ReferenceOrientation[1] = 0.0;
+  m_ReferenceOrientation[2] = 0.0;
+  m_Sigma[0] = 0.0;
+  m_Sigma[1] = 0.0;
+  m_Sigma[2] = 0.0;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+CubochoricSampler::~CubochoricSampler()
+{
+
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void CubochoricSampler::setReferenceOrientation(double phi1, double Phi, double phi2)
+{
+  m_ReferenceOrientation[0] = phi1;
+  m_ReferenceOrientation[1] = Phi;
+  m_ReferenceOrientation[2] = phi2;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void CubochoricSampler::setProgressCallback(ProgressCallbackType callback, size_t object)
+{
+  m_ProgressCallback = callback;
+  m_ProgressObject = object;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void CubochoricSampler::cancel()
+{
+  m_Canceled.storeRelease(1);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void CubochoricSampler::reset()
+{
+  m_Canceled.storeRelease(0);
+  m_Completed.storeRelease(0);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool CubochoricSampler::wasCanceled() const
+{
+  return (m_Canceled.loadAcquire() != 0);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+size_t CubochoricSampler::countSamples()
+{
+  startProgress(false);
+  if(prepare() == false)
+  {
+    return 0;
+  }
+  return m_NumberOfSamples;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool CubochoricSampler::generate(FloatArrayType::Pointer output)
+{
+  startProgress(true);
+  return writeSamples(output);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool CubochoricSampler::writeSamples(FloatArrayType::Pointer output)
+{
+  if(prepare() == false || output.get() == nullptr)
+  {
+    return false;
+  }
+
+  int numComps = output->getNumberOfComponents();
+  if(output->getNumberOfTuples() != m_NumberOfSamples || (numComps != 3 && numComps != 4))
+  {
+    return false;
+  }
+  if(m_NumberOfSamples == 0)
+  {
+    return true;
+  }
+
+  setupWritePass(output->getPointer(0), numComps, 0, m_NumberOfSamples);
+  runRows(0, m_NumberOfRows);
+  m_Output = nullptr;
+
+  return (wasCanceled() == false);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool CubochoricSampler::generateBlocks(int numComponents, size_t samplesPerBlock, BlockCallbackType callback, size_t object)
+{
+  startProgress(true);
+  return writeBlocks(numComponents, samplesPerBlock, callback, object);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool CubochoricSampler::writeBlocks(int numComponents, size_t samplesPerBlock, BlockCallbackType callback, size_t object)
+{
+  if(prepare() == false || nullptr == callback || samplesPerBlock == 0 || (numComponents != 3 && numComponents != 4))
+  {
+    return false;
+  }
+
+  // Only one block is ever held in memory; the rows that straddle a block boundary are
+  // processed for both blocks, but only the samples inside the current block are stored.
+  // Such a row only counts once for the progress, and the empty rows that no block
+  // touches are counted when they are skipped.
+  std::vector<float> block(std::min(samplesPerBlock, m_NumberOfSamples) * numComponents);
+  std::vector<size_t>::const_iterator offsetsBegin = m_RowOffsets.begin();
+  std::vector<size_t>::const_iterator offsetsEnd = offsetsBegin + m_NumberOfRows + 1;
+  size_t reportedRows = 0;
+  for(size_t firstSample = 0; firstSample < m_NumberOfSamples; firstSample += samplesPerBlock)
+  {
+    size_t endSample = std::min(firstSample + samplesPerBlock, m_NumberOfSamples);
+    size_t firstRow = (std::upper_bound(offsetsBegin, offsetsEnd, firstSample) - offsetsBegin) - 1;
+    size_t endRow = std::lower_bound(offsetsBegin, offsetsEnd, endSample) - offsetsBegin;
+    if(firstRow > reportedRows)
+    {
+      reportProgress(firstRow - reportedRows);
+      reportedRows = firstRow;
+    }
+
+    setupWritePass(block.data(), numComponents, firstSample, endSample);
+    m_FirstNewRow = reportedRows;
+    runRows(firstRow, endRow);
+    m_Output = nullptr;
+    reportedRows = std::max(reportedRows, endRow);
+    if(wasCanceled())
+    {
+      return false;
+    }
+    if(callback(object, block.data(), firstSample, endSample - firstSample) == false)
+    {
+      return false;
+    }
+  }
+  if(reportedRows < m_NumberOfRows)
+  {
+    reportProgress(m_NumberOfRows - reportedRows);
+  }
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool CubochoricSampler::writeH5Dataset(hid_t parentId, const QString& name, int numComponents, size_t samplesPerBlock)
+{
+  startProgress(true);
+  if((numComponents != 3 && numComponents != 4) || prepare() == false)
+  {
+    return false;
+  }
+  size_t numSamples = m_NumberOfSamples;
+
+  // Create the whole dataset up front, chunked along the samples, and fill it one block at a time.
+  // A dataset without samples can not be chunked, so it is created contiguous and left empty.
+  hsize_t dims[2] = { static_cast<hsize_t>(numSamples), static_cast<hsize_t>(numComponents) };
+  H5Lite::DatasetCreationOptions options;
+  if(numSamples > 0)
+  {
+    options.chunkDims = H5Lite::defaultChunkDimensions(2, dims, sizeof(float));
+  }
+  hid_t dcpl = H5Lite::createDatasetCreationPropertyList(options, 2, dims, sizeof(float));
+  hid_t sid = H5Screate_simple(2, dims, NULL);
+  hid_t did = -1;
+  if(dcpl >= 0 && sid >= 0)
+  {
+    did = H5Dcreate(parentId, name.toStdString().c_str(), H5T_NATIVE_FLOAT, sid, H5P_DEFAULT, dcpl, H5P_DEFAULT);
+  }
+  if(sid >= 0) { H5Sclose(sid); }
+  if(dcpl >= 0 && dcpl != H5P_DEFAULT) { H5Pclose(dcpl); }
+  if(did < 0)
+  {
+    return false;
+  }
+
+  bool success = true;
+  if(numSamples > 0)
+  {
+    H5DatasetBlockWriter writer = { did, numComponents };
+    success = writeBlocks(numComponents, samplesPerBlock, &CubochoricSampler::WriteH5Block, reinterpret_cast<size_t>(&writer));
+  }
+  H5Dclose(did);
+  return success;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool CubochoricSampler::WriteH5Block(size_t object, const float* data, size_t firstSample, size_t numSamples)
+{
+  H5DatasetBlockWriter* writer = reinterpret_cast<H5DatasetBlockWriter*>(object);
+  hsize_t offset[2] = { static_cast<hsize_t>(firstSample), 0 };
+  hsize_t count[2] = { static_cast<hsize_t>(numSamples), static_cast<hsize_t>(writer->numComponents) };
+
+  hid_t fileSpaceId = H5Dget_space(writer->datasetId);
+  herr_t err = H5Sselect_hyperslab(fileSpaceId, H5S_SELECT_SET, offset, NULL, count, NULL);
+  hid_t memSpaceId = H5Screate_simple(2, count, NULL);
+  if(err >= 0 && memSpaceId >= 0)
+  {
+    err = H5Dwrite(writer->datasetId, H5T_NATIVE_FLOAT, memSpaceId, fileSpaceId, H5P_DEFAULT, data);
+  }
+  if(memSpaceId >= 0) { H5Sclose(memSpaceId); }
+  H5Sclose(fileSpaceId);
+  return (err >= 0 && memSpaceId >= 0);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void CubochoricSampler::setupWritePass(float* output, int numComponents, size_t firstSample, size_t endSample)
+{
+  m_Output = output;
+  m_NumberOfComponents = numComponents;
+  m_FirstSample = firstSample;
+  m_EndSample = endSample;
+  m_FirstNewRow = 0;
+  m_Pass = WritePass;
+  if(m_SamplingMode != FundamentalZone)
+  {
+    // step size for sampling of grid; the edge length of the cube is (pi ( w - sin(w) ))^1/3 with w the misorientation angle
+    double omega = m_MisorientationAngle;
+    m_Semi = pow(SIMPLib::Constants::k_Pi * (omega - sin(omega)), 1.0 / 3.0) * 0.5;
+    m_Delta = m_Semi / static_cast<double>(m_NumberOfSamplingPoints);
+
+    // convert the reference orientation to a 3-component Rodrigues vector sigma
+    DOrientFixedArrayType referenceOrientation(m_ReferenceOrientation[0], m_ReferenceOrientation[1], m_ReferenceOrientation[2]);
+    DOrientFixedArrayType sigm(4);
+    FixedOrientationTransformsType::eu2ro(referenceOrientation, sigm);
+    m_Sigma[0] = sigm[0] * sigm[3];
+    m_Sigma[1] = sigm[1] * sigm[3];
+    m_Sigma[2] = sigm[2] * sigm[3];
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+FloatArrayType::Pointer CubochoricSampler::generate(int numComponents, const QString& name)
+{
+  // The count and the write phase report against one total
+  startProgress(true);
+  if((numComponents != 3 && numComponents != 4) || prepare() == false)
+  {
+    return FloatArrayType::NullPointer();
+  }
+
+  FloatArrayType::Pointer output = FloatArrayType::CreateArray(m_NumberOfSamples, QVector<size_t>(1, numComponents), name);
+  if(writeSamples(output) == false)
+  {
+    return FloatArrayType::NullPointer();
+  }
+  return output;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+size_t CubochoricSampler::numberOfRows() const
+{
+  size_t a = static_cast<size_t>(2 * m_NumberOfSamplingPoints + 1);
+  size_t b = static_cast<size_t>(2 * m_NumberOfSamplingPoints - 1);
+  if(m_SamplingMode == MisorientationSurface)
+  {
+    // the x-y planes, the y-z planes and the x-z planes; see the misorientation sampling paper
+    return a + a + b;
+  }
+  if(m_SamplingMode == MisorientationVolume)
+  {
+    return a * a;
+  }
+  // one row for every (x, y) pair of the grid
+  return (a - 1) * (a - 1);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool CubochoricSampler::isPrepared() const
+{
+  // The counts only depend on these settings, so an earlier count can be reused
+  return (m_Prepared && m_PreparedMode == m_SamplingMode && m_PreparedNumberOfSamplingPoints == m_NumberOfSamplingPoints &&
+          (m_SamplingMode != FundamentalZone || (m_PreparedPointGroup == m_PointGroup && m_PreparedOffsetGrid == m_OffsetGrid)));
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void CubochoricSampler::startProgress(bool writeSamples)
+{
+  // Only the FundamentalZone mode has a count pass; the misorientation modes are counted analytically
+  size_t rows = (m_NumberOfSamplingPoints < 1) ? 0 : numberOfRows();
+  size_t countRows = (m_SamplingMode == FundamentalZone && isPrepared() == false) ? rows : 0;
+  m_Completed.storeRelease(0);
+  m_TotalWork = countRows + (writeSamples ? rows : 0);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool CubochoricSampler::prepare()
+{
+  int Np = m_NumberOfSamplingPoints;
+  if(Np < 1 || (m_SamplingMode == FundamentalZone && (m_PointGroup < 1 || m_PointGroup > 32)))
+  {
+    m_Prepared = false;
+    return false;
+  }
+  if(wasCanceled())
+  {
+    return false;
+  }
+  if(isPrepared())
+  {
+    return true;
+  }
+  m_Prepared = false;
+
+  size_t a = static_cast<size_t>(2 * Np + 1);
+  size_t b = static_cast<size_t>(2 * Np - 1);
+  m_NumberOfRows = numberOfRows();
+  if(m_SamplingMode == MisorientationSurface)
+  {
+    m_RowOffsets.assign(m_NumberOfRows + 1, 2 * b);
+    std::fill(m_RowOffsets.begin(), m_RowOffsets.begin() + a, 2 * a);
+  }
+  else if(m_SamplingMode == MisorientationVolume)
+  {
+    m_RowOffsets.assign(m_NumberOfRows + 1, a);
+  }
+  else
+  {
+    // step size for sampling of grid; maximum total number of samples = pow(2*Np+1,3)
+    m_Delta = (0.50 * LPs::ap) / static_cast<double>(Np);
+    // eliminate points for which any of the coordinates lies outside the cube with semi-edge length "edge"
+    m_Edge = 0.5 * LPs::ap;
+    // do we need to shift this array away from the origin?
+    m_GridShift = m_OffsetGrid ? 0.5 : 0.0;
+    m_FZtype = FundamentalZoneConstants::FZtarray[m_PointGroup - 1];
+    m_FZorder = FundamentalZoneConstants::FZoarray[m_PointGroup - 1];
+
+    // the count pass is followed by a write pass
+    m_RowOffsets.assign(m_NumberOfRows + 1, 0);
+
+    m_Pass = CountPass;
+    m_FirstNewRow = 0;
+    runRows(0, m_NumberOfRows);
+    if(wasCanceled())
+    {
+      return false;
+    }
+  }
+
+  // turn the row counts into the offset of the first sample of every row
+  size_t offset = 0;
+  for(size_t row = 0; row <= m_NumberOfRows; row++)
+  {
+    size_t count = m_RowOffsets[row];
+    m_RowOffsets[row] = offset;
+    offset += count;
+  }
+  m_NumberOfSamples = m_RowOffsets[m_NumberOfRows];
+
+  m_Prepared = true;
+  m_PreparedMode = m_SamplingMode;
+  m_PreparedNumberOfSamplingPoints = Np;
+  m_PreparedPointGroup = m_PointGroup;
+  m_PreparedOffsetGrid = m_OffsetGrid;
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void CubochoricSampler::runRows(size_t firstRow, size_t endRow)
+{
+  typedef OrientationConversionTask<CubochoricSamplerRange> TaskType;
+
+  CubochoricSamplerRange range(this, firstRow);
+  size_t numRows = endRow - firstRow;
+  size_t rowsPerChunk = std::max<size_t>(1, k_PointsPerChunk / (2 * m_NumberOfSamplingPoints + 1));
+
+  TaskType::SharedState state;
+  state.range = &range;
+  state.numTuples = numRows;
+  state.chunkSize = rowsPerChunk;
+  state.numChunks = static_cast<int>((numRows + rowsPerChunk - 1) / rowsPerChunk);
+
+  // Only count the tasks that actually started, so that a busy pool can not deadlock us
+  QThreadPool* pool = QThreadPool::globalInstance();
+  int numHelpers = std::min(pool->maxThreadCount(), state.numChunks) - 1;
+  int started = 0;
+  for(int i = 0; i < numHelpers; i++)
+  {
+    TaskType* task = new TaskType(&state);
+    task->setAutoDelete(true);
+    if(pool->tryStart(task) == false)
+    {
+      delete task;
+      break;
+    }
+    started++;
+  }
+
+  TaskType::Convert(&state);
+  state.finished.acquire(started);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void CubochoricSampler::processRows(size_t start, size_t end)
+{
+  for(size_t row = start; row < end; row++)
+  {
+    if(wasCanceled())
+    {
+      return;
+    }
+    if(m_Pass == CountPass)
+    {
+      countRow(row);
+    }
+    else if(m_SamplingMode == FundamentalZone)
+    {
+      writeFundamentalZoneRow(row);
+    }
+    else
+    {
+      writeMisorientationRow(row);
+    }
+  }
+  // rows below m_FirstNewRow were already reported by the previous block
+  size_t first = std::max(start, m_FirstNewRow);
+  if(end > first)
+  {
+    reportProgress(end - first);
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void CubochoricSampler::reportProgress(size_t amount)
+{
+  int completed = m_Completed.fetchAndAddOrdered(static_cast<int>(amount)) + static_cast<int>(amount);
+  if(nullptr != m_ProgressCallback)
+  {
+    m_ProgressCallback(m_ProgressObject, std::min(static_cast<size_t>(completed), m_TotalWork), m_TotalWork);
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void CubochoricSampler::countRow(size_t row)
+{
+  // loop over the cube of volume pi^2; note that we do not want to include
+  // the opposite edges/facets of the cube, to avoid double counting rotations
+  // with a rotation angle of 180 degrees.  This only affects the cyclic groups.
+  int Np = m_NumberOfSamplingPoints;
+  size_t n = static_cast<size_t>(2 * Np);
+  int i = static_cast<int>(row / n) - Np + 1;
+  int j = static_cast<int>(row % n) - Np + 1;
+  double x = (static_cast<double>(i) + m_GridShift) * m_Delta;
+  double y = (static_cast<double>(j) + m_GridShift) * m_Delta;
+
+  size_t count = 0;
+  if(fabs(x) <= m_Edge && fabs(y) <= m_Edge)
+  {
+    for(int k = -Np + 1; k < Np + 1; k++)
+    {
+      double z = (static_cast<double>(k) + m_GridShift) * m_Delta;
+      if(fabs(z) <= m_Edge)
+      {
+        DOrientFixedArrayType cu(x, y, z);
+        DOrientFixedArrayType rod(4);
+        FixedOrientationTransformsType::cu2ro(cu, rod);
+        if(IsInsideFZ(rod.data(), m_FZtype, m_FZorder))
+        {
+          count++;
+        }
+      }
+    }
+  }
+  m_RowOffsets[row] = count;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void CubochoricSampler::writeFundamentalZoneRow(size_t row)
+{
+  size_t index = m_RowOffsets[row];
+  if(m_RowOffsets[row + 1] == index || index >= m_EndSample || m_RowOffsets[row + 1] <= m_FirstSample)
+  {
+    return;
+  }
+
+  int Np = m_NumberOfSamplingPoints;
+  size_t n = static_cast<size_t>(2 * Np);
+  int i = static_cast<int>(row / n) - Np + 1;
+  int j = static_cast<int>(row % n) - Np + 1;
+  double x = (static_cast<double>(i) + m_GridShift) * m_Delta;
+  double y = (static_cast<double>(j) + m_GridShift) * m_Delta;
+
+  for(int k = -Np + 1; k < Np + 1; k++)
+  {
+    double z = (static_cast<double>(k) + m_GridShift) * m_Delta;
+    if(fabs(z) <= m_Edge)
+    {
+      DOrientFixedArrayType cu(x, y, z);
+      DOrientFixedArrayType rod(4);
+      FixedOrientationTransformsType::cu2ro(cu, rod);
+      if(IsInsideFZ(rod.data(), m_FZtype, m_FZorder))
+      {
+        writeSample(rod, index);
+        index++;
+      }
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void CubochoricSampler::writeMisorientationRow(size_t row)
+{
+  int Np = m_NumberOfSamplingPoints;
+  size_t a = static_cast<size_t>(2 * Np + 1);
+  double delta = m_Delta;
+  double semi = m_Semi;
+
+  if(m_SamplingMode == MisorientationVolume)
+  {
+    double x = static_cast<double>(static_cast<int>(row / a) - Np) * delta;
+    double y = static_cast<double>(static_cast<int>(row % a) - Np) * delta;
+    size_t index = m_RowOffsets[row];
+    for(int k = -Np; k <= Np; k++)
+    {
+      double z = static_cast<double>(k) * delta;
+      writeMisorientationSample(-x, -y, -z, index++);
+    }
+    return;
+  }
+
+  // the surface of the sub-cube: first the x-y bottom and top planes, then
+  // the y-z planes and finally the x-z planes, each as a pair of opposite faces
+  if(row < a)
+  {
+    double x = static_cast<double>(static_cast<int>(row) - Np) * delta;
+    size_t index = m_RowOffsets[row];
+    for(int j = -Np; j <= Np; j++)
+    {
+      double y = static_cast<double>(j) * delta;
+      writeMisorientationSample(-x, -y, -semi, index++);
+      writeMisorientationSample(-x, -y, semi, index++);
+    }
+  }
+  else if(row < 2 * a)
+  {
+    double y = static_cast<double>(static_cast<int>(row - a) - Np) * delta;
+    size_t index = m_RowOffsets[row];
+    for(int k = -Np + 1; k <= Np - 1; k++)
+    {
+      double z = static_cast<double>(k) * delta;
+      writeMisorientationSample(-semi, -y, -z, index++);
+      writeMisorientationSample(semi, -y, -z, index++);
+    }
+  }
+  else
+  {
+    double x = static_cast<double>(static_cast<int>(row - 2 * a) - Np + 1) * delta;
+    size_t index = m_RowOffsets[row];
+    for(int k = -Np + 1; k <= Np - 1; k++)
+    {
+      double z = static_cast<double>(k) * delta;
+      writeMisorientationSample(-x, -semi, -z, index++);
+      writeMisorientationSample(-x, semi, -z, index++);
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void CubochoricSampler::writeMisorientationSample(double x, double y, double z, size_t index)
+{
+  if(index < m_FirstSample || index >= m_EndSample)
+  {
+    return;
+  }
+
+  // convert to Rodrigues representation and apply Rodrigues composition formula
+  DOrientFixedArrayType cu(x, y, z);
+  DOrientFixedArrayType rod(4);
+  FixedOrientationTransformsType::cu2ro(cu, rod);
+  RodriguesComposition(m_Sigma, rod.data());
+  writeSample(rod, index);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void CubochoricSampler::writeSample(const DOrientFixedArrayType& rod, size_t index)
+{
+  if(index < m_FirstSample || index >= m_EndSample)
+  {
+    return;
+  }
+
+  float* out = m_Output + (index - m_FirstSample) * m_NumberOfComponents;
+  if(m_NumberOfComponents == 3)
+  {
+    DOrientFixedArrayType eu(3, 0.0);
+    FixedOrientationTransformsType::ro2eu(rod, eu);
+    out[0] = static_cast<float>(eu[0]);
+    out[1] = static_cast<float>(eu[1]);
+    out[2] = static_cast<float>(eu[2]);
+  }
+  else
+  {
+    DOrientFixedArrayType qu(4, 0.0);
+    FixedOrientationTransformsType::ro2qu(rod, qu);
+    out[0] = static_cast<float>(qu[0]);
+    out[1] = static_cast<float>(qu[1]);
+    out[2] = static_cast<float>(qu[2]);
+    out[3] = static_cast<float>(qu[3]);
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void CubochoricSampler::RodriguesComposition(const double* sigma, double* rod)
+{
+  double rho[3] = { -rod[0] * rod[3], -rod[1] * rod[3], -rod[2] * rod[3] };
+
+  // perform the Rodrigues rotation composition with sigma to get rhomis
+  double denom = 1.0f + (sigma[0] * rho[0] + sigma[1] * rho[1] + sigma[2] * rho[2]);
+  if(denom == 0.0f)
+  {
+    double len = sqrt(sigma[0] * sigma[0] + sigma[1] * sigma[1] + sigma[2] * sigma[2]);
+    rod[0] = sigma[0] / len;
+    rod[1] = sigma[1] / len;
+    rod[2] = sigma[2] / len;
+    rod[3] = std::numeric_limits<double>::infinity(); // set this to infinity
+  }
+  else
+  {
+    double rhomis[3];
+    rhomis[0] = (rho[0] - sigma[0] + (rho[1] * sigma[2] - rho[2] * sigma[1])) / denom;
+    rhomis[1] = (rho[1] - sigma[1] + (rho[2] * sigma[0] - rho[0] * sigma[2])) / denom;
+    rhomis[2] = (rho[2] - sigma[2] + (rho[0] * sigma[1] - rho[1] * sigma[0])) / denom;
+    // revert rhomis to a four-component Rodrigues vector
+    double len = sqrt(rhomis[0] * rhomis[0] + rhomis[1] * rhomis[1] + rhomis[2] * rhomis[2]);
+    if(len != 0.0f)
+    {
+      rod[0] = -rhomis[0] / len;
+      rod[1] = -rhomis[1] / len;
+      rod[2] = -rhomis[2] / len;
+      rod[3] = len;
+    }
+    else
+    {
+      rod[0] = 0.0;
+      rod[1] = 0.0;
+      rod[2] = 0.0;
+      rod[3] = 0.0;
+    }
+  }
+}
+
+namespace
+{
+  // ---------------------------------------------------------------------------
+  //
+  // ---------------------------------------------------------------------------
+  bool insideCyclicFZ(const double* rod, int order)
+  {
+    bool insideFZ = false;
+
+    if (rod[3] != std::numeric_limits<double>::infinity())
+    {
+      // check the z-component vs. tan(pi/2n)
+      insideFZ = fabs(rod[2] * rod[3]) <= LPs::BP[order - 1];
+    }
+    else if (rod[2] == 0.0)
+    {
+      insideFZ = true;
+    }
+    return insideFZ;
+  }
+
+  // ---------------------------------------------------------------------------
+  //
+  // ---------------------------------------------------------------------------
+  bool insideDihedralFZ(const double* rod, int order)
+  {
+    bool c1 = false, c2 = false;
+    double r[3] = { rod[0] * rod[3], rod[1] * rod[3], rod[2] * rod[3] };
+    const double r1 = 1.0;
+
+    // first, check the z-component vs. tan(pi/2n)  (same as insideCyclicFZ)
+    c1 = fabs(r[2]) <= LPs::BP[order - 1];
+
+    // check the square boundary planes if c1=true
+    if (c1)
+    {
+      switch (order)
+      {
+        case FundamentalZoneConstants::TwoFoldAxisOrder:
+          c2 = (fabs(r[0]) <= r1) && (fabs(r[1]) <= r1);
+          break;
+        case FundamentalZoneConstants::ThreeFoldAxisOrder:
+          c2 = fabs( LPs::srt * r[0] + 0.50 * r[1]) <= r1;
+          c2 = c2 && ( fabs( LPs::srt * r[0] - 0.50 * r[1]) <= r1 );
+          c2 = c2 && ( fabs(r[1]) <= r1 );
+          break;
+        case FundamentalZoneConstants::FourFoldAxisOrder:
+          c2 = (fabs(r[0]) <= r1) && (fabs(r[1]) <= r1);
+          c2 = c2 && ((LPs::r22 * fabs(r[0] + r[1]) <= r1) && (LPs::r22 * fabs(r[0] - r[1]) <= r1));
+          break;
+        case FundamentalZoneConstants::SixFoldAxisOrder:
+          c2 =          fabs( 0.50 * r[0] + LPs::srt * r[1]) <= r1;
+          c2 = c2 && ( fabs( LPs::srt * r[0] + 0.50 * r[1]) <= r1 );
+          c2 = c2 && ( fabs( LPs::srt * r[0] - 0.50 * r[1]) <= r1 );
+          c2 = c2 && ( fabs( 0.50 * r[0] - LPs::srt * r[1]) <= r1 );
+          c2 = c2 && ( fabs(r[1]) <= r1 );
+          c2 = c2 && ( fabs(r[0]) <= r1 );
+          break;
+        default:
+          break;
+      }
+    }
+    return c2;
+  }
+
+  // ---------------------------------------------------------------------------
+  //
+  // ---------------------------------------------------------------------------
+  bool insideCubicFZ(const double* rod, int ot)
+  {
+    bool c1 = false, c2 = false;
+    double r[3] = { rod[0] * rod[3], rod[1] * rod[3], rod[2] * rod[3] };
+    const double r1 = 1.0;
+
+    // primary cube planes (only needed for octahedral case)
+    if (ot == FundamentalZoneConstants::OctahedralType)
+    {
+      c1 = std::max(std::max(fabs(r[0]), fabs(r[1])), fabs(r[2])) <= LPs::BP[3];
+    }
+    else
+    {
+      c1 = true;
+    }
+
+    // octahedral truncation planes, both for tetrahedral and octahedral point groups
+    c2 = ((fabs(r[0]) + fabs(r[1]) + fabs(r[2])) <= r1);
+
+    // if both c1 and c2, then the point is inside
+    return (c1 && c2);
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool CubochoricSampler::IsInsideFZ(const double* rod, int FZtype, int FZorder)
+{
+  bool insideFZ = false;
+  // dealing with 180 rotations is needed only for
+  // FZtypes 0 and 1; the other FZs are always finite.
+  switch(FZtype)
+  {
+    case FundamentalZoneConstants::AnorthicType:
+      insideFZ = true;   // all points are inside the FZ
+      break;
+    case FundamentalZoneConstants::CyclicType:
+      insideFZ = insideCyclicFZ(rod, FZorder);      // infinity is checked inside this function
+      break;
+    case FundamentalZoneConstants::DihedralType:
+      if (rod[3] != std::numeric_limits<double>::infinity()) { insideFZ = insideDihedralFZ(rod, FZorder); }
+      break;
+    case FundamentalZoneConstants::TetrahedralType:
+      if (rod[3] != std::numeric_limits<double>::infinity()) { insideFZ = insideCubicFZ(rod, FundamentalZoneConstants::TetrahedralType); }
+      break;
+    case FundamentalZoneConstants::OctahedralType:
+      if (rod[3] != std::numeric_limits<double>::infinity()) { insideFZ = insideCubicFZ(rod, FundamentalZoneConstants::OctahedralType); }
+      break;
+    default:
+      insideFZ = false;
+      break;
+  }
+  return insideFZ;
+}
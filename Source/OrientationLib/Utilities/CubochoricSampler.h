@@ -0,0 +1,315 @@
+/* ============================================================================
+* Copyright (c) 2009-2017 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+
+#ifndef _cubochoricsampler_h_
+#define _cubochoricsampler_h_
+
+#include <vector>
+
+#include <hdf5.h>
+
+#include <QtCore/QAtomicInt>
+#include <QtCore/QString>
+
+#include "SIMPLib/Common/SIMPLibSetGetMacros.h"
+#include "SIMPLib/DataArrays/DataArray.hpp"
+
+#include "OrientationLib/OrientationLib.h"
+#include "OrientationLib/OrientationMath/OrientationFixedArray.hpp"
+
+/**
+ * @class CubochoricSampler CubochoricSampler.h OrientationLib/Utilities/CubochoricSampler.h
+ * @brief This class samples orientation space on a uniform cubochoric grid. It either keeps the grid
+ * points that lie inside the Rodrigues fundamental zone of a point group, or it samples a constant
+ * misorientation around a reference orientation (the surface or the whole volume of a sub-cube).
+ * The grid is split into rows that are processed on the global QThreadPool. The rows are counted
+ * first (analytically for the misorientation modes) so that every row knows where its samples go, and
+ * then the samples are written straight into a preallocated output array in the same order as a serial
+ * walk of the grid. No memory is allocated per grid point. For very fine samplings the output can also
+ * be streamed in fixed-size blocks to a callback or into an HDF5 dataset, so that only one block is
+ * ever held in memory.
+ */
+class OrientationLib_EXPORT CubochoricSampler
+{
+  public:
+    SIMPL_SHARED_POINTERS(CubochoricSampler)
+    SIMPL_STATIC_NEW_MACRO(CubochoricSampler)
+    SIMPL_TYPE_MACRO(CubochoricSampler)
+
+    virtual ~CubochoricSampler();
+
+    /**
+     * @brief The SamplingMode enum selects which part of the cubochoric grid is kept
+     */
+    enum SamplingMode
+    {
+      FundamentalZone = 0,      //!< Grid points inside the Rodrigues fundamental zone of the point group
+      MisorientationSurface,    //!< Constant misorientation; the surface of the sub-cube around the reference orientation
+      MisorientationVolume      //!< All grid points of the sub-cube around the reference orientation
+    };
+
+    /**
+     * @brief Progress callback; object is the value passed to setProgressCallback. It is called
+     * from the worker threads, so the receiver has to be thread safe.
+     */
+    typedef void (*ProgressCallbackType)(size_t object, size_t completed, size_t total);
+
+    /**
+     * @brief Block callback for generateBlocks; data holds numSamples samples starting at sample
+     * firstSample. It is called from the thread that called generateBlocks. Returning false stops
+     * the generation.
+     */
+    typedef bool (*BlockCallbackType)(size_t object, const float* data, size_t firstSample, size_t numSamples);
+
+    SIMPL_INSTANCE_PROPERTY(SamplingMode, SamplingMode)
+
+    /**
+     * @brief The number of grid points along the semi-edge of the cube
+     */
+    SIMPL_INSTANCE_PROPERTY(int, NumberOfSamplingPoints)
+
+    /**
+     * @brief The point group number (1-32) for the FundamentalZone mode
+     */
+    SIMPL_INSTANCE_PROPERTY(int, PointGroup)
+
+    /**
+     * @brief Shift the FundamentalZone grid by half a step away from the origin
+     */
+    SIMPL_INSTANCE_PROPERTY(bool, OffsetGrid)
+
+    /**
+     * @brief The misorientation angle in radians for the misorientation modes
+     */
+    SIMPL_INSTANCE_PROPERTY(double, MisorientationAngle)
+
+    /**
+     * @brief setReferenceOrientation Sets the reference orientation for the misorientation modes
+     * @param phi1 Euler angle in radians
+     * @param Phi Euler angle in radians
+     * @param phi2 Euler angle in radians
+     */
+    void setReferenceOrientation(double phi1, double Phi, double phi2);
+
+    /**
+     * @brief setProgressCallback Sets a callback that is called after every finished block of rows
+     * @param callback The callback or nullptr
+     * @param object Identifier that is handed back to the callback
+     */
+    void setProgressCallback(ProgressCallbackType callback, size_t object);
+
+    /**
+     * @brief cancel Stops a running countSamples or generate call as soon as possible. This may be
+     * called from any thread. The flag stays set until reset() is called, so every later call also
+     * returns right away and a cancel that arrives between the count and the write phase is not lost.
+     */
+    void cancel();
+
+    /**
+     * @brief reset Clears the cancel flag and the progress counter. The owner calls this before it
+     * reuses a sampler that was canceled.
+     */
+    void reset();
+
+    /**
+     * @brief wasCanceled Returns true if cancel() was called since the sampler was created or reset
+     */
+    bool wasCanceled() const;
+
+    /**
+     * @brief countSamples Returns the number of samples for the current settings. For the
+     * FundamentalZone mode this tests every grid point; the result is kept for the next generate call.
+     * @return The number of samples or 0 for invalid settings or when canceled
+     */
+    size_t countSamples();
+
+    /**
+     * @brief generate Writes the samples into an existing array. The array must have countSamples()
+     * tuples and either 3 components (Bunge Euler angles in radians) or 4 components (quaternions in
+     * x, y, z, w order).
+     * @param output The output array
+     * @return false if the settings or the array are invalid or the call was canceled
+     */
+    bool generate(FloatArrayType::Pointer output);
+
+    /**
+     * @brief generate Creates a new array of Euler angles or quaternions and fills it with the samples
+     * @param numComponents 3 for Euler angles or 4 for quaternions
+     * @param name The name of the new array
+     * @return The new array or a NullPointer if the settings are invalid or the call was canceled
+     */
+    FloatArrayType::Pointer generate(int numComponents, const QString& name);
+
+    /**
+     * @brief generateBlocks Streams the samples in blocks of samplesPerBlock samples (the last block
+     * may be smaller) to a callback, in order. Only one block is held in memory.
+     * @param numComponents 3 for Euler angles or 4 for quaternions
+     * @param samplesPerBlock The number of samples in each block
+     * @param callback The callback that receives the blocks
+     * @param object Identifier that is handed back to the callback
+     * @return false if the settings are invalid, the call was canceled or the callback returned false
+     */
+    bool generateBlocks(int numComponents, size_t samplesPerBlock, BlockCallbackType callback, size_t object);
+
+    /**
+     * @brief writeH5Dataset Creates a chunked numSamples x numComponents float dataset and streams
+     * the samples into it block by block
+     * @param parentId The HDF5 group or file to create the dataset in
+     * @param name The name of the new dataset
+     * @param numComponents 3 for Euler angles or 4 for quaternions
+     * @param samplesPerBlock The number of samples that are generated and written at a time
+     * @return false if the dataset could not be created or written, or the call was canceled
+     */
+    bool writeH5Dataset(hid_t parentId, const QString& name, int numComponents, size_t samplesPerBlock);
+
+    /**
+     * @brief IsInsideFZ Tests if a 4 component Rodrigues vector (unit axis and length) lies inside a
+     * fundamental zone (see FundamentalZoneConstants)
+     */
+    static bool IsInsideFZ(const double* rod, int FZtype, int FZorder);
+
+    /**
+     * @brief RodriguesComposition Composes a 4 component Rodrigues vector with the 3 component
+     * Rodrigues vector sigma; the result replaces rod
+     */
+    static void RodriguesComposition(const double* sigma, double* rod);
+
+  protected:
+    CubochoricSampler();
+
+    /**
+     * @brief numberOfRows Returns the number of grid rows for the current settings
+     */
+    size_t numberOfRows() const;
+
+    /**
+     * @brief isPrepared Returns true if the row offsets of the current settings are already known
+     */
+    bool isPrepared() const;
+
+    /**
+     * @brief startProgress Resets the progress counter and sets the total to the rows that are left to
+     * count plus, if writeSamples is true, the rows of the write pass
+     */
+    void startProgress(bool writeSamples);
+
+    /**
+     * @brief prepare Computes the grid parameters and, for the FundamentalZone mode, the row offsets
+     * @return false if the settings are invalid or the call was canceled
+     */
+    bool prepare();
+
+    /**
+     * @brief writeSamples Prepares the settings and writes all samples into output
+     */
+    bool writeSamples(FloatArrayType::Pointer output);
+
+    /**
+     * @brief writeBlocks Prepares the settings and streams the samples block by block to callback
+     */
+    bool writeBlocks(int numComponents, size_t samplesPerBlock, BlockCallbackType callback, size_t object);
+
+    /**
+     * @brief setupWritePass Sets up a write pass that stores the samples [firstSample, endSample) in output
+     */
+    void setupWritePass(float* output, int numComponents, size_t firstSample, size_t endSample);
+
+    /**
+     * @brief runRows Processes the rows [firstRow, endRow) of the current pass on the global thread pool
+     */
+    void runRows(size_t firstRow, size_t endRow);
+
+    /**
+     * @brief reportProgress Adds finished work to the progress counter and calls the callback
+     */
+    void reportProgress(size_t amount);
+
+  private:
+    friend class CubochoricSamplerRange;
+
+    enum Pass
+    {
+      CountPass,
+      WritePass
+    };
+
+    double                  m_ReferenceOrientation[3];
+
+    ProgressCallbackType    m_ProgressCallback;
+    size_t                  m_ProgressObject;
+    QAtomicInt              m_Canceled;
+
+    // Grid parameters of the prepared settings
+    bool                    m_Prepared;
+    SamplingMode            m_PreparedMode;
+    int                     m_PreparedNumberOfSamplingPoints;
+    int                     m_PreparedPointGroup;
+    bool                    m_PreparedOffsetGrid;
+    int                     m_FZtype;
+    int                     m_FZorder;
+    double                  m_Delta;
+    double                  m_Edge;
+    double                  m_GridShift;
+    size_t                  m_NumberOfRows;
+    size_t                  m_NumberOfSamples;
+    std::vector<size_t>     m_RowOffsets;
+
+    // State of the running pass
+    Pass                    m_Pass;
+    double                  m_Semi;
+    double                  m_Sigma[3];
+    float*                  m_Output;
+    int                     m_NumberOfComponents;
+    size_t                  m_FirstSample;
+    size_t                  m_EndSample;
+    size_t                  m_FirstNewRow;
+    QAtomicInt              m_Completed;
+    size_t                  m_TotalWork;
+
+    void processRows(size_t start, size_t end);
+    void countRow(size_t row);
+    void writeFundamentalZoneRow(size_t row);
+    void writeMisorientationRow(size_t row);
+    void writeMisorientationSample(double x, double y, double z, size_t index);
+    void writeSample(const DOrientFixedArrayType& rod, size_t index);
+
+    static bool WriteH5Block(size_t object, const float* data, size_t firstSample, size_t numSamples);
+
+    CubochoricSampler(const CubochoricSampler&); // Copy Constructor Not Implemented
+    void operator=(const CubochoricSampler&); // Operator '=' Not Implemented
+};
+
+#endif /* _cubochoricsampler_h_ */
@@ -42,6 +42,8 @@
 
 #include "SIMPLib/Math/MatrixMath.h"
 
+#include "OrientationLib/Utilities/ModifiedLambertProjectionPlan.h"
+
 #define WRITE_LAMBERT_SQUARE_COORD_VTK 0
 
 // -----------------------------------------------------------------------------
@@ -181,70 +183,16 @@ int ModifiedLambertProjection::readHDF5Data(hid_t groupId)
 // -----------------------------------------------------------------------------
 void ModifiedLambertProjection::addInterpolatedValues(Square square, float* sqCoord, double value)
 {
-  int abin1 = 0, bbin1 = 0;
-  int abin2 = 0, bbin2 = 0;
-  int abin3 = 0, bbin3 = 0;
-  int abin4 = 0, bbin4 = 0;
-  int abinSign, bbinSign;
-  float modX = (sqCoord[0] + m_HalfDimensionTimesStepSize ) / m_StepSize;
-  float modY = (sqCoord[1] + m_HalfDimensionTimesStepSize ) / m_StepSize;
-  int abin = (int) modX;
-  int bbin = (int) modY;
-  modX -= abin;
-  modY -= bbin;
-  modX -= 0.5;
-  modY -= 0.5;
-  if(modX == 0.0)
-  {
-    abinSign = 1;
-  }
-  else
-  {
-    abinSign = modX / fabs(modX);
-  }
-  if(modY == 0.0)
-  {
-    bbinSign = 1;
-  }
-  else
-  {
-    bbinSign = modY / fabs(modY);
-  }
-  abin1 = abin;
-  bbin1 = bbin;
-  abin2 = abin + abinSign;
-  bbin2 = bbin;
-  if(abin2 < 0 || abin2 > m_Dimension - 1)
-  {
-    abin2 = abin2 - (abinSign * m_Dimension), bbin2 = m_Dimension - bbin2 - 1;
-  }
-  abin3 = abin;
-  bbin3 = bbin + bbinSign;
-  if(bbin3 < 0 || bbin3 > m_Dimension - 1)
-  {
-    abin3 = m_Dimension - abin3 - 1, bbin3 = bbin3 - (bbinSign * m_Dimension);
-  }
-  abin4 = abin + abinSign;
-  bbin4 = bbin + bbinSign;
-  if((abin4 < 0 || abin4 > m_Dimension - 1) && (bbin4 >= 0 && bbin4 <= m_Dimension - 1))
-  {
-    abin4 = abin4 - (abinSign * m_Dimension), bbin4 = m_Dimension - bbin4 - 1;
-  }
-  else if((abin4 >= 0 && abin4 <= m_Dimension - 1) && (bbin4 < 0 || bbin4 > m_Dimension - 1))
-  {
-    abin4 = m_Dimension - abin4 - 1, bbin4 = bbin4 - (bbinSign * m_Dimension);
-  }
-  else if((abin4 < 0 || abin4 > m_Dimension - 1) && (bbin4 < 0 || bbin4 > m_Dimension - 1))
-  {
-    abin4 = abin4 - (abinSign * m_Dimension), bbin4 = bbin4 - (bbinSign * m_Dimension);
-  }
-  modX = fabs(modX);
-  modY = fabs(modY);
-
-  int index1 = bbin1 * m_Dimension + abin1;
-  int index2 = bbin2 * m_Dimension + abin2;
-  int index3 = bbin3 * m_Dimension + abin3;
-  int index4 = bbin4 * m_Dimension + abin4;
+  int index[4] = { 0, 0, 0, 0 };
+  float mod[2] = { 0.0f, 0.0f };
+  getInterpolationBins(sqCoord, index, mod);
+  float modX = mod[0];
+  float modY = mod[1];
+
+  int index1 = index[0];
+  int index2 = index[1];
+  int index3 = index[2];
+  int index4 = index[3];
   if (square == ModifiedLambertProjection::Square::NorthSquare)
   {
     double v1 = m_NorthSquare->getValue(index1) + value * (1.0 - modX) * (1.0 - modY);
@@ -319,9 +267,8 @@ double ModifiedLambertProjection::getValue(Square square, int index)
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-double ModifiedLambertProjection::getInterpolatedValue(Square square, float* sqCoord)
+void ModifiedLambertProjection::getInterpolationBins(float* sqCoord, int* index, float* mod)
 {
-// float sqCoord[2] = { sqCoord0[0] - 0.5*m_StepSize, sqCoord0[1] - 0.5*m_StepSize};
   int abin1, bbin1;
   int abin2, bbin2;
   int abin3, bbin3;
@@ -379,23 +326,40 @@ double ModifiedLambertProjection::getInterpolatedValue(Square square, float* sqC
   {
     abin4 = abin4 - (abinSign * m_Dimension), bbin4 = bbin4 - (bbinSign * m_Dimension);
   }
-  modX = fabs(modX);
-  modY = fabs(modY);
+  mod[0] = fabs(modX);
+  mod[1] = fabs(modY);
+
+  index[0] = (abin1) + (bbin1 * m_Dimension);
+  index[1] = (abin2) + (bbin2 * m_Dimension);
+  index[2] = (abin3) + (bbin3 * m_Dimension);
+  index[3] = (abin4) + (bbin4 * m_Dimension);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+double ModifiedLambertProjection::getInterpolatedValue(Square square, float* sqCoord)
+{
+  int index[4] = { 0, 0, 0, 0 };
+  float mod[2] = { 0.0f, 0.0f };
+  getInterpolationBins(sqCoord, index, mod);
+  float modX = mod[0];
+  float modY = mod[1];
   if (square == ModifiedLambertProjection::Square::NorthSquare)
   {
-    float intensity1 = m_NorthSquare->getValue((abin1) + (bbin1 * m_Dimension));
-    float intensity2 = m_NorthSquare->getValue((abin2) + (bbin2 * m_Dimension));
-    float intensity3 = m_NorthSquare->getValue((abin3) + (bbin3 * m_Dimension));
-    float intensity4 = m_NorthSquare->getValue((abin4) + (bbin4 * m_Dimension));
+    float intensity1 = m_NorthSquare->getValue(index[0]);
+    float intensity2 = m_NorthSquare->getValue(index[1]);
+    float intensity3 = m_NorthSquare->getValue(index[2]);
+    float intensity4 = m_NorthSquare->getValue(index[3]);
     float interpolatedIntensity = ((intensity1 * (1 - modX) * (1 - modY)) + (intensity2 * (modX) * (1 - modY)) + (intensity3 * (1 - modX) * (modY)) + (intensity4 * (modX) * (modY)));
     return interpolatedIntensity;
   }
   else
   {
-    float intensity1 = m_SouthSquare->getValue((abin1) + (bbin1 * m_Dimension));
-    float intensity2 = m_SouthSquare->getValue((abin2) + (bbin2 * m_Dimension));
-    float intensity3 = m_SouthSquare->getValue((abin3) + (bbin3 * m_Dimension));
-    float intensity4 = m_SouthSquare->getValue((abin4) + (bbin4 * m_Dimension));
+    float intensity1 = m_SouthSquare->getValue(index[0]);
+    float intensity2 = m_SouthSquare->getValue(index[1]);
+    float intensity3 = m_SouthSquare->getValue(index[2]);
+    float intensity4 = m_SouthSquare->getValue(index[3]);
     float interpolatedIntensity = ((intensity1 * (1 - modX) * (1 - modY)) + (intensity2 * (modX) * (1 - modY)) + (intensity3 * (1 - modX) * (modY)) + (intensity4 * (modX) * (modY)));
     return interpolatedIntensity;
   }
@@ -531,100 +495,15 @@ void ModifiedLambertProjection::normalizeSquaresToMRD()
 // -----------------------------------------------------------------------------
 void ModifiedLambertProjection::createProjection(int dim, FloatArrayType* stereoIntensity, ModifiedLambertProjection::ProjectionType projType)
 {
-  int xpoints = dim;
-  int ypoints = dim;
-
-  int xpointshalf = xpoints / 2;
-  int ypointshalf = ypoints / 2;
-
-  float span;
-  float unitRadius = 1.0;
-  if (projType == ModifiedLambertProjection::ProjectionType::Stereographic)
-  {
-  }
-  else if(projType == ModifiedLambertProjection::ProjectionType::Circular)
-  {
-    unitRadius = std::sqrt(2.0f);
-  }
-  else
+  if (projType != ModifiedLambertProjection::ProjectionType::Stereographic && projType != ModifiedLambertProjection::ProjectionType::Circular)
   {
+    // Not a valid projection type
     return;
   }
 
-  span = unitRadius - (-unitRadius);
-
-
-  float xres = span / static_cast<float>(xpoints);
-  float yres = span / static_cast<float>(ypoints);
-  float xtmp, ytmp;
-  float sqCoord[2];
-  float xyz[3];
-  bool nhCheck = false;
-
-  stereoIntensity->initializeWithZeros();
-  float* intensity = stereoIntensity->getPointer(0);
-// int sqIndex = 0;
-
-  for (int64_t y = 0; y < ypoints; y++)
-  {
-    for (int64_t x = 0; x < xpoints; x++)
-    {
-      //get (x,y) for stereographic projection pixel
-      xtmp = static_cast<float>(x - xpointshalf) * xres + (xres * 0.5f);
-      ytmp = static_cast<float>(y - ypointshalf) * yres + (yres * 0.5f);
-      size_t index = static_cast<size_t>(y * xpoints + x);
-      if((xtmp * xtmp + ytmp * ytmp) <= unitRadius * unitRadius)
-      {
-        //project xy from stereo projection to the unit sphere
-        if (projType == ModifiedLambertProjection::ProjectionType::Stereographic)
-        {
-          xyz[2] = -((xtmp * xtmp + ytmp * ytmp) - 1) / ((xtmp * xtmp + ytmp * ytmp) + 1);
-          xyz[0] = xtmp * (1 + xyz[2]);
-          xyz[1] = ytmp * (1 + xyz[2]);
-        }
-        else if (projType == ModifiedLambertProjection::ProjectionType::Circular)
-        {
-          float q = xtmp*xtmp + ytmp*ytmp;
-          float t = std::sqrt(1.0f - (q / 4.0f));
-
-          xyz[0] = xtmp * t;
-          xyz[1] = ytmp * t;
-          xyz[2] = (q / 2.0f) - 1.0f;
-        }
-        else
-        {
-          // Not a valid projection type
-          return;
-        }
-
-
-        for( int64_t m = 0; m < 2; m++)
-        {
-          if(m == 1)
-          {
-            xyz[0] *= -1.0;
-            xyz[1] *= -1.0;
-            xyz[2] *= -1.0;
-          }
-          nhCheck = getSquareCoord(xyz, sqCoord);
-          //sqIndex = getSquareIndex(sqCoord);
-          if (nhCheck == true)
-          {
-            //get Value from North square
-            intensity[index] += getInterpolatedValue(ModifiedLambertProjection::Square::NorthSquare, sqCoord);
-            //intensity[index] += getValue(ModifiedLambertProjection::Square::NorthSquare, sqIndex);
-          }
-          else
-          {
-            //get Value from South square
-            intensity[index] += getInterpolatedValue(ModifiedLambertProjection::Square::SouthSquare, sqCoord);
-            //intensity[index] += getValue(ModifiedLambertProjection::SouthSquare, sqIndex);
-          }
-        }
-        intensity[index]  = intensity[index] * 0.5f;
-      }
-    }
-  }
+  // The pixel to square mapping only depends on the geometry so it is computed once and shared
+  ModifiedLambertProjectionPlan::Pointer plan = ModifiedLambertProjectionPlan::GetPlan(m_Dimension, m_SphereRadius, dim, projType);
+  plan->apply<double>(m_NorthSquare->getPointer(0), m_SouthSquare->getPointer(0), stereoIntensity->getPointer(0));
 }
 
 // -----------------------------------------------------------------------------
@@ -147,6 +147,15 @@ class OrientationLib_EXPORT ModifiedLambertProjection
      */
     double getInterpolatedValue(Square square, float* sqCoord);
 
+    /**
+     * @brief getInterpolationBins Computes the 4 bins and the interpolation fractions used by
+     * getInterpolatedValue and addInterpolatedValues for a coordinate in the Modified Lambert Square
+     * @param sqCoord The XY coordinate in the Modified Lambert Square
+     * @param index [output] The 4 bin indices into a square
+     * @param mod [output] The X and Y interpolation fractions
+     */
+    void getInterpolationBins(float* sqCoord, int* index, float* mod);
+
     /**
      * @brief getSquareCoord
      * @param xyz The input XYZ coordinate on the unit sphere.
@@ -174,7 +183,8 @@ class OrientationLib_EXPORT ModifiedLambertProjection
     void normalizeSquaresToMRD();
 
     /**
-     * @brief ModifiedLambertProjection::createProjection
+     * @brief ModifiedLambertProjection::createProjection The mapping from the projection pixels
+     * to the squares is taken from the ModifiedLambertProjectionPlan cache.
      * @param dim
      * @param stereoIntensity
      * @param projType
@@ -0,0 +1,225 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+
+#include "ModifiedLambertProjectionPlan.h"
+
+#include <cmath>
+#include <list>
+#include <tuple>
+#include <utility>
+
+#include <QtCore/QMutex>
+#include <QtCore/QMutexLocker>
+
+namespace
+{
+  using PlanKey = std::tuple<int, float, int, ModifiedLambertProjection::EnumType>;
+  using PlanCacheType = std::list<std::pair<PlanKey, ModifiedLambertProjectionPlan::Pointer> >;
+
+  // A plan for a 1001 x 1001 projection takes about 57 MB, so only the most recently used
+  // plans are kept; a session rarely switches between more than a few geometries
+  const size_t k_MaxCachedPlans = 4;
+
+  QMutex& PlanCacheMutex()
+  {
+    static QMutex mutex;
+    return mutex;
+  }
+
+  // The most recently used plan comes first
+  PlanCacheType& PlanCache()
+  {
+    static PlanCacheType cache;
+    return cache;
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+ModifiedLambertProjectionPlan::ModifiedLambertProjectionPlan() :
+  m_SquareDimension(0),
+  m_Dimension(0)
+{
+
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+ModifiedLambertProjectionPlan::~ModifiedLambertProjectionPlan()
+{
+
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+ModifiedLambertProjectionPlan::Pointer ModifiedLambertProjectionPlan::GetPlan(int squareDim, float sphereRadius, int dim, ModifiedLambertProjection::ProjectionType projType)
+{
+  if (projType != ModifiedLambertProjection::ProjectionType::Stereographic && projType != ModifiedLambertProjection::ProjectionType::Circular)
+  {
+    // Not a valid projection type
+    return NullPointer();
+  }
+
+  PlanKey key(squareDim, sphereRadius, dim, static_cast<ModifiedLambertProjection::EnumType>(projType));
+
+  QMutexLocker locker(&PlanCacheMutex());
+  PlanCacheType& cache = PlanCache();
+  for (PlanCacheType::iterator iter = cache.begin(); iter != cache.end(); ++iter)
+  {
+    if (iter->first == key)
+    {
+      cache.splice(cache.begin(), cache, iter);
+      return cache.front().second;
+    }
+  }
+
+  Pointer plan = Pointer(new ModifiedLambertProjectionPlan());
+  if (!plan->initialize(squareDim, sphereRadius, dim, projType))
+  {
+    return NullPointer();
+  }
+  cache.push_front(std::make_pair(key, plan));
+  if (cache.size() > k_MaxCachedPlans)
+  {
+    cache.pop_back();
+  }
+  return plan;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ModifiedLambertProjectionPlan::ClearCache()
+{
+  QMutexLocker locker(&PlanCacheMutex());
+  PlanCache().clear();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool ModifiedLambertProjectionPlan::initialize(int squareDim, float sphereRadius, int dim, ModifiedLambertProjection::ProjectionType projType)
+{
+  // The projection is only used for its geometry; the squares themselves are never read
+  ModifiedLambertProjection::Pointer lambertProjection = ModifiedLambertProjection::New();
+  lambertProjection->initializeSquares(squareDim, sphereRadius);
+
+  int xpoints = dim;
+  int ypoints = dim;
+
+  int xpointshalf = xpoints / 2;
+  int ypointshalf = ypoints / 2;
+
+  float span;
+  float unitRadius = 1.0;
+  if (projType == ModifiedLambertProjection::ProjectionType::Stereographic)
+  {
+  }
+  else if(projType == ModifiedLambertProjection::ProjectionType::Circular)
+  {
+    unitRadius = std::sqrt(2.0f);
+  }
+  else
+  {
+    return false;
+  }
+
+  span = unitRadius - (-unitRadius);
+
+  float xres = span / static_cast<float>(xpoints);
+  float yres = span / static_cast<float>(ypoints);
+  float xtmp, ytmp;
+  float sqCoord[2];
+  float xyz[3];
+  float mod[2];
+
+  m_SquareDimension = squareDim;
+  m_Dimension = dim;
+  m_Valid.assign(static_cast<size_t>(xpoints) * static_cast<size_t>(ypoints), 0);
+  m_Samples.resize(2 * m_Valid.size());
+
+  for (int64_t y = 0; y < ypoints; y++)
+  {
+    for (int64_t x = 0; x < xpoints; x++)
+    {
+      //get (x,y) for stereographic projection pixel
+      xtmp = static_cast<float>(x - xpointshalf) * xres + (xres * 0.5f);
+      ytmp = static_cast<float>(y - ypointshalf) * yres + (yres * 0.5f);
+      size_t index = static_cast<size_t>(y * xpoints + x);
+      if((xtmp * xtmp + ytmp * ytmp) <= unitRadius * unitRadius)
+      {
+        //project xy from stereo projection to the unit sphere
+        if (projType == ModifiedLambertProjection::ProjectionType::Stereographic)
+        {
+          xyz[2] = -((xtmp * xtmp + ytmp * ytmp) - 1) / ((xtmp * xtmp + ytmp * ytmp) + 1);
+          xyz[0] = xtmp * (1 + xyz[2]);
+          xyz[1] = ytmp * (1 + xyz[2]);
+        }
+        else
+        {
+          float q = xtmp*xtmp + ytmp*ytmp;
+          float t = std::sqrt(1.0f - (q / 4.0f));
+
+          xyz[0] = xtmp * t;
+          xyz[1] = ytmp * t;
+          xyz[2] = (q / 2.0f) - 1.0f;
+        }
+
+        // Each pixel is the average of the point and its antipode
+        for( int64_t m = 0; m < 2; m++)
+        {
+          if(m == 1)
+          {
+            xyz[0] *= -1.0;
+            xyz[1] *= -1.0;
+            xyz[2] *= -1.0;
+          }
+          Sample& sample = m_Samples[2 * index + m];
+          sample.north = lambertProjection->getSquareCoord(xyz, sqCoord);
+          lambertProjection->getInterpolationBins(sqCoord, sample.index, mod);
+          sample.modX = mod[0];
+          sample.modY = mod[1];
+        }
+        m_Valid[index] = 1;
+      }
+    }
+  }
+
+  return true;
+}
@@ -0,0 +1,171 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+
+
+#ifndef _modifiedlambertprojectionplan_h_
+#define _modifiedlambertprojectionplan_h_
+
+#include <vector>
+
+#include "SIMPLib/Common/SIMPLibSetGetMacros.h"
+
+#include "OrientationLib/OrientationLib.h"
+#include "OrientationLib/Utilities/ModifiedLambertProjection.h"
+
+/**
+ * @class ModifiedLambertProjectionPlan ModifiedLambertProjectionPlan.h OrientationLib/Utilities/ModifiedLambertProjectionPlan.h
+ * @brief This class holds the precomputed mapping from the pixels of a Stereographic or Circular projection
+ * to the bins of the Modified Lambert squares. The mapping only depends on the square dimension, the sphere
+ * radius, the projection dimension and the projection type, so it is computed once (see GetPlan) and every
+ * projection after that is a gather of 4 bins per hemisphere sample using the stored interpolation fractions.
+ * A plan takes about 57 bytes per projection pixel, so the cache only keeps the 4 most recently used plans;
+ * a plan that was dropped from the cache lives on for as long as a caller still holds its pointer.
+ * The gather reproduces the arithmetic of ModifiedLambertProjection::getInterpolatedValue exactly.
+ */
+class OrientationLib_EXPORT ModifiedLambertProjectionPlan
+{
+  public:
+    SIMPL_SHARED_POINTERS(ModifiedLambertProjectionPlan)
+    SIMPL_TYPE_MACRO(ModifiedLambertProjectionPlan)
+
+    virtual ~ModifiedLambertProjectionPlan();
+
+    /**
+     * @brief GetPlan Returns the cached plan for the given geometry, creating it on first use. Creating a plan
+     * drops the least recently used one once the cache holds 4 plans. This is thread safe.
+     * @param squareDim The dimension of the Modified Lambert squares
+     * @param sphereRadius The sphere radius the squares were initialized with
+     * @param dim The dimension of the projection image
+     * @param projType The projection type
+     * @return The plan or a NullPointer for an invalid projection type
+     */
+    static Pointer GetPlan(int squareDim, float sphereRadius, int dim, ModifiedLambertProjection::ProjectionType projType);
+
+    /**
+     * @brief ClearCache Releases all of the cached plans. Plans that are still referenced stay valid.
+     */
+    static void ClearCache();
+
+    SIMPL_GET_PROPERTY(int, SquareDimension)
+    SIMPL_GET_PROPERTY(int, Dimension)
+
+    /**
+     * @brief apply Creates the projection image from a pair of Modified Lambert squares
+     * @param northSquare The north square (squareDim * squareDim values) or nullptr if it is all zeros
+     * @param southSquare The south square (squareDim * squareDim values) or nullptr if it is all zeros
+     * @param intensity [output] The projection image (dim * dim values)
+     */
+    template<typename T>
+    void apply(const T* northSquare, const T* southSquare, float* intensity) const
+    {
+      size_t numPixels = static_cast<size_t>(m_Dimension) * static_cast<size_t>(m_Dimension);
+      for(size_t i = 0; i < numPixels; i++)
+      {
+        if(m_Valid[i] == 0)
+        {
+          intensity[i] = 0.0f;
+          continue;
+        }
+        float value = 0.0f;
+        for(size_t m = 0; m < 2; m++)
+        {
+          const Sample& sample = m_Samples[2 * i + m];
+          const T* square = sample.north ? northSquare : southSquare;
+          float interpolatedIntensity = 0.0f;
+          if(nullptr != square)
+          {
+            float intensity1 = static_cast<float>(square[sample.index[0]]);
+            float intensity2 = static_cast<float>(square[sample.index[1]]);
+            float intensity3 = static_cast<float>(square[sample.index[2]]);
+            float intensity4 = static_cast<float>(square[sample.index[3]]);
+            float modX = sample.modX;
+            float modY = sample.modY;
+            interpolatedIntensity = ((intensity1 * (1 - modX) * (1 - modY)) + (intensity2 * (modX) * (1 - modY)) + (intensity3 * (1 - modX) * (modY)) + (intensity4 * (modX) * (modY)));
+          }
+          value += interpolatedIntensity;
+        }
+        intensity[i] = value * 0.5f;
+      }
+    }
+
+    /**
+     * @brief apply Creates one projection image per slice from a stack of Modified Lambert squares
+     * @param northSquares numSlices contiguous north squares or nullptr
+     * @param southSquares numSlices contiguous south squares or nullptr
+     * @param numSlices The number of slices
+     * @param intensity [output] numSlices contiguous projection images
+     */
+    template<typename T>
+    void apply(const T* northSquares, const T* southSquares, size_t numSlices, float* intensity) const
+    {
+      size_t squareSize = static_cast<size_t>(m_SquareDimension) * static_cast<size_t>(m_SquareDimension);
+      size_t imageSize = static_cast<size_t>(m_Dimension) * static_cast<size_t>(m_Dimension);
+      for(size_t z = 0; z < numSlices; z++)
+      {
+        apply<T>(nullptr != northSquares ? northSquares + z * squareSize : nullptr,
+                 nullptr != southSquares ? southSquares + z * squareSize : nullptr,
+                 intensity + z * imageSize);
+      }
+    }
+
+  protected:
+    ModifiedLambertProjectionPlan();
+
+    /**
+     * @brief initialize Computes the mapping for every pixel of the projection image
+     */
+    bool initialize(int squareDim, float sphereRadius, int dim, ModifiedLambertProjection::ProjectionType projType);
+
+  private:
+    struct Sample
+    {
+      int index[4];
+      float modX;
+      float modY;
+      bool north;
+    };
+
+    int m_SquareDimension;
+    int m_Dimension;
+
+    std::vector<unsigned char> m_Valid;
+    std::vector<Sample>        m_Samples;
+
+    ModifiedLambertProjectionPlan(const ModifiedLambertProjectionPlan&); // Copy Constructor Not Implemented
+    void operator=(const ModifiedLambertProjectionPlan&); // Operator '=' Not Implemented
+};
+
+#endif /* _modifiedlambertprojectionplan_h_ */
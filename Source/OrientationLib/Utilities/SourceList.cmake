@@ -39,12 +39,16 @@ set(OrientationLib_Utilities_MOC_HDRS
 
 
 set(OrientationLib_Utilities_HDRS
+  ${OrientationLib_SOURCE_DIR}/Utilities/CubochoricSampler.h
   ${OrientationLib_SOURCE_DIR}/Utilities/ModifiedLambertProjection.h
+  ${OrientationLib_SOURCE_DIR}/Utilities/ModifiedLambertProjectionPlan.h
   ${OrientationLib_SOURCE_DIR}/Utilities/ModifiedLambertProjection3D.hpp
 )
 
 set(OrientationLib_Utilities_SRCS
+  ${OrientationLib_SOURCE_DIR}/Utilities/CubochoricSampler.cpp
   ${OrientationLib_SOURCE_DIR}/Utilities/ModifiedLambertProjection.cpp
+  ${OrientationLib_SOURCE_DIR}/Utilities/ModifiedLambertProjectionPlan.cpp
 )
 QT5_WRAP_CPP( OrientationLib_Generated_MOC_SRCS ${OrientationLib_Utilities_MOC_HDRS} )
 set_source_files_properties( ${OrientationLib_Generated_MOC_SRCS} PROPERTIES HEADER_FILE_ONLY TRUE)
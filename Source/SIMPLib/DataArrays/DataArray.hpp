@@ -342,7 +342,7 @@ class DataArray : public IDataArray
     }
 
     /**
-     * @brief FromPointer
+     * @brief FromPointer Copies the data into a new array. Use WrapPointer to use the memory in place.
      * @param data
      * @param size
      * @param name
@@ -360,7 +360,9 @@ class DataArray : public IDataArray
 
 
     /**
-     * @brief WrapPointer
+     * @brief WrapPointer Uses the memory in place without copying it. With ownsData = false the array is
+     * a view and the caller keeps the memory alive for the lifetime of the array; with ownsData = true
+     * the memory must have been allocated with malloc.
      * @param data
      * @param numTuples
      * @param cDims
@@ -677,7 +679,7 @@ class DataArray : public IDataArray
       {
         T* currentSrc = m_Array + (j * m_NumComponents);
         ::memcpy(currentDest, currentSrc, (getNumberOfTuples() - idxs.size()) * m_NumComponents * sizeof(T));
-        _deallocate(); // We are done copying - delete the current m_Array
+        if (m_OwnsData) { _deallocate(); } // We are done copying - delete the current m_Array
         m_Size = newSize;
         m_Array = newArray;
         m_OwnsData = true;
@@ -718,7 +720,7 @@ class DataArray : public IDataArray
       }
 
       // We are done copying - delete the current m_Array
-      _deallocate();
+      if (m_OwnsData) { _deallocate(); }
 
       // Allocation was successful.  Save it.
       m_Size = newSize;
@@ -1073,6 +1075,21 @@ class DataArray : public IDataArray
 #endif
     }
 
+    /**
+     * @brief Writes the array using the chunking, compression and fill value described by
+     * options. Large arrays such as pattern stacks benefit from a deflated, chunked layout.
+     * @param parentId
+     * @param tDims
+     * @param options
+     * @return
+     */
+    int writeH5Data(hid_t parentId, QVector<size_t> tDims, const H5Lite::DatasetCreationOptions& options)
+    {
+      if (m_Array == nullptr)
+      { return -85648; }
+      return H5DataArrayWriter::writeDataArray<Self>(parentId, this, tDims, options);
+    }
+
     /**
      * @brief writeXdmfAttribute
      * @param out
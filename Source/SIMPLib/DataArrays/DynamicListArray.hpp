@@ -46,6 +46,10 @@
 /**
  * @brief The MeshFaceNeighbors class contains arrays of Faces for each Node in the mesh. This allows quick query to the node
  * to determine what Cells the node is a part of.
+ *
+ * allocateLists() and deserializeLinks() place all lists back to back in one contiguous arena instead of
+ * allocating every list on its own. The usual way to build the lists is therefore in two passes: count the
+ * entries of every list, call allocateLists() with the counts and then fill the lists with insertCellReference().
  */
 template<typename T, typename K>
 class DynamicListArray
@@ -70,20 +74,7 @@ class DynamicListArray
     // -----------------------------------------------------------------------------
     virtual ~DynamicListArray()
     {
-      // This makes sure we deallocate any lists that have been created
-      for (size_t i = 0; i < this->m_Size; i++)
-      {
-        if ( this->m_Array[i].cells != nullptr )
-        {
-          delete [] this->m_Array[i].cells;
-        }
-      }
-      // Now delete all the "NeighborLists" structures
-      if ( this->m_Array != nullptr )
-      {
-        delete [] this->m_Array;
-      }
-
+      releaseLists();
     }
 
     //----------------------------------------------------------------------------
@@ -106,11 +97,18 @@ class DynamicListArray
     bool setElementList(size_t ptId, T nCells, K* data)
     {
       if(ptId >= m_Size) { return false; }
-      if(nullptr != m_Array[ptId].cells && m_Array[ptId].ncells > 0)
+      if(isInArena(m_Array[ptId].cells) && nCells <= m_Array[ptId].ncells)
+      {
+        // The new list fits into the space of the current one
+        m_Array[ptId].ncells = nCells;
+        ::memcpy(m_Array[ptId].cells, data, sizeof(K) * nCells);
+        return true;
+      }
+      if(nullptr != m_Array[ptId].cells && !isInArena(m_Array[ptId].cells))
       {
-        m_Array[ptId].cells = nullptr;
-        m_Array[ptId].ncells = 0;
+        delete [] m_Array[ptId].cells;
       }
+      m_Array[ptId].cells = nullptr;
       m_Array[ptId].ncells = nCells;
       //If nCells is huge then there could be problems with this
       this->m_Array[ptId].cells = new K[nCells];
@@ -131,21 +129,7 @@ class DynamicListArray
     // -----------------------------------------------------------------------------
     void deserializeLinks(QVector<uint8_t>& buffer, size_t nElements)
     {
-      size_t offset = 0;
-      allocate(nElements); // Allocate all the links with 0 and nullptr;
-      uint8_t* bufPtr = buffer.data();
-
-      // Walk the array and allocate all the array links to Zero and nullptr
-      T* ncells = nullptr;
-      for(size_t i = 0; i < nElements; ++i)
-      {
-        ncells = reinterpret_cast<T*>(bufPtr + offset);
-        this->m_Array[i].ncells = *ncells; // Set the number of cells in this link
-        offset += 2;
-        this->m_Array[i].cells = new K[(*ncells)]; // Allocate a new chunk of memory to store the list
-        ::memcpy(this->m_Array[i].cells, bufPtr + offset, (*ncells)*sizeof(K) ); // Copy from the buffer into the new list memory
-        offset += (*ncells) * sizeof(K); // Increment the offset
-      }
+      deserializeLinks(buffer.data(), nElements);
     }
 
     // -----------------------------------------------------------------------------
@@ -153,21 +137,34 @@ class DynamicListArray
     // -----------------------------------------------------------------------------
     void deserializeLinks(std::vector<uint8_t>& buffer, size_t nElements)
     {
+      deserializeLinks(&(buffer.front()), nElements);
+    }
+
+    // -----------------------------------------------------------------------------
+    //
+    // -----------------------------------------------------------------------------
+    void deserializeLinks(uint8_t* bufPtr, size_t nElements)
+    {
+      // First pass: read the number of cells of every link so the arena can be allocated in one piece
+      std::vector<T> linkCounts(nElements);
       size_t offset = 0;
-      allocate(nElements); // Allocate all the links with 0 and nullptr;
-      uint8_t* bufPtr = &(buffer.front());
+      T ncells = 0;
+      for(size_t i = 0; i < nElements; ++i)
+      {
+        ::memcpy(&ncells, bufPtr + offset, sizeof(T));
+        linkCounts[i] = ncells;
+        offset += 2;
+        offset += ncells * sizeof(K);
+      }
+      allocateLists(linkCounts);
 
-      // Walk the array and allocate all the array links to Zero and nullptr
-      T* ncells = nullptr;
-      //int32_t* cells = nullptr;
+      // Second pass: copy every list from the buffer into its place in the arena
+      offset = 0;
       for(size_t i = 0; i < nElements; ++i)
       {
-        ncells = reinterpret_cast<T*>(bufPtr + offset);
-        this->m_Array[i].ncells = *ncells; // Set the number of cells in this link
         offset += 2;
-        this->m_Array[i].cells = new K[(*ncells)]; // Allocate a new chunk of memory to store the list
-        ::memcpy(this->m_Array[i].cells, bufPtr + offset, (*ncells)*sizeof(K) ); // Copy from the buffer into the new list memory
-        offset += (*ncells) * sizeof(K); // Increment the offset
+        ::memcpy(this->m_Array[i].cells, bufPtr + offset, linkCounts[i] * sizeof(K)); // Copy from the buffer into the list memory
+        offset += linkCounts[i] * sizeof(K); // Increment the offset
       }
     }
 
@@ -177,12 +174,7 @@ class DynamicListArray
      */
     void allocateLists(QVector<T>& linkCounts)
     {
-      allocate(linkCounts.size());
-      for (K i = 0; i < linkCounts.size(); i++)
-      {
-        this->m_Array[i].ncells = linkCounts[i];
-        this->m_Array[i].cells = new K[this->m_Array[i].ncells];
-      }
+      allocateLists(linkCounts.data(), static_cast<size_t>(linkCounts.size()));
     }
 
     /**
@@ -191,18 +183,40 @@ class DynamicListArray
      */
     void allocateLists(std::vector<T>& linkCounts)
     {
-      allocate(linkCounts.size());
-      for (K i = 0; i < linkCounts.size(); i++)
+      allocateLists(linkCounts.empty() ? nullptr : &(linkCounts.front()), linkCounts.size());
+    }
+
+    /**
+     * @brief allocateLists Allocates one arena for all lists and points every list at its part of it
+     * @param linkCounts The number of entries of every list
+     * @param numLists The number of lists
+     */
+    void allocateLists(const T* linkCounts, size_t numLists)
+    {
+      allocate(numLists);
+      size_t total = 0;
+      for (size_t i = 0; i < numLists; i++)
+      {
+        total += static_cast<size_t>(linkCounts[i]);
+      }
+      this->m_Arena = new K[total];
+      this->m_ArenaSize = total;
+
+      size_t offset = 0;
+      for (size_t i = 0; i < numLists; i++)
       {
         this->m_Array[i].ncells = linkCounts[i];
-        this->m_Array[i].cells = new K[this->m_Array[i].ncells];
+        this->m_Array[i].cells = this->m_Arena + offset;
+        offset += static_cast<size_t>(linkCounts[i]);
       }
     }
 
   protected:
     DynamicListArray() :
       m_Array(nullptr),
-      m_Size(0)
+      m_Size(0),
+      m_Arena(nullptr),
+      m_ArenaSize(0)
     {}
 
     //----------------------------------------------------------------------------
@@ -212,10 +226,35 @@ class DynamicListArray
     {
       static typename DynamicListArray<T, K>::ElementList linkInit = {0, nullptr};
 
-      // This makes sure we deallocate any lists that have been created
+      releaseLists();
+
+      this->m_Size = sz;
+      // Allocate a whole new set of structures
+      this->m_Array = new typename DynamicListArray<T, K>::ElementList[sz];
+
+      // Initialize each structure to have 0 entries and nullptr pointer.
+      for (size_t i = 0; i < sz; i++)
+      {
+        this->m_Array[i] = linkInit;
+      }
+    }
+
+
+    //----------------------------------------------------------------------------
+    // Returns true if the list memory is part of the arena and must not be deleted on its own.
+    // The end of the arena counts as well because empty lists at the end point there.
+    bool isInArena(K* cells)
+    {
+      return (this->m_Arena != nullptr && cells >= this->m_Arena && cells <= this->m_Arena + this->m_ArenaSize);
+    }
+
+    //----------------------------------------------------------------------------
+    void releaseLists()
+    {
+      // This makes sure we deallocate any lists that have been created on their own
       for (size_t i = 0; i < this->m_Size; i++)
       {
-        if ( this->m_Array[i].cells != nullptr )
+        if ( this->m_Array[i].cells != nullptr && !isInArena(this->m_Array[i].cells) )
         {
           delete [] this->m_Array[i].cells;
         }
@@ -225,22 +264,23 @@ class DynamicListArray
       {
         delete [] this->m_Array;
       }
+      this->m_Array = nullptr;
+      this->m_Size = 0;
 
-      this->m_Size = sz;
-      // Allocate a whole new set of structures
-      this->m_Array = new typename DynamicListArray<T, K>::ElementList[sz];
-
-      // Initialize each structure to have 0 entries and nullptr pointer.
-      for (size_t i = 0; i < sz; i++)
+      // and the arena with the lists that were allocated together
+      if ( this->m_Arena != nullptr )
       {
-        this->m_Array[i] = linkInit;
+        delete [] this->m_Arena;
       }
+      this->m_Arena = nullptr;
+      this->m_ArenaSize = 0;
     }
 
-
   private:
     ElementList* m_Array;   // pointer to data
     size_t m_Size;
+    K* m_Arena;             // storage of all lists created by allocateLists() or deserializeLinks()
+    size_t m_ArenaSize;
 
 
 };
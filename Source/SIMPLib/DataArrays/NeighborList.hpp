@@ -58,6 +58,14 @@
 /**
  * @class NeighborList NeighborList.hpp DREAM3DLib/Common/NeighborList.hpp
  * @brief Template class for wrapping raw arrays of data.
+ *
+ * The lists are either stored as one shared std::vector per tuple or in a compact (compressed sparse
+ * row) form that keeps all values in one array together with an array of list offsets. The compact
+ * form is built with compact() or appendList(), or by readH5Data() when the PreferCompactStorage
+ * property is set, and it is read from and written to HDF5 without any per-list copies. The methods
+ * that hand out a std::vector (getList(), getListReference(), operator[], setList(), ...) convert a
+ * compact list back to one vector per tuple first, so call expand() before sharing a compact list
+ * between threads that use those methods.
  * @author mjackson
  * @date July 3, 2008
  * @version 1.0
@@ -72,6 +80,11 @@ class NeighborList : public IDataArray
 
     SIMPL_INSTANCE_STRING_PROPERTY(NumNeighborsArrayName)
 
+    /**
+     * @brief If set, readH5Data() and deepCopy() keep the lists in the compact form
+     */
+    SIMPL_INSTANCE_PROPERTY(bool, PreferCompactStorage)
+
     static Pointer New()
     {
       return CreateArray(0, "NeighborList", false);
@@ -356,7 +369,7 @@ class NeighborList : public IDataArray
         return 0;
       }
 
-      size_t arraySize = m_Array.size();
+      size_t arraySize = static_cast<size_t>(getNumberOfLists());
       // Sanity Check the Indices in the vector to make sure we are not trying to remove any indices that are
       // off the end of the array and return an error code.
       for(QVector<size_t>::size_type i = 0; i < idxs.size(); ++i)
@@ -364,6 +377,33 @@ class NeighborList : public IDataArray
         if (idxs[i] >= arraySize) { return -100; }
       }
 
+      if (m_Compact)
+      {
+        // Slide the lists that are kept down over the ones that are removed
+        size_t idxsIndex = 0;
+        size_t rIdx = 0;
+        size_t valueEnd = 0;
+        for(size_t dIdx = 0; dIdx < arraySize; ++dIdx)
+        {
+          if (idxsIndex < idxsSize && dIdx == idxs[idxsIndex])
+          {
+            ++idxsIndex;
+            continue;
+          }
+          size_t nEle = m_Offsets[dIdx + 1] - m_Offsets[dIdx];
+          if (nEle > 0 && valueEnd != m_Offsets[dIdx])
+          {
+            ::memmove(&(m_Values[valueEnd]), &(m_Values[m_Offsets[dIdx]]), nEle * sizeof(T));
+          }
+          valueEnd += nEle;
+          m_Offsets[++rIdx] = valueEnd;
+        }
+        m_Offsets.resize(rIdx + 1);
+        m_Values.resize(valueEnd);
+        m_NumTuples = rIdx;
+        return err;
+      }
+
       std::vector<SharedVectorType> replacement(arraySize - idxsSize);
 
       size_t idxsIndex = 0;
@@ -394,6 +434,7 @@ class NeighborList : public IDataArray
      */
     virtual int copyTuple(size_t currentPos, size_t newPos)
     {
+      expand();
       m_Array[newPos] = m_Array[currentPos];
       return 0;
     }
@@ -417,6 +458,7 @@ class NeighborList : public IDataArray
   virtual bool copyData(size_t destTupleOffset, IDataArray::Pointer sourceArray)
     {
       if(!m_IsAllocated) { return false; }
+      expand();
       if(destTupleOffset >= m_Array.size() ) { return false; }
       if(!sourceArray->isAllocated()) { return false; }
       Self* source = dynamic_cast<Self*>(sourceArray.get());
@@ -459,6 +501,7 @@ class NeighborList : public IDataArray
      */
     size_t getSize()
     {
+      if (m_Compact) { return m_Values.size(); }
       size_t total = 0;
       for(size_t dIdx = 0; dIdx < m_Array.size(); ++dIdx)
       {
@@ -511,8 +554,7 @@ class NeighborList : public IDataArray
      * @brief initializeWithZeros
      */
     void initializeWithZeros() {
-      m_Array.clear();
-      m_IsAllocated = false;
+      clearAllLists();
     }
 
     /**
@@ -522,8 +564,18 @@ class NeighborList : public IDataArray
     IDataArray::Pointer deepCopy(bool forceNoAllocate = false)
     {
       typename NeighborList<T>::Pointer daCopyPtr = NeighborList<T>::CreateArray(getNumberOfTuples(), getName(), m_IsAllocated);
+      daCopyPtr->setPreferCompactStorage(m_PreferCompactStorage);
 
-      if(forceNoAllocate == false)
+      if(forceNoAllocate == false && m_Compact)
+      {
+        // Two block copies instead of one allocation per list
+        daCopyPtr->m_Array.clear();
+        daCopyPtr->m_Offsets = m_Offsets;
+        daCopyPtr->m_Values = m_Values;
+        daCopyPtr->m_Compact = true;
+        if (m_PreferCompactStorage == false) { daCopyPtr->expand(); }
+      }
+      else if(forceNoAllocate == false)
       {
         size_t count = (m_IsAllocated ? getNumberOfTuples(): 0);
         for(size_t i = 0; i < count; i++)
@@ -543,6 +595,16 @@ class NeighborList : public IDataArray
     int32_t resizeTotalElements(size_t size)
     {
       //std::cout << "NeighborList::resizeTotalElements(" << size << ")" << std::endl;
+      if (m_Compact)
+      {
+        // New lists are empty, so they all end where the last current list ends
+        size_t old = m_Offsets.size() - 1;
+        if (size < old) { m_Values.resize(m_Offsets[size]); }
+        m_Offsets.resize(size + 1, m_Offsets.back());
+        m_NumTuples = size;
+        m_IsAllocated = (size != 0);
+        return 1;
+      }
       size_t old = m_Array.size();
       m_Array.resize(size);
       m_NumTuples = size;
@@ -566,6 +628,16 @@ class NeighborList : public IDataArray
     //FIXME: These need to be implemented
     virtual void printTuple(QTextStream& out, size_t i, char delimiter = ',')
     {
+      if (m_Compact)
+      {
+        size_t size = m_Offsets[i + 1] - m_Offsets[i];
+        out << size;
+        for(size_t j = m_Offsets[i]; j < m_Offsets[i + 1]; j++)
+        {
+          out << delimiter << m_Values[j];
+        }
+        return;
+      }
       SharedVectorType sharedVec = m_Array[i];
       VectorType* vec = sharedVec.get();
       size_t size = vec->size();
@@ -601,13 +673,14 @@ class NeighborList : public IDataArray
       // can compare this with what is written in the file. If they are
       // different we are going to overwrite what is in the file with what
       // we compute here.
-      Int32ArrayType::Pointer numNeighborsPtr = Int32ArrayType::CreateArray(m_Array.size(), m_NumNeighborsArrayName);
+      size_t numLists = static_cast<size_t>(getNumberOfLists());
+      Int32ArrayType::Pointer numNeighborsPtr = Int32ArrayType::CreateArray(numLists, m_NumNeighborsArrayName);
       int32_t* numNeighbors = numNeighborsPtr->getPointer(0);
       size_t total = 0;
-      for(size_t dIdx = 0; dIdx < m_Array.size(); ++dIdx)
+      for(size_t dIdx = 0; dIdx < numLists; ++dIdx)
       {
-        numNeighbors[dIdx] = static_cast<int32_t>(m_Array[dIdx]->size());
-        total += m_Array[dIdx]->size();
+        numNeighbors[dIdx] = getListSize(static_cast<int>(dIdx));
+        total += static_cast<size_t>(numNeighbors[dIdx]);
       }
 
       // Check to see if the NumNeighbors is already written to the file
@@ -621,7 +694,7 @@ class NeighborList : public IDataArray
       {
         // The NumNeighbors array is in the dream3d file so read it up into memory and compare with what
         // we have in memory.
-        std::vector<int32_t> fileNumNeigh(m_Array.size());
+        std::vector<int32_t> fileNumNeigh(numLists);
         err = QH5Lite::readVectorDataset(parentId, m_NumNeighborsArrayName, fileNumNeigh);
         if (err < 0)
         {
@@ -649,10 +722,10 @@ class NeighborList : public IDataArray
         numNeighborsPtr->writeH5Data(parentId, tDims);
       }
 
-      // Allocate an array of the proper size so we can concatenate all the arrays together into a single array that
-      // can be written to the HDF5 File. This operation can ballon the memory size temporarily until this operation
-      // is complete.
-      QVector<T> flat (total);
+      // The compact lists are already one flat array. Otherwise allocate an array of the proper size so we can
+      // concatenate all the arrays together into a single array that can be written to the HDF5 File. This operation
+      // can ballon the memory size temporarily until this operation is complete.
+      QVector<T> flat (m_Compact ? 0 : total);
       size_t currentStart = 0;
       for(size_t dIdx = 0; dIdx < m_Array.size(); ++dIdx)
       {
@@ -671,7 +744,8 @@ class NeighborList : public IDataArray
       hsize_t dims[1] = { total };
       if (total > 0)
       {
-        err = QH5Lite::writePointerDataset(parentId, getName(), rank, dims, &(flat.front()));
+        const T* data = m_Compact ? &(m_Values.front()) : &(flat.front());
+        err = QH5Lite::writePointerDataset(parentId, getName(), rank, dims, data);
         if(err < 0)
         {
           return -605;
@@ -810,36 +884,35 @@ class NeighborList : public IDataArray
         return -703;
       }
 
-      std::vector<T> flat;
-      err = QH5Lite::readVectorDataset(parentId, getName(), flat);
+      // Read the values straight into the compact storage; the offsets follow from the list sizes
+      m_Array.clear();
+      m_Values.clear();
+      err = QH5Lite::readVectorDataset(parentId, getName(), m_Values);
       if (err < 0)
       {
         return err;
       }
-      // Loop over all the entries and make new Vectors to hold the incoming data
-      m_Array.resize(numNeighbors.size());
-      m_IsAllocated = true;
-      size_t currentStart = 0;
-      qint32 count = static_cast<qint32>(numNeighbors.size());
-      for(QVector<int32_t>::size_type dIdx = 0; dIdx < count; ++dIdx)
+      m_Offsets.resize(numNeighbors.size() + 1);
+      m_Offsets[0] = 0;
+      for(size_t dIdx = 0; dIdx < numNeighbors.size(); ++dIdx)
       {
-        size_t nEle = numNeighbors[dIdx];
-        if(nEle > 0)
-        {
-          m_Array[dIdx] = SharedVectorType(new VectorType(numNeighbors[dIdx]));
+        m_Offsets[dIdx + 1] = m_Offsets[dIdx] + static_cast<size_t>(numNeighbors[dIdx]);
+      }
+      if (m_Offsets.back() > m_Values.size())
+      {
+        m_Offsets.assign(1, 0);
+        m_Values.clear();
+        return -704;
+      }
+      m_Values.resize(m_Offsets.back());
+      m_Compact = true;
+      m_IsAllocated = true;
+      m_NumTuples = numNeighbors.size(); // Sync up the numTuples property with the number of lists
 
-          T* dst = &(m_Array[dIdx]->front()); // get the pointer to the front of the array
-          //    T* end = start + nEle; // get the pointer to the end of the array
-          T* start = &(flat.front()) + currentStart;
-          ::memcpy(dst, start, nEle * sizeof(T));
-          currentStart += nEle;
-        }
-        else
-        {
-          m_Array[dIdx] = SharedVectorType(new VectorType(0));
-        }
+      if (m_PreferCompactStorage == false)
+      {
+        expand();
       }
-      m_NumTuples = m_Array.size(); // Sync up the numTuples property with the size of the internal array
       return err;
     }
 
@@ -850,6 +923,15 @@ class NeighborList : public IDataArray
      */
     void addEntry(int grainId, T value)
     {
+      if (m_Compact && grainId >= getNumberOfLists() - 1)
+      {
+        // Appending to the last list (or to a new one past it) does not move any other list
+        if (grainId >= getNumberOfLists()) { resizeTotalElements(grainId + 1); }
+        m_Values.push_back(value);
+        m_Offsets.back() = m_Values.size();
+        return;
+      }
+      expand();
       if(grainId >= static_cast<int>(m_Array.size()) )
       {
         size_t old = m_Array.size();
@@ -871,9 +953,105 @@ class NeighborList : public IDataArray
     void clearAllLists()
     {
       m_Array.clear();
+      m_Offsets.assign(1, 0);
+      m_Values.clear();
+      m_Compact = false;
       m_IsAllocated = false;
     }
 
+    /**
+     * @brief isCompact
+     * @return true if the lists are stored in the compact form
+     */
+    bool isCompact()
+    {
+      return m_Compact;
+    }
+
+    /**
+     * @brief compact Moves all lists into one values array and one offsets array and releases the
+     * per list vectors
+     */
+    void compact()
+    {
+      if (m_Compact) { return; }
+      size_t numLists = m_Array.size();
+      m_Offsets.resize(numLists + 1);
+      m_Offsets[0] = 0;
+      for(size_t dIdx = 0; dIdx < numLists; ++dIdx)
+      {
+        m_Offsets[dIdx + 1] = m_Offsets[dIdx] + m_Array[dIdx]->size();
+      }
+      m_Values.resize(m_Offsets.back());
+      for(size_t dIdx = 0; dIdx < numLists; ++dIdx)
+      {
+        if (m_Array[dIdx]->empty()) { continue; }
+        ::memcpy(&(m_Values[m_Offsets[dIdx]]), &(m_Array[dIdx]->front()), m_Array[dIdx]->size() * sizeof(T));
+      }
+      std::vector<SharedVectorType>().swap(m_Array);
+      m_NumTuples = numLists;
+      m_Compact = true;
+    }
+
+    /**
+     * @brief expand Converts compact lists back to one vector per tuple
+     */
+    void expand()
+    {
+      if (!m_Compact) { return; }
+      size_t numLists = m_Offsets.size() - 1;
+      m_Array.resize(numLists);
+      for(size_t dIdx = 0; dIdx < numLists; ++dIdx)
+      {
+        m_Array[dIdx] = SharedVectorType(new VectorType(m_Values.begin() + m_Offsets[dIdx], m_Values.begin() + m_Offsets[dIdx + 1]));
+      }
+      m_Offsets.assign(1, 0);
+      std::vector<T>().swap(m_Values);
+      m_NumTuples = numLists;
+      m_Compact = false;
+    }
+
+    /**
+     * @brief reserveCompact Reserves room for appendList() calls
+     * @param numLists The total number of lists
+     * @param numValues The total number of values in all lists
+     */
+    void reserveCompact(size_t numLists, size_t numValues)
+    {
+      compact();
+      m_Offsets.reserve(numLists + 1);
+      m_Values.reserve(numValues);
+    }
+
+    /**
+     * @brief appendList Adds a new list at the end. The lists are converted to the compact form
+     * first, so building a NeighborList with appendList() needs no per list allocations.
+     * @param values The values of the new list
+     * @param count The number of values
+     */
+    void appendList(const T* values, size_t count)
+    {
+      compact();
+      m_Values.insert(m_Values.end(), values, values + count);
+      m_Offsets.push_back(m_Values.size());
+      m_NumTuples = m_Offsets.size() - 1;
+      m_IsAllocated = true;
+    }
+
+    /**
+     * @brief getListPointer
+     * @param grainId
+     * @return A pointer to the first value of the list; use getListSize() for its length
+     */
+    T* getListPointer(int grainId)
+    {
+      if (m_Compact)
+      {
+        return m_Values.empty() ? nullptr : &(m_Values.front()) + m_Offsets[grainId];
+      }
+      return m_Array[grainId]->empty() ? nullptr : &(m_Array[grainId]->front());
+    }
+
 
     /**
      * @brief setList
@@ -882,6 +1060,7 @@ class NeighborList : public IDataArray
      */
     void setList(int grainId, SharedVectorType neighborList)
     {
+      expand();
       if(grainId >= static_cast<int>(m_Array.size()) )
       {
         size_t old = m_Array.size();
@@ -906,8 +1085,17 @@ class NeighborList : public IDataArray
     T getValue(int grainId, int index, bool& ok)
     {
 #ifndef NDEBUG
-      if (m_Array.size() > 0u) { Q_ASSERT(grainId < static_cast<int>(m_Array.size()));}
+      if (getNumberOfLists() > 0) { Q_ASSERT(grainId < getNumberOfLists());}
 #endif
+      if (m_Compact)
+      {
+        if(index < 0 || static_cast<size_t>(index) >= m_Offsets[grainId + 1] - m_Offsets[grainId])
+        {
+          ok = false;
+          return -1;
+        }
+        return m_Values[m_Offsets[grainId] + index];
+      }
       SharedVectorType vec = m_Array[grainId];
       if(index < 0 || static_cast<size_t>(index) >= vec->size())
       {
@@ -923,6 +1111,7 @@ class NeighborList : public IDataArray
      */
     int getNumberOfLists()
     {
+      if (m_Compact) { return static_cast<int>(m_Offsets.size() - 1); }
       return static_cast<int>(m_Array.size());
     }
 
@@ -934,13 +1123,15 @@ class NeighborList : public IDataArray
     int getListSize(int grainId)
     {
 #ifndef NDEBUG
-      if (m_Array.size() > 0u) { Q_ASSERT(grainId < static_cast<int>(m_Array.size()));}
+      if (getNumberOfLists() > 0) { Q_ASSERT(grainId < getNumberOfLists());}
 #endif
+      if (m_Compact) { return static_cast<int>(m_Offsets[grainId + 1] - m_Offsets[grainId]); }
       return static_cast<int>(m_Array[grainId]->size());
     }
 
     VectorType& getListReference(int grainId)
     {
+      expand();
 #ifndef NDEBUG
       if (m_Array.size() > 0u) { Q_ASSERT(grainId < static_cast<int>(m_Array.size()));}
 #endif
@@ -954,6 +1145,7 @@ class NeighborList : public IDataArray
      */
     SharedVectorType getList(int grainId)
     {
+      expand();
 #ifndef NDEBUG
       if (m_Array.size() > 0u) { Q_ASSERT(grainId < static_cast<int>(m_Array.size()));}
 #endif
@@ -968,8 +1160,12 @@ class NeighborList : public IDataArray
     VectorType copyOfList(int grainId)
     {
 #ifndef NDEBUG
-      if (m_Array.size() > 0u) { Q_ASSERT(grainId < static_cast<int>(m_Array.size()));}
+      if (getNumberOfLists() > 0) { Q_ASSERT(grainId < getNumberOfLists());}
 #endif
+      if (m_Compact)
+      {
+        return VectorType(m_Values.begin() + m_Offsets[grainId], m_Values.begin() + m_Offsets[grainId + 1]);
+      }
 
       VectorType copy(*(m_Array[grainId]));
       return copy;
@@ -982,6 +1178,7 @@ class NeighborList : public IDataArray
      */
     VectorType& operator[](int grainId)
     {
+      expand();
 #ifndef NDEBUG
       if (m_Array.size() > 0u) { Q_ASSERT(grainId < static_cast<int>(m_Array.size()));}
 #endif
@@ -995,6 +1192,7 @@ class NeighborList : public IDataArray
      */
     VectorType& operator[](size_t grainId)
     {
+      expand();
 #ifndef NDEBUG
       if (m_Array.size() > 0ul) { Q_ASSERT(grainId < m_Array.size());}
 #endif
@@ -1009,9 +1207,12 @@ class NeighborList : public IDataArray
      */
     NeighborList(size_t numTuples, const QString name) :
       m_NumNeighborsArrayName(SIMPL::FeatureData::NumNeighbors),
+      m_PreferCompactStorage(false),
       m_Name(name),
       m_NumTuples(numTuples),
-      m_IsAllocated(false)
+      m_IsAllocated(false),
+      m_Compact(false),
+      m_Offsets(1, 0)
     {    }
 
   private:
@@ -1019,6 +1220,9 @@ class NeighborList : public IDataArray
     QString m_Name;
     size_t m_NumTuples;
     bool m_IsAllocated;
+    bool m_Compact;
+    std::vector<size_t> m_Offsets; // Compact storage: list i holds m_Values[m_Offsets[i]] to m_Values[m_Offsets[i + 1] - 1]
+    std::vector<T> m_Values;
     T m_InitValue;
 
 
@@ -0,0 +1,208 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include "H5AsyncDataArrayWriter.h"
+
+#include <QtCore/QMutexLocker>
+#include <QtCore/QThread>
+
+#include "H5Support/QH5Utilities.h"
+
+/**
+ * @brief The thread that makes all of the HDF5 calls of one H5AsyncDataArrayWriter
+ */
+class H5AsyncDataArrayWriter::WriterThread : public QThread
+{
+  public:
+    explicit WriterThread(H5AsyncDataArrayWriter* writer) :
+      m_Writer(writer)
+    {}
+
+    virtual ~WriterThread() {}
+
+  protected:
+    void run()
+    {
+      m_Writer->processJobs();
+    }
+
+  private:
+    H5AsyncDataArrayWriter* m_Writer;
+
+    WriterThread(const WriterThread&); // Copy Constructor Not Implemented
+    void operator=(const WriterThread&); // Operator '=' Not Implemented
+};
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+H5AsyncDataArrayWriter::Pointer H5AsyncDataArrayWriter::New(size_t maxQueuedJobs)
+{
+  Pointer sharedPtr(new H5AsyncDataArrayWriter(maxQueuedJobs));
+  return sharedPtr;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+H5AsyncDataArrayWriter::H5AsyncDataArrayWriter(size_t maxQueuedJobs) :
+  m_MaxQueuedJobs(maxQueuedJobs > 0 ? maxQueuedJobs : 1),
+  m_Busy(false),
+  m_Stop(false),
+  m_Thread(nullptr)
+{
+  m_Thread = new WriterThread(this);
+  m_Thread->start();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+H5AsyncDataArrayWriter::~H5AsyncDataArrayWriter()
+{
+  {
+    QMutexLocker locker(&m_Mutex);
+    m_Stop = true;
+    m_JobAvailable.wakeAll();
+    m_SlotAvailable.wakeAll();
+  }
+  m_Thread->wait();
+  delete m_Thread;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+size_t H5AsyncDataArrayWriter::getMaxQueuedJobs()
+{
+  return m_MaxQueuedJobs;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QFuture<int> H5AsyncDataArrayWriter::writeDataArray(hid_t locId, const QString& groupPath, IDataArray::Pointer dataArray, QVector<size_t> tDims)
+{
+  return submit([locId, groupPath, dataArray, tDims]() -> int
+  {
+    if(nullptr == dataArray.get()) { return -1; }
+    if(groupPath.isEmpty())
+    {
+      return dataArray->writeH5Data(locId, tDims);
+    }
+
+    herr_t err = QH5Utilities::createGroupsFromPath(groupPath, locId);
+    if(err < 0) { return err; }
+    hid_t gid = H5Gopen(locId, groupPath.toLatin1().data(), H5P_DEFAULT);
+    if(gid < 0) { return gid; }
+    int writeErr = dataArray->writeH5Data(gid, tDims);
+    H5Gclose(gid);
+    return writeErr;
+  });
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QFuture<int> H5AsyncDataArrayWriter::submit(Job job)
+{
+  Task task;
+  task.job = job;
+  task.result.reportStarted();
+  QFuture<int> future = task.result.future();
+
+  QMutexLocker locker(&m_Mutex);
+  // Back-pressure: wait for the writer to catch up instead of queueing without limit
+  while(m_Tasks.size() >= m_MaxQueuedJobs && !m_Stop)
+  {
+    m_SlotAvailable.wait(&m_Mutex);
+  }
+  if(m_Stop)
+  {
+    task.result.reportResult(-1);
+    task.result.reportFinished();
+    return future;
+  }
+  m_Tasks.push_back(task);
+  m_JobAvailable.wakeOne();
+  return future;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void H5AsyncDataArrayWriter::waitForDone()
+{
+  QMutexLocker locker(&m_Mutex);
+  while(!m_Tasks.empty() || m_Busy)
+  {
+    m_Idle.wait(&m_Mutex);
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void H5AsyncDataArrayWriter::processJobs()
+{
+  QMutexLocker locker(&m_Mutex);
+  while(true)
+  {
+    while(m_Tasks.empty() && !m_Stop)
+    {
+      m_JobAvailable.wait(&m_Mutex);
+    }
+    // Queued jobs are finished before the thread stops
+    if(m_Tasks.empty()) { break; }
+
+    Task task = m_Tasks.front();
+    m_Tasks.pop_front();
+    m_Busy = true;
+    m_SlotAvailable.wakeOne();
+    locker.unlock();
+
+    int result = task.job();
+    task.job = Job(); // Release the array before the future reports that the job is done
+    task.result.reportResult(result);
+    task.result.reportFinished();
+
+    locker.relock();
+    m_Busy = false;
+    if(m_Tasks.empty())
+    {
+      m_Idle.wakeAll();
+    }
+  }
+}
@@ -0,0 +1,152 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#ifndef _h5asyncdataarraywriter_h_
+#define _h5asyncdataarraywriter_h_
+
+#include <deque>
+#include <functional>
+
+#include <hdf5.h>
+
+#include <QtCore/QFuture>
+#include <QtCore/QFutureInterface>
+#include <QtCore/QMutex>
+#include <QtCore/QString>
+#include <QtCore/QVector>
+#include <QtCore/QWaitCondition>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/Common/SIMPLibSetGetMacros.h"
+#include "SIMPLib/DataArrays/IDataArray.h"
+
+/**
+ * @class H5AsyncDataArrayWriter H5AsyncDataArrayWriter.h SIMPLib/HDF5/H5AsyncDataArrayWriter.h
+ * @brief Writes data arrays to HDF5 files on a dedicated background thread so that the
+ * compute threads can carry on with the next block while the previous one is written.
+ *
+ * The HDF5 library is not thread safe, so every HDF5 call of the jobs is made on the one
+ * writer thread, in the order the jobs were submitted. While jobs are queued or running the
+ * caller must not make HDF5 calls of its own; wait for the futures or call waitForDone()
+ * first. The queue is bounded: once maxQueuedJobs jobs are waiting, the submitting thread
+ * blocks until the writer has caught up, which keeps the memory held by pending arrays
+ * bounded. A queued array is kept alive by the writer but is not copied, so it must not be
+ * modified until its future has finished.
+ */
+class SIMPLib_EXPORT H5AsyncDataArrayWriter
+{
+  public:
+    SIMPL_SHARED_POINTERS(H5AsyncDataArrayWriter)
+
+    /**
+     * @brief A unit of work for the writer thread; returns a negative value on error
+     */
+    typedef std::function<int()> Job;
+
+    /**
+     * @brief Creates a writer and starts its thread
+     * @param maxQueuedJobs The number of jobs that may wait before submitting blocks
+     * @return
+     */
+    static Pointer New(size_t maxQueuedJobs = 4);
+
+    /**
+     * @brief Finishes all queued jobs and stops the writer thread
+     */
+    virtual ~H5AsyncDataArrayWriter();
+
+    /**
+     * @brief Queues the array to be written into the group at groupPath below locId. Missing
+     * groups are created. locId must stay open until the future has finished.
+     * @param locId File or group id
+     * @param groupPath Path of the group relative to locId; empty writes into locId itself
+     * @param dataArray The array
+     * @param tDims The tuple dimensions written as attribute
+     * @return The future result of IDataArray::writeH5Data, or a negative value if the group
+     * could not be opened
+     */
+    QFuture<int> writeDataArray(hid_t locId, const QString& groupPath, IDataArray::Pointer dataArray, QVector<size_t> tDims);
+
+    /**
+     * @brief Queues an arbitrary job, e.g. closing the file after the last array. Jobs run in
+     * the order they were submitted.
+     * @param job
+     * @return The future result of the job
+     */
+    QFuture<int> submit(Job job);
+
+    /**
+     * @brief Blocks until every job submitted so far has finished
+     */
+    void waitForDone();
+
+    /**
+     * @brief getMaxQueuedJobs
+     * @return
+     */
+    size_t getMaxQueuedJobs();
+
+  protected:
+    H5AsyncDataArrayWriter(size_t maxQueuedJobs);
+
+  private:
+    class WriterThread;
+
+    typedef struct
+    {
+      Job job;
+      QFutureInterface<int> result;
+    } Task;
+
+    /**
+     * @brief Runs on the writer thread until the writer is destroyed
+     */
+    void processJobs();
+
+    QMutex              m_Mutex;
+    QWaitCondition      m_JobAvailable;
+    QWaitCondition      m_SlotAvailable;
+    QWaitCondition      m_Idle;
+    std::deque<Task>    m_Tasks;
+    size_t              m_MaxQueuedJobs;
+    bool                m_Busy;
+    bool                m_Stop;
+    WriterThread*       m_Thread;
+
+    H5AsyncDataArrayWriter(const H5AsyncDataArrayWriter&); // Copy Constructor Not Implemented
+    void operator=(const H5AsyncDataArrayWriter&); // Operator '=' Not Implemented
+};
+
+#endif /* _h5asyncdataarraywriter_h_ */
@@ -39,6 +39,8 @@
 #include <hdf5.h>
 
 #include <QtCore/QString>
+#include <QtCore/QVector>
+#include <QtCore/QtDebug>
 
 #include "H5Support/QH5Lite.h"
 
@@ -114,10 +116,12 @@ class H5DataArrayWriter
      * @param gid
      * @param dataArray
      * @param tDims
+     * @param options Chunking, compression and fill value settings used if the dataset is created
      * @return
      */
     template<class T>
-    static int writeDataArray(hid_t gid, T* dataArray, QVector<size_t> tDims)
+    static int writeDataArray(hid_t gid, T* dataArray, QVector<size_t> tDims,
+                              const H5Lite::DatasetCreationOptions& options = H5Lite::DatasetCreationOptions())
     {
       int err = 0;
 
@@ -166,7 +170,7 @@ class H5DataArrayWriter
 #endif
       if (QH5Lite::datasetExists(gid, dataArray->getName()) == false)
       {
-        err = QH5Lite::writePointerDataset(gid, dataArray->getName(), h5Rank, h5Dims.data(), dataArray->getPointer(0));
+        err = QH5Lite::writePointerDataset(gid, dataArray->getName(), h5Rank, h5Dims.data(), dataArray->getPointer(0), options);
         if(err < 0)
         {
           return err;
@@ -174,7 +178,7 @@ class H5DataArrayWriter
       }
       else
       {
-        err = QH5Lite::replacePointerDataset(gid, dataArray->getName(), h5Rank, h5Dims.data(), dataArray->getPointer(0));
+        err = QH5Lite::replacePointerDataset(gid, dataArray->getName(), h5Rank, h5Dims.data(), dataArray->getPointer(0), options);
         if(err < 0)
         {
           return err;
@@ -186,6 +190,42 @@ class H5DataArrayWriter
       return err;
     }
 
+    /**
+     * @brief appendDataArray Appends the tuples of a DataArray as new rows of an extendible dataset
+     * of the same name, creating the dataset on the first call. This lets a large stack (e.g. of
+     * patterns) be written batch by batch without holding the whole stack in memory. Each tuple is one
+     * row of shape cDims, and the TupleDimensions attribute is updated to the total number of tuples
+     * written so far.
+     * @param gid
+     * @param dataArray
+     * @param options Chunking, compression and fill value settings used if the dataset is created
+     * @return
+     */
+    template<class T>
+    static int appendDataArray(hid_t gid, T* dataArray,
+                               const H5Lite::DatasetCreationOptions& options = H5Lite::DatasetCreationOptions())
+    {
+      QVector<size_t> cDims = dataArray->getComponentDimensions();
+      // HDF5 order is slowest to fastest, see writeDataArray
+      QVector<hsize_t> rowDims(cDims.size());
+      qint32 count = cDims.size() - 1;
+      for (int i = count; i >= 0; i--)
+      {
+        rowDims[count - i] = cDims[i];
+      }
+
+      hsize_t totalRows = 0;
+      int err = appendRows(gid, dataArray->getName(), rowDims, dataArray->getPointer(0), dataArray->getNumberOfTuples(), options, totalRows);
+      if(err < 0)
+      {
+        return err;
+      }
+
+      QVector<size_t> tDims(1, static_cast<size_t>(totalRows));
+      err = writeDataArrayAttributes<T>(gid, dataArray, tDims, cDims);
+      return err;
+    }
+
 
     /**
      * @brief writeDataArray
@@ -217,6 +257,42 @@ class H5DataArrayWriter
   protected:
     H5DataArrayWriter() {}
 
+    /**
+     * @brief appendRows Creates the extendible dataset if needed and appends the rows to it. An
+     * existing dataset must have the same rank and row dimensions as the new rows.
+     */
+    template<typename V>
+    static int appendRows(hid_t gid, const QString& name, const QVector<hsize_t>& rowDims, const V* data, size_t numRows,
+                          const H5Lite::DatasetCreationOptions& options, hsize_t& totalRows)
+    {
+      int err = 0;
+      if (QH5Lite::datasetExists(gid, name) == false)
+      {
+        err = QH5Lite::createExtendibleDataset<V>(gid, name, rowDims, options);
+        if(err < 0)
+        {
+          return err;
+        }
+      }
+      else
+      {
+        QVector<hsize_t> dims;
+        H5T_class_t typeClass;
+        size_t typeSize = 0;
+        err = QH5Lite::getDatasetInfo(gid, name, dims, typeClass, typeSize);
+        if(err < 0)
+        {
+          return err;
+        }
+        if(dims.size() != rowDims.size() + 1 || dims.mid(1) != rowDims)
+        {
+          qDebug() << "appendRows: the row dimensions do not match the existing dataset " << name;
+          return -1;
+        }
+      }
+      return QH5Lite::appendSlab(gid, name, data, static_cast<hsize_t>(numRows), &totalRows);
+    }
+
   private:
     H5DataArrayWriter(const H5DataArrayWriter&); // Copy Constructor Not Implemented
     void operator=(const H5DataArrayWriter&); // Operator '=' Not Implemented
@@ -0,0 +1,456 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+
+#ifndef _arraypermute_h_
+#define _arraypermute_h_
+
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <algorithm>
+#include <vector>
+
+#include <QtCore/QAtomicInt>
+#include <QtCore/QRunnable>
+#include <QtCore/QSemaphore>
+#include <QtCore/QThreadPool>
+
+/**
+ * @brief ArrayPermute reorders the dimensions of multi dimensional arrays, e.g. to turn an
+ * interleaved (x,y,z) Monte Carlo histogram into z slices or to convert between the Fortran
+ * (column-major) and C (row-major) layout of a master pattern.
+ *
+ * All dimensions are given in C (HDF5) order, the first dimension being the slowest. The
+ * output is always contiguous. Dimensions that stay adjacent are merged first, and when the
+ * fastest dimension of the source is not the fastest of the output the copy is done in square
+ * tiles so that both the reads and the writes use whole cache lines. Large copies are split
+ * over QThreadPool::globalInstance() and the calling thread.
+ */
+template<typename T>
+class ArrayPermute
+{
+  public:
+    virtual ~ArrayPermute() {}
+
+    /**
+     * @brief Copies a strided view of src into the contiguous array dst.
+     * @param src Address of the element that becomes dst[0]
+     * @param dims The dimensions of the output
+     * @param srcStrides The distance in elements in src between neighbours along each output
+     * dimension; negative strides walk the source backwards
+     * @param dst Output buffer with room for the product of dims elements
+     * @param parallel Allow the copy to use the global thread pool
+     * @return 0 on success, -1 if the sizes of dims and srcStrides differ
+     */
+    static int StridedCopy(const T* src, const std::vector<size_t>& dims, const std::vector<ptrdiff_t>& srcStrides, T* dst, bool parallel = true)
+    {
+      Plan plan;
+      if(makePlan(dims, srcStrides, plan) < 0) { return -1; }
+      if(plan.numElements == 0) { return 0; }
+      if(plan.dims.empty())
+      {
+        dst[0] = src[0];
+        return 0;
+      }
+
+      CopyState state;
+      state.plan = &plan;
+      state.src = src;
+      state.dst = dst;
+      state.numItems = plan.numItems();
+      size_t itemBytes = plan.itemElements() * sizeof(T);
+      state.itemsPerChunk = std::max<size_t>(1, static_cast<size_t>(ChunkBytes) / std::max<size_t>(1, itemBytes));
+      state.numChunks = static_cast<int>((state.numItems + state.itemsPerChunk - 1) / state.itemsPerChunk);
+
+      QThreadPool* pool = QThreadPool::globalInstance();
+      int numHelpers = 0;
+      if(parallel && plan.numElements * sizeof(T) >= static_cast<size_t>(ParallelBytes))
+      {
+        numHelpers = std::min(pool->maxThreadCount(), state.numChunks) - 1;
+      }
+      // Only count the tasks that actually started, so that a busy pool can not deadlock us
+      int started = 0;
+      for(int i = 0; i < numHelpers; i++)
+      {
+        CopyTask* task = new CopyTask(&state);
+        task->setAutoDelete(true);
+        if(pool->tryStart(task) == false)
+        {
+          delete task;
+          break;
+        }
+        started++;
+      }
+      CopyChunks(&state);
+      state.finished.acquire(started);
+      return 0;
+    }
+
+    /**
+     * @brief Reorders the dimensions of src into dst. Output dimension i is source dimension
+     * perm[i], so perm = (2, 0, 1) moves the fastest dimension of a 3D array to the front.
+     * @param src Source array
+     * @param dst Output array; must not overlap src
+     * @param dims The dimensions of the source
+     * @param perm The source dimension of each output dimension
+     * @param reverse Optional, one flag per source dimension that is traversed backwards
+     * @param parallel Allow the copy to use the global thread pool
+     * @return 0 on success, -1 if perm is not a permutation of the dimensions
+     */
+    static int Permute(const T* src, T* dst, const std::vector<size_t>& dims, const std::vector<size_t>& perm,
+                       const std::vector<bool>& reverse = std::vector<bool>(), bool parallel = true)
+    {
+      std::vector<size_t> outDims;
+      std::vector<ptrdiff_t> outStrides;
+      ptrdiff_t base = 0;
+      if(permutedView(dims, perm, reverse, outDims, outStrides, base) < 0) { return -1; }
+      return StridedCopy(src + base, outDims, outStrides, dst, parallel);
+    }
+
+    /**
+     * @brief Reorders the dimensions of data in place by following the cycles of the permutation.
+     * This needs one bit per element instead of a second array, but it visits the elements in a
+     * scattered order and runs on the calling thread only, so Permute into a second buffer is
+     * much faster when the memory is available.
+     * @param data The array
+     * @param dims The dimensions of the source
+     * @param perm The source dimension of each output dimension
+     * @param reverse Optional, one flag per source dimension that is traversed backwards
+     * @return 0 on success, -1 if perm is not a permutation of the dimensions
+     */
+    static int PermuteInPlace(T* data, const std::vector<size_t>& dims, const std::vector<size_t>& perm,
+                              const std::vector<bool>& reverse = std::vector<bool>())
+    {
+      std::vector<size_t> outDims;
+      std::vector<ptrdiff_t> outStrides;
+      ptrdiff_t base = 0;
+      if(permutedView(dims, perm, reverse, outDims, outStrides, base) < 0) { return -1; }
+      Plan plan;
+      makePlan(outDims, outStrides, plan);
+      if(plan.dims.size() == 1 && plan.srcStrides[0] == 1) { return 0; } // Nothing moves
+
+      size_t numElements = plan.numElements;
+      size_t rank = plan.dims.size();
+      std::vector<bool> visited(numElements, false);
+      for(size_t start = 0; start < numElements; start++)
+      {
+        if(visited[start]) { continue; }
+        // Element j of the output comes from element source(j) of the input
+        T value = data[start];
+        size_t j = start;
+        while(true)
+        {
+          visited[j] = true;
+          ptrdiff_t k = base;
+          size_t remainder = j;
+          for(size_t d = rank; d-- > 0;)
+          {
+            k += static_cast<ptrdiff_t>(remainder % plan.dims[d]) * plan.srcStrides[d];
+            remainder /= plan.dims[d];
+          }
+          size_t source = static_cast<size_t>(k);
+          if(source == start)
+          {
+            data[j] = value;
+            break;
+          }
+          data[j] = data[source];
+          j = source;
+        }
+      }
+      return 0;
+    }
+
+    /**
+     * @brief Reverses the order of the dimensions, which converts between the Fortran
+     * (column-major) and C (row-major) layout of the same array.
+     * @param src Source array
+     * @param dst Output array; must not overlap src
+     * @param dims The dimensions of the source
+     * @param parallel Allow the copy to use the global thread pool
+     * @return 0 on success
+     */
+    static int ReverseDimensionOrder(const T* src, T* dst, const std::vector<size_t>& dims, bool parallel = true)
+    {
+      std::vector<size_t> perm(dims.size());
+      for(size_t i = 0; i < dims.size(); i++)
+      {
+        perm[i] = dims.size() - 1 - i;
+      }
+      return Permute(src, dst, dims, perm, std::vector<bool>(), parallel);
+    }
+
+  protected:
+    ArrayPermute() {}
+
+  private:
+    enum
+    {
+      TileSize = 32,               // Edge of the square tiles of a transposing copy
+      ChunkBytes = 256 * 1024,     // Amount of output handed out at once to a thread
+      ParallelBytes = 1024 * 1024  // Smaller copies stay on the calling thread
+    };
+
+    /**
+     * @brief A copy reduced to its simplest form. The work is split into items: rows of the
+     * fastest output dimension, or for a transposing copy one row of tiles along the tile
+     * dimension.
+     */
+    typedef struct
+    {
+      std::vector<size_t> dims;
+      std::vector<ptrdiff_t> srcStrides;
+      std::vector<size_t> dstStrides;
+      std::vector<size_t> outerDims; // Output dimensions that are iterated over by the items
+      size_t numElements;
+      int tileDim; // Output dimension that is fastest in the source, or -1 for a row copy
+
+      size_t numTiles() const { return (tileDim < 0) ? 1 : (dims[tileDim] + TileSize - 1) / TileSize; }
+
+      size_t numItems() const
+      {
+        size_t n = numTiles();
+        for(size_t i = 0; i < outerDims.size(); i++) { n *= dims[outerDims[i]]; }
+        return n;
+      }
+
+      size_t itemElements() const { return dims.back() * ((tileDim < 0) ? 1 : std::min<size_t>(TileSize, dims[tileDim])); }
+    } Plan;
+
+    typedef struct
+    {
+      const Plan* plan;
+      const T* src;
+      T* dst;
+      size_t numItems;
+      size_t itemsPerChunk;
+      int numChunks;
+      QAtomicInt nextChunk;
+      QSemaphore finished;
+    } CopyState;
+
+    class CopyTask : public QRunnable
+    {
+      public:
+        explicit CopyTask(CopyState* state) :
+          m_State(state)
+        {}
+
+        virtual ~CopyTask() {}
+
+        void run()
+        {
+          CopyChunks(m_State);
+          m_State->finished.release();
+        }
+
+      private:
+        CopyState* m_State;
+
+        CopyTask(const CopyTask&); // Copy Constructor Not Implemented
+        void operator=(const CopyTask&); // Operator '=' Not Implemented
+    };
+
+    /**
+     * @brief Computes the strided view of src that Permute copies
+     */
+    static int permutedView(const std::vector<size_t>& dims, const std::vector<size_t>& perm, const std::vector<bool>& reverse,
+                            std::vector<size_t>& outDims, std::vector<ptrdiff_t>& outStrides, ptrdiff_t& base)
+    {
+      size_t rank = dims.size();
+      if(perm.size() != rank || (!reverse.empty() && reverse.size() != rank)) { return -1; }
+      std::vector<bool> used(rank, false);
+      for(size_t i = 0; i < rank; i++)
+      {
+        if(perm[i] >= rank || used[perm[i]]) { return -1; }
+        used[perm[i]] = true;
+      }
+
+      std::vector<ptrdiff_t> strides(rank, 1);
+      for(size_t i = rank; i-- > 1;)
+      {
+        strides[i - 1] = strides[i] * static_cast<ptrdiff_t>(dims[i]);
+      }
+      base = 0;
+      outDims.resize(rank);
+      outStrides.resize(rank);
+      for(size_t i = 0; i < rank; i++)
+      {
+        size_t s = perm[i];
+        outDims[i] = dims[s];
+        outStrides[i] = strides[s];
+        if(!reverse.empty() && reverse[s] && dims[s] > 0)
+        {
+          base += static_cast<ptrdiff_t>(dims[s] - 1) * strides[s];
+          outStrides[i] = -strides[s];
+        }
+      }
+      return 0;
+    }
+
+    /**
+     * @brief Drops dimensions of size 1, merges dimensions that are adjacent in both arrays and
+     * decides between a row copy and a tiled copy.
+     */
+    static int makePlan(const std::vector<size_t>& dims, const std::vector<ptrdiff_t>& srcStrides, Plan& plan)
+    {
+      if(dims.size() != srcStrides.size()) { return -1; }
+      plan.dims.clear();
+      plan.srcStrides.clear();
+      plan.numElements = 1;
+      for(size_t i = 0; i < dims.size(); i++)
+      {
+        plan.numElements *= dims[i];
+        if(dims[i] == 1) { continue; }
+        if(!plan.dims.empty() && plan.srcStrides.back() == srcStrides[i] * static_cast<ptrdiff_t>(dims[i]))
+        {
+          plan.dims.back() *= dims[i];
+          plan.srcStrides.back() = srcStrides[i];
+          continue;
+        }
+        plan.dims.push_back(dims[i]);
+        plan.srcStrides.push_back(srcStrides[i]);
+      }
+
+      size_t rank = plan.dims.size();
+      plan.dstStrides.assign(rank, 1);
+      for(size_t i = rank; i-- > 1;)
+      {
+        plan.dstStrides[i - 1] = plan.dstStrides[i] * plan.dims[i];
+      }
+
+      // Tile when another dimension walks the source with a shorter step than the fastest output dimension
+      plan.tileDim = -1;
+      if(rank >= 2)
+      {
+        ptrdiff_t innerStep = std::abs(plan.srcStrides[rank - 1]);
+        for(size_t i = 0; i < rank - 1; i++)
+        {
+          ptrdiff_t step = std::abs(plan.srcStrides[i]);
+          if(step < innerStep && (plan.tileDim < 0 || step < std::abs(plan.srcStrides[plan.tileDim])))
+          {
+            plan.tileDim = static_cast<int>(i);
+          }
+        }
+      }
+
+      plan.outerDims.clear();
+      for(size_t i = 0; i + 1 < rank; i++)
+      {
+        if(static_cast<int>(i) != plan.tileDim) { plan.outerDims.push_back(i); }
+      }
+      return 0;
+    }
+
+    /**
+     * @brief Copies chunks of items until all of them have been taken
+     */
+    static void CopyChunks(CopyState* state)
+    {
+      int chunk = state->nextChunk.fetchAndAddOrdered(1);
+      while(chunk < state->numChunks)
+      {
+        size_t start = static_cast<size_t>(chunk) * state->itemsPerChunk;
+        size_t end = std::min(start + state->itemsPerChunk, state->numItems);
+        for(size_t item = start; item < end; item++)
+        {
+          copyItem(*(state->plan), state->src, state->dst, item);
+        }
+        chunk = state->nextChunk.fetchAndAddOrdered(1);
+      }
+    }
+
+    static void copyItem(const Plan& plan, const T* src, T* dst, size_t item)
+    {
+      size_t numTiles = plan.numTiles();
+      size_t tile = item % numTiles;
+      size_t remainder = item / numTiles;
+
+      ptrdiff_t srcOffset = 0;
+      size_t dstOffset = 0;
+      for(size_t i = plan.outerDims.size(); i-- > 0;)
+      {
+        size_t d = plan.outerDims[i];
+        size_t index = remainder % plan.dims[d];
+        remainder /= plan.dims[d];
+        srcOffset += static_cast<ptrdiff_t>(index) * plan.srcStrides[d];
+        dstOffset += index * plan.dstStrides[d];
+      }
+
+      size_t inner = plan.dims.size() - 1;
+      size_t cols = plan.dims[inner];
+      ptrdiff_t colStep = plan.srcStrides[inner];
+      if(plan.tileDim < 0)
+      {
+        const T* s = src + srcOffset;
+        T* d = dst + dstOffset;
+        if(colStep == 1)
+        {
+          ::memcpy(d, s, cols * sizeof(T));
+        }
+        else
+        {
+          for(size_t c = 0; c < cols; c++) { d[c] = s[static_cast<ptrdiff_t>(c) * colStep]; }
+        }
+        return;
+      }
+
+      // One row of square tiles: rows along the tile dimension, columns along the fastest output dimension
+      size_t rowStart = tile * TileSize;
+      size_t rowEnd = std::min<size_t>(rowStart + TileSize, plan.dims[plan.tileDim]);
+      ptrdiff_t rowStep = plan.srcStrides[plan.tileDim];
+      size_t dstRowStep = plan.dstStrides[plan.tileDim];
+      for(size_t colStart = 0; colStart < cols; colStart += TileSize)
+      {
+        size_t colEnd = std::min<size_t>(colStart + TileSize, cols);
+        for(size_t r = rowStart; r < rowEnd; r++)
+        {
+          const T* s = src + srcOffset + static_cast<ptrdiff_t>(r) * rowStep;
+          T* d = dst + dstOffset + r * dstRowStep;
+          for(size_t c = colStart; c < colEnd; c++)
+          {
+            d[c] = s[static_cast<ptrdiff_t>(c) * colStep];
+          }
+        }
+      }
+    }
+
+    ArrayPermute(const ArrayPermute&); // Copy Constructor Not Implemented
+    void operator=(const ArrayPermute&); // Operator '=' Not Implemented
+};
+
+#endif /* _arraypermute_h_ */
@@ -40,6 +40,7 @@ set(SIMPLib_${SUBDIR_NAME}_HDRS
   ${SIMPLib_SOURCE_DIR}/Math/MatrixMath.h
   ${SIMPLib_SOURCE_DIR}/Math/QuaternionMath.hpp
   ${SIMPLib_SOURCE_DIR}/Math/ArrayHelpers.hpp
+  ${SIMPLib_SOURCE_DIR}/Math/ArrayPermute.hpp
   ${SIMPLib_SOURCE_DIR}/Math/SIMPLibMath.h
 )
 set(SIMPLib_${SUBDIR_NAME}_SRCS
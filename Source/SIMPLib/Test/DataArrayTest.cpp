@@ -0,0 +1,163 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (c) 2017 BlueQuartz Software
+//  All rights reserved.
+//  BSD License: http://www.opensource.org/licenses/bsd-license.html
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include <stdio.h>
+
+#if defined (_MSC_VER)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+//-- C++ includes
+#include <iostream>
+
+#include "SIMPLib/DataArrays/DataArray.hpp"
+
+#include "UnitTestSupport.hpp"
+
+namespace
+{
+  const size_t k_NumValues = 1024;
+
+  // -----------------------------------------------------------------------------
+  // Maps one or more pages, fills them with 0..n-1 and then makes them read only
+  // -----------------------------------------------------------------------------
+  int32_t* mapReadOnlyBuffer(size_t numValues, size_t& numBytes)
+  {
+#if defined (_MSC_VER)
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    size_t pageSize = static_cast<size_t>(info.dwPageSize);
+#else
+    size_t pageSize = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+#endif
+    numBytes = ((numValues * sizeof(int32_t) + pageSize - 1) / pageSize) * pageSize;
+
+#if defined (_MSC_VER)
+    void* mem = VirtualAlloc(NULL, numBytes, MEM_COMMIT | MEM_RESERVE, PAGE_READWRITE);
+    if (NULL == mem) { return nullptr; }
+#else
+    void* mem = mmap(nullptr, numBytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (MAP_FAILED == mem) { return nullptr; }
+#endif
+
+    int32_t* data = static_cast<int32_t*>(mem);
+    for (size_t i = 0; i < numValues; i++)
+    {
+      data[i] = static_cast<int32_t>(i);
+    }
+
+#if defined (_MSC_VER)
+    DWORD oldProtect = 0;
+    VirtualProtect(mem, numBytes, PAGE_READONLY, &oldProtect);
+#else
+    mprotect(mem, numBytes, PROT_READ);
+#endif
+    return data;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void unmapBuffer(int32_t* data, size_t numBytes)
+  {
+#if defined (_MSC_VER)
+    VirtualFree(data, 0, MEM_RELEASE);
+#else
+    munmap(data, numBytes);
+#endif
+  }
+}
+
+// -----------------------------------------------------------------------------
+// A view of a read only buffer is neither written to nor freed when the array
+// is destroyed
+// -----------------------------------------------------------------------------
+void TestWrapReadOnlyPointer()
+{
+  size_t numBytes = 0;
+  int32_t* data = mapReadOnlyBuffer(k_NumValues, numBytes);
+  EMSOFT_REQUIRE(nullptr != data);
+
+  {
+    Int32ArrayType::Pointer array = Int32ArrayType::WrapPointer(data, k_NumValues, QVector<size_t>(1, 1), "ReadOnly", false);
+    EMSOFT_REQUIRE(array->getPointer(0) == data);
+    EMSOFT_REQUIRE_EQUAL(array->getNumberOfTuples(), k_NumValues);
+    EMSOFT_REQUIRE_EQUAL(array->getValue(k_NumValues - 1), static_cast<int32_t>(k_NumValues - 1));
+  }
+
+  EMSOFT_REQUIRE_EQUAL(data[0], 0);
+  EMSOFT_REQUIRE_EQUAL(data[1], 1);
+  unmapBuffer(data, numBytes);
+}
+
+// -----------------------------------------------------------------------------
+// Resizing a view copies it into memory that the array owns
+// -----------------------------------------------------------------------------
+void TestResizeWrappedReadOnlyPointer()
+{
+  size_t numBytes = 0;
+  int32_t* data = mapReadOnlyBuffer(k_NumValues, numBytes);
+  EMSOFT_REQUIRE(nullptr != data);
+
+  {
+    Int32ArrayType::Pointer array = Int32ArrayType::WrapPointer(data, k_NumValues, QVector<size_t>(1, 1), "ReadOnly", false);
+    array->resize(2 * k_NumValues);
+    EMSOFT_REQUIRE(array->getPointer(0) != data);
+    EMSOFT_REQUIRE_EQUAL(array->getValue(k_NumValues - 1), static_cast<int32_t>(k_NumValues - 1));
+    array->setValue(0, 42);
+  }
+
+  EMSOFT_REQUIRE_EQUAL(data[0], 0);
+  EMSOFT_REQUIRE_EQUAL(data[1], 1);
+  unmapBuffer(data, numBytes);
+}
+
+// -----------------------------------------------------------------------------
+// Erasing tuples from a view copies the remaining tuples out instead of freeing
+// the view
+// -----------------------------------------------------------------------------
+void TestEraseTuplesWrappedReadOnlyPointer()
+{
+  size_t numBytes = 0;
+  int32_t* data = mapReadOnlyBuffer(k_NumValues, numBytes);
+  EMSOFT_REQUIRE(nullptr != data);
+
+  {
+    Int32ArrayType::Pointer array = Int32ArrayType::WrapPointer(data, k_NumValues, QVector<size_t>(1, 1), "ReadOnly", false);
+    QVector<size_t> idxs(1, 0);
+    int err = array->eraseTuples(idxs);
+    EMSOFT_REQUIRE_EQUAL(err, 0);
+    EMSOFT_REQUIRE(array->getPointer(0) != data);
+    EMSOFT_REQUIRE_EQUAL(array->getSize(), k_NumValues - 1);
+    EMSOFT_REQUIRE_EQUAL(array->getValue(0), 1);
+  }
+
+  EMSOFT_REQUIRE_EQUAL(data[0], 0);
+  unmapBuffer(data, numBytes);
+}
+
+// -----------------------------------------------------------------------------
+//  Use unit test framework
+// -----------------------------------------------------------------------------
+int main(int argc, char** argv)
+{
+  int err = EXIT_SUCCESS;
+
+  EMSOFT_REGISTER_TEST( TestWrapReadOnlyPointer() )
+  EMSOFT_REGISTER_TEST( TestResizeWrappedReadOnlyPointer() )
+  EMSOFT_REGISTER_TEST( TestEraseTuplesWrappedReadOnlyPointer() )
+  PRINT_TEST_SUMMARY();
+
+  return err;
+}